@@ -59,6 +59,8 @@ min5_max = {min5_max}
 min15_max = {min15_max}
 min30_max = {min30_max}
 min60_max = {min60_max}
+memory_limit = 0
+io_concurrency = 0
 
 
 [baseinfo]
@@ -117,6 +119,8 @@ min5_max = {min5_max}
 min15_max = {min15_max}
 min30_max = {min30_max}
 min60_max = {min60_max}
+memory_limit = 0
+io_concurrency = 0
 
 [baseinfo]
 type = mysql
@@ -286,6 +286,7 @@ Query.MIN5 = "MIN5"
 Query.MIN15 = "MIN15"
 Query.MIN30 = "MIN30"
 Query.MIN60 = "MIN60"
+Query.MIN3 = "MIN3"
 Query.HOUR2 = "HOUR2"
 Query.HOUR4 = "HOUR4"
 Query.HOUR6 = "HOUR6"
@@ -332,37 +333,46 @@ try:
     def KData_to_np(kdata):
         """转化为numpy结构数组"""
         if kdata.get_query().ktype in ('DAY', 'WEEK', 'MONTH', 'QUARTER', 'HALFYEAR', 'YEAR'):
-            k_type = np.dtype(
-                {
-                    'names': ['datetime', 'open', 'high', 'low', 'close', 'amount', 'volume'],
-                    'formats': ['datetime64[D]', 'd', 'd', 'd', 'd', 'd', 'd']
-                }
-            )
+            date_type = 'datetime64[D]'
         else:
-            k_type = np.dtype(
-                {
-                    'names': ['datetime', 'open', 'high', 'low', 'close', 'amount', 'volume'],
-                    'formats': ['datetime64[ms]', 'd', 'd', 'd', 'd', 'd', 'd']
-                }
-            )
-        return np.array(
-            [
-                (k.datetime.datetime(), k.open, k.high, k.low, k.close, k.amount, k.volume)
-                for k in kdata
-            ],
-            dtype=k_type
+            date_type = 'datetime64[ms]'
+        k_type = np.dtype(
+            {
+                'names': ['datetime', 'open', 'high', 'low', 'close', 'amount', 'volume'],
+                'formats': [date_type, 'd', 'd', 'd', 'd', 'd', 'd']
+            }
         )
+        result = np.empty(len(kdata), dtype=k_type)
+        result['datetime'] = np.frombuffer(kdata._datetime_us_bytes(), dtype='datetime64[us]')
+        for field in ('open', 'high', 'low', 'close', 'amount', 'volume'):
+            result[field] = np.asarray(kdata._buffer_view(field))
+        return result
+
+    def KData_column_to_np(kdata, field):
+        """
+        返回K线中指定字段的只读 np.array，与 KData 共享内存（零拷贝）
+
+        :param str field: open|high|low|close|amount|volume|datetime，
+                          datetime 为 datetime64[us] 类型，需复制转换
+        """
+        if field == 'datetime':
+            return np.frombuffer(kdata._datetime_us_bytes(), dtype='datetime64[us]')
+        return np.asarray(kdata._buffer_view(field))
 
     def KData_to_df(kdata):
         """转化为pandas的DataFrame"""
         return pd.DataFrame.from_records(KData_to_np(kdata), index='datetime')
 
     KData.to_np = KData_to_np
+    KData.column_to_np = KData_column_to_np
     KData.to_df = KData_to_df
 
     def PriceList_to_np(data):
-        """仅在安装了numpy模块时生效，转换为numpy.array"""
-        return np.array(data, dtype='d')
+        """
+        仅在安装了numpy模块时生效，转换为只读的numpy.array，与 PriceList 共享内存，
+        该数组存续期间 PriceList.append 将抛出 BufferError
+        """
+        return np.asarray(data._buffer_view())
 
     def PriceList_to_df(data):
         """仅在安装了pandas模块时生效，转换为pandas.DataFrame"""
@@ -372,8 +382,8 @@ try:
     PriceList.to_df = PriceList_to_df
 
     def DatetimeList_to_np(data):
-        """仅在安装了numpy模块时生效，转换为numpy.array"""
-        return np.array(data, dtype='datetime64[D]')
+        """仅在安装了numpy模块时生效，转换为 datetime64[us] 类型的numpy.array"""
+        return np.frombuffer(data._to_us_bytes(), dtype='datetime64[us]')
 
     def DatetimeList_to_df(data):
         """仅在安装了pandas模块时生效，转换为pandas.DataFrame"""
@@ -63,9 +63,10 @@ Indicator.__iter__ = indicator_iter
 
 def PRICELIST(data, result_index=0, discard=0):
     """
-    将 list、tuple、Indicator 转化为普通的 Indicator
+    将 list、tuple、numpy.ndarray、Indicator 转化为普通的 Indicator
     
-    :param data: 输入数据，可以为 list、tuple、Indicator
+    :param data: 输入数据，可以为 list、tuple、numpy.ndarray、Indicator。一维 float64 的
+                 numpy.ndarray 将整体复制，无需逐个元素转换
     :param int result_index: 当data为Indicator实例时，指示Indicator的第几个结果集
     :param int discard: 在 data 为 Indicator类型时无效。表示前端抛弃的数据点数，抛弃的值使用 constant.null_price 填充
     :return: Indicator
@@ -74,7 +75,7 @@ def PRICELIST(data, result_index=0, discard=0):
     if isinstance(data, ind.Indicator):
         return ind.PRICELIST(data, result_index)
     else:
-        return ind.PRICELIST(toPriceList(data), discard)
+        return ind.PRICELIST(data, discard)
 
 
 VALUE = PRICELIST
@@ -83,9 +84,14 @@ try:
     import numpy as np
     import pandas as pd
 
-    def indicator_to_np(indicator):
-        """转化为np.array，如果indicator存在多个值，只返回第一个"""
-        return np.array(indicator, dtype='d')
+    def indicator_to_np(indicator, result_index=0):
+        """
+        转化为只读的 np.array，与 Indicator 共享内存（零拷贝），如需修改请先 copy()。
+        该数组存续期间 set_context 将抛出 BufferError
+
+        :param int result_index: 指定的结果集，默认返回第一个结果集
+        """
+        return np.asarray(indicator._buffer_view(result_index))
 
     def indicator_to_df(indicator):
         """转化为pandas.DataFrame"""
@@ -96,7 +102,7 @@ try:
         name = indicator.name
         columns = []
         for i in range(indicator.get_result_num()):
-            data[name + str(i)] = indicator.get_result(i)
+            data[name + str(i)] = indicator_to_np(indicator, i)
             columns.append(name + str(i + 1))
         return pd.DataFrame(data, columns=columns)
 
@@ -139,6 +139,40 @@ class IndicatorTest(unittest.TestCase):
         self.assert_(abs(m[2] - 1.5) < 0.0001)
         self.assert_(abs(m[3] - 2.5) < 0.0001)
 
+    def test_numpy(self):
+        import numpy as np
+        a = np.array([0.0, 1.0, 2.0, 3.0])
+        x = PRICELIST(a, discard=1)
+        self.assertEqual(x.size(), 4)
+        self.assertEqual(x.discard, 1)
+        self.assertEqual(x[3], 3)
+
+        m = MA(x, 2)
+        y = m.to_np()
+        self.assertEqual(len(y), 4)
+        self.assertEqual(y.flags.writeable, False)
+        self.assert_(abs(y[2] - 1.5) < 0.0001)
+        self.assert_(abs(y[3] - 2.5) < 0.0001)
+
+        # 视图持有指标的计算结果，导出期间不允许重新计算
+        k = sm['sh000001'].get_kdata(Query(-10))
+        self.assertRaises(BufferError, m.set_context, k)
+        del m
+        self.assert_(abs(y[3] - 2.5) < 0.0001)
+
+        # PriceList 导出期间不允许追加
+        p = toPriceList([1.0, 2.0])
+        z = p.to_np()
+        self.assertRaises(BufferError, p.append, 3.0)
+        del z
+        p.append(3.0)
+        self.assertEqual(len(p), 3)
+
+        # 非 float64 数组退回逐个转换
+        x = PRICELIST(np.array([1, 2, 3]))
+        self.assertEqual(x.size(), 3)
+        self.assertEqual(x[2], 3)
+
     def test_pickle(self):
         if not constant.pickle_support:
             return
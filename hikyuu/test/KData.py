@@ -43,6 +43,19 @@ class KDataTest(unittest.TestCase):
         self.assert_(abs(k[1].open - 104.3) < 0.0001)
         self.assert_(abs(k[9].open - 127.61) < 0.0001)
 
+    def test_to_np(self):
+        k = sm["sh000001"].getKData(Query(0, 10))
+        close = k.column_to_np('close')
+        self.assertEqual(len(close), 10)
+        self.assertEqual(close.flags.writeable, False)
+        self.assert_(abs(close[0] - 99.98) < 0.0001)
+        self.assert_(abs(k.column_to_np('open')[9] - 127.61) < 0.0001)
+        self.assertEqual(str(k.column_to_np('datetime')[0]), '1990-12-19T00:00:00.000000')
+
+        x = k.to_np()
+        self.assertEqual(len(x), 10)
+        self.assert_(abs(x['volume'][0] - 1260) < 0.0001)
+
     def test_pickle(self):
         if not constant.pickle_support:
             return
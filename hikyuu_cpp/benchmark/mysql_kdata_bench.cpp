@@ -0,0 +1,134 @@
+/*
+ *  Copyright(C) 2026 hikyuu.org
+ *
+ *  Create on: 2026-10-18
+ *     Author: fasiondog
+ */
+
+// MySQL K线数据查询延迟测试
+//
+// mysql-kdata-bench <host> <port> <usr> <pwd> [market，默认 SH] [ktype，默认 MIN] [代码，逗号分隔]
+//
+// 分别输出首次（冷，需建立日期索引）与再次（热）查询的耗时，并与原先基于 limit offset
+// 及 count(1) 的查询方式对比
+
+#include <chrono>
+#include <iostream>
+#include <boost/algorithm/string.hpp>
+#include <hikyuu/Log.h>
+#include <hikyuu/data_driver/kdata/mysql/MySQLKDataDriver.h>
+
+using namespace hku;
+
+template <class Func>
+static double elapsed_ms(Func&& func) {
+    auto start = std::chrono::steady_clock::now();
+    func();
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start)
+      .count();
+}
+
+static void print(const string& name, double cold, double warm) {
+    std::cout << fmt::format("{:<36}{:>12.3f}ms{:>12.3f}ms", name, cold, warm) << std::endl;
+}
+
+template <class Func>
+static void run(const string& name, Func&& func) {
+    double cold = elapsed_ms(func);
+    double warm = elapsed_ms(func);
+    print(name, cold, warm);
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 5) {
+        std::cout << "Usage:\n"
+                  << "  mysql-kdata-bench <host> <port> <usr> <pwd> [market] [ktype] [codes]"
+                  << std::endl;
+        return 1;
+    }
+
+    initLogger();
+    string market = argc > 5 ? argv[5] : "SH";
+    KQuery::KType ktype = argc > 6 ? argv[6] : KQuery::MIN;
+    vector<string> codes;
+    boost::split(codes, argc > 7 ? string(argv[7]) : string("600000,600004,600009,600010"),
+                 boost::is_any_of(","));
+    const string& code = codes.front();
+
+    Parameter param;
+    param.set<string>("type", "mysql");
+    param.set<string>("host", argv[1]);
+    param.set<string>("port", argv[2]);
+    param.set<string>("usr", argv[3]);
+    param.set<string>("pwd", argv[4]);
+
+    MySQLKDataDriver driver;
+    HKU_ERROR_IF_RETURN(!driver.init(param), 1, "Failed init driver!");
+
+    // 原先的查询方式，作为对照
+    Parameter connect_param;
+    connect_param.set<string>("db", "");
+    connect_param.set<string>("host", argv[1]);
+    connect_param.set<int>("port", std::stoi(argv[2]));
+    connect_param.set<string>("usr", argv[3]);
+    connect_param.set<string>("pwd", argv[4]);
+    MySQLConnect connect(connect_param);
+    string tablename = fmt::format("`{}_{}`.`{}`", market, KQuery::getKTypeName(ktype), code);
+    to_lower(tablename);
+
+    size_t total = 0;
+    std::cout << fmt::format("{:<36}{:>14}{:>14}", "query", "cold", "warm") << std::endl;
+    run("count(1)", [&]() { total = connect.queryInt("select count(1) from " + tablename); });
+    run("getCount", [&]() { total = driver.getCount(market, code, ktype); });
+    std::cout << fmt::format("{} records in {}", total, tablename) << std::endl;
+    HKU_IF_RETURN(total == 0, 0);
+
+    size_t mid = total / 2;
+    size_t count = std::min<size_t>(1000, total - mid);
+    KRecordList klist;
+    run("limit offset (middle 1000)", [&]() {
+        auto st = connect.getStatement(
+          fmt::format("select `date`,`open`,`high`,`low`,`close`,`amount`,`count` from {} order "
+                      "by date limit {}, {}",
+                      tablename, mid, count));
+        st->exec();
+        while (st->moveNext()) {
+        }
+    });
+    run("getKRecordList index (middle 1000)", [&]() {
+        klist = driver.getKRecordList(market, code, KQuery(mid, mid + count, ktype));
+    });
+
+    size_t tail = total > 4096 ? total - 4096 : 0;
+    run("getKRecordList index (last 4096)", [&]() {
+        klist = driver.getKRecordList(market, code, KQuery(tail, Null<int64_t>(), ktype));
+    });
+
+    HKU_IF_RETURN(klist.empty(), 0);
+    KQuery date_query(klist.front().datetime, klist.back().datetime, ktype);
+    run("getKRecordList date (last 4096)",
+        [&]() { klist = driver.getKRecordList(market, code, date_query); });
+
+    size_t out_start = 0, out_end = 0;
+    run("count(1) x2 (index range)", [&]() {
+        connect.queryInt(fmt::format("select count(1) from {} where date<{}", tablename,
+                                     date_query.startDatetime().number()));
+        connect.queryInt(fmt::format("select count(1) from {} where date<{}", tablename,
+                                     date_query.endDatetime().number()));
+    });
+    run("getIndexRangeByDate",
+        [&]() { driver.getIndexRangeByDate(market, code, date_query, out_start, out_end); });
+
+    KQuery tail_query(-4096, Null<int64_t>(), ktype);
+    run(fmt::format("getKRecordList x{} (last 4096)", codes.size()), [&]() {
+        // 与 Stock 预加载时相同，先获取总数再按位置查询
+        for (const auto& c : codes) {
+            size_t n = driver.getCount(market, c, ktype);
+            driver.getKRecordList(market, c,
+                                  KQuery(n > 4096 ? n - 4096 : 0, Null<int64_t>(), ktype));
+        }
+    });
+    run(fmt::format("getKRecordListBatch x{} (last 4096)", codes.size()),
+        [&]() { driver.getKRecordListBatch(market, codes, tail_query); });
+    return 0;
+}
@@ -0,0 +1,90 @@
+/*
+ *  Copyright(C) 2026 hikyuu.org
+ *
+ *  Create on: 2026-10-18
+ *     Author: fasiondog
+ */
+
+// spot 数据录制及回放性能测试
+//
+// 录制：spot-bench record <录制文件> [录制秒数，默认 3600]
+// 回放：spot-bench replay <hikyuu.ini> <录制文件> [回放速度，默认 1 即按原始时间间隔]
+//
+// 回放时按配置文件中的预加载参数启动 SpotAgent，统计接收吞吐量及批次处理耗时分布
+// 回放速度小于等于 0 时为最快速度，接收方处理不及时消息可能被发布端丢弃，吞吐量仅供参考
+
+#include <hikyuu/hikyuu.h>
+#include <thread>
+#include <chrono>
+#include <limits>
+#include <iostream>
+#include <hikyuu/global/GlobalSpotAgent.h>
+#include <hikyuu/global/agent/SpotReplay.h>
+
+using namespace hku;
+
+static int record(const string& filename, int seconds) {
+    SpotRecorder recorder(filename);
+    recorder.start();
+    for (int i = 0; i < seconds; i++) {
+        std::this_thread::sleep_for(std::chrono::seconds(1));
+    }
+    recorder.stop();
+    std::cout << fmt::format("recorded messages: {}", recorder.count()) << std::endl;
+    return 0;
+}
+
+static int replay(const string& config_file, const string& filename, double speed) {
+    hikyuu_init(config_file);
+
+    // 处理函数在多个工作线程中并行执行，仅使用原子变量计数，避免加锁影响吞吐量
+    std::atomic<size_t> spot_count = 0;
+    std::atomic<int64_t> first_ns = std::numeric_limits<int64_t>::max();
+    std::atomic<int64_t> last_ns = 0;
+    auto* agent = getGlobalSpotAgent();
+    agent->addProcess([&](const SpotRecord& spot) {
+        int64_t now = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                        std::chrono::steady_clock::now().time_since_epoch())
+                        .count();
+        spot_count.fetch_add(1, std::memory_order_relaxed);
+        int64_t first = first_ns.load(std::memory_order_relaxed);
+        while (now < first && !first_ns.compare_exchange_weak(first, now)) {
+        }
+        int64_t last = last_ns.load(std::memory_order_relaxed);
+        while (now > last && !last_ns.compare_exchange_weak(last, now)) {
+        }
+    });
+    startSpotAgent(false);
+
+    // SpotAgent 连接失败后 5 秒重试，等待其完成连接
+    SpotReplayer replayer(filename);
+    size_t sent = replayer.run(speed, 6000);
+
+    // 等待最后一个批次处理完毕
+    std::this_thread::sleep_for(std::chrono::seconds(1));
+    stopSpotAgent();
+
+    double seconds = spot_count > 0 ? (last_ns - first_ns) / 1e9 : 0.0;
+    std::cout << fmt::format("sent messages: {}", sent) << std::endl;
+    std::cout << fmt::format("received spots: {}", spot_count.load()) << std::endl;
+    if (seconds > 0.0) {
+        std::cout << fmt::format("throughput: {:.0f} spots/s", spot_count.load() / seconds)
+                  << std::endl;
+    }
+    std::cout << "batch latency: " << agent->getBatchLatency().str() << std::endl;
+    return 0;
+}
+
+int main(int argc, char* argv[]) {
+    string mode = argc > 1 ? argv[1] : "";
+    if (mode == "record" && argc > 2) {
+        return record(argv[2], argc > 3 ? std::stoi(argv[3]) : 3600);
+    } else if (mode == "replay" && argc > 3) {
+        return replay(argv[2], argv[3], argc > 4 ? std::stod(argv[4]) : 1.0);
+    }
+
+    std::cout << "Usage:\n"
+              << "  spot-bench record <file> [seconds]\n"
+              << "  spot-bench replay <hikyuu.ini> <file> [speed]" << std::endl;
+    return 1;
+}
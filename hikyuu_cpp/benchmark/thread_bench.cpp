@@ -0,0 +1,110 @@
+/*
+ *  Copyright(C) 2026 hikyuu.org
+ *
+ *  Create on: 2026-10-18
+ *     Author: fasiondog
+ */
+
+// 线程池任务吞吐量性能测试
+//
+// thread-bench [工作线程数，默认为 CPU 数] [任务数，默认 1000000]
+//
+// 分别测试外部线程批量提交细粒度任务、任务内递归提交任务两种场景，
+// 输出各线程池的任务吞吐量，以及 StealThreadPool 的偷取、阻塞次数
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <fmt/format.h>
+#include <hikyuu/utilities/thread/StealThreadPool.h>
+#include <hikyuu/utilities/thread/ThreadPool.h>
+#include <hikyuu/utilities/thread/MQStealThreadPool.h>
+
+using namespace hku;
+
+template <class Pool>
+static double bench_submit(Pool& tg, size_t total) {
+    std::atomic<size_t> count = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < total; i++) {
+        tg.submit([&count]() { count.fetch_add(1, std::memory_order_relaxed); });
+    }
+    while (count.load(std::memory_order_relaxed) < total) {
+        std::this_thread::yield();
+    }
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+template <class Pool>
+static double bench_recursive(Pool& tg, int depth) {
+    std::atomic<size_t> count = 0;
+    size_t total = (size_t(1) << (depth + 1)) - 1;
+    std::function<void(int)> spawn = [&](int d) {
+        count.fetch_add(1, std::memory_order_relaxed);
+        if (d > 0) {
+            tg.submit([&spawn, d]() { spawn(d - 1); });
+            tg.submit([&spawn, d]() { spawn(d - 1); });
+        }
+    };
+    auto start = std::chrono::steady_clock::now();
+    tg.submit([&spawn, depth]() { spawn(depth); });
+    while (count.load(std::memory_order_relaxed) < total) {
+        std::this_thread::yield();
+    }
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+static void print(const std::string& name, const std::string& scene, size_t total,
+                  double seconds) {
+    std::cout << fmt::format("{:<20}{:<12}{:>12} tasks {:>10.3f}s {:>14.0f} tasks/s", name,
+                             scene, total, seconds, total / seconds)
+              << std::endl;
+}
+
+template <class Pool>
+static void run(const std::string& name, size_t worker_num, size_t total, int depth) {
+    size_t recursive_total = (size_t(1) << (depth + 1)) - 1;
+    {
+        Pool tg(worker_num);
+        print(name, "submit", total, bench_submit(tg, total));
+        tg.join();
+    }
+    {
+        Pool tg(worker_num);
+        print(name, "recursive", recursive_total, bench_recursive(tg, depth));
+        tg.join();
+    }
+}
+
+int main(int argc, char* argv[]) {
+    size_t worker_num = argc > 1 ? std::stoul(argv[1]) : std::thread::hardware_concurrency();
+    size_t total = argc > 2 ? std::stoul(argv[2]) : 1000000;
+    int depth = 0;
+    while ((size_t(1) << (depth + 2)) - 1 <= total) {
+        depth++;
+    }
+
+    std::cout << fmt::format("worker num: {}", worker_num) << std::endl;
+    run<ThreadPool>("ThreadPool", worker_num, total, depth);
+    run<MQStealThreadPool>("MQStealThreadPool", worker_num, total, depth);
+
+    // StealThreadPool 额外输出偷取、阻塞次数
+    {
+        StealThreadPool tg(worker_num);
+        print("StealThreadPool", "submit", total, bench_submit(tg, total));
+        tg.join();
+        std::cout << fmt::format("  steal: {}, park: {}", tg.steal_count(), tg.park_count())
+                  << std::endl;
+    }
+    {
+        StealThreadPool tg(worker_num);
+        size_t recursive_total = (size_t(1) << (depth + 1)) - 1;
+        print("StealThreadPool", "recursive", recursive_total, bench_recursive(tg, depth));
+        tg.join();
+        std::cout << fmt::format("  steal: {}, park: {}", tg.steal_count(), tg.park_count())
+                  << std::endl;
+    }
+    return 0;
+}
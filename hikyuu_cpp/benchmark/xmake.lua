@@ -0,0 +1,73 @@
+target("spot-bench")
+    set_kind("binary")
+    set_default(false)
+
+    add_packages("spdlog", "fmt", "flatbuffers")
+    add_includedirs("..")
+
+    if is_plat("windows") then
+        add_cxflags("-wd4267")
+        add_cxflags("-wd4251")
+    end
+
+    if is_plat("windows") and is_mode("release") then
+        add_defines("HKU_API=__declspec(dllimport)")
+        add_defines("SQLITE_API=__declspec(dllimport)")
+    end
+
+    -- add files
+    add_files("./spot_bench.cpp")
+
+    add_deps("hikyuu")
+
+target_end()
+
+target("thread-bench")
+    set_kind("binary")
+    set_default(false)
+
+    add_packages("fmt")
+    add_includedirs("..")
+
+    if is_plat("windows") then
+        add_cxflags("-wd4267")
+        add_cxflags("-wd4251")
+    end
+
+    if is_plat("linux") then
+        add_links("pthread")
+    end
+
+    -- add files
+    add_files("./thread_bench.cpp")
+
+target_end()
+
+target("mysql-kdata-bench")
+    set_kind("binary")
+    set_default(false)
+
+    add_packages("spdlog", "fmt")
+    add_includedirs("..")
+
+    if is_plat("windows") then
+        add_cxflags("-wd4267")
+        add_cxflags("-wd4251")
+        add_packages("mysql")
+    end
+
+    if is_plat("windows") and is_mode("release") then
+        add_defines("HKU_API=__declspec(dllimport)")
+        add_defines("SQLITE_API=__declspec(dllimport)")
+    end
+
+    if is_plat("linux") or is_plat("macosx") then
+        add_links("mysqlclient")
+    end
+
+    -- add files
+    add_files("./mysql_kdata_bench.cpp")
+
+    add_deps("hikyuu")
+
+target_end()
@@ -12,6 +12,26 @@
 
 namespace hku {
 
+static inline bool test_bit(const vector<uint64_t>& bits, uint32_t id) {
+    size_t word = id >> 6;
+    return word < bits.size() && ((bits[word] >> (id & 63)) & 1);
+}
+
+static inline void set_bit(vector<uint64_t>& bits, uint32_t id) {
+    size_t word = id >> 6;
+    if (word >= bits.size()) {
+        bits.resize(word + 1, 0);
+    }
+    bits[word] |= uint64_t(1) << (id & 63);
+}
+
+static inline void reset_bit(vector<uint64_t>& bits, uint32_t id) {
+    size_t word = id >> 6;
+    if (word < bits.size()) {
+        bits[word] &= ~(uint64_t(1) << (id & 63));
+    }
+}
+
 HKU_API std::ostream& operator<<(std::ostream& os, const Block& blk) {
     string strip(", ");
     os << "Block(" << blk.category() << strip << blk.name() << ")";
@@ -47,7 +67,11 @@ bool Block::have(const string& market_code) const {
 }
 
 bool Block::have(const Stock& stock) const {
-    HKU_IF_RETURN(!m_data, false);
+    HKU_IF_RETURN(!m_data || stock.isNull(), false);
+    uint32_t id = stock.denseId();
+    if (id != Null<uint32_t>()) {
+        return test_bit(m_data->m_bits, id);
+    }
     return m_data->m_stockDict.count(stock.market_code()) ? true : false;
 }
 
@@ -69,32 +93,119 @@ bool Block::add(const Stock& stock) {
         m_data = shared_ptr<Data>(new Data);
 
     m_data->m_stockDict[stock.market_code()] = stock;
+    uint32_t id = stock.denseId();
+    if (id != Null<uint32_t>()) {
+        set_bit(m_data->m_bits, id);
+    }
     return true;
 }
 
 bool Block::add(const string& market_code) {
     const StockManager& sm = StockManager::instance();
-    Stock stock = sm.getStock(market_code);
-    HKU_IF_RETURN(stock.isNull() || have(stock), false);
-    if (!m_data)
-        m_data = shared_ptr<Data>(new Data);
-
-    m_data->m_stockDict[stock.market_code()] = stock;
-    return true;
+    return add(sm.getStock(market_code));
 }
 
 bool Block::remove(const string& market_code) {
-    HKU_IF_RETURN(!have(market_code), false);
+    HKU_IF_RETURN(!m_data, false);
     string query_str = market_code;
     to_upper(query_str);
-    m_data->m_stockDict.erase(query_str);
+    auto iter = m_data->m_stockDict.find(query_str);
+    HKU_IF_RETURN(iter == m_data->m_stockDict.end(), false);
+    uint32_t id = iter->second.denseId();
+    if (id != Null<uint32_t>()) {
+        reset_bit(m_data->m_bits, id);
+    }
+    m_data->m_stockDict.erase(iter);
     return true;
 }
 
 bool Block::remove(const Stock& stock) {
     HKU_IF_RETURN(!have(stock), false);
+    uint32_t id = stock.denseId();
+    if (id != Null<uint32_t>()) {
+        reset_bit(m_data->m_bits, id);
+    }
     m_data->m_stockDict.erase(stock.market_code());
     return true;
 }
 
+Block Block::clone() const {
+    Block result;
+    if (m_data) {
+        result.m_data = make_shared<Data>(*m_data);
+    }
+    return result;
+}
+
+Block Block::operator|(const Block& blk) const {
+    Block result("", "");
+    const Data* a = m_data.get();
+    const Data* b = blk.m_data.get();
+    if (a) {
+        result.m_data->m_stockDict = a->m_stockDict;
+        result.m_data->m_bits = a->m_bits;
+    }
+    if (b) {
+        vector<uint64_t>& bits = result.m_data->m_bits;
+        if (bits.size() < b->m_bits.size()) {
+            bits.resize(b->m_bits.size(), 0);
+        }
+        for (size_t i = 0, total = b->m_bits.size(); i < total; i++) {
+            bits[i] |= b->m_bits[i];
+        }
+
+        // 位图已合并，只需补充字典中 a 未包含的成员
+        for (auto iter = b->m_stockDict.begin(); iter != b->m_stockDict.end(); ++iter) {
+            if (!have(iter->second)) {
+                result.m_data->m_stockDict.insert(*iter);
+            }
+        }
+    }
+    return result;
+}
+
+Block Block::operator&(const Block& blk) const {
+    Block result("", "");
+    HKU_IF_RETURN(!m_data || !blk.m_data, result);
+    const Data* a = m_data.get();
+    const Data* b = blk.m_data.get();
+    vector<uint64_t>& bits = result.m_data->m_bits;
+    bits.resize(std::min(a->m_bits.size(), b->m_bits.size()));
+    for (size_t i = 0, total = bits.size(); i < total; i++) {
+        bits[i] = a->m_bits[i] & b->m_bits[i];
+    }
+
+    // 遍历较小的板块，逐一判断是否属于另一板块
+    const Block& small = size() <= blk.size() ? *this : blk;
+    const Block& other = size() <= blk.size() ? blk : *this;
+    for (auto iter = small.m_data->m_stockDict.begin(); iter != small.m_data->m_stockDict.end();
+         ++iter) {
+        if (other.have(iter->second)) {
+            result.m_data->m_stockDict.insert(*iter);
+        }
+    }
+    return result;
+}
+
+Block Block::operator-(const Block& blk) const {
+    Block result("", "");
+    HKU_IF_RETURN(!m_data, result);
+    const Data* a = m_data.get();
+    result.m_data->m_bits = a->m_bits;
+    if (blk.m_data) {
+        vector<uint64_t>& bits = result.m_data->m_bits;
+        const vector<uint64_t>& b_bits = blk.m_data->m_bits;
+        for (size_t i = 0, total = std::min(bits.size(), b_bits.size()); i < total; i++) {
+            bits[i] &= ~b_bits[i];
+        }
+    }
+
+    for (auto iter = a->m_stockDict.begin(); iter != a->m_stockDict.end(); ++iter) {
+        if (!blk.have(iter->second)) {
+            result.m_data->m_stockDict.insert(*iter);
+        }
+    }
+    return result;
+}
+
 } /* namespace hku */
@@ -48,6 +48,18 @@ public:
         return m_data != blk.m_data;
     }
 
+    /** 并集，返回的新板块类别、名称均为空 */
+    Block operator|(const Block& blk) const;
+
+    /** 交集，返回的新板块类别、名称均为空 */
+    Block operator&(const Block& blk) const;
+
+    /** 差集，返回的新板块类别、名称均为空 */
+    Block operator-(const Block& blk) const;
+
+    /** 深度复制，复制后的板块与原板块互不影响 */
+    Block clone() const;
+
     /** 获取板块类别 */
     string category() const {
         return m_data ? m_data->m_category : "";
@@ -75,7 +87,7 @@ public:
     /** 是否包含指定的证券 */
     bool have(const string& market_code) const;
 
-    /** 是否包含指定的证券 */
+    /** 是否包含指定的证券，已由 StockManager 编号的证券按位图判断，为常数时间 */
     bool have(const Stock& stock) const;
 
     /** 获取指定的证券 */
@@ -110,8 +122,10 @@ public:
 
     /** 清除包含的所有证券 */
     void clear() {
-        if (m_data)
+        if (m_data) {
             m_data->m_stockDict.clear();
+            m_data->m_bits.clear();
+        }
     }
 
 private:
@@ -119,6 +133,7 @@ private:
         string m_category;
         string m_name;
         StockMapIterator::stock_map_t m_stockDict;
+        vector<uint64_t> m_bits;  // 成员位图，按 Stock::denseId 索引
     };
     shared_ptr<Data> m_data;
 };
@@ -57,6 +57,8 @@ void GlobalInitializer::init() {
 }
 
 void GlobalInitializer::clean() {
+    // 预加载任务运行于全局任务组中，需先于任务组结束
+    StockManager::instance().stopPreload();
     releaseGlobalTaskGroup();
     releaseScheduler();
     releaseGlobalSpotAgent();
@@ -38,6 +38,9 @@ public:
     /** 获取指定位置的KRecord，未作越界检查 */
     KRecord getKRecord(size_t pos) const;
 
+    /** 获取K线记录数组的首地址，可直接访问 size() 条连续的记录，为空时可能返回 nullptr */
+    const KRecord* data() const;
+
     /** 按日期查询KRecord */
     KRecord getKRecord(Datetime datetime) const;
 
@@ -166,6 +169,10 @@ inline KRecord KData::getKRecord(size_t pos) const {
     return m_imp->getKRecord(pos);  //如果为空，将抛出异常
 }
 
+inline const KRecord* KData::data() const {
+    return m_imp ? m_imp->data() : nullptr;
+}
+
 inline KRecord KData::getKRecord(Datetime datetime) const {
     size_t pos = getPos(datetime);
     return pos != Null<size_t>() ? getKRecord(pos) : Null<KRecord>();
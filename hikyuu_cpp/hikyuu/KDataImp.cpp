@@ -126,6 +126,8 @@ void KDataImp::_recoverForUpDay() {
 
     Datetime startDate = startOfPhase(m_buffer.front().datetime);
     Datetime endDate = m_buffer.back().datetime.nextDay();
+    HKU_IF_RETURN(_getRecoverForUpDayFromCache(startDate, endDate), void());
+
     KQuery query = KQueryByDate(startDate, endDate, KQuery::DAY, m_query.recoverType());
     KData day_list = m_stock.getKData(query);
     if (day_list.empty())
@@ -162,7 +164,89 @@ void KDataImp::_recoverForUpDay() {
         }
     }
 
-    return;
+    _saveRecoverForUpDayToCache(startDate, endDate);
+}
+
+string KDataImp::_getRecoverCacheKey() const {
+    return fmt::format("{}_{}", m_query.kType(), int(m_query.recoverType()));
+}
+
+/*
+ * 前复权类（FORWARD、EQUAL_FORWARD）以结束日期为基准，某日复权后的价格只与该日至结束日期之间的
+ * 权息有关，与起始日期无关；后复权类则相反。因此除日期范围完全一致外，前复权类在结束日期相同且
+ * 缓存起始日期不晚于当前起始日期时、后复权类在起始日期相同且缓存结束日期不早于当前结束日期时，
+ * 均可直接从缓存中截取。
+ */
+bool KDataImp::_getRecoverForUpDayFromCache(const Datetime& start, const Datetime& end) {
+    auto& data = m_stock.m_data;
+    std::lock_guard<std::mutex> lock(data->m_recover_cache_mutex);
+    auto iter = data->m_recoverKDataCache.find(_getRecoverCacheKey());
+    HKU_IF_RETURN(iter == data->m_recoverKDataCache.end(), false);
+
+    const Stock::Data::RecoverKDataCache& cache = iter->second;
+    KQuery::RecoverType recover_type = m_query.recoverType();
+    bool hit = false;
+    if (recover_type == KQuery::FORWARD || recover_type == KQuery::EQUAL_FORWARD) {
+        hit = cache.end == end && cache.start <= start;
+    } else {
+        hit = cache.start == start && cache.end >= end;
+    }
+    HKU_IF_RETURN(!hit, false);
+
+    const KRecordList& records = cache.records;
+    auto record_iter = std::lower_bound(
+      records.begin(), records.end(), m_buffer.front().datetime,
+      [](const KRecord& record, const Datetime& date) { return record.datetime < date; });
+    size_t total = m_buffer.size();
+    HKU_IF_RETURN(size_t(records.end() - record_iter) < total, false);
+    for (size_t i = 0; i < total; i++) {
+        HKU_IF_RETURN(record_iter[i].datetime != m_buffer[i].datetime, false);
+    }
+
+    for (size_t i = 0; i < total; i++) {
+        m_buffer[i].openPrice = record_iter[i].openPrice;
+        m_buffer[i].highPrice = record_iter[i].highPrice;
+        m_buffer[i].lowPrice = record_iter[i].lowPrice;
+        m_buffer[i].closePrice = record_iter[i].closePrice;
+    }
+    return true;
+}
+
+void KDataImp::_saveRecoverForUpDayToCache(const Datetime& start, const Datetime& end) {
+    auto& data = m_stock.m_data;
+    std::lock_guard<std::mutex> lock(data->m_recover_cache_mutex);
+    Stock::Data::RecoverKDataCache& cache = data->m_recoverKDataCache[_getRecoverCacheKey()];
+    cache.start = start;
+    cache.end = end;
+    cache.records = m_buffer;
+}
+
+/** 按 复权后价格 = k * 复权前价格 + b 调整K线价格，仅在最后取整一次 */
+static inline void recoverKRecord(KRecord& record, price_t k, price_t b, int precision) {
+    record.openPrice = roundEx(k * record.openPrice + b, precision);
+    record.highPrice = roundEx(k * record.highPrice + b, precision);
+    record.lowPrice = roundEx(k * record.lowPrice + b, precision);
+    record.closePrice = roundEx(k * record.closePrice + b, precision);
+}
+
+StockRecoverFactorList KDataImp::_getRecoverFactor() const {
+    Datetime start_date(m_buffer.front().datetime.date());
+    Datetime end_date(m_buffer.back().datetime.date() + bd::days(1));
+    return m_stock.getRecoverFactor(start_date, end_date);
+}
+
+size_t KDataImp::_getFirstPosFrom(const Datetime& datetime) const {
+    auto iter = std::lower_bound(
+      m_buffer.begin(), m_buffer.end(), datetime,
+      [](const KRecord& record, const Datetime& date) { return record.datetime < date; });
+    return iter - m_buffer.begin();
+}
+
+size_t KDataImp::_getLastPosTo(const Datetime& datetime) const {
+    auto iter = std::upper_bound(
+      m_buffer.begin(), m_buffer.end(), datetime,
+      [](const Datetime& date, const KRecord& record) { return date < record.datetime; });
+    return iter == m_buffer.begin() ? 0 : iter - m_buffer.begin() - 1;
 }
 
 /******************************************************************************
@@ -171,49 +255,31 @@ void KDataImp::_recoverForUpDay() {
  * 复权计算时首先从上市日开始，逐日向后判断，遇到除权日，则将上市日到除权日之间（不包括除权日）的
  * 全部股价通过复权计算降下来；然后再继续向后判断，遇到下一个除权日，则再次将上市日到该除权日之间
  * （不包括除权日）的全部股价通过复权计算降下来。
+ * 实现时从最新日向前逐日累积各除权日的复权公式（复合后仍为线性变换），每条K线只计算并取整一次。
  *****************************************************************************/
 void KDataImp::_recoverForward() {
     size_t total = m_buffer.size();
     HKU_IF_RETURN(total == 0, void());
 
-    Datetime start_date(m_buffer.front().datetime.date());
-    Datetime end_date(m_buffer.back().datetime.date() + bd::days(1));
-    StockWeightList weightList = m_stock.getWeight(start_date, end_date);
-    StockWeightList::const_iterator weightIter = weightList.begin();
-    StockWeightList::const_iterator pre_weightIter = weightIter;
-
-    size_t pre_pos = 0;
-    for (; weightIter != weightList.end(); ++weightIter) {
-        //计算流通股份变动比例,但不处理仅仅只有流通股本改变的情况
-        if ((weightIter->countAsGift() == 0.0 && weightIter->countForSell() == 0.0 &&
-             weightIter->priceForSell() == 0.0 && weightIter->bonus() == 0.0 &&
-             weightIter->increasement() == 0.0))
-            continue;
-
-        size_t i = pre_pos;
-        while (i < total && m_buffer[i].datetime < weightIter->datetime()) {
-            i++;
+    StockRecoverFactorList factors = _getRecoverFactor();
+    HKU_IF_RETURN(factors.empty(), void());
+
+    int precision = m_stock.precision();
+    price_t k = 1.0, b = 0.0;  //累积复权公式：复权后价格 = k * 复权前价格 + b
+    auto factor_iter = factors.rbegin();
+    size_t pre_pos = _getFirstPosFrom(factor_iter->datetime);  //除权日
+    for (size_t i = total; i-- > 0;) {
+        while (factor_iter != factors.rend() && pre_pos > i) {
+            b += k * factor_iter->adjust / factor_iter->denominator;
+            k /= factor_iter->denominator;
+            if (++factor_iter != factors.rend()) {
+                pre_pos = _getFirstPosFrom(factor_iter->datetime);
+            }
         }
-        pre_pos = i;  //除权日
-
-        price_t change = 0.1 * (weightIter->countAsGift() + weightIter->countForSell() +
-                                weightIter->increasement());
-        price_t denominator = 1.0 + change;  //分母 = (1+流通股份变动比例)
-        price_t temp = weightIter->priceForSell() * change - 0.1 * weightIter->bonus();
-
-        if (denominator == 1.0 && temp == 0.0)
+        if (k == 1.0 && b == 0.0) {
             continue;
-
-        for (i = 0; i < pre_pos; ++i) {
-            m_buffer[i].openPrice =
-              roundEx((m_buffer[i].openPrice + temp) / denominator, m_stock.precision());
-            m_buffer[i].highPrice =
-              roundEx((m_buffer[i].highPrice + temp) / denominator, m_stock.precision());
-            m_buffer[i].lowPrice =
-              roundEx((m_buffer[i].lowPrice + temp) / denominator, m_stock.precision());
-            m_buffer[i].closePrice =
-              roundEx((m_buffer[i].closePrice + temp) / denominator, m_stock.precision());
         }
+        recoverKRecord(m_buffer[i], k, b, precision);
     }
 }
 
@@ -222,50 +288,31 @@ void KDataImp::_recoverForward() {
  * 向后复权指以除权前的股价为基准（即除权前的股价不变），将除权后的股价升上去。复权计算时首先从最新日开始，
  * 逐日向前判断，遇到除权日，则将除权日到最新日之间（包括除权日）的全部股价通过复权计算升上去；然后再继续
  * 向前判断，遇到下一个除权日，则再次将除权日到最新日之间（包括除权日）的全部股价通过复权计算升上去。
+ * 实现时从上市日向后逐日累积各除权日的复权公式，每条K线只计算并取整一次。
  *****************************************************************************/
 void KDataImp::_recoverBackward() {
     size_t total = m_buffer.size();
     HKU_IF_RETURN(total == 0, void());
 
-    Datetime start_date(m_buffer.front().datetime.date());
-    Datetime end_date(m_buffer.back().datetime.date() + bd::days(1));
-    StockWeightList weightList = m_stock.getWeight(start_date, end_date);
-    StockWeightList::const_reverse_iterator weightIter = weightList.rbegin();
-    StockWeightList::const_reverse_iterator pre_weightIter;
-
-    size_t pre_pos = total - 1;
-    for (; weightIter != weightList.rend(); ++weightIter) {
-        //计算流通股份变动比例,但不处理仅仅只有流通股本改变的情况
-        if ((weightIter->countAsGift() == 0.0 && weightIter->countForSell() == 0.0 &&
-             weightIter->priceForSell() == 0.0 && weightIter->bonus() == 0.0 &&
-             weightIter->increasement() == 0.0))
-            continue;
-
-        size_t i = pre_pos;
-        while (i > 0 && m_buffer[i].datetime > weightIter->datetime()) {
-            i--;
+    StockRecoverFactorList factors = _getRecoverFactor();
+    HKU_IF_RETURN(factors.empty(), void());
+
+    int precision = m_stock.precision();
+    price_t k = 1.0, b = 0.0;  //累积复权公式：复权后价格 = k * 复权前价格 + b
+    auto factor_iter = factors.begin();
+    size_t pre_pos = _getLastPosTo(factor_iter->datetime);  //除权日
+    for (size_t i = 0; i < total; i++) {
+        while (factor_iter != factors.end() && pre_pos <= i) {
+            b -= k * factor_iter->adjust;
+            k *= factor_iter->denominator;
+            if (++factor_iter != factors.end()) {
+                pre_pos = _getLastPosTo(factor_iter->datetime);
+            }
         }
-        pre_pos = i;
-
-        //流通股份变动比例
-        price_t change = 0.1 * (weightIter->countAsGift() + weightIter->countForSell() +
-                                weightIter->increasement());
-        price_t denominator = 1.0 + change;  //(1+流通股份变动比例)
-        price_t temp = 0.1 * weightIter->bonus() - weightIter->priceForSell() * change;
-
-        if (denominator == 1.0 && temp == 0.0)
+        if (k == 1.0 && b == 0.0) {
             continue;
-
-        for (i = pre_pos; i < total; ++i) {
-            m_buffer[i].openPrice =
-              roundEx(m_buffer[i].openPrice * denominator + temp, m_stock.precision());
-            m_buffer[i].highPrice =
-              roundEx(m_buffer[i].highPrice * denominator + temp, m_stock.precision());
-            m_buffer[i].lowPrice =
-              roundEx(m_buffer[i].lowPrice * denominator + temp, m_stock.precision());
-            m_buffer[i].closePrice =
-              roundEx(m_buffer[i].closePrice * denominator + temp, m_stock.precision());
         }
+        recoverKRecord(m_buffer[i], k, b, precision);
     }
 }
 
@@ -276,61 +323,44 @@ void KDataImp::_recoverBackward() {
  * 复权计算时首先从上市日开始，逐日向后判断，遇到除权日，则将上市日到除权日之间（不包括除权日）的
  * 全部股价通过复权计算降下来；然后再继续向后判断，遇到下一个除权日，则再次将上市日到该除权日之间
  * （不包括除权日）的全部股价通过复权计算降下来。
+ * 实现时从最新日向前逐日累乘各除权日的复权率，每条K线只计算并取整一次。
  *****************************************************************************/
 void KDataImp::_recoverEqualForward() {
     size_t total = m_buffer.size();
     HKU_IF_RETURN(total == 0, void());
 
-    Datetime start_date(m_buffer.front().datetime.date());
-    Datetime end_date(m_buffer.back().datetime.date() + bd::days(1));
-    StockWeightList weightList = m_stock.getWeight(start_date, end_date);
-    if (weightList.empty()) {
-        return;
-    }
-
-    KRecordList kdata = m_buffer;  //防止同一天两条权息记录
-    StockWeightList::const_iterator weightIter = weightList.begin();
-    StockWeightList::const_iterator pre_weightIter;
-    size_t pre_pos = 0;
-    for (; weightIter != weightList.end(); ++weightIter) {
-        //计算流通股份变动比例,但不处理仅仅只有流通股本改变的情况
-        if ((weightIter->countAsGift() == 0.0 && weightIter->countForSell() == 0.0 &&
-             weightIter->priceForSell() == 0.0 && weightIter->bonus() == 0.0 &&
-             weightIter->increasement() == 0.0))
-            continue;
-
-        size_t i = pre_pos;
-        while (i < total && m_buffer[i].datetime < weightIter->datetime()) {
-            i++;
-        }
-        pre_pos = i;  //除权日
+    StockRecoverFactorList factors = _getRecoverFactor();
+    HKU_IF_RETURN(factors.empty(), void());
 
+    //先按未复权的股权登记日收盘价计算各除权日的复权率
+    vector<std::pair<size_t, price_t>> rates;  //(除权日, 复权率)
+    rates.reserve(factors.size());
+    for (const auto& factor : factors) {
+        size_t pre_pos = _getFirstPosFrom(factor.datetime);
         //股权登记日（即除权日的前一天数据）收盘价
         if (pre_pos == 0) {
             continue;
         }
-        price_t closePrice = kdata[pre_pos - 1].closePrice;
-        if (closePrice == 0.0) {
+        price_t closePrice = m_buffer[pre_pos - 1].closePrice;
+        if (closePrice == 0.0 || factor.denominator == 0.0) {
             continue;  //除零保护
         }
+        rates.emplace_back(pre_pos,
+                           (closePrice + factor.adjust) / (factor.denominator * closePrice));
+    }
 
-        //流通股份变动比例
-        price_t change = 0.1 * (weightIter->countAsGift() + weightIter->countForSell() +
-                                weightIter->increasement());
-        price_t denominator = 1.0 + change;  //(1+流通股份变动比例)
-        price_t temp = weightIter->priceForSell() * change - 0.1 * weightIter->bonus();
-
-        if (denominator == 0.0 || (denominator == 1.0 && temp == 0.0))
+    int precision = m_stock.precision();
+    price_t k = 1.0;
+    auto rate_iter = rates.rbegin();
+    for (size_t i = total; i-- > 0;) {
+        while (rate_iter != rates.rend() && rate_iter->first > i) {
+            k *= rate_iter->second;
+            ++rate_iter;
+        }
+        if (k == 1.0) {
             continue;
-
-        price_t k = (closePrice + temp) / (denominator * closePrice);
-
-        for (i = 0; i < pre_pos; ++i) {
-            m_buffer[i].openPrice = roundEx(k * m_buffer[i].openPrice, m_stock.precision());
-            m_buffer[i].highPrice = roundEx(k * m_buffer[i].highPrice, m_stock.precision());
-            m_buffer[i].lowPrice = roundEx(k * m_buffer[i].lowPrice, m_stock.precision());
-            m_buffer[i].closePrice = roundEx(k * m_buffer[i].closePrice, m_stock.precision());
         }
+        recoverKRecord(m_buffer[i], k, 0.0, precision);
     }
 }
 
@@ -340,47 +370,44 @@ void KDataImp::_recoverEqualForward() {
  * 向后复权指以除权前的股价为基准（即除权前的股价不变），将除权后的股价升上去。复权计算时首先从最新日开始，
  * 逐日向前判断，遇到除权日，则将除权日到最新日之间（包括除权日）的全部股价通过复权计算升上去；然后再继续
  * 向前判断，遇到下一个除权日，则再次将除权日到最新日之间（包括除权日）的全部股价通过复权计算升上去。
+ * 实现时从上市日向后逐日累乘各除权日的复权率，每条K线只计算并取整一次。
  *****************************************************************************/
 void KDataImp::_recoverEqualBackward() {
     size_t total = m_buffer.size();
     HKU_IF_RETURN(total == 0, void());
 
-    Datetime start_date(m_buffer.front().datetime.date());
-    Datetime end_date(m_buffer.back().datetime.date() + bd::days(1));
-    StockWeightList weightList = m_stock.getWeight(start_date, end_date);
-    StockWeightList::const_reverse_iterator weightIter = weightList.rbegin();
-    StockWeightList::const_reverse_iterator pre_weightIter;
-
-    size_t pre_pos = total - 1;
-    for (; weightIter != weightList.rend(); ++weightIter) {
-        size_t i = pre_pos;
-        while (i > 0 && m_buffer[i].datetime > weightIter->datetime()) {
-            i--;
-        }
-        pre_pos = i;  //除权日
+    StockRecoverFactorList factors = _getRecoverFactor();
+    HKU_IF_RETURN(factors.empty(), void());
 
+    //先按未复权的股权登记日收盘价计算各除权日的复权率
+    vector<std::pair<size_t, price_t>> rates;  //(除权日, 1/复权率)
+    rates.reserve(factors.size());
+    for (const auto& factor : factors) {
+        size_t pre_pos = _getLastPosTo(factor.datetime);
         //股权登记日（即除权日的前一天数据）收盘价
         if (pre_pos == 0) {
             continue;
         }
         price_t closePrice = m_buffer[pre_pos - 1].closePrice;
-
-        //流通股份变动比例
-        price_t change = 0.1 * (weightIter->countAsGift() + weightIter->countForSell() +
-                                weightIter->increasement());
-        price_t denominator = 1.0 + change;  //(1+流通股份变动比例)
-        price_t temp = closePrice + weightIter->priceForSell() * change - 0.1 * weightIter->bonus();
-        if (temp == 0.0 || denominator == 0.0) {
+        price_t temp = closePrice + factor.adjust;
+        if (temp == 0.0 || factor.denominator == 0.0) {
             continue;
         }
-        price_t k = (denominator * closePrice) / temp;
+        rates.emplace_back(pre_pos, (factor.denominator * closePrice) / temp);
+    }
 
-        for (i = pre_pos; i < total; ++i) {
-            m_buffer[i].openPrice = roundEx(k * m_buffer[i].openPrice, m_stock.precision());
-            m_buffer[i].highPrice = roundEx(k * m_buffer[i].highPrice, m_stock.precision());
-            m_buffer[i].lowPrice = roundEx(k * m_buffer[i].lowPrice, m_stock.precision());
-            m_buffer[i].closePrice = roundEx(k * m_buffer[i].closePrice, m_stock.precision());
+    int precision = m_stock.precision();
+    price_t k = 1.0;
+    auto rate_iter = rates.begin();
+    for (size_t i = 0; i < total; i++) {
+        while (rate_iter != rates.end() && rate_iter->first <= i) {
+            k *= rate_iter->second;
+            ++rate_iter;
+        }
+        if (k == 1.0) {
+            continue;
         }
+        recoverKRecord(m_buffer[i], k, 0.0, precision);
     }
 }
 
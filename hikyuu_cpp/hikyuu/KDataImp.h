@@ -31,6 +31,10 @@ public:
         return m_buffer[pos];
     }
 
+    const KRecord* data() const {
+        return m_buffer.data();
+    }
+
     bool empty() const {
         return m_buffer.empty();
     }
@@ -53,6 +57,24 @@ private:
     void _recoverEqualBackward();
     void _recoverForUpDay();
 
+    /** 日线以上复权数据缓存的键值 */
+    string _getRecoverCacheKey() const;
+
+    /** 尝试从所属证券的缓存中获取日线以上复权数据，成功时返回 true */
+    bool _getRecoverForUpDayFromCache(const Datetime& start, const Datetime& end);
+
+    /** 将合成的日线以上复权数据保存至所属证券的缓存 */
+    void _saveRecoverForUpDayToCache(const Datetime& start, const Datetime& end);
+
+    /** 获取当前K线数据时间范围内的复权因子 */
+    StockRecoverFactorList _getRecoverFactor() const;
+
+    /** 获取首个不早于指定时刻的K线位置，不存在时返回 size() */
+    size_t _getFirstPosFrom(const Datetime&) const;
+
+    /** 获取最后一个不晚于指定时刻的K线位置，不存在时返回 0 */
+    size_t _getLastPosTo(const Datetime&) const;
+
 private:
     KRecordList m_buffer;
     KQuery m_query;
@@ -0,0 +1,214 @@
+/*
+ * KDataResample.cpp
+ *
+ *  Copyright (c) 2026 hikyuu.org
+ *
+ *  Created on: 2026-10-18
+ *      Author: fasiondog
+ */
+
+#include "KDataResample.h"
+
+namespace hku {
+
+const vector<KQuery::KType>& getResampleBaseKType(const KQuery::KType& ktype) {
+    static const unordered_map<string, vector<KQuery::KType>> s_base_ktype{
+      {KQuery::MIN3, {KQuery::MIN}},
+      {KQuery::MIN15, {KQuery::MIN5, KQuery::MIN}},
+      {KQuery::MIN30, {KQuery::MIN15, KQuery::MIN5, KQuery::MIN}},
+      {KQuery::MIN60, {KQuery::MIN30, KQuery::MIN15, KQuery::MIN5, KQuery::MIN}},
+      {KQuery::HOUR2, {KQuery::MIN60, KQuery::MIN30, KQuery::MIN15, KQuery::MIN5, KQuery::MIN}},
+      {KQuery::HOUR4, {KQuery::MIN60, KQuery::MIN30, KQuery::MIN15, KQuery::MIN5, KQuery::MIN}},
+      {KQuery::HOUR6, {KQuery::MIN60, KQuery::MIN30, KQuery::MIN15, KQuery::MIN5, KQuery::MIN}},
+      {KQuery::HOUR12, {KQuery::MIN60, KQuery::MIN30, KQuery::MIN15, KQuery::MIN5, KQuery::MIN}},
+      {KQuery::WEEK, {KQuery::DAY}},
+      {KQuery::MONTH, {KQuery::DAY}},
+      {KQuery::QUARTER, {KQuery::DAY}},
+      {KQuery::HALFYEAR, {KQuery::DAY}},
+      {KQuery::YEAR, {KQuery::DAY}}};
+    static const vector<KQuery::KType> s_null_base;
+
+    auto iter = s_base_ktype.find(ktype);
+    return iter != s_base_ktype.end() ? iter->second : s_null_base;
+}
+
+namespace {
+
+/** 分钟级K线周期（分钟数），非分钟级返回 0 */
+int64_t getResampleMinutes(const KQuery::KType& ktype) {
+    static const unordered_map<string, int64_t> s_minutes{
+      {KQuery::MIN, 1},      {KQuery::MIN3, 3},     {KQuery::MIN5, 5},     {KQuery::MIN15, 15},
+      {KQuery::MIN30, 30},   {KQuery::MIN60, 60},   {KQuery::HOUR2, 120},  {KQuery::HOUR4, 240},
+      {KQuery::HOUR6, 360},  {KQuery::HOUR12, 720}};
+    auto iter = s_minutes.find(ktype);
+    return iter != s_minutes.end() ? iter->second : 0;
+}
+
+int64_t toMinutes(const TimeDelta& delta) {
+    return delta.ticks() / 60000000LL;
+}
+
+/**
+ * 分钟级K线分组，按交易时段内已交易的分钟数划分，午间休市不计入
+ * @note 基础K线的时间为其结束时刻，如 09:35 的5分钟线对应 09:30 ~ 09:35
+ */
+class MinuteGrouper {
+public:
+    MinuteGrouper(int64_t minutes, const MarketInfo& market_info) : m_minutes(minutes) {
+        m_open1 = toMinutes(market_info.openTime1());
+        m_close1 = toMinutes(market_info.closeTime1());
+        m_open2 = toMinutes(market_info.openTime2());
+        m_close2 = toMinutes(market_info.closeTime2());
+        m_session1 = m_close1 > m_open1 ? m_close1 - m_open1 : 0;
+        m_session2 = m_close2 > m_open2 ? m_close2 - m_open2 : 0;
+        if (m_session1 + m_session2 == 0) {
+            // 无交易时段信息时，按自然时间划分
+            m_open1 = 0;
+            m_close1 = 24 * 60;
+            m_session1 = m_close1;
+            m_open2 = m_close2 = m_close1;
+        }
+    }
+
+    /** 返回分组编号，同一交易日内单调不减，不足整分钟的时刻归入下一分钟 */
+    int64_t group(const Datetime& datetime) const {
+        int64_t minute = datetime.hour() * 60 + datetime.minute();
+        if (datetime.second() != 0 || datetime.millisecond() != 0 ||
+            datetime.microsecond() != 0) {
+            minute++;
+        }
+        int64_t traded = _tradedMinutes(minute);
+        return traded <= 0 ? 0 : (traded - 1) / m_minutes;
+    }
+
+    /** 分组的结束时刻 */
+    Datetime groupEnd(const Datetime& datetime, int64_t group) const {
+        int64_t traded = std::min((group + 1) * m_minutes, m_session1 + m_session2);
+        int64_t minute =
+          traded <= m_session1 ? m_open1 + traded : m_open2 + (traded - m_session1);
+        return datetime.startOfDay() + Minutes(minute);
+    }
+
+private:
+    int64_t _tradedMinutes(int64_t minute) const {
+        if (minute <= m_close1 || m_session2 == 0) {
+            return std::min(minute - m_open1, m_session1 + m_session2);
+        }
+        if (minute <= m_open2) {
+            return m_session1;
+        }
+        return m_session1 + std::min(minute - m_open2, m_session2);
+    }
+
+private:
+    int64_t m_minutes;
+    int64_t m_open1, m_close1, m_open2, m_close2;
+    int64_t m_session1, m_session2;
+};
+
+typedef Datetime (Datetime::*PhaseFunc)() const;
+
+/** 周线及以上K线分组，以自然周期的结束日期作为分组标识及K线时间 */
+PhaseFunc getEndOfPhase(const KQuery::KType& ktype) {
+    if (ktype == KQuery::WEEK) {
+        return &Datetime::endOfWeek;
+    } else if (ktype == KQuery::MONTH) {
+        return &Datetime::endOfMonth;
+    } else if (ktype == KQuery::QUARTER) {
+        return &Datetime::endOfQuarter;
+    } else if (ktype == KQuery::HALFYEAR) {
+        return &Datetime::endOfHalfyear;
+    } else if (ktype == KQuery::YEAR) {
+        return &Datetime::endOfYear;
+    }
+    return nullptr;
+}
+
+Datetime getPhaseTime(const Datetime& datetime, const KQuery::KType& ktype,
+                      PhaseFunc endOfPhase) {
+    Datetime result = (datetime.startOfDay().*endOfPhase)();
+    // 周线时间为周五
+    return ktype == KQuery::WEEK ? result - TimeDelta(2) : result;
+}
+
+inline void mergeKRecord(KRecord& record, const KRecord& base) {
+    if (base.highPrice > record.highPrice) {
+        record.highPrice = base.highPrice;
+    }
+    if (base.lowPrice < record.lowPrice) {
+        record.lowPrice = base.lowPrice;
+    }
+    record.closePrice = base.closePrice;
+    record.transAmount += base.transAmount;
+    record.transCount += base.transCount;
+}
+
+}  // namespace
+
+Datetime getResampleTime(const Datetime& datetime, const KQuery::KType& ktype,
+                         const MarketInfo& market_info) {
+    HKU_IF_RETURN(datetime.isNull(), Null<Datetime>());
+    int64_t minutes = getResampleMinutes(ktype);
+    if (minutes > 0) {
+        MinuteGrouper grouper(minutes, market_info);
+        return grouper.groupEnd(datetime, grouper.group(datetime));
+    }
+    PhaseFunc endOfPhase = getEndOfPhase(ktype);
+    return endOfPhase ? getPhaseTime(datetime, ktype, endOfPhase) : Null<Datetime>();
+}
+
+size_t resampleKRecordList(const KRecordList& base, size_t start, const KQuery::KType& ktype,
+                           const MarketInfo& market_info, KRecordList& out) {
+    size_t total = base.size();
+    HKU_IF_RETURN(start >= total, start);
+
+    size_t last_group_start = start;
+    int64_t minutes = getResampleMinutes(ktype);
+    if (minutes > 0) {
+        MinuteGrouper grouper(minutes, market_info);
+        bd::date pre_date = base[start].datetime.date();
+        int64_t pre_group = grouper.group(base[start].datetime);
+        KRecord record = base[start];
+        record.datetime = grouper.groupEnd(base[start].datetime, pre_group);
+        for (size_t i = start + 1; i < total; i++) {
+            const KRecord& k = base[i];
+            bd::date cur_date = k.datetime.date();
+            int64_t cur_group = grouper.group(k.datetime);
+            if (cur_date == pre_date && cur_group == pre_group) {
+                mergeKRecord(record, k);
+                continue;
+            }
+            out.push_back(record);
+            last_group_start = i;
+            pre_date = cur_date;
+            pre_group = cur_group;
+            record = k;
+            record.datetime = grouper.groupEnd(k.datetime, cur_group);
+        }
+        out.push_back(record);
+        return last_group_start;
+    }
+
+    PhaseFunc endOfPhase = getEndOfPhase(ktype);
+    HKU_ERROR_IF_RETURN(!endOfPhase, start, "Can't resample ktype: {}", ktype);
+    Datetime pre_phase = getPhaseTime(base[start].datetime, ktype, endOfPhase);
+    KRecord record = base[start];
+    record.datetime = pre_phase;
+    for (size_t i = start + 1; i < total; i++) {
+        const KRecord& k = base[i];
+        Datetime cur_phase = getPhaseTime(k.datetime, ktype, endOfPhase);
+        if (cur_phase == pre_phase) {
+            mergeKRecord(record, k);
+            continue;
+        }
+        out.push_back(record);
+        last_group_start = i;
+        pre_phase = cur_phase;
+        record = k;
+        record.datetime = cur_phase;
+    }
+    out.push_back(record);
+    return last_group_start;
+}
+
+}  // namespace hku
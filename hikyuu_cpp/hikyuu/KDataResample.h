@@ -0,0 +1,60 @@
+/*
+ * KDataResample.h
+ *
+ *  Copyright (c) 2026 hikyuu.org
+ *
+ *  Created on: 2026-10-18
+ *      Author: fasiondog
+ */
+
+#pragma once
+#ifndef KDATARESAMPLE_H_
+#define KDATARESAMPLE_H_
+
+#include "KQuery.h"
+#include "KRecord.h"
+#include "MarketInfo.h"
+
+namespace hku {
+
+/**
+ * 获取可用于合成指定K线类型的基础K线类型，按由粗到细的顺序排列
+ * @details 分钟级K线（如 MIN3、MIN15、HOUR2）由周期能整除目标周期的分钟级K线合成，
+ *          周线及以上由日线合成，日线、1分钟线及5分钟线无法合成，返回空列表
+ * @param ktype 目标K线类型
+ * @ingroup StockManage
+ */
+const vector<KQuery::KType>& HKU_API getResampleBaseKType(const KQuery::KType& ktype);
+
+/**
+ * 获取指定时刻所属K线的时间，与数据源中K线时间的约定一致
+ * @details 分钟级K线按市场交易时段对齐分组（如两小时线分别对应上午、下午两个交易时段），
+ *          时间为所在分组的结束时刻，不足整分钟的时刻归入下一分钟（如 09:31:10 的行情属于
+ *          09:32 的1分钟线）；周线及以上为自然周期的结束日期，其中周线为周五。
+ * @param datetime 指定时刻，如基础K线或实时行情的时间
+ * @param ktype K线类型，不支持日线
+ * @param market_info 所属市场信息，用于获取交易时段
+ * @return 不支持的K线类型返回 Null<Datetime>()
+ * @ingroup StockManage
+ */
+Datetime HKU_API getResampleTime(const Datetime& datetime, const KQuery::KType& ktype,
+                                 const MarketInfo& market_info);
+
+/**
+ * 将按时间升序排列的基础K线合成为指定类型的K线，结果追加至 out
+ * @details 按 getResampleTime 分组，每根K线的时间即为该函数的返回值。只进行一次线性扫描。
+ * @param base 基础K线数据
+ * @param start 从 base 中该位置开始合成，调用方需保证其为某一分组的起始位置
+ * @param ktype 目标K线类型
+ * @param market_info 所属市场信息，用于获取交易时段
+ * @param out [out] 合成结果
+ * @return 最后一个分组在 base 中的起始位置，可用于后续增量合成；无合成结果时返回 start
+ * @ingroup StockManage
+ */
+size_t HKU_API resampleKRecordList(const KRecordList& base, size_t start,
+                                   const KQuery::KType& ktype, const MarketInfo& market_info,
+                                   KRecordList& out);
+
+}  // namespace hku
+
+#endif /* KDATARESAMPLE_H_ */
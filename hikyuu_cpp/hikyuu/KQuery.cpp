@@ -24,7 +24,7 @@ const string KQuery::YEAR("YEAR");
 const string KQuery::MIN3("MIN3");
 const string KQuery::HOUR2("HOUR2");
 const string KQuery::HOUR4("HOUR4");
-const string KQuery::HOUR6("HOUR5");
+const string KQuery::HOUR6("HOUR6");
 const string KQuery::HOUR12("HOUR12");
 // const string KQuery::INVALID_KTYPE("Z");
 
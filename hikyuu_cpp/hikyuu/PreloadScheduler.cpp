@@ -0,0 +1,344 @@
+/*
+ *  Copyright(C) 2026 hikyuu.org
+ *
+ *  Create on: 2026-10-18
+ *     Author: fasiondog
+ */
+
+#include <boost/lexical_cast.hpp>
+#include "global/GlobalTaskGroup.h"
+#include "StockManager.h"
+#include "PreloadScheduler.h"
+
+namespace hku {
+
+const string PreloadScheduler::TICKS("TICKS");
+const string PreloadScheduler::TIMELINE("TIMELINE");
+
+// 分笔、分时缓存中单条记录占用的字节数 @see TickBuffer
+static const size_t g_tick_record_bytes = sizeof(int64_t) + 2 * sizeof(price_t) + sizeof(int8_t);
+
+static bool isTickType(const string& ktype) {
+    return ktype == PreloadScheduler::TICKS || ktype == PreloadScheduler::TIMELINE;
+}
+
+/* 任务类型对应的预加载参数名前缀，如 day、min5、ticks */
+static string paramPrefix(const string& ktype) {
+    string prefix(ktype);
+    to_lower(prefix);
+    return prefix;
+}
+
+/* 预加载的最大记录数，与 Stock::loadKDataToBuffer 等保持一致 */
+static size_t preloadMax(const string& ktype) {
+    const auto& param = StockManager::instance().getPreloadParameter();
+    int max_num =
+      param.tryGet<int>(fmt::format("{}_max", paramPrefix(ktype)), isTickType(ktype) ? 5120 : 4096);
+    return max_num < 0 ? 0 : size_t(max_num);
+}
+
+int PreloadScheduler::getPriority(const KQuery::KType& ktype) {
+    // 默认日线优先，其后依次为长周期、分钟线（周期由长至短）、分时、分笔
+    static const unordered_map<string, int> default_priority{
+      {"DAY", 0},   {"WEEK", 1},  {"MONTH", 2}, {"QUARTER", 3}, {"HALFYEAR", 4},
+      {"YEAR", 5},  {"MIN60", 6}, {"MIN30", 7}, {"MIN15", 8},   {"MIN5", 9},
+      {"MIN", 10},  {"TIMELINE", 11}, {"TICKS", 12}};
+
+    string nktype(ktype);
+    to_upper(nktype);
+    auto iter = default_priority.find(nktype);
+    int priority = iter != default_priority.end() ? iter->second : 100;
+    const auto& param = StockManager::instance().getPreloadParameter();
+    return param.tryGet<int>(fmt::format("{}_priority", paramPrefix(nktype)), priority);
+}
+
+PreloadScheduler::PreloadScheduler(size_t memory_limit, size_t io_concurrency)
+: m_memory_limit(memory_limit),
+  m_io_concurrency(io_concurrency),
+  m_seq(0),
+  m_started(false),
+  m_done(false) {
+    m_future = m_promise.get_future().share();
+}
+
+size_t PreloadScheduler::_getDriverLimit(const KDataDriverConnectPoolPtr& driver) const {
+    auto prototype = driver->getPrototype();
+    HKU_IF_RETURN(!prototype->canParallelLoad(), 1);
+
+    // 驱动参数一般来自配置文件，可能以字符串保存
+    const auto& param = prototype->getParameter();
+    int limit = param.tryGet<int>("io_concurrency", 0);
+    if (limit <= 0 && param.have("io_concurrency")) {
+        try {
+            limit = boost::lexical_cast<int>(param.tryGet<string>("io_concurrency", "0"));
+        } catch (...) {
+            HKU_WARN("Invalid kdata driver param io_concurrency!");
+        }
+    }
+    HKU_IF_RETURN(limit > 0, size_t(limit));
+    HKU_IF_RETURN(m_io_concurrency > 0, m_io_concurrency);
+    HKU_IF_RETURN(driver->maxConnect() > 0, driver->maxConnect());
+    return std::max(getGlobalTaskGroup()->worker_num(), size_t(1));
+}
+
+void PreloadScheduler::add(const Stock& stk, const KQuery::KType& ktype) {
+    HKU_IF_RETURN(stk.isNull(), void());
+    string nktype(ktype);
+    to_upper(nktype);
+    int priority = getPriority(nktype);
+    KDataDriverConnectPoolPtr driver = stk.getKDataDirver();
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    HKU_WARN_IF_RETURN(m_started, void(), "The scheduler has been started!");
+    size_t index = 0;
+    while (index < m_queues.size() && m_queues[index].driver != driver) {
+        index++;
+    }
+    if (index == m_queues.size()) {
+        m_queues.push_back(DriverQueue{driver, _getDriverLimit(driver), 0, {}});
+    }
+    m_queues[index].tasks.push_back(Task{stk, nktype, priority, m_seq++});
+    m_stock_pending[stk.market_code()]++;
+    m_ktype_pending[nktype]++;
+    m_progress.total++;
+}
+
+bool PreloadScheduler::_pick(Task& task, size_t& queue_index) {
+    const Task* best = nullptr;
+    for (size_t i = 0, total = m_queues.size(); i < total; i++) {
+        const auto& queue = m_queues[i];
+        if (queue.tasks.empty() || queue.running >= queue.limit) {
+            continue;
+        }
+        const Task& front = queue.tasks.front();
+        if (!best || front.priority < best->priority ||
+            (front.priority == best->priority && front.seq < best->seq)) {
+            best = &front;
+            queue_index = i;
+        }
+    }
+    HKU_IF_RETURN(!best, false);
+
+    auto& queue = m_queues[queue_index];
+    task = std::move(queue.tasks.front());
+    queue.tasks.pop_front();
+    queue.running++;
+    return true;
+}
+
+size_t PreloadScheduler::_estimateBytes(const Task& task) const {
+    // 按最大记录数估算，避免加载前再向数据驱动查询记录数
+    size_t max_num = preloadMax(task.ktype);
+    return max_num * (isTickType(task.ktype) ? g_tick_record_bytes : sizeof(KRecord));
+}
+
+size_t PreloadScheduler::_load(const Task& task) const {
+    Stock stk = task.stk;
+    if (task.ktype == TICKS) {
+        stk.loadTransToBuffer();
+        return stk.isTransBuffer() ? preloadMax(task.ktype) : 0;
+    }
+    if (task.ktype == TIMELINE) {
+        stk.loadTimeLineToBuffer();
+        return stk.isTimeLineBuffer() ? preloadMax(task.ktype) : 0;
+    }
+    stk.loadKDataToBuffer(task.ktype);
+    return stk.isBuffer(task.ktype) ? stk.getCount(task.ktype) : 0;
+}
+
+bool PreloadScheduler::_hasQueued() const {
+    for (const auto& queue : m_queues) {
+        HKU_IF_RETURN(!queue.tasks.empty(), true);
+    }
+    return false;
+}
+
+bool PreloadScheduler::_runOne() {
+    Task task;
+    size_t queue_index = 0;
+    {
+        // 仍有任务排队但所属驱动并发已满时，等待其他任务结束后再选取
+        std::unique_lock<std::mutex> lock(m_mutex);
+        bool picked = false;
+        m_cond.wait(lock, [&] {
+            picked = _pick(task, queue_index);
+            return picked || !_hasQueued();
+        });
+        HKU_IF_RETURN(!picked, false);
+    }
+
+    bool skipped = false, failed = false;
+    size_t bytes = 0, records = 0;
+    try {
+        // 先占用预算再加载，避免并发加载时超出预算
+        if (m_memory_limit > 0) {
+            bytes = _estimateBytes(task);
+            std::lock_guard<std::mutex> lock(m_mutex);
+            skipped = m_progress.bytes + bytes > m_memory_limit;
+            if (!skipped) {
+                m_progress.bytes += bytes;
+            }
+        }
+
+        if (skipped) {
+            // 释放可能存在的旧缓存，查询时直接从数据驱动读取
+            Stock stk = task.stk;
+            if (task.ktype == TICKS) {
+                stk.releaseTransBuffer();
+            } else if (task.ktype == TIMELINE) {
+                stk.releaseTimeLineBuffer();
+            } else {
+                stk.releaseKDataBuffer(task.ktype);
+            }
+        } else {
+            records = _load(task);
+        }
+    } catch (const std::exception& e) {
+        failed = true;
+        HKU_ERROR("Failed preload {} {}! {}", task.stk.market_code(), task.ktype, e.what());
+    } catch (...) {
+        failed = true;
+        HKU_ERROR("Failed preload {} {}! Unknown error!", task.stk.market_code(), task.ktype);
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_queues[queue_index].running--;
+    m_cond.notify_all();
+    if (skipped) {
+        m_progress.skipped++;
+    } else if (failed) {
+        m_progress.failed++;
+        m_progress.bytes -= m_memory_limit > 0 ? bytes : 0;  // 归还已占用的预算
+    } else {
+        m_progress.records += records;
+        size_t used = records * (isTickType(task.ktype) ? g_tick_record_bytes : sizeof(KRecord));
+        // 预算按最大记录数预先占用，加载后按实际记录数修正，归还多占用的部分
+        m_progress.bytes = m_progress.bytes - bytes + used;
+    }
+    _finishTask(task);
+    return true;
+}
+
+void PreloadScheduler::_finishTask(const Task& task) {
+    m_stock_pending[task.stk.market_code()]--;
+    m_ktype_pending[task.ktype]--;
+    m_progress.finished++;
+    if (m_progress.finished == m_progress.total) {
+        _setDone();
+    }
+}
+
+void PreloadScheduler::_setDone() {
+    HKU_IF_RETURN(m_done, void());
+    m_done = true;
+    m_end_time = std::chrono::steady_clock::now();
+    std::chrono::duration<double> sec = m_end_time - m_start_time;
+    HKU_INFO_IF(m_progress.total > 0,
+                "Preloaded {} tasks ({} skipped, {} failed), {} records, {:.2f}MB, {:.2f}s",
+                m_progress.total, m_progress.skipped, m_progress.failed, m_progress.records,
+                m_progress.bytes / 1048576.0, sec.count());
+    m_promise.set_value();
+}
+
+void PreloadScheduler::_prepare() {
+    m_started = true;
+    m_start_time = std::chrono::steady_clock::now();
+    // 加入时已按先后顺序排列，稳定排序后同优先级的任务仍先加入先执行
+    for (auto& queue : m_queues) {
+        std::stable_sort(queue.tasks.begin(), queue.tasks.end(),
+                         [](const Task& a, const Task& b) { return a.priority < b.priority; });
+    }
+    if (m_progress.total == 0) {
+        _setDone();
+    }
+}
+
+std::shared_future<void> PreloadScheduler::start() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    HKU_WARN_IF_RETURN(m_started, m_future, "The scheduler has been started!");
+    _prepare();
+    HKU_IF_RETURN(m_done, m_future);
+
+    size_t limit = 0;
+    for (const auto& queue : m_queues) {
+        limit += queue.limit;
+    }
+
+    // 工作任务数不超过全局任务组的线程数，排队任务全部取出后工作任务自行退出
+    auto* tg = getGlobalTaskGroup();
+    size_t worker_num = std::max(std::min(limit, tg->worker_num()), size_t(1));
+    auto self = shared_from_this();
+    for (size_t i = 0; i < worker_num; i++) {
+        tg->submit([self]() {
+            while (self->_runOne()) {
+            }
+        });
+    }
+    return m_future;
+}
+
+void PreloadScheduler::run() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        HKU_WARN_IF_RETURN(m_started, void(), "The scheduler has been started!");
+        _prepare();
+    }
+    while (_runOne()) {
+    }
+}
+
+void PreloadScheduler::cancel() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (!m_started) {
+        m_started = true;
+        m_start_time = std::chrono::steady_clock::now();
+    }
+    for (auto& queue : m_queues) {
+        for (const auto& task : queue.tasks) {
+            m_stock_pending[task.stk.market_code()]--;
+            m_ktype_pending[task.ktype]--;
+            m_progress.total--;
+        }
+        queue.tasks.clear();
+    }
+    m_cond.notify_all();
+    if (m_progress.finished == m_progress.total) {
+        _setDone();
+    }
+}
+
+bool PreloadScheduler::done() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_done;
+}
+
+bool PreloadScheduler::waitFor(int64_t ms) const {
+    return m_future.wait_for(std::chrono::milliseconds(ms)) == std::future_status::ready;
+}
+
+bool PreloadScheduler::isReady(const Stock& stk) const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto iter = m_stock_pending.find(stk.market_code());
+    return iter == m_stock_pending.end() || iter->second == 0;
+}
+
+bool PreloadScheduler::isReady(const KQuery::KType& ktype) const {
+    string nktype(ktype);
+    to_upper(nktype);
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto iter = m_ktype_pending.find(nktype);
+    return iter == m_ktype_pending.end() || iter->second == 0;
+}
+
+PreloadProgress PreloadScheduler::progress() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    PreloadProgress result = m_progress;
+    if (m_started) {
+        auto end_time = m_done ? m_end_time : std::chrono::steady_clock::now();
+        std::chrono::duration<double> sec = end_time - m_start_time;
+        result.elapsed = sec.count();
+    }
+    return result;
+}
+
+} /* namespace hku */
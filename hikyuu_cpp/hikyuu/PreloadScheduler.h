@@ -0,0 +1,202 @@
+/*
+ *  Copyright(C) 2026 hikyuu.org
+ *
+ *  Create on: 2026-10-18
+ *     Author: fasiondog
+ */
+
+#pragma once
+#ifndef PRELOADSCHEDULER_H_
+#define PRELOADSCHEDULER_H_
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <future>
+#include <mutex>
+#include "Stock.h"
+
+namespace hku {
+
+/**
+ * 预加载进度
+ * @ingroup StockManage
+ */
+struct HKU_API PreloadProgress {
+    size_t total = 0;      // 任务总数
+    size_t finished = 0;   // 已结束的任务数，包含跳过及失败的任务
+    size_t skipped = 0;    // 因超出内存预算而跳过的任务数
+    size_t failed = 0;     // 加载失败的任务数
+    size_t records = 0;    // 已加载的记录数，分笔、分时按最大记录数计
+    size_t bytes = 0;      // 已加载数据占用的内存字节数（按记录数估算），含加载中任务预占的预算
+    double elapsed = 0.0;  // 已耗时（秒），全部结束后不再增长
+
+    /** 每秒加载的记录数 */
+    double recordsPerSecond() const {
+        return elapsed > 0.0 ? records / elapsed : 0.0;
+    }
+
+    /** 每秒加载的字节数 */
+    double bytesPerSecond() const {
+        return elapsed > 0.0 ? bytes / elapsed : 0.0;
+    }
+};
+
+/**
+ * 预加载调度器
+ * @details 按K线类型优先级（默认日线优先，分笔、分时最后）依次将数据加载至缓存：
+ * <pre>
+ * 1. 各数据驱动的任务分别排队，同一驱动同时执行的加载任务数不超过其 I/O 并发数；
+ * 2. 设置内存预算时，加载前按预加载的最大记录数预先占用预算，超出预算的任务将被跳过，
+ *    对应数据不做缓存，查询时直接从数据驱动读取；加载完成后按实际记录数归还多占用的预算；
+ * 3. 异步执行时不阻塞调用方，可通过 future、isReady 判断加载是否完成。
+ * </pre>
+ * 优先级、最大记录数等取自预加载参数，如 day_priority、day_max，优先级数值越小越先加载。
+ * @ingroup StockManage
+ */
+class HKU_API PreloadScheduler : public std::enable_shared_from_this<PreloadScheduler> {
+public:
+    /** 分笔数据任务类型 */
+    static const string TICKS;
+
+    /** 分时数据任务类型 */
+    static const string TIMELINE;
+
+    /**
+     * 构造函数
+     * @param memory_limit 内存预算（字节），为 0 表示不限制
+     * @param io_concurrency 默认的单个数据驱动 I/O 并发数，为 0 时由数据驱动参数 io_concurrency、
+     *                       连接池最大连接数或全局任务组线程数决定
+     */
+    explicit PreloadScheduler(size_t memory_limit = 0, size_t io_concurrency = 0);
+    virtual ~PreloadScheduler() = default;
+
+    PreloadScheduler(const PreloadScheduler&) = delete;
+    PreloadScheduler& operator=(const PreloadScheduler&) = delete;
+
+    /**
+     * 增加加载任务，仅可在启动前调用
+     * @param stk 指定的证券，使用其自身的K线数据驱动
+     * @param ktype K线类型，或 PreloadScheduler::TICKS、PreloadScheduler::TIMELINE
+     */
+    void add(const Stock& stk, const KQuery::KType& ktype);
+
+    /**
+     * 在全局任务组中异步执行全部任务，仅可启动一次
+     * @return 全部任务结束时就绪的 future
+     */
+    std::shared_future<void> start();
+
+    /** 在当前线程中按优先级依次执行全部任务，用于不支持并行加载的数据驱动 */
+    void run();
+
+    /** 取消尚未开始的任务，已开始的任务仍将执行完毕 */
+    void cancel();
+
+    /** 全部任务结束时就绪的 future */
+    std::shared_future<void> getFuture() const {
+        return m_future;
+    }
+
+    /** 是否已全部结束 */
+    bool done() const;
+
+    /** 阻塞等待全部任务结束 */
+    void wait() const {
+        m_future.wait();
+    }
+
+    /**
+     * 阻塞等待全部任务结束
+     * @param ms 最长等待时间（毫秒）
+     * @return 全部任务已结束时返回 true，超时返回 false
+     */
+    bool waitFor(int64_t ms) const;
+
+    /** 指定证券的全部任务是否已结束，无任务时返回 true */
+    bool isReady(const Stock& stk) const;
+
+    /** 指定类型的全部任务是否已结束，无任务时返回 true */
+    bool isReady(const KQuery::KType& ktype) const;
+
+    /** 获取当前进度 */
+    PreloadProgress progress() const;
+
+    /** 内存预算（字节），为 0 表示不限制 */
+    size_t memoryLimit() const {
+        return m_memory_limit;
+    }
+
+    /**
+     * 获取指定类型的优先级，取自预加载参数 <ktype>_priority，数值越小越先加载
+     * @param ktype K线类型，或 PreloadScheduler::TICKS、PreloadScheduler::TIMELINE
+     */
+    static int getPriority(const KQuery::KType& ktype);
+
+private:
+    struct Task {
+        Stock stk;
+        string ktype;  // 大写
+        int priority;  // 数值越小越先执行
+        size_t seq;    // 加入顺序，同优先级时先加入先执行
+    };
+
+    struct DriverQueue {
+        KDataDriverConnectPoolPtr driver;
+        size_t limit;    // I/O 并发数
+        size_t running;  // 正在执行的任务数
+        std::deque<Task> tasks;
+    };
+
+    /* 选取可执行的最高优先级任务，需持有 m_mutex，无可执行任务时返回 false */
+    bool _pick(Task& task, size_t& queue_index);
+
+    /* 是否仍有排队中的任务，需持有 m_mutex */
+    bool _hasQueued() const;
+
+    /* 执行一个任务，所属驱动并发已满时等待，无排队任务时返回 false */
+    bool _runOne();
+
+    /* 加载前按预加载的最大记录数估算所需内存字节数，不访问数据驱动 */
+    size_t _estimateBytes(const Task& task) const;
+
+    /* 执行加载，返回加载的记录数 */
+    size_t _load(const Task& task) const;
+
+    /* 任务结束计数，需持有 m_mutex */
+    void _finishTask(const Task& task);
+
+    /* 标记为已启动并按优先级排序任务，需持有 m_mutex */
+    void _prepare();
+
+    /* 全部任务结束，需持有 m_mutex */
+    void _setDone();
+
+    size_t _getDriverLimit(const KDataDriverConnectPoolPtr& driver) const;
+
+private:
+    size_t m_memory_limit;
+    size_t m_io_concurrency;
+
+    mutable std::mutex m_mutex;
+    std::condition_variable m_cond;  // 任务结束或取消时通知等待中的工作任务
+    vector<DriverQueue> m_queues;
+    unordered_map<string, size_t> m_stock_pending;  // market_code -> 未结束的任务数
+    unordered_map<string, size_t> m_ktype_pending;  // ktype -> 未结束的任务数
+    size_t m_seq;
+    bool m_started;
+    bool m_done;
+
+    PreloadProgress m_progress;
+    std::chrono::steady_clock::time_point m_start_time;
+    std::chrono::steady_clock::time_point m_end_time;
+
+    std::promise<void> m_promise;
+    std::shared_future<void> m_future;
+};
+
+typedef shared_ptr<PreloadScheduler> PreloadSchedulerPtr;
+
+} /* namespace hku */
+
+#endif /* PRELOADSCHEDULER_H_ */
@@ -11,6 +11,7 @@
 #include "data_driver/HistoryFinanceReader.h"
 #include "utilities/util.h"
 #include "KData.h"
+#include "KDataResample.h"
 
 namespace hku {
 
@@ -58,16 +59,20 @@ Stock::Data::Data()
   m_valid(default_valid),
   m_startDate(default_startDate),
   m_lastDate(default_lastDate),
+  m_denseId(Null<uint32_t>()),
   m_tick(default_tick),
   m_tickValue(default_tickValue),
   m_unit(default_unit),
   m_precision(default_precision),
   m_minTradeNumber(default_minTradeNumber),
-  m_maxTradeNumber(default_maxTradeNumber) {
+  m_maxTradeNumber(default_maxTradeNumber),
+  m_recoverFactorValid(false),
+  m_spotTickValid(false) {
     const auto& ktype_list = KQuery::getAllKType();
     for (auto& ktype : ktype_list) {
         pKData[ktype] = nullptr;
         pMutex[ktype] = nullptr;
+        m_resampleVersion[ktype].store(0, std::memory_order_relaxed);
     }
 }
 
@@ -81,11 +86,14 @@ Stock::Data::Data(const string& market, const string& code, const string& name,
   m_valid(valid),
   m_startDate(startDate),
   m_lastDate(lastDate),
+  m_denseId(Null<uint32_t>()),
   m_tick(tick),
   m_tickValue(tickValue),
   m_precision(precision),
   m_minTradeNumber(minTradeNumber),
-  m_maxTradeNumber(maxTradeNumber) {
+  m_maxTradeNumber(maxTradeNumber),
+  m_recoverFactorValid(false),
+  m_spotTickValid(false) {
     if (0.0 == m_tick) {
         HKU_WARN("tick should not be zero! now use as 1.0");
         m_unit = 1.0;
@@ -100,6 +108,7 @@ Stock::Data::Data(const string& market, const string& code, const string& name,
     for (auto& ktype : ktype_list) {
         pMutex[ktype] = new std::shared_mutex();
         pKData[ktype] = nullptr;
+        m_resampleVersion[ktype].store(0, std::memory_order_relaxed);
     }
 }
 
@@ -228,6 +237,7 @@ void Stock::setKDataDriver(const KDataDriverConnectPoolPtr& kdataDriver) {
             delete m_data->pKData[ktype];
             m_data->pKData[ktype] = nullptr;
         }
+        m_data->m_kdataVersion.fetch_add(1, std::memory_order_acq_rel);
     }
 }
 
@@ -239,7 +249,9 @@ void Stock::setWeightList(const StockWeightList& weightList) {
     if (m_data) {
         std::lock_guard<std::mutex> lock(m_data->m_weight_mutex);
         m_data->m_weightList = weightList;
+        m_data->m_recoverFactorValid = false;
     }
+    _clearRecoverKDataCache();
 }
 
 bool Stock::isBuffer(KQuery::KType ktype) const {
@@ -260,12 +272,136 @@ void Stock::releaseKDataBuffer(KQuery::KType inkType) {
     to_upper(ktype);
     HKU_IF_RETURN(m_data->pMutex.find(ktype) == m_data->pMutex.end(), void());
 
+    {
+        std::lock_guard<std::mutex> resample_lock(m_data->m_resample_mutex);
+        m_data->m_resampleState.erase(ktype);
+        std::unique_lock<std::shared_mutex> lock(*(m_data->pMutex[ktype]));
+        auto iter = m_data->pKData.find(ktype);
+        if (iter->second) {
+            delete iter->second;
+            iter->second = nullptr;
+        }
+    }
+    m_data->m_kdataVersion.fetch_add(1, std::memory_order_acq_rel);
+    _clearRecoverKDataCache();
+
+    // 缓存释放或重新加载后，实时行情聚合状态需重新同步
+    std::lock_guard<std::mutex> spot_lock(m_data->m_spot_bar_mutex);
+    m_data->m_spotBarState.erase(ktype);
+}
+
+bool Stock::_isResampleKType(const string& ktype) const {
+    return !getResampleBaseKType(ktype).empty() &&
+           !m_kdataDriver->getPrototype()->isSupportKType(ktype);
+}
+
+void Stock::_prepareResampleKData(const KQuery::KType& inktype) const {
+    HKU_IF_RETURN(isNull(), void());
+    string ktype(inktype);
+    to_upper(ktype);
+    auto version_iter = m_data->m_resampleVersion.find(ktype);
+    HKU_IF_RETURN(version_iter == m_data->m_resampleVersion.end() || !_isResampleKType(ktype),
+                  void());
+
+    // K线缓存自上次同步后未变化时直接返回，不加锁
+    std::atomic<uint64_t>& synced = version_iter->second;
+    HKU_IF_RETURN(synced.load(std::memory_order_acquire) ==
+                    m_data->m_kdataVersion.load(std::memory_order_acquire),
+                  void());
+
+    std::lock_guard<std::mutex> resample_lock(m_data->m_resample_mutex);
+    // 先读取版本号，合成期间基础K线再有变化时，下次访问将重新同步
+    uint64_t version = m_data->m_kdataVersion.load(std::memory_order_acquire);
+    HKU_IF_RETURN(synced.load(std::memory_order_acquire) == version, void());
+
+    // 只由已缓存的基础K线合成，优先使用粒度最粗的，二者合成结果一致，粒度越粗需处理的数据越少
+    // 基础K线均未缓存时不合成，也不访问数据驱动
+    string base_ktype;
+    for (const auto& candidate : getResampleBaseKType(ktype)) {
+        if (isBuffer(candidate)) {
+            base_ktype = candidate;
+            break;
+        }
+    }
+
+    size_t base_total = base_ktype.empty() ? 0 : _getCountFromBuffer(base_ktype);
+    auto& state_map = m_data->m_resampleState;
+    if (base_total == 0) {
+        state_map.erase(ktype);
+        {
+            std::unique_lock<std::shared_mutex> lock(*(m_data->pMutex[ktype]));
+            delete m_data->pKData[ktype];
+            m_data->pKData[ktype] = nullptr;
+        }
+        synced.store(version, std::memory_order_release);
+        return;
+    }
+
+    // 基础K线只在末尾追加或更新时，从最后一根合成K线的起始位置增量合成
+    size_t start = 0;
+    bool incremental = false;
+    auto state_iter = state_map.find(ktype);
+    if (state_iter != state_map.end() && state_iter->second.base_ktype == base_ktype &&
+        state_iter->second.base_count <= base_total) {
+        const Stock::Data::ResampleState& state = state_iter->second;
+        if (!state.dirty && state.base_count == base_total) {
+            synced.store(version, std::memory_order_release);
+            return;
+        }
+        KRecord last = _getKRecordFromBuffer(state.base_count - 1, base_ktype);
+        if (last.datetime == state.base_last) {
+            start = state.last_group_start;
+            incremental = true;
+        }
+    }
+
+    KRecordList base_list = _getKRecordListFromBuffer(start, base_total, base_ktype);
+    MarketInfo market_info = StockManager::instance().getMarketInfo(market());
+
     std::unique_lock<std::shared_mutex> lock(*(m_data->pMutex[ktype]));
-    auto iter = m_data->pKData.find(ktype);
-    if (iter->second) {
-        delete iter->second;
-        iter->second = nullptr;
+    KRecordList*& buffer = m_data->pKData[ktype];
+    if (!buffer) {
+        buffer = new KRecordList;
+        incremental = false;
+    }
+    if (!incremental) {
+        buffer->clear();
+    } else if (!buffer->empty()) {
+        buffer->pop_back();
     }
+
+    if (base_list.empty()) {
+        state_map.erase(ktype);
+        synced.store(version, std::memory_order_release);
+        return;
+    }
+
+    size_t group_start = resampleKRecordList(base_list, 0, ktype, market_info, *buffer);
+    state_map[ktype] = Stock::Data::ResampleState{base_ktype, start + base_list.size(),
+                                                  base_list.back().datetime,
+                                                  start + group_start, false};
+
+    // 全量合成时与预加载一致，最多保留 <ktype>_max 条记录
+    if (!incremental) {
+        string preload_type = fmt::format("{}_max", ktype);
+        to_lower(preload_type);
+        int max_num = StockManager::instance().getPreloadParameter().tryGet<int>(preload_type,
+                                                                                  4096);
+        if (max_num >= 0 && buffer->size() > size_t(max_num)) {
+            buffer->erase(buffer->begin(), buffer->end() - max_num);
+        }
+    }
+    lock.unlock();
+    synced.store(version, std::memory_order_release);
+
+    // 合成结果已变化，由其合成的日线以上复权数据需重新计算
+    _clearRecoverKDataCache();
+}
+
+void Stock::_clearRecoverKDataCache() const {
+    HKU_IF_RETURN(!m_data, void());
+    std::lock_guard<std::mutex> lock(m_data->m_recover_cache_mutex);
+    m_data->m_recoverKDataCache.clear();
 }
 
 // 仅在初始化时调用
@@ -295,6 +431,100 @@ void Stock::loadKDataToBuffer(KQuery::KType inkType) {
         (*ptr_klist) = driver->getKRecordList(m_data->m_market, m_data->m_code,
                                               KQuery(start, Null<int64_t>(), kType));
     }
+    m_data->m_kdataVersion.fetch_add(1, std::memory_order_acq_rel);
+}
+
+/** 分笔、分时缓存的最大记录数，参数无效时返回 -1 */
+static int getTickBufferMax(const string& name) {
+    const auto& param = StockManager::instance().getPreloadParameter();
+    int max_num = param.tryGet<int>(name, 5120);
+    HKU_ERROR_IF_RETURN(max_num < 0, -1, "Invalid preload {} param: {}", name, max_num);
+    return max_num;
+}
+
+void Stock::loadTransToBuffer() {
+    HKU_IF_RETURN(!m_data || !m_kdataDriver, void());
+    int max_num = getTickBufferMax("ticks_max");
+    HKU_IF_RETURN(max_num < 0, void());
+
+    auto buffer = make_shared<TickBuffer>(max_num);
+    if (max_num > 0) {
+        TransList trans_list = m_kdataDriver->getConnect()->getTransList(
+          m_data->m_market, m_data->m_code, KQuery(-max_num));
+        for (const auto& trans : trans_list) {
+            buffer->push_back(TickBuffer::toTicks(trans.datetime), trans.price, trans.vol,
+                              trans.direct);
+        }
+    }
+    buffer->setTruncated(buffer->truncated() || buffer->size() >= size_t(max_num));
+
+    std::unique_lock<std::shared_mutex> lock(m_data->m_tick_mutex);
+    m_data->m_transBuffer = buffer;
+    m_data->m_spotTickValid = false;
+}
+
+void Stock::releaseTransBuffer() {
+    HKU_IF_RETURN(!m_data, void());
+    std::unique_lock<std::shared_mutex> lock(m_data->m_tick_mutex);
+    m_data->m_transBuffer.reset();
+    m_data->m_spotTickValid = false;
+}
+
+bool Stock::isTransBuffer() const {
+    HKU_IF_RETURN(!m_data, false);
+    std::shared_lock<std::shared_mutex> lock(m_data->m_tick_mutex);
+    return m_data->m_transBuffer != nullptr;
+}
+
+void Stock::loadTimeLineToBuffer() {
+    HKU_IF_RETURN(!m_data || !m_kdataDriver, void());
+    int max_num = getTickBufferMax("timeline_max");
+    HKU_IF_RETURN(max_num < 0, void());
+
+    auto buffer = make_shared<TickBuffer>(max_num);
+    if (max_num > 0) {
+        TimeLineList time_line = m_kdataDriver->getConnect()->getTimeLineList(
+          m_data->m_market, m_data->m_code, KQuery(-max_num));
+        for (const auto& record : time_line) {
+            buffer->push_back(TickBuffer::toTicks(record.datetime), record.price, record.vol);
+        }
+    }
+    buffer->setTruncated(buffer->truncated() || buffer->size() >= size_t(max_num));
+
+    std::unique_lock<std::shared_mutex> lock(m_data->m_tick_mutex);
+    m_data->m_timeLineBuffer = buffer;
+    m_data->m_spotTickValid = false;
+}
+
+void Stock::releaseTimeLineBuffer() {
+    HKU_IF_RETURN(!m_data, void());
+    std::unique_lock<std::shared_mutex> lock(m_data->m_tick_mutex);
+    m_data->m_timeLineBuffer.reset();
+    m_data->m_spotTickValid = false;
+}
+
+bool Stock::isTimeLineBuffer() const {
+    HKU_IF_RETURN(!m_data, false);
+    std::shared_lock<std::shared_mutex> lock(m_data->m_tick_mutex);
+    return m_data->m_timeLineBuffer != nullptr;
+}
+
+bool Stock::getTimeLineFromBuffer(const KQuery& query, bool vol, PriceList& out) const {
+    out.clear();
+    HKU_IF_RETURN(!m_data, false);
+    std::shared_lock<std::shared_mutex> lock(m_data->m_tick_mutex);
+    const TickBufferPtr& buffer = m_data->m_timeLineBuffer;
+    HKU_IF_RETURN(!buffer || !buffer->covers(query), false);
+
+    size_t start = 0, end = 0;
+    HKU_IF_RETURN(!buffer->getIndexRange(query, start, end), true);
+    out.resize(end - start);
+    if (vol) {
+        buffer->copyVol(start, end, out.data());
+    } else {
+        buffer->copyPrice(start, end, out.data());
+    }
+    return true;
 }
 
 StockWeightList Stock::getWeight(const Datetime& start, const Datetime& end) const {
@@ -317,6 +547,38 @@ StockWeightList Stock::getWeight(const Datetime& start, const Datetime& end) con
     return result;
 }
 
+StockRecoverFactorList Stock::getRecoverFactor(const Datetime& start, const Datetime& end) const {
+    StockRecoverFactorList result;
+    HKU_IF_RETURN(!m_data || start >= end, result);
+    std::lock_guard<std::mutex> lock(m_data->m_weight_mutex);
+    StockRecoverFactorList& factors = m_data->m_recoverFactorList;
+    if (!m_data->m_recoverFactorValid) {
+        factors.clear();
+        for (const auto& weight : m_data->m_weightList) {
+            //流通股份变动比例
+            price_t change =
+              0.1 * (weight.countAsGift() + weight.countForSell() + weight.increasement());
+            price_t denominator = 1.0 + change;
+            price_t adjust = weight.priceForSell() * change - 0.1 * weight.bonus();
+
+            //不处理仅仅只有流通股本改变的情况
+            if (denominator == 1.0 && adjust == 0.0) {
+                continue;
+            }
+            factors.push_back(StockRecoverFactor{weight.datetime(), denominator, adjust});
+        }
+        m_data->m_recoverFactorValid = true;
+    }
+
+    auto comp = [](const StockRecoverFactor& factor, const Datetime& date) {
+        return factor.datetime < date;
+    };
+    auto start_iter = std::lower_bound(factors.begin(), factors.end(), start, comp);
+    auto end_iter = std::lower_bound(start_iter, factors.end(), end, comp);
+    result.assign(start_iter, end_iter);
+    return result;
+}
+
 KData Stock::getKData(const KQuery& query) const {
     return KData(*this, query);
 }
@@ -330,6 +592,7 @@ size_t Stock::getCount(KQuery::KType kType) const {
     HKU_IF_RETURN(!m_data, 0);
     string nktype(kType);
     to_upper(nktype);
+    _prepareResampleKData(nktype);
     if (m_data->pKData.find(nktype) != m_data->pKData.end() && m_data->pKData[nktype]) {
         return _getCountFromBuffer(nktype);
     }
@@ -343,6 +606,7 @@ price_t Stock::getMarketValue(const Datetime& datetime, KQuery::KType inktype) c
 
     string ktype(inktype);
     to_upper(ktype);
+    _prepareResampleKData(ktype);
 
     // 如果为内存缓存或者数据驱动为索引优先，则按索引方式获取
     if (isBuffer(ktype) || m_kdataDriver->getConnect()->isIndexFirst()) {
@@ -398,6 +662,7 @@ bool Stock::getIndexRange(const KQuery& query, size_t& out_start, size_t& out_en
     if ((KQuery::DATE != query.queryType()) || query.startDatetime() >= query.endDatetime())
         return false;
 
+    _prepareResampleKData(query.kType());
     if (isBuffer(query.kType())) {
         return _getIndexRangeByDateFromBuffer(query, out_start, out_end);
     }
@@ -540,6 +805,7 @@ KRecord Stock::_getKRecordFromBuffer(size_t pos, KQuery::KType ktype) const {
 
 KRecord Stock::getKRecord(size_t pos, KQuery::KType kType) const {
     HKU_IF_RETURN(!m_data, Null<KRecord>());
+    _prepareResampleKData(kType);
     if (isBuffer(kType)) {
         return _getKRecordFromBuffer(pos, kType);
     }
@@ -555,6 +821,7 @@ KRecord Stock::getKRecord(const Datetime& datetime, KQuery::KType ktype) const {
     HKU_IF_RETURN(isNull(), result);
 
     KQuery query = KQueryByDate(datetime, datetime + Minutes(1), ktype);
+    _prepareResampleKData(query.kType());
     auto driver = m_kdataDriver->getConnect();
     if (isBuffer(query.kType()) || driver->isIndexFirst()) {
         size_t startix = 0, endix = 0;
@@ -583,6 +850,7 @@ KRecordList Stock::_getKRecordListFromBuffer(size_t start_ix, size_t end_ix,
 KRecordList Stock::getKRecordList(const KQuery& query) const {
     KRecordList result;
     HKU_IF_RETURN(isNull(), result);
+    _prepareResampleKData(query.kType());
 
     // 如果是在内存缓存中
     if (isBuffer(query.kType())) {
@@ -640,11 +908,29 @@ DatetimeList Stock::getDatetimeList(const KQuery& query) const {
 }
 
 TimeLineList Stock::getTimeLineList(const KQuery& query) const {
+    if (m_data) {
+        std::shared_lock<std::shared_mutex> lock(m_data->m_tick_mutex);
+        const TickBufferPtr& buffer = m_data->m_timeLineBuffer;
+        if (buffer && buffer->covers(query)) {
+            size_t start = 0, end = 0;
+            return buffer->getIndexRange(query, start, end) ? buffer->getTimeLineList(start, end)
+                                                            : TimeLineList();
+        }
+    }
     return m_kdataDriver ? m_kdataDriver->getConnect()->getTimeLineList(market(), code(), query)
                          : TimeLineList();
 }
 
 TransList Stock::getTransList(const KQuery& query) const {
+    if (m_data) {
+        std::shared_lock<std::shared_mutex> lock(m_data->m_tick_mutex);
+        const TickBufferPtr& buffer = m_data->m_transBuffer;
+        if (buffer && buffer->covers(query)) {
+            size_t start = 0, end = 0;
+            return buffer->getIndexRange(query, start, end) ? buffer->getTransList(start, end)
+                                                            : TransList();
+        }
+    }
     return m_kdataDriver ? m_kdataDriver->getConnect()->getTransList(market(), code(), query)
                          : TransList();
 }
@@ -702,6 +988,18 @@ void Stock::realtimeUpdate(KRecord record, KQuery::KType inktype) {
     string ktype(inktype);
     to_upper(ktype);
 
+    // 新增或更新K线后，已合成的日线以上复权数据不再有效
+    _clearRecoverKDataCache();
+
+    // 以该K线为基础合成的K线需增量更新，持有 m_resample_mutex 期间合成K线不会读取缓存
+    std::lock_guard<std::mutex> resample_lock(m_data->m_resample_mutex);
+    for (auto& item : m_data->m_resampleState) {
+        if (item.second.base_ktype == ktype) {
+            item.second.dirty = true;
+        }
+    }
+    m_data->m_kdataVersion.fetch_add(1, std::memory_order_acq_rel);
+
     // 加写锁
     std::unique_lock<std::shared_mutex> lock(*(m_data->pMutex[ktype]));
 
@@ -722,6 +1020,230 @@ void Stock::realtimeUpdate(KRecord record, KQuery::KType inktype) {
     }
 }
 
+/** 日线以上K线对应周期的起始日期，非日线以上类型返回 Null */
+static Datetime getSpotPhaseStart(const Datetime& day, const string& ktype) {
+    if (KQuery::WEEK == ktype) {
+        return day.startOfWeek();
+    } else if (KQuery::MONTH == ktype) {
+        return day.startOfMonth();
+    } else if (KQuery::QUARTER == ktype) {
+        return day.startOfQuarter();
+    } else if (KQuery::HALFYEAR == ktype) {
+        return day.startOfHalfyear();
+    } else if (KQuery::YEAR == ktype) {
+        return day.startOfYear();
+    }
+    return Null<Datetime>();
+}
+
+void Stock::realtimeUpdateFromSpot(const KRecord& spot, KQuery::KType inktype) {
+    HKU_IF_RETURN(!isBuffer(inktype) || spot.datetime.isNull(), void());
+
+    string ktype(inktype);
+    to_upper(ktype);
+    Datetime day = spot.datetime.startOfDay();
+    if (KQuery::DAY == ktype) {
+        realtimeUpdate(KRecord(day, spot.openPrice, spot.highPrice, spot.lowPrice,
+                               spot.closePrice, spot.transAmount, spot.transCount),
+                       ktype);
+        return;
+    }
+
+    // 与数据源及K线合成一致：分钟级K线以按交易时段对齐的周期结束时刻为K线时间，
+    // 日线以上以周期结束日期为K线时间
+    Datetime bar =
+      getResampleTime(spot.datetime, ktype, StockManager::instance().getMarketInfo(market()));
+    HKU_ERROR_IF_RETURN(bar.isNull(), void(), "Invalid ktype: {}", ktype);
+    Datetime start_of_phase = getSpotPhaseStart(day, ktype);
+    bool is_minute = start_of_phase.isNull();
+
+    std::lock_guard<std::mutex> lock(m_data->m_spot_bar_mutex);
+    auto iter = m_data->m_spotBarState.find(ktype);
+    if (iter == m_data->m_spotBarState.end()) {
+        // 首次更新（或缓存重新加载后），从缓存中同步一次当前K线及此前已累计的成交
+        Data::SpotBarState state;
+        state.bar = bar;
+        state.day = day;
+        state.open = Null<price_t>();
+        state.high = Null<price_t>();
+        state.low = Null<price_t>();
+        state.baseAmount = 0.0;
+        state.baseCount = 0.0;
+        state.dayAmount = 0.0;
+        state.dayCount = 0.0;
+
+        // 分钟级：当日此前各K线的成交之和即为当前K线开始时的当日累计成交；
+        // 日线以上：本周期内此前各交易日的日线
+        KRecordList klist =
+          is_minute ? getKRecordList(KQuery(day, bar + Minutes(1), ktype))
+                    : getKRecordList(KQuery(start_of_phase, day, KQuery::DAY));
+        for (const auto& k : klist) {
+            if (is_minute && k.datetime >= bar) {
+                state.open = k.openPrice;
+                state.high = k.highPrice;
+                state.low = k.lowPrice;
+                continue;
+            }
+            state.baseAmount += k.transAmount;
+            state.baseCount += k.transCount;
+            if (!is_minute) {
+                if (state.open == Null<price_t>()) {
+                    state.open = k.openPrice;
+                    state.high = k.highPrice;
+                    state.low = k.lowPrice;
+                } else {
+                    state.high = std::max(state.high, k.highPrice);
+                    state.low = std::min(state.low, k.lowPrice);
+                }
+            }
+        }
+
+        if (state.open == Null<price_t>()) {
+            state.open = is_minute ? spot.closePrice : spot.openPrice;
+            state.high = is_minute ? spot.closePrice : spot.highPrice;
+            state.low = is_minute ? spot.closePrice : spot.lowPrice;
+        }
+        iter = m_data->m_spotBarState.emplace(ktype, state).first;
+    }
+
+    Data::SpotBarState& state = iter->second;
+    KRecord record;
+    if (is_minute) {
+        if (state.day != day) {
+            state.day = day;
+            state.dayAmount = 0.0;
+            state.dayCount = 0.0;
+        }
+        if (state.bar != bar) {
+            // 新K线，此前的当日累计成交即为新K线的起点
+            state.bar = bar;
+            state.baseAmount = state.dayAmount;
+            state.baseCount = state.dayCount;
+            state.open = spot.closePrice;
+            state.high = spot.closePrice;
+            state.low = spot.closePrice;
+        } else {
+            state.high = std::max(state.high, spot.closePrice);
+            state.low = std::min(state.low, spot.closePrice);
+        }
+        record = KRecord(bar, state.open, state.high, state.low, spot.closePrice,
+                         std::max(spot.transAmount - state.baseAmount, 0.0),
+                         std::max(spot.transCount - state.baseCount, 0.0));
+
+    } else {
+        if (state.bar != bar) {
+            // 新周期
+            state.bar = bar;
+            state.day = day;
+            state.baseAmount = 0.0;
+            state.baseCount = 0.0;
+            state.open = spot.openPrice;
+            state.high = spot.highPrice;
+            state.low = spot.lowPrice;
+        } else {
+            if (state.day != day) {
+                // 同一周期内的新交易日，上一交易日的成交计入累计
+                state.day = day;
+                state.baseAmount += state.dayAmount;
+                state.baseCount += state.dayCount;
+            }
+            state.high = std::max(state.high, spot.highPrice);
+            state.low = std::min(state.low, spot.lowPrice);
+        }
+        record = KRecord(bar, state.open, state.high, state.low, spot.closePrice,
+                         state.baseAmount + spot.transAmount, state.baseCount + spot.transCount);
+    }
+
+    state.dayAmount = spot.transAmount;
+    state.dayCount = spot.transCount;
+    realtimeUpdate(record, ktype);
+}
+
+void Stock::realtimeUpdateTickFromSpot(const KRecord& spot) {
+    HKU_IF_RETURN(!m_data || spot.datetime.isNull(), void());
+
+    std::unique_lock<std::shared_mutex> lock(m_data->m_tick_mutex);
+    TickBuffer* trans = m_data->m_transBuffer.get();
+    TickBuffer* time_line = m_data->m_timeLineBuffer.get();
+    HKU_IF_RETURN(!trans && !time_line, void());
+
+    Datetime day = spot.datetime.startOfDay();
+    Datetime minute = spot.datetime - (spot.datetime - day) % Minutes(1);
+    Data::SpotTickState& state = m_data->m_spotTickState;
+    if (!m_data->m_spotTickValid) {
+        // 首次更新（或缓存重新加载后），从缓存中同步当日已累计的成交量
+        state.day = day;
+        state.dayCount = 0.0;
+        state.lastPrice = Null<price_t>();
+        state.lastDirect = TransRecord::AUCTION;
+        state.minute = Null<Datetime>();
+        state.minuteBase = 0.0;
+
+        int64_t day_ticks = TickBuffer::toTicks(day);
+        TickBuffer* base = trans ? trans : time_line;
+        size_t pos = base->size();
+        while (pos > 0 && base->time(pos - 1) >= day_ticks) {
+            pos--;
+            state.dayCount += base->vol(pos);
+        }
+        if (pos < base->size()) {
+            state.lastPrice = base->price(base->size() - 1);
+            state.lastDirect = trans ? trans->direct(trans->size() - 1) : TransRecord::AUCTION;
+        }
+        m_data->m_spotTickValid = true;
+    }
+
+    if (state.day != day) {
+        state.day = day;
+        state.dayCount = 0.0;
+        state.lastPrice = Null<price_t>();
+        state.lastDirect = TransRecord::AUCTION;
+    }
+
+    int64_t ticks = TickBuffer::toTicks(spot.datetime);
+    price_t vol = spot.transCount - state.dayCount;
+    if (trans && vol > 0.0 && (trans->empty() || trans->time(trans->size() - 1) <= ticks)) {
+        // 价格上涨视为买盘，下跌视为卖盘，不变时沿用上一笔
+        int direct = state.lastDirect;
+        if (state.lastPrice == Null<price_t>()) {
+            direct = TransRecord::AUCTION;
+        } else if (spot.closePrice > state.lastPrice) {
+            direct = TransRecord::BUY;
+        } else if (spot.closePrice < state.lastPrice) {
+            direct = TransRecord::SELL;
+        }
+        trans->push_back(ticks, spot.closePrice, vol, direct);
+        state.lastDirect = direct;
+    }
+
+    if (time_line) {
+        if (state.minute != minute) {
+            int64_t minute_ticks = TickBuffer::toTicks(minute);
+            int64_t last_ticks = time_line->empty() ? Null<int64_t>()
+                                                    : time_line->time(time_line->size() - 1);
+            if (time_line->empty() || last_ticks < minute_ticks) {
+                state.minute = minute;
+                state.minuteBase = state.dayCount;
+                time_line->push_back(minute_ticks, spot.closePrice,
+                                     std::max(spot.transCount - state.minuteBase, 0.0));
+            } else if (last_ticks == minute_ticks) {
+                // 缓存中已有当前分钟（如盘中加载缓存后的首个行情），接续更新该分钟
+                state.minute = minute;
+                state.minuteBase = std::max(state.dayCount - time_line->vol(time_line->size() - 1),
+                                            0.0);
+                time_line->updateBack(spot.closePrice,
+                                      std::max(spot.transCount - state.minuteBase, 0.0));
+            }
+        } else {
+            time_line->updateBack(spot.closePrice,
+                                  std::max(spot.transCount - state.minuteBase, 0.0));
+        }
+    }
+
+    state.dayCount = std::max(state.dayCount, spot.transCount);
+    state.lastPrice = spot.closePrice;
+}
+
 Stock HKU_API getStock(const string& querystr) {
     const StockManager& sm = StockManager::instance();
     return sm.getStock(querystr);
@@ -10,10 +10,12 @@
 #define STOCK_H_
 
 #include <shared_mutex>
+#include <atomic>
 #include "StockWeight.h"
 #include "KQuery.h"
 #include "TimeLineRecord.h"
 #include "TransRecord.h"
+#include "TickBuffer.h"
 
 namespace hku {
 
@@ -34,6 +36,7 @@ class HKU_API Parameter;
  */
 class HKU_API Stock {
     friend class StockManager;
+    friend class KDataImp;
 
 private:
     static const string default_market;
@@ -73,6 +76,12 @@ public:
      */
     uint64_t id() const;
 
+    /**
+     * 获取证券在 StockManager 中的连续编号，可作为数组下标用于快速查找
+     * @note 仅对已加入 StockManager 的证券有效，否则返回 Null<uint32_t>()
+     */
+    uint32_t denseId() const;
+
     /** 获取所属市场简称，市场简称是市场的唯一标识 */
     const string& market() const;
 
@@ -127,6 +136,15 @@ public:
     StockWeightList getWeight(const Datetime& start = Datetime::min(),
                               const Datetime& end = Null<Datetime>()) const;
 
+    /**
+     * 获取指定时间段[start,end)内影响价格的复权因子
+     * @details 复权因子由全部权息信息计算后缓存，权息信息更新时重新计算
+     * @param start 起始日期
+     * @param end 结束日期
+     */
+    StockRecoverFactorList getRecoverFactor(const Datetime& start = Datetime::min(),
+                                            const Datetime& end = Null<Datetime>()) const;
+
     /** 获取不同类型K线数据量 */
     size_t getCount(KQuery::KType dataType = KQuery::DAY) const;
 
@@ -205,12 +223,65 @@ public:
     /** 指定类型的K线数据是否被缓存 */
     bool isBuffer(KQuery::KType) const;
 
+    /**
+     * 将最近的分笔数据加载至列式环形缓存，最大记录数由预加载参数 ticks_max 指定
+     * @note 缓存后 getTransList 在查询范围完全落在缓存内时从缓存中获取数据，否则仍从数据驱动
+     *       获取；实时行情将持续追加至缓存
+     */
+    void loadTransToBuffer();
+
+    /** 释放分笔数据缓存 */
+    void releaseTransBuffer();
+
+    /** 分笔数据是否被缓存 */
+    bool isTransBuffer() const;
+
+    /**
+     * 将最近的分时数据加载至列式环形缓存，最大记录数由预加载参数 timeline_max 指定
+     * @note 缓存后 getTimeLineList 在查询范围完全落在缓存内时从缓存中获取数据，否则仍从数据驱动
+     *       获取；实时行情将持续追加至缓存
+     */
+    void loadTimeLineToBuffer();
+
+    /** 释放分时数据缓存 */
+    void releaseTimeLineBuffer();
+
+    /** 分时数据是否被缓存 */
+    bool isTimeLineBuffer() const;
+
+    /**
+     * 从分时缓存中直接获取价格或成交量序列，避免构造 TimeLineList
+     * @param query 查询条件
+     * @param vol 为 true 时获取成交量，否则获取价格
+     * @param out [out] 查询结果
+     * @return 分时数据未被缓存或查询范围超出缓存时返回 false
+     */
+    bool getTimeLineFromBuffer(const KQuery& query, bool vol, PriceList& out) const;
+
     /** 是否为Null */
     bool isNull() const;
 
     /** （临时函数）只用于更新缓存中的日线数据 **/
     void realtimeUpdate(KRecord, KQuery::KType ktype = KQuery::DAY);
 
+    /**
+     * 根据实时行情更新指定类型的K线缓存
+     * @details 各K线类型分别维护当前K线的增量聚合状态，每次更新为常数时间，无需查询历史数据；
+     *          仅在K线缓存重新加载后的首次更新时，从缓存中同步一次聚合状态。K线时间与数据源及
+     *          K线合成一致 @see getResampleTime
+     * @param spot 实时行情，datetime 为行情时间，开高低收为当日价格，成交金额、成交量为当日累计值
+     * @param ktype K线类型，支持日线及以上、分钟级K线
+     */
+    void realtimeUpdateFromSpot(const KRecord& spot, KQuery::KType ktype);
+
+    /**
+     * 根据实时行情更新分笔、分时缓存，未缓存时忽略
+     * @details 分笔成交量为两次行情间的当日累计成交量之差，买卖盘性质由价格变动推断，
+     *          当日首笔视为集合竞价；分时以所在分钟的起始时刻为时间，同一分钟内更新最后一条记录
+     * @param spot 实时行情，datetime 为行情时间，收盘价为最新价，成交量为当日累计值
+     */
+    void realtimeUpdateTickFromSpot(const KRecord& spot);
+
     /** 仅用于python的__str__ */
     string toString() const;
 
@@ -224,6 +295,15 @@ private:
                                           KQuery::KType ktype) const;
     bool _getIndexRangeByDateFromBuffer(const KQuery&, size_t&, size_t&) const;
 
+    /** 清除日线以上复权数据缓存，权息信息或K线缓存变化时调用 */
+    void _clearRecoverKDataCache() const;
+
+    /** 数据驱动不支持、需由其他K线类型合成的K线类型，合成结果缓存于 pKData 中 */
+    bool _isResampleKType(const string& ktype) const;
+
+    /** 合成或增量更新指定类型的K线缓存，非合成K线类型时不做处理 */
+    void _prepareResampleKData(const KQuery::KType& ktype) const;
+
 private:
     struct HKU_API Data;
     shared_ptr<Data> m_data;
@@ -239,10 +319,25 @@ struct HKU_API Stock::Data {
     bool m_valid;          //当前证券是否有效
     Datetime m_startDate;  //证券起始日期
     Datetime m_lastDate;   //证券最后日期
+    uint32_t m_denseId;    //在 StockManager 中的连续编号
 
     StockWeightList m_weightList;  //权息信息列表
     std::mutex m_weight_mutex;
 
+    StockRecoverFactorList m_recoverFactorList;  //复权因子缓存，由 m_weight_mutex 保护
+    bool m_recoverFactorValid;                   //复权因子缓存是否与权息信息一致
+
+    /** 日线以上复权数据缓存，由复权后的日线数据合成 */
+    struct RecoverKDataCache {
+        Datetime start;        //合成所用日线数据的起始日期
+        Datetime end;          //合成所用日线数据的结束日期（不包含）
+        KRecordList records;   //复权后的K线数据
+    };
+
+    //日线以上复权数据缓存，键值为 K线类型_复权类型
+    unordered_map<string, RecoverKDataCache> m_recoverKDataCache;
+    std::mutex m_recover_cache_mutex;
+
     price_t m_tick;
     price_t m_tickValue;
     price_t m_unit;
@@ -253,6 +348,58 @@ struct HKU_API Stock::Data {
     unordered_map<string, KRecordList*> pKData;
     unordered_map<string, std::shared_mutex*> pMutex;
 
+    /** 合成K线的增量更新状态 */
+    struct ResampleState {
+        string base_ktype;        //基础K线类型
+        size_t base_count;        //已合成的基础K线数量
+        Datetime base_last;       //已合成的最后一条基础K线时间
+        size_t last_group_start;  //最后一根合成K线在基础K线中的起始位置
+        bool dirty;               //基础K线的最后一条记录已被更新
+    };
+
+    unordered_map<string, ResampleState> m_resampleState;  //键值为合成的K线类型
+    std::mutex m_resample_mutex;
+
+    //K线缓存版本号，任一K线缓存加载、释放或更新时递增
+    std::atomic<uint64_t> m_kdataVersion{1};
+
+    //各合成K线类型已同步的K线缓存版本号，与 m_kdataVersion 相等时无需加锁检查，
+    //仅在构造时创建键值
+    unordered_map<string, std::atomic<uint64_t>> m_resampleVersion;
+
+    /** 实时行情的K线增量聚合状态 */
+    struct SpotBarState {
+        Datetime bar;        //当前K线时间
+        Datetime day;        //最近一次更新的交易日
+        price_t open;        //当前K线开盘价
+        price_t high;        //当前K线最高价
+        price_t low;         //当前K线最低价
+        price_t baseAmount;  //日线以上为本周期此前交易日累计成交金额，分钟级为K线开始时当日累计
+        price_t baseCount;   //同上，成交量
+        price_t dayAmount;   //最近一次更新时的当日累计成交金额
+        price_t dayCount;    //最近一次更新时的当日累计成交量
+    };
+
+    unordered_map<string, SpotBarState> m_spotBarState;  //键值为K线类型
+    std::mutex m_spot_bar_mutex;
+
+    TickBufferPtr m_transBuffer;     //分笔数据缓存
+    TickBufferPtr m_timeLineBuffer;  //分时数据缓存
+
+    /** 实时行情的分笔、分时更新状态 */
+    struct SpotTickState {
+        Datetime day;        //最近一次更新的交易日
+        price_t dayCount;    //最近一次更新时的当日累计成交量
+        price_t lastPrice;   //最近一次更新时的价格
+        int lastDirect;      //最近一笔的买卖盘性质
+        Datetime minute;     //当前分时记录的时间
+        price_t minuteBase;  //当前分时记录开始时的当日累计成交量
+    };
+
+    bool m_spotTickValid;           //m_spotTickState 是否已与缓存同步
+    SpotTickState m_spotTickState;  //由 m_tick_mutex 保护
+    std::shared_mutex m_tick_mutex;
+
     Data();
     Data(const string& market, const string& code, const string& name, uint32_t type, bool valid,
          const Datetime& startDate, const Datetime& lastDate, price_t tick, price_t tickValue,
@@ -289,6 +436,10 @@ inline uint64_t Stock::id() const {
     return isNull() ? 0 : (int64_t)m_data.get();
 }
 
+inline uint32_t Stock::denseId() const {
+    return isNull() ? Null<uint32_t>() : m_data->m_denseId;
+}
+
 inline bool Stock::operator==(const Stock& stock) const {
     return (*this != stock) ? false : true;
 }
@@ -11,16 +11,16 @@
 
 #include "GlobalInitializer.h"
 #include <chrono>
+#include <unordered_set>
 #include <fmt/format.h>
 #include <boost/lexical_cast.hpp>
 #include <boost/algorithm/string.hpp>
 
 #include "utilities/IniParser.h"
 #include "utilities/util.h"
-#include "utilities/thread/ThreadPool.h"
 #include "StockManager.h"
-#include "global/GlobalTaskGroup.h"
 #include "global/schedule/inner_tasks.h"
+#include "data_driver/HistoryFinanceReader.h"
 #include "data_driver/kdata/cvs/KDataTempCsvDriver.h"
 #include "data_driver/base_info/sqlite/SQLiteBaseInfoDriver.h"
 #include "data_driver/base_info/mysql/MySQLBaseInfoDriver.h"
@@ -41,7 +41,7 @@ void StockManager::quit() {
 }
 
 StockManager::StockManager() : m_initializing(false) {
-    m_stockDict_mutex = new std::mutex;
+    m_stockDict_mutex = new std::shared_mutex;
     m_marketInfoDict_mutex = new std::mutex;
     m_stockTypeInfo_mutex = new std::mutex;
     m_holidays_mutex = new std::mutex;
@@ -76,6 +76,7 @@ Parameter default_preload_param() {
     param.set<bool>("min30", false);
     param.set<bool>("min60", false);
     param.set<bool>("ticks", false);
+    param.set<bool>("timeline", false);
     param.set<int>("day_max", 100000);
     param.set<int>("week_max", 100000);
     param.set<int>("month_max", 100000);
@@ -88,6 +89,9 @@ Parameter default_preload_param() {
     param.set<int>("min30_max", 5120);
     param.set<int>("min60_max", 5120);
     param.set<int>("ticks_max", 5120);
+    param.set<int>("timeline_max", 5120);
+    param.set<int>("memory_limit", 0);
+    param.set<int>("io_concurrency", 0);
     return param;
 }
 
@@ -104,6 +108,7 @@ void StockManager::init(const Parameter& baseInfoParam, const Parameter& blockPa
     HKU_WARN_IF_RETURN(m_initializing, void(),
                        "The last initialization has not finished. Please try again later!");
     m_initializing = true;
+    stopPreload();  // 上一次的预加载仍在进行时，需先结束，避免与重新初始化冲突
     m_thread_id = std::this_thread::get_id();
     m_baseInfoDriverParam = baseInfoParam;
     m_blockDriverParam = blockParam;
@@ -116,7 +121,11 @@ void StockManager::init(const Parameter& baseInfoParam, const Parameter& blockPa
     m_tmpdir = hikyuuParam.tryGet<string>("tmpdir", ".");
     m_datadir = hikyuuParam.tryGet<string>("datadir", ".");
 
-    m_stockDict.clear();
+    {
+        std::unique_lock<std::shared_mutex> lock(*m_stockDict_mutex);
+        m_stockDict.clear();
+        m_stockList.clear();
+    }
     m_marketInfoDict.clear();
     m_stockTypeInfo.clear();
 
@@ -158,104 +167,55 @@ void StockManager::setKDataDriver(const KDataDriverConnectPoolPtr& driver) {
         m_kdataDriverParam = driver->getPrototype()->getParameter();
     }
 
-    bool preload_day = m_preloadParam.tryGet<bool>("day", false);
-    HKU_INFO_IF(preload_day, "Preloading all day kdata to buffer!");
-
-    bool preload_week = m_preloadParam.tryGet<bool>("week", false);
-    HKU_INFO_IF(preload_week, "Preloading all week kdata to buffer!");
-
-    bool preload_month = m_preloadParam.tryGet<bool>("month", false);
-    HKU_INFO_IF(preload_month, "Preloading all month kdata to buffer!");
-
-    bool preload_quarter = m_preloadParam.tryGet<bool>("quarter", false);
-    HKU_INFO_IF(preload_quarter, "Preloading all quarter kdata to buffer!");
-
-    bool preload_halfyear = m_preloadParam.tryGet<bool>("halfyear", false);
-    HKU_INFO_IF(preload_halfyear, "Preloading all halfyear kdata to buffer!");
-
-    bool preload_year = m_preloadParam.tryGet<bool>("year", false);
-    HKU_INFO_IF(preload_year, "Preloading all year kdata to buffer!");
-
-    bool preload_min = m_preloadParam.tryGet<bool>("min", false);
-    HKU_INFO_IF(preload_min, "Preloading all 1 min kdata to buffer!");
-
-    bool preload_min5 = m_preloadParam.tryGet<bool>("min5", false);
-    HKU_INFO_IF(preload_min5, "Preloading all 5 min kdata to buffer!");
-
-    bool preload_min15 = m_preloadParam.tryGet<bool>("min15", false);
-    HKU_INFO_IF(preload_min15, "Preloading all 15 min kdata to buffer!");
+    static const vector<string> preload_types{
+      KQuery::DAY,  KQuery::WEEK, KQuery::MONTH, KQuery::QUARTER, KQuery::HALFYEAR,
+      KQuery::YEAR, KQuery::MIN,  KQuery::MIN5,  KQuery::MIN15,   KQuery::MIN30,
+      KQuery::MIN60};
+    vector<string> ktype_list;
+    for (const auto& ktype : preload_types) {
+        string name(ktype);
+        to_lower(name);
+        if (m_preloadParam.tryGet<bool>(name, false)) {
+            HKU_INFO("Preloading all {} kdata to buffer!", name);
+            ktype_list.push_back(ktype);
+        }
+    }
 
-    bool preload_min30 = m_preloadParam.tryGet<bool>("min30", false);
-    HKU_INFO_IF(preload_min30, "Preloading all 30 min kdata to buffer!");
+    bool preload_ticks = m_preloadParam.tryGet<bool>("ticks", false);
+    HKU_INFO_IF(preload_ticks, "Preloading all trans data to buffer!");
+    if (preload_ticks) {
+        ktype_list.push_back(PreloadScheduler::TICKS);
+    }
 
-    bool preload_min60 = m_preloadParam.tryGet<bool>("min60", false);
-    HKU_INFO_IF(preload_min60, "Preloading all 60 min kdata to buffer!");
+    bool preload_timeline = m_preloadParam.tryGet<bool>("timeline", false);
+    HKU_INFO_IF(preload_timeline, "Preloading all timeline data to buffer!");
+    if (preload_timeline) {
+        ktype_list.push_back(PreloadScheduler::TIMELINE);
+    }
 
-    if (!driver->getPrototype()->canParallelLoad()) {
-        for (auto iter = m_stockDict.begin(); iter != m_stockDict.end(); ++iter) {
-            if (iter->second.market() == "TMP")
-                continue;
-            iter->second.setKDataDriver(driver);
-            if (preload_day)
-                iter->second.loadKDataToBuffer(KQuery::DAY);
-            if (preload_week)
-                iter->second.loadKDataToBuffer(KQuery::WEEK);
-            if (preload_month)
-                iter->second.loadKDataToBuffer(KQuery::MONTH);
-            if (preload_quarter)
-                iter->second.loadKDataToBuffer(KQuery::QUARTER);
-            if (preload_halfyear)
-                iter->second.loadKDataToBuffer(KQuery::HALFYEAR);
-            if (preload_year)
-                iter->second.loadKDataToBuffer(KQuery::YEAR);
-            if (preload_min)
-                iter->second.loadKDataToBuffer(KQuery::MIN);
-            if (preload_min5)
-                iter->second.loadKDataToBuffer(KQuery::MIN5);
-            if (preload_min15)
-                iter->second.loadKDataToBuffer(KQuery::MIN15);
-            if (preload_min30)
-                iter->second.loadKDataToBuffer(KQuery::MIN30);
-            if (preload_min60)
-                iter->second.loadKDataToBuffer(KQuery::MIN60);
+    // 按优先级调度，支持并行加载时异步执行，不阻塞初始化
+    auto scheduler = makePreloadScheduler();
+    for (auto iter = m_stockDict.begin(); iter != m_stockDict.end(); ++iter) {
+        if (iter->second.market() == "TMP")
+            continue;
+        iter->second.setKDataDriver(driver);
+        for (const auto& ktype : ktype_list) {
+            scheduler->add(iter->second, ktype);
         }
+    }
 
+    m_preloadScheduler = scheduler;
+    if (driver->getPrototype()->canParallelLoad()) {
+        scheduler->start();
     } else {
-        // 异步并行加载
-        auto& tg = *getGlobalTaskGroup();
-        for (auto iter = m_stockDict.begin(); iter != m_stockDict.end(); ++iter) {
-            if (iter->second.market() == "TMP")
-                continue;
-            iter->second.setKDataDriver(driver);
-            if (preload_day)
-                tg.submit([=]() mutable { iter->second.loadKDataToBuffer(KQuery::DAY); });
-            if (preload_week)
-                tg.submit([=]() mutable { iter->second.loadKDataToBuffer(KQuery::WEEK); });
-            if (preload_month)
-                tg.submit([=]() mutable { iter->second.loadKDataToBuffer(KQuery::MONTH); });
-            if (preload_quarter)
-                tg.submit([=]() mutable { iter->second.loadKDataToBuffer(KQuery::QUARTER); });
-            if (preload_halfyear)
-                tg.submit([=]() mutable { iter->second.loadKDataToBuffer(KQuery::HALFYEAR); });
-            if (preload_year)
-                tg.submit([=]() mutable { iter->second.loadKDataToBuffer(KQuery::YEAR); });
-            if (preload_min)
-                tg.submit([=]() mutable { iter->second.loadKDataToBuffer(KQuery::MIN); });
-            if (preload_min5)
-                tg.submit([=]() mutable { iter->second.loadKDataToBuffer(KQuery::MIN5); });
-            if (preload_min15)
-                tg.submit([=]() mutable { iter->second.loadKDataToBuffer(KQuery::MIN15); });
-            if (preload_min30)
-                tg.submit([=]() mutable { iter->second.loadKDataToBuffer(KQuery::MIN30); });
-            if (preload_min60)
-                tg.submit([=]() mutable { iter->second.loadKDataToBuffer(KQuery::MIN60); });
-        }
+        scheduler->run();
     }
 
     initInnerTasek();
 }
 
 void StockManager::reload() {
+    stopPreload();
     loadAllHolidays();
 
     loadAllMarketInfos();
@@ -264,12 +224,17 @@ void StockManager::reload() {
     loadAllStockWeights();
 
     HKU_INFO("start reload kdata to buffer");
+    auto scheduler = makePreloadScheduler();
     std::vector<Stock> can_not_parallel_stk_list;  // 记录不支持并行加载的Stock
+    std::unordered_set<KDataDriver*> invalidated;  // 已清除缓存的驱动
     {
-        auto* tg = getGlobalTaskGroup();
-        std::lock_guard<std::mutex> lock(*m_stockDict_mutex);
+        std::shared_lock<std::shared_mutex> lock(*m_stockDict_mutex);
         for (auto iter = m_stockDict.begin(); iter != m_stockDict.end(); ++iter) {
             auto driver = iter->second.getKDataDirver();
+            if (invalidated.insert(driver->getPrototype().get()).second) {
+                // 数据可能已更新，清除驱动缓存的元数据
+                driver->getPrototype()->invalidateCache();
+            }
             if (!driver->getPrototype()->canParallelLoad()) {
                 can_not_parallel_stk_list.push_back(iter->second);
                 continue;
@@ -278,14 +243,20 @@ void StockManager::reload() {
             auto& ktype_list = KQuery::getAllKType();
             for (auto& ktype : ktype_list) {
                 if (iter->second.isBuffer(ktype)) {
-                    tg->submit([=]() mutable {
-                        Stock& stk = iter->second;
-                        stk.loadKDataToBuffer(ktype);
-                    });
+                    scheduler->add(iter->second, ktype);
                 }
             }
+
+            if (iter->second.isTransBuffer()) {
+                scheduler->add(iter->second, PreloadScheduler::TICKS);
+            }
+            if (iter->second.isTimeLineBuffer()) {
+                scheduler->add(iter->second, PreloadScheduler::TIMELINE);
+            }
         }
     }
+    m_preloadScheduler = scheduler;
+    scheduler->start();
 
     for (auto& stk : can_not_parallel_stk_list) {
         auto& ktype_list = KQuery::getAllKType();
@@ -294,9 +265,30 @@ void StockManager::reload() {
                 stk.loadKDataToBuffer(ktype);
             }
         }
+        if (stk.isTransBuffer()) {
+            stk.loadTransToBuffer();
+        }
+        if (stk.isTimeLineBuffer()) {
+            stk.loadTimeLineToBuffer();
+        }
     }
 }
 
+void StockManager::stopPreload() {
+    HKU_IF_RETURN(!m_preloadScheduler, void());
+    m_preloadScheduler->cancel();
+    m_preloadScheduler->wait();
+}
+
+PreloadSchedulerPtr StockManager::makePreloadScheduler() const {
+    int memory_limit = m_preloadParam.tryGet<int>("memory_limit", 0);
+    HKU_WARN_IF(memory_limit < 0, "Invalid preload memory_limit param: {}", memory_limit);
+    int io_concurrency = m_preloadParam.tryGet<int>("io_concurrency", 0);
+    HKU_WARN_IF(io_concurrency < 0, "Invalid preload io_concurrency param: {}", io_concurrency);
+    return make_shared<PreloadScheduler>(memory_limit > 0 ? size_t(memory_limit) * 1024 * 1024 : 0,
+                                         io_concurrency > 0 ? size_t(io_concurrency) : 0);
+}
+
 string StockManager::tmpdir() const {
     return m_tmpdir;
 }
@@ -307,13 +299,45 @@ string StockManager::datadir() const {
 
 Stock StockManager::getStock(const string& querystr) const {
     Stock result;
+    // 查询串通常已为大写（如 Stock::market_code()），此时无需复制转换
+    bool has_lower = false;
+    for (auto c : querystr) {
+        if (c >= 'a' && c <= 'z') {
+            has_lower = true;
+            break;
+        }
+    }
+
+    std::shared_lock<std::shared_mutex> lock(*m_stockDict_mutex);
+    if (!has_lower) {
+        auto iter = m_stockDict.find(querystr);
+        return (iter != m_stockDict.end()) ? iter->second : result;
+    }
+
     string query_str = querystr;
     to_upper(query_str);
-    std::lock_guard<std::mutex> lock(*m_stockDict_mutex);
     auto iter = m_stockDict.find(query_str);
     return (iter != m_stockDict.end()) ? iter->second : result;
 }
 
+Stock StockManager::getStockByDenseId(uint32_t id) const {
+    std::shared_lock<std::shared_mutex> lock(*m_stockDict_mutex);
+    return id < m_stockList.size() ? m_stockList[id] : Null<Stock>();
+}
+
+size_t StockManager::denseIdCount() const {
+    std::shared_lock<std::shared_mutex> lock(*m_stockDict_mutex);
+    return m_stockList.size();
+}
+
+void StockManager::_addToStockDict(const string& market_code, const Stock& stock) {
+    m_stockDict[market_code] = stock;
+    if (stock.m_data) {
+        stock.m_data->m_denseId = uint32_t(m_stockList.size());
+        m_stockList.push_back(stock);
+    }
+}
+
 MarketInfo StockManager::getMarketInfo(const string& market) const {
     MarketInfo result;
     string market_tmp = market;
@@ -404,8 +428,14 @@ Stock StockManager::addTempCsvStock(const string& code, const string& day_filena
 void StockManager::removeTempCsvStock(const string& code) {
     string query_str = "TMP" + code;
     to_upper(query_str);
+    std::unique_lock<std::shared_mutex> lock(*m_stockDict_mutex);
     auto iter = m_stockDict.find(query_str);
     if (iter != m_stockDict.end()) {
+        // 连续编号不回收，仅将其对应位置置空
+        uint32_t id = iter->second.denseId();
+        if (id < m_stockList.size()) {
+            m_stockList[id] = Null<Stock>();
+        }
         m_stockDict.erase(iter);
     }
 }
@@ -413,10 +443,10 @@ void StockManager::removeTempCsvStock(const string& code) {
 bool StockManager::addStock(const Stock& stock) {
     string market_code(stock.market_code());
     to_upper(market_code);
-    std::lock_guard<std::mutex> lock(*m_stockDict_mutex);
+    std::unique_lock<std::shared_mutex> lock(*m_stockDict_mutex);
     HKU_ERROR_IF_RETURN(m_stockDict.find(market_code) != m_stockDict.end(), false,
                         "The stock had exist! {}", market_code);
-    m_stockDict[market_code] = stock;
+    _addToStockDict(market_code, stock);
     return true;
 }
 
@@ -445,7 +475,9 @@ void StockManager::loadAllStocks() {
         }
     }
 
-    std::lock_guard<std::mutex> lock(*m_stockDict_mutex);
+    std::unique_lock<std::shared_mutex> lock(*m_stockDict_mutex);
+    m_stockDict.reserve(m_stockDict.size() + stockInfos.size());
+    m_stockList.reserve(m_stockList.size() + stockInfos.size());
     for (auto& info : stockInfos) {
         Datetime startDate, endDate;
         try {
@@ -466,7 +498,7 @@ void StockManager::loadAllStocks() {
             Stock stock(info.market, info.code, info.name, info.type, info.valid, startDate,
                         endDate, info.tick, info.tickValue, info.precision, info.minTradeNumber,
                         info.maxTradeNumber);
-            m_stockDict[market_code] = stock;
+            _addToStockDict(market_code, stock);
 
         } else {
             Stock& stock = iter->second;
@@ -475,6 +507,8 @@ void StockManager::loadAllStocks() {
                   new Stock::Data(info.market, info.code, info.name, info.type, info.valid,
                                   startDate, endDate, info.tick, info.tickValue, info.precision,
                                   info.minTradeNumber, info.maxTradeNumber));
+                stock.m_data->m_denseId = uint32_t(m_stockList.size());
+                m_stockList.push_back(stock);
             } else {
                 stock.m_data->m_market = info.market;
                 stock.m_data->m_code = info.code;
@@ -523,25 +557,49 @@ void StockManager::loadAllHolidays() {
     m_holidays = std::move(holidays);
 }
 
+PriceList StockManager::getHistoryFinanceInfo(const Datetime& date,
+                                               const StockList& stocks) const {
+    size_t field_count = 0;
+    HistoryFinanceReader rd(datadir() + "/downloads/finance");
+    return rd.getHistoryFinanceInfo(date, stocks, field_count);
+}
+
 void StockManager::loadAllStockWeights() {
     HKU_INFO("Loading stock weight...");
-    ThreadPool tg;  // 这里不用全局的线程池，可以避免在初始化后立即reload导致过长的等待
-    std::vector<std::future<void>> task_list;
-    std::lock_guard<std::mutex> lock(*m_stockDict_mutex);
-    for (auto iter = m_stockDict.begin(); iter != m_stockDict.end(); ++iter) {
-        task_list.push_back(tg.submit([=]() mutable {
-            Stock& stock = iter->second;
-            StockWeightList weightList = m_baseInfoDriver->getStockWeightList(
-              stock.market(), stock.code(), Datetime::min(), Null<Datetime>());
-            if (stock.m_data) {
-                std::lock_guard<std::mutex> lock(stock.m_data->m_weight_mutex);
-                stock.m_data->m_weightList.swap(weightList);
-            }
-        }));
+    // 单次批量读取全部权息后按证券分发，避免逐个证券查询
+    unordered_map<string, StockWeightList> all_weights;
+    try {
+        all_weights = m_baseInfoDriver->getAllStockWeightList();
+    } catch (std::exception& e) {
+        HKU_ERROR("Failed load stock weight, keep the existing weights! {}", e.what());
+        return;
+    } catch (...) {
+        HKU_ERROR("Failed load stock weight, keep the existing weights! Unknown error!");
+        return;
     }
-    // 权息信息如果不等待加载完毕，在数据加载期间进行计算可能导致复权错误，所以这里需要等待
-    for (auto& task : task_list) {
-        task.get();
+
+    // 空结果通常意味着数据源异常，保留已有权息，避免清空全部证券的复权信息
+    HKU_ERROR_IF_RETURN(all_weights.empty(), void(),
+                        "No stock weight was loaded, keep the existing weights!");
+
+    // 权息信息如果不在此同步更新完毕，在数据加载期间进行计算可能导致复权错误
+    std::shared_lock<std::shared_mutex> lock(*m_stockDict_mutex);
+    for (auto iter = m_stockDict.begin(); iter != m_stockDict.end(); ++iter) {
+        Stock& stock = iter->second;
+        if (!stock.m_data) {
+            continue;
+        }
+        StockWeightList weightList;
+        auto weight_iter = all_weights.find(iter->first);
+        if (weight_iter != all_weights.end()) {
+            weightList.swap(weight_iter->second);
+        }
+        {
+            std::lock_guard<std::mutex> lock(stock.m_data->m_weight_mutex);
+            stock.m_data->m_weightList.swap(weightList);
+            stock.m_data->m_recoverFactorValid = false;
+        }
+        stock._clearRecoverKDataCache();
     }
 }
 
@@ -9,6 +9,7 @@
 #define STOCKMANAGER_H_
 
 #include <mutex>
+#include <shared_mutex>
 #include <thread>
 #include "utilities/Parameter.h"
 #include "data_driver/DataDriverFactory.h"
@@ -16,6 +17,7 @@
 #include "MarketInfo.h"
 #include "StockTypeInfo.h"
 #include "StrategyContext.h"
+#include "PreloadScheduler.h"
 
 namespace hku {
 
@@ -75,6 +77,18 @@ public:
     /** 获取基础信息驱动 */
     BaseInfoDriverPtr getBaseInfoDriver() const;
 
+    /**
+     * 获取当前的预加载调度器，可用于等待预加载完成、查询进度及证券的就绪状态
+     * @note 数据驱动支持并行加载时，init 及 reload 不等待预加载完成即返回
+     */
+    PreloadSchedulerPtr getPreloadScheduler() const;
+
+    /**
+     * 取消尚未开始的预加载任务，并等待已开始的任务结束
+     * @note 需在释放全局任务组前调用，程序退出时由 GlobalInitializer 负责
+     */
+    void stopPreload();
+
     /**
      * 获取用于保存零时变量等的临时目录，如为配置则为当前目录
      * 由m_config中的“tmpdir”指定
@@ -97,6 +111,16 @@ public:
     /** 同 getStock @see getStock */
     Stock operator[](const string&) const;
 
+    /**
+     * 根据证券的连续编号获取对应的证券实例
+     * @param id 连续编号 @see Stock::denseId
+     * @return 对应的证券实例，如果实例不存在或已被移除，则返回Null<Stock>()
+     */
+    Stock getStockByDenseId(uint32_t id) const;
+
+    /** 已分配的连续编号数量，所有证券的连续编号均小于该值，可用于预分配按编号索引的数组 */
+    size_t denseIdCount() const;
+
     /**
      * 获取相应的市场信息
      * @param market 指定的市场标识
@@ -138,6 +162,15 @@ public:
     //目前支持"SH"
     DatetimeList getTradingCalendar(const KQuery& query, const string& market = "SH");
 
+    /**
+     * 批量获取指定报告期多只证券的历史财务信息，用于截面筛选
+     * @param date 报告期，必须是 0331、0630、0930、1231
+     * @param stocks 证券列表
+     * @return 按行存放的 stocks.size() × 字段数 矩阵，不存在的证券整行为 Null<price_t>()；
+     *         报告期文件不存在时返回空列表
+     */
+    PriceList getHistoryFinanceInfo(const Datetime& date, const StockList& stocks) const;
+
     /**
      * 判断指定日期是否为节假日
      * @param d 指定日期
@@ -210,6 +243,12 @@ private:
     /* 加载所有权息数据 */
     void loadAllStockWeights();
 
+    /* 将证券加入证券表并分配连续编号，需在持有 m_stockDict_mutex 写锁时调用 */
+    void _addToStockDict(const string& market_code, const Stock& stock);
+
+    /* 根据预加载参数 memory_limit（MB）、io_concurrency 创建预加载调度器 */
+    PreloadSchedulerPtr makePreloadScheduler() const;
+
 private:
     StockManager();
 
@@ -223,7 +262,8 @@ private:
     BlockInfoDriverPtr m_blockDriver;
 
     StockMapIterator::stock_map_t m_stockDict;  // SH000001 -> stock
-    std::mutex* m_stockDict_mutex;
+    StockList m_stockList;                      // 连续编号 -> stock，已移除的证券为 Null<Stock>()
+    std::shared_mutex* m_stockDict_mutex;       // 读多写少，查询时仅持有读锁
 
     typedef unordered_map<string, MarketInfo> MarketInfoMap;
     mutable MarketInfoMap m_marketInfoDict;
@@ -242,6 +282,8 @@ private:
     Parameter m_preloadParam;
     Parameter m_hikyuuParam;
     StrategyContext m_context;
+
+    PreloadSchedulerPtr m_preloadScheduler;
 };
 
 inline size_t StockManager::size() const {
@@ -284,6 +326,10 @@ inline BaseInfoDriverPtr StockManager::getBaseInfoDriver() const {
     return m_baseInfoDriver;
 }
 
+inline PreloadSchedulerPtr StockManager::getPreloadScheduler() const {
+    return m_preloadScheduler;
+}
+
 }  // namespace hku
 
 #endif /* STOCKMANAGER_H_ */
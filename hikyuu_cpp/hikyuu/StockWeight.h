@@ -82,6 +82,21 @@ private:
 /** @ingroup StockManage */
 typedef vector<StockWeight> StockWeightList;
 
+/**
+ * 复权因子，由影响价格的权息信息计算得到，供复权计算使用
+ * @details 前复权：复权后价格 = (复权前价格 + adjust) / denominator
+ *          后复权：复权后价格 = 复权前价格 * denominator - adjust
+ * @ingroup StockManage
+ */
+struct HKU_API StockRecoverFactor {
+    Datetime datetime;    ///< 权息日期
+    price_t denominator;  ///< 1 + 流通股份变动比例
+    price_t adjust;       ///< 配股价 × 流通股份变动比例 - 现金红利
+};
+
+/** @ingroup StockManage */
+typedef vector<StockRecoverFactor> StockRecoverFactorList;
+
 /**
  * 输出权息信息，如：Weight(datetime, countAsGift, countForSell,
  * priceForSell, bonus, increasement, totalCount, freeCount)
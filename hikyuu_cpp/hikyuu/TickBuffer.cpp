@@ -0,0 +1,163 @@
+/*
+ *  Copyright(C) 2026 hikyuu.org
+ *
+ *  Create on: 2026-10-18
+ *     Author: fasiondog
+ */
+
+#include "TickBuffer.h"
+
+namespace hku {
+
+TickBuffer::TickBuffer(size_t capacity)
+: m_capacity(capacity), m_head(0), m_size(0), m_truncated(false) {}
+
+void TickBuffer::clear() {
+    m_head = 0;
+    m_size = 0;
+    m_truncated = false;
+    m_time.clear();
+    m_price.clear();
+    m_vol.clear();
+    m_direct.clear();
+}
+
+void TickBuffer::push_back(int64_t time, price_t price, price_t vol, int direct) {
+    if (m_capacity == 0) {
+        m_truncated = true;
+        return;
+    }
+    if (m_size < m_capacity) {
+        m_time.push_back(time);
+        m_price.push_back(price);
+        m_vol.push_back(vol);
+        m_direct.push_back(int8_t(direct));
+        m_size++;
+        return;
+    }
+
+    // 已满，覆盖最早的记录
+    m_truncated = true;
+    m_time[m_head] = time;
+    m_price[m_head] = price;
+    m_vol[m_head] = vol;
+    m_direct[m_head] = int8_t(direct);
+    m_head = m_head + 1 == m_capacity ? 0 : m_head + 1;
+}
+
+void TickBuffer::updateBack(price_t price, price_t vol) {
+    HKU_IF_RETURN(m_size == 0, void());
+    size_t i = _index(m_size - 1);
+    m_price[i] = price;
+    m_vol[i] = vol;
+}
+
+size_t TickBuffer::_lowerBound(int64_t time) const {
+    size_t low = 0, high = m_size;
+    while (low < high) {
+        size_t mid = low + (high - low) / 2;
+        if (m_time[_index(mid)] < time) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    return low;
+}
+
+bool TickBuffer::getIndexRange(const KQuery& query, size_t& out_start, size_t& out_end) const {
+    out_start = 0;
+    out_end = 0;
+    HKU_IF_RETURN(m_size == 0, false);
+
+    if (query.queryType() == KQuery::INDEX) {
+        int64_t total = int64_t(m_size);
+        int64_t start = query.start();
+        int64_t end = query.end();
+        if (start < 0) {
+            start = std::max(start + total, int64_t(0));
+        }
+        if (end < 0) {
+            end = std::max(end + total, int64_t(0));
+        }
+        HKU_IF_RETURN(start >= end || start >= total, false);
+        out_start = size_t(start);
+        out_end = end > total ? m_size : size_t(end);
+        return true;
+    }
+
+    Datetime start_date = query.startDatetime();
+    Datetime end_date = query.endDatetime();
+    HKU_IF_RETURN(!start_date.isNull() && !end_date.isNull() && start_date >= end_date, false);
+    out_start = start_date.isNull() ? 0 : _lowerBound(toTicks(start_date));
+    out_end = end_date.isNull() ? m_size : _lowerBound(toTicks(end_date));
+    if (out_start >= out_end) {
+        out_start = 0;
+        out_end = 0;
+        return false;
+    }
+    return true;
+}
+
+bool TickBuffer::covers(const KQuery& query) const {
+    HKU_IF_RETURN(!m_truncated, true);
+    HKU_IF_RETURN(m_size == 0, false);
+
+    if (query.queryType() == KQuery::INDEX) {
+        // 正数索引自全部历史记录的起点计数，缓存截断后无法对应
+        int64_t start = query.start();
+        int64_t end = query.end();
+        return start < 0 && -start <= int64_t(m_size) && (end < 0 || end == Null<int64_t>());
+    }
+
+    // 与最早记录时间相同的记录可能已被覆盖，起始时间须严格晚于最早的记录
+    Datetime start_date = query.startDatetime();
+    return !start_date.isNull() && toTicks(start_date) > m_time[m_head];
+}
+
+TimeLineList TickBuffer::getTimeLineList(size_t start, size_t end) const {
+    TimeLineList result;
+    end = std::min(end, m_size);
+    HKU_IF_RETURN(start >= end, result);
+    result.reserve(end - start);
+    for (size_t pos = start; pos < end; pos++) {
+        size_t i = _index(pos);
+        result.emplace_back(fromTicks(m_time[i]), m_price[i], m_vol[i]);
+    }
+    return result;
+}
+
+TransList TickBuffer::getTransList(size_t start, size_t end) const {
+    TransList result;
+    end = std::min(end, m_size);
+    HKU_IF_RETURN(start >= end, result);
+    result.reserve(end - start);
+    for (size_t pos = start; pos < end; pos++) {
+        size_t i = _index(pos);
+        result.emplace_back(fromTicks(m_time[i]), m_price[i], m_vol[i],
+                            TransRecord::DIRECT(m_direct[i]));
+    }
+    return result;
+}
+
+template <typename Column>
+void TickBuffer::_copy(const Column& column, size_t start, size_t end, price_t* out) const {
+    end = std::min(end, m_size);
+    HKU_IF_RETURN(start >= end, void());
+    // 环形缓存至多分为两段连续内存
+    size_t first = _index(start);
+    size_t count = end - start;
+    size_t head_count = std::min(count, m_capacity - first);
+    std::copy(column.begin() + first, column.begin() + first + head_count, out);
+    std::copy(column.begin(), column.begin() + (count - head_count), out + head_count);
+}
+
+void TickBuffer::copyPrice(size_t start, size_t end, price_t* out) const {
+    _copy(m_price, start, end, out);
+}
+
+void TickBuffer::copyVol(size_t start, size_t end, price_t* out) const {
+    _copy(m_vol, start, end, out);
+}
+
+} /* namespace hku */
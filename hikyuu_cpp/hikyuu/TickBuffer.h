@@ -0,0 +1,160 @@
+/*
+ *  Copyright(C) 2026 hikyuu.org
+ *
+ *  Create on: 2026-10-18
+ *     Author: fasiondog
+ */
+
+#pragma once
+#ifndef TICKBUFFER_H_
+#define TICKBUFFER_H_
+
+#include "KQuery.h"
+#include "TimeLineRecord.h"
+#include "TransRecord.h"
+
+namespace hku {
+
+/**
+ * 分时、分笔数据的列式环形缓存
+ * @details 时间（距 Datetime::min() 的微秒数）、价格、成交量、买卖盘性质分列存放，容量固定，
+ *          写满后覆盖最早的记录。位置 0 为缓存中最早的记录，时间须按非递减顺序加入。
+ *          缓存之前可能还有未加载或已被覆盖的更早记录（truncated），此时仅能响应
+ *          完全落在缓存范围内的查询 @see covers
+ * @note 非线程安全，由调用方加锁保护
+ * @ingroup StockManage
+ */
+class HKU_API TickBuffer {
+public:
+    /**
+     * 构造函数
+     * @param capacity 最大记录数
+     */
+    explicit TickBuffer(size_t capacity);
+
+    /** 最大记录数 */
+    size_t capacity() const {
+        return m_capacity;
+    }
+
+    /** 记录数 */
+    size_t size() const {
+        return m_size;
+    }
+
+    /** 是否为空 */
+    bool empty() const {
+        return m_size == 0;
+    }
+
+    /** 清除全部记录 */
+    void clear();
+
+    /** 缓存之前是否还有未加载或已被覆盖的更早记录 */
+    bool truncated() const {
+        return m_truncated;
+    }
+
+    /** 设置缓存之前是否还有更早的记录，如从数据源加载时已达到最大记录数 */
+    void setTruncated(bool truncated) {
+        m_truncated = truncated;
+    }
+
+    /**
+     * 查询结果是否完全落在缓存范围内，即与直接从数据源查询的结果一致
+     * @details 缓存未截断时总是返回 true；否则仅按时间查询且起始时间晚于缓存中最早的记录，
+     *          或按索引查询且起止索引均从末尾起算并不超出缓存记录数时返回 true
+     */
+    bool covers(const KQuery& query) const;
+
+    /**
+     * 追加记录，已满时覆盖最早的记录
+     * @param time 时间（微秒） @see toTicks
+     * @param price 价格
+     * @param vol 成交量
+     * @param direct 买卖盘性质 @see TransRecord::DIRECT，分时数据忽略
+     */
+    void push_back(int64_t time, price_t price, price_t vol, int direct = 0);
+
+    /** 修改最后一条记录的价格与成交量，缓存为空时忽略 */
+    void updateBack(price_t price, price_t vol);
+
+    /** 指定位置的时间（微秒），未作越界检查 */
+    int64_t time(size_t pos) const {
+        return m_time[_index(pos)];
+    }
+
+    /** 指定位置的价格，未作越界检查 */
+    price_t price(size_t pos) const {
+        return m_price[_index(pos)];
+    }
+
+    /** 指定位置的成交量，未作越界检查 */
+    price_t vol(size_t pos) const {
+        return m_vol[_index(pos)];
+    }
+
+    /** 指定位置的买卖盘性质，未作越界检查 */
+    int direct(size_t pos) const {
+        return m_direct[_index(pos)];
+    }
+
+    /**
+     * 根据查询条件获取对应的记录位置范围，按索引查询时支持负数（从末尾起算）
+     * @param query 查询条件，忽略K线类型
+     * @param out_start [out] 起始位置
+     * @param out_end [out] 结束位置，不包含自身
+     * @return 范围为空时返回 false
+     */
+    bool getIndexRange(const KQuery& query, size_t& out_start, size_t& out_end) const;
+
+    /** 获取 [start, end) 范围内的分时记录 */
+    TimeLineList getTimeLineList(size_t start, size_t end) const;
+
+    /** 获取 [start, end) 范围内的分笔记录 */
+    TransList getTransList(size_t start, size_t end) const;
+
+    /** 将 [start, end) 范围内的价格复制至 out */
+    void copyPrice(size_t start, size_t end, price_t* out) const;
+
+    /** 将 [start, end) 范围内的成交量复制至 out */
+    void copyVol(size_t start, size_t end, price_t* out) const;
+
+    /** 日期转换为缓存中的时间（距 Datetime::min() 的微秒数） */
+    static int64_t toTicks(const Datetime& datetime) {
+        return (datetime - Datetime::min()).ticks();
+    }
+
+    /** 缓存中的时间转换为日期 */
+    static Datetime fromTicks(int64_t ticks) {
+        return Datetime::min() + TimeDelta::fromTicks(ticks);
+    }
+
+private:
+    size_t _index(size_t pos) const {
+        size_t i = m_head + pos;
+        return i >= m_capacity ? i - m_capacity : i;
+    }
+
+    /** 第一个时间不小于 time 的位置 */
+    size_t _lowerBound(int64_t time) const;
+
+    template <typename Column>
+    void _copy(const Column& column, size_t start, size_t end, price_t* out) const;
+
+private:
+    size_t m_capacity;
+    size_t m_head;  // 最早的记录所在的下标
+    size_t m_size;
+    bool m_truncated;  // 缓存之前是否还有更早的记录
+    vector<int64_t> m_time;
+    vector<price_t> m_price;
+    vector<price_t> m_vol;
+    vector<int8_t> m_direct;
+};
+
+typedef shared_ptr<TickBuffer> TickBufferPtr;
+
+} /* namespace hku */
+
+#endif /* TICKBUFFER_H_ */
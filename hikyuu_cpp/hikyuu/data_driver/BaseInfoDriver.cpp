@@ -71,4 +71,66 @@ StockWeightList BaseInfoDriver::getStockWeightList(const string& market, const s
     return StockWeightList();
 }
 
+unordered_map<string, StockWeightList> BaseInfoDriver::getAllStockWeightList() {
+    unordered_map<string, StockWeightList> result;
+    auto stock_info_list = getAllStockInfo();
+    for (auto& info : stock_info_list) {
+        StockWeightList weight_list =
+          getStockWeightList(info.market, info.code, Datetime::min(), Null<Datetime>());
+        if (!weight_list.empty()) {
+            string market_code = info.market + info.code;
+            to_upper(market_code);
+            result[market_code].swap(weight_list);
+        }
+    }
+    return result;
+}
+
+unordered_map<string, StockWeightList> BaseInfoDriver::_loadAllStockWeightList(
+  DBConnectBase& con) {
+    unordered_map<string, StockWeightList> result;
+
+    // 单次查询按证券、日期顺序读取全部权息，逐行转换，无需先载入中间表
+    SQLStatementPtr st = con.getStatement(
+      "select a.stockid, c.market, b.code, a.date, a.countAsGift, a.countForSell, "
+      "a.priceForSell, a.bonus, a.countOfIncreasement, a.totalCount, a.freeCount from "
+      "stkWeight a, stock b, market c where a.stockid=b.stockid and b.marketid=c.marketid "
+      "order by a.stockid, a.date");
+    st->exec();
+
+    uint64_t last_stockid = Null<uint64_t>();
+    StockWeightList* weight_list = nullptr;
+    uint64_t stockid = 0, date = 0;
+    double countAsGift = 0.0, countForSell = 0.0, priceForSell = 0.0, bonus = 0.0;
+    double countOfIncreasement = 0.0, totalCount = 0.0, freeCount = 0.0;
+    string market, code;
+    while (st->moveNext()) {
+        st->getColumn(0, stockid);
+        if (stockid != last_stockid) {
+            st->getColumn(1, market, code);
+            string market_code = market + code;
+            to_upper(market_code);
+            weight_list = &result[market_code];
+            last_stockid = stockid;
+        }
+
+        st->getColumn(3, date, countAsGift, countForSell, priceForSell, bonus,
+                      countOfIncreasement, totalCount, freeCount);
+        try {
+            weight_list->push_back(StockWeight(Datetime(date * 10000), countAsGift * 0.0001,
+                                               countForSell * 0.0001, priceForSell * 0.001,
+                                               bonus * 0.001, countOfIncreasement * 0.0001,
+                                               totalCount, freeCount));
+        } catch (std::out_of_range& e) {
+            HKU_WARN("Date of stockid({}) is invalid! {}", stockid, e.what());
+        } catch (std::exception& e) {
+            HKU_WARN("Error StockWeight Record stockid({}) {}", stockid, e.what());
+        } catch (...) {
+            HKU_WARN("Error StockWeight Record stockid({})! Unknown reason!", stockid);
+        }
+    }
+
+    return result;
+}
+
 } /* namespace hku */
@@ -14,7 +14,7 @@
 #include "../MarketInfo.h"
 #include "../StockTypeInfo.h"
 #include "../Stock.h"
-#include "../utilities/db_connect/SQLStatementBase.h"
+#include "../utilities/db_connect/DBConnectBase.h"
 
 namespace hku {
 
@@ -111,6 +111,14 @@ public:
     virtual StockWeightList getStockWeightList(const string& market, const string& code,
                                                Datetime start, Datetime end);
 
+    /**
+     * 一次性获取全部证券的权息列表
+     * @note 默认实现为逐个证券调用 getStockWeightList，子类应尽量以单次查询批量读取
+     * @return 市场简称证券代码（大写）-> 按日期升序排列的权息列表，无权息记录的证券可不包含
+     * @exception 读取失败时子类应抛出异常，而非返回空结果，以免调用者误清空已有权息
+     */
+    virtual unordered_map<string, StockWeightList> getAllStockWeightList();
+
     /**
      * 获取当前财务信息
      * @param market 市场标识
@@ -150,6 +158,14 @@ public:
 private:
     bool checkType();
 
+protected:
+    /**
+     * 以单次查询从 stkWeight 表读取全部证券的权息，供基于数据库连接的子类共用
+     * @param con 数据库连接
+     * @exception 查询失败时抛出异常
+     */
+    static unordered_map<string, StockWeightList> _loadAllStockWeightList(DBConnectBase& con);
+
 protected:
     string m_name;
 };
@@ -77,6 +77,11 @@ public:
         return m_prototype;
     }
 
+    /** 允许的最大连接数，为 0 表示不限制 */
+    size_t maxConnect() const {
+        return m_maxSize;
+    }
+
     /** 当前活动的连接数 */
     size_t count() const {
         return m_count;
@@ -7,92 +7,168 @@
  *      Author: fasiondog
  */
 
-#include <stdio.h>
+#include <cstring>
+#include <list>
+#include <mutex>
+#include <boost/filesystem.hpp>
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
 #include <boost/lexical_cast.hpp>
 #include "HistoryFinanceReader.h"
 
 namespace hku {
 
-HistoryFinanceReader::HistoryFinanceReader(const string& dir) : m_dir(dir) {}
-
-HistoryFinanceReader::~HistoryFinanceReader() {}
+namespace {
 
-PriceList HistoryFinanceReader ::getHistoryFinanceInfo(Datetime date, const string& market,
-                                                       const string& code) {
-    PriceList result;
+/*
+ * 内存映射的报告期文件
+ * 文件头 20 字节（2~6 报告日期，6~8 证券数量，12~16 单条记录字节数），随后为每只证券 11 字节的
+ * 索引项（7 字节代码，4 字节记录偏移），记录为连续的 float 字段
+ */
+class HistoryFinanceFile {
+public:
+    HistoryFinanceFile(const string& filename, std::time_t mtime, uintmax_t size)
+    : m_mtime(mtime), m_size(size), m_field_count(0) {
+        using namespace boost::interprocess;
+        m_mapping = file_mapping(filename.c_str(), read_only);
+        m_region = mapped_region(m_mapping, read_only);
+        const char* data = static_cast<const char*>(m_region.get_address());
+        size_t file_size = m_region.get_size();
+        HKU_CHECK(file_size >= 20, "read data failed! {}", filename);
+
+        unsigned short max_count = 0;
+        uint32_t report_size = 0;
+        memcpy(&max_count, data + 6, 2);
+        memcpy(&report_size, data + 12, 4);
+
+        const size_t MAX_COL_NUM = 350;
+        m_field_count = report_size / 4;
+        if (m_field_count >= MAX_COL_NUM) {
+            HKU_WARN("Over MAX_COL_NUM! {}", filename);
+            m_field_count = MAX_COL_NUM;
+        }
 
-    string filename(m_dir + "/gpcw" + boost::lexical_cast<string>(date.number() / 10000) + ".dat");
-    FILE* fp = fopen(filename.c_str(), "rb");
-    HKU_INFO_IF_RETURN(NULL == fp, result, "Can't found {}", filename);
+        HKU_CHECK(20 + size_t(max_count) * 11 <= file_size, "read stock_code failed! {}",
+                  filename);
+        m_address.reserve(max_count);
+        const char* item = data + 20;
+        for (unsigned short i = 0; i < max_count; i++, item += 11) {
+            uint32_t address = 0;
+            memcpy(&address, item + 7, 4);
+            if (address != 0 && address + m_field_count * 4 <= file_size) {
+                // 代码重复时与原先顺序查找一致，以第一个为准
+                m_address.emplace(string(item, strnlen(item, 6)), address);
+            }
+        }
+    }
 
-    unsigned int report_date = 0;
-    unsigned short max_count = 0;
-    unsigned long report_size = 0;
+    bool isValid(std::time_t mtime, uintmax_t size) const {
+        return m_mtime == mtime && m_size == size;
+    }
 
-    char header_buf[20];
-    if (!fread(header_buf, 1, 20, fp)) {
-        HKU_ERROR("read data failed! {}", filename);
-        fclose(fp);
-        return result;
+    size_t fieldCount() const {
+        return m_field_count;
     }
 
-    memcpy(&report_date, header_buf + 2, 4);
-    memcpy(&max_count, header_buf + 6, 2);
-    memcpy(&report_size, header_buf + 12, 4);
-
-    char stock_code[7];
-    uint32_t address = 0;
-    for (int i = 0; i < max_count; i++) {
-        if (!fread(stock_code, 1, 7, fp)) {
-            HKU_ERROR("read stock_code failed! {}", filename);
-            fclose(fp);
-            return result;
+    /* 读取指定证券的记录，追加至 out，证券不存在时返回 false */
+    bool read(const string& code, PriceList& out) const {
+        auto iter = m_address.find(code);
+        HKU_IF_RETURN(iter == m_address.end(), false);
+        const char* record = static_cast<const char*>(m_region.get_address()) + iter->second;
+        price_t null_price = Null<price_t>();
+        float value = 0.0f;
+        for (size_t i = 0; i < m_field_count; i++) {
+            memcpy(&value, record + i * 4, 4);
+            out.push_back(value == 0xf8f8f8f8 ? null_price : value);
         }
+        return true;
+    }
 
-        if (!fread(&address, 4, 1, fp)) {
-            HKU_ERROR("read stock_item address failed! {}", filename);
-            fclose(fp);
-            return result;
+private:
+    std::time_t m_mtime;
+    uintmax_t m_size;
+    size_t m_field_count;
+    boost::interprocess::file_mapping m_mapping;
+    boost::interprocess::mapped_region m_region;
+    unordered_map<string, uint32_t> m_address;  // 证券代码 -> 记录偏移
+};
+
+typedef shared_ptr<const HistoryFinanceFile> HistoryFinanceFilePtr;
+
+// 最多保留的已映射报告期文件数，超出时释放最久未访问的文件
+// 正在读取中的文件由读取方持有，释放缓存后待读取结束时才解除映射
+const size_t g_max_cached_files = 8;
+
+std::mutex g_file_cache_mutex;
+std::list<std::pair<string, HistoryFinanceFilePtr>> g_file_cache;  // 按最近访问先后排列
+
+/* 获取已映射的报告期文件，文件不存在或无效时返回空指针 */
+HistoryFinanceFilePtr getHistoryFinanceFile(const string& dir, Datetime date) {
+    string filename(dir + "/gpcw" + boost::lexical_cast<string>(date.number() / 10000) + ".dat");
+    boost::system::error_code ec;
+    uintmax_t size = boost::filesystem::file_size(filename, ec);
+    std::time_t mtime = ec ? 0 : boost::filesystem::last_write_time(filename, ec);
+
+    std::lock_guard<std::mutex> lock(g_file_cache_mutex);
+    auto iter = g_file_cache.begin();
+    while (iter != g_file_cache.end() && iter->first != filename) {
+        ++iter;
+    }
+    if (iter != g_file_cache.end()) {
+        if (!ec && iter->second->isValid(mtime, size)) {
+            g_file_cache.splice(g_file_cache.begin(), g_file_cache, iter);
+            return iter->second;
         }
-
-        stock_code[6] = '\0';
-        if (strcmp(stock_code, code.c_str()) == 0) {
-            break;
+        // 文件已被删除或更新，释放旧的映射
+        g_file_cache.erase(iter);
+    }
+    HKU_INFO_IF_RETURN(ec, HistoryFinanceFilePtr(), "Can't found {}", filename);
+
+    HistoryFinanceFilePtr file;
+    try {
+        file = std::make_shared<HistoryFinanceFile>(filename, mtime, size);
+        g_file_cache.emplace_front(filename, file);
+        if (g_file_cache.size() > g_max_cached_files) {
+            g_file_cache.pop_back();
         }
+    } catch (std::exception& e) {
+        HKU_ERROR("{}", e.what());
+    } catch (...) {
+        HKU_ERROR("Failed open {}! Unknown error!", filename);
     }
+    return file;
+}
 
-    if (address != 0) {
-        const int MAX_COL_NUM = 350;
-        float result_buffer[MAX_COL_NUM];
-        int report_fields_count = int(report_size / 4);
-        if (report_fields_count >= MAX_COL_NUM) {
-            HKU_WARN("Over MAX_COL_NUM! {}", filename);
-            report_fields_count = MAX_COL_NUM;
-        }
+}  // namespace
 
-        fseek(fp, address, SEEK_SET);
+HistoryFinanceReader::HistoryFinanceReader(const string& dir) : m_dir(dir) {}
 
-        if (!fread(result_buffer, 4, report_fields_count, fp)) {
-            HKU_ERROR("read col data failed! {}", filename);
-            fclose(fp);
-            return result;
-        }
+HistoryFinanceReader::~HistoryFinanceReader() {}
 
-        result.reserve(report_fields_count);
-        price_t null_price = Null<price_t>();
-        for (int i = 0; i < report_fields_count; i++) {
-            if (result_buffer[i] == 0xf8f8f8f8) {
-                result.push_back(null_price);
-            } else {
-                result.push_back(result_buffer[i]);
-            }
-        }
+PriceList HistoryFinanceReader ::getHistoryFinanceInfo(Datetime date, const string& market,
+                                                       const string& code) {
+    PriceList result;
+    HistoryFinanceFilePtr file = getHistoryFinanceFile(m_dir, date);
+    HKU_IF_RETURN(!file, result);
+    result.reserve(file->fieldCount());
+    file->read(code, result);
+    return result;
+}
 
-    } else {
-        HKU_ERROR("Invalid address(0)! {}", filename);
+PriceList HistoryFinanceReader::getHistoryFinanceInfo(Datetime date, const StockList& stocks,
+                                                      size_t& field_count) {
+    PriceList result;
+    field_count = 0;
+    HistoryFinanceFilePtr file = getHistoryFinanceFile(m_dir, date);
+    HKU_IF_RETURN(!file, result);
+
+    field_count = file->fieldCount();
+    result.reserve(stocks.size() * field_count);
+    for (const auto& stk : stocks) {
+        if (stk.isNull() || !file->read(stk.code(), result)) {
+            result.resize(result.size() + field_count, Null<price_t>());
+        }
     }
-
-    fclose(fp);
     return result;
 }
 
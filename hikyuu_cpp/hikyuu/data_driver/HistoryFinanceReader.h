@@ -17,6 +17,9 @@ namespace hku {
 
 /**
  * 读取历史财务信息
+ * @details 各报告期文件（gpcwYYYYMMDD.dat）首次访问时以内存映射方式打开，并建立证券代码到
+ *          记录位置的索引，之后由所有读取实例共享；文件被更新（修改时间或大小变化）时重新加载。
+ *          最多保留最近访问的 8 个报告期文件，超出时释放最久未访问的文件。
  * @ingroup DataDriver
  */
 class HKU_API HistoryFinanceReader {
@@ -25,8 +28,24 @@ public:
     explicit HistoryFinanceReader(const string& dir);
     virtual ~HistoryFinanceReader();
 
+    /**
+     * 获取指定证券的历史财务信息
+     * @param date 报告期
+     * @param market 市场简称
+     * @param code 证券代码
+     * @return 各字段值，报告期文件或证券不存在时返回空列表
+     */
     PriceList getHistoryFinanceInfo(Datetime date, const string& market, const string& code);
 
+    /**
+     * 批量获取指定报告期多只证券的历史财务信息
+     * @param date 报告期
+     * @param stocks 证券列表
+     * @param field_count [out] 字段数，即矩阵列数，报告期文件不存在时为 0
+     * @return 按行存放的 stocks.size() × field_count 矩阵，不存在的证券整行为 Null<price_t>()
+     */
+    PriceList getHistoryFinanceInfo(Datetime date, const StockList& stocks, size_t& field_count);
+
 private:
     string m_dir;  //历史财务信息文件存放目录
 };
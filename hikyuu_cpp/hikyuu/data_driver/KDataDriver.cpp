@@ -68,6 +68,11 @@ bool KDataDriver::init(const Parameter& params) {
     return _init();
 }
 
+bool KDataDriver::isSupportKType(const KQuery::KType& ktype) {
+    return !(ktype == KQuery::MIN3 || ktype == KQuery::HOUR2 || ktype == KQuery::HOUR4 ||
+             ktype == KQuery::HOUR6 || ktype == KQuery::HOUR12);
+}
+
 size_t KDataDriver::getCount(const string& market, const string& code, KQuery::KType kType) {
     HKU_INFO("The getCount method has not been implemented! (KDataDriver: {})", m_name);
     return 0;
@@ -85,6 +90,16 @@ KRecordList KDataDriver::getKRecordList(const string& market, const string& code
     return KRecordList();
 }
 
+vector<KRecordList> KDataDriver::getKRecordListBatch(const string& market,
+                                                     const vector<string>& codes,
+                                                     const KQuery& query) {
+    vector<KRecordList> result(codes.size());
+    for (size_t i = 0, total = codes.size(); i < total; i++) {
+        result[i] = getKRecordList(market, codes[i], query);
+    }
+    return result;
+}
+
 TimeLineList KDataDriver::getTimeLineList(const string& market, const string& code,
                                           const KQuery& query) {
     HKU_INFO("The getTimeLineList method has not been implemented! (KDataDriver: {})", m_name);
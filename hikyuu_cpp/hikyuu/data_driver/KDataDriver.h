@@ -70,6 +70,13 @@ public:
      */
     virtual bool canParallelLoad() = 0;
 
+    /**
+     * 是否支持指定的K线类型，不支持的K线类型将由 Stock 从其他K线类型合成
+     * @note 默认支持除 MIN3、HOUR2、HOUR4、HOUR6、HOUR12 之外的K线类型
+     * @param ktype K线类型
+     */
+    virtual bool isSupportKType(const KQuery::KType& ktype);
+
     /**
      * 获取指定类型的K线数据量
      * @param market 市场简称
@@ -100,6 +107,18 @@ public:
     virtual KRecordList getKRecordList(const string& market, const string& code,
                                        const KQuery& query);
 
+    /**
+     * 批量获取同一市场下多只证券的 K 线数据
+     * @note 默认实现为逐个调用 getKRecordList，支持单次请求批量读取的引擎可重载以减少往返
+     * @param market 市场简称
+     * @param codes  证券代码列表
+     * @param query  查询条件，各证券使用相同的查询条件
+     * @return 与 codes 一一对应的 K 线数据
+     */
+    virtual vector<KRecordList> getKRecordListBatch(const string& market,
+                                                    const vector<string>& codes,
+                                                    const KQuery& query);
+
     /**
      * 获取分时线
      * @param market 市场简称
@@ -119,6 +138,13 @@ public:
      */
     virtual TransList getTransList(const string& market, const string& code, const KQuery& query);
 
+    /**
+     * 数据已在外部更新（如导入了新数据）时调用，清除引擎内部缓存的元数据（如记录数、日期索引），
+     * 下次查询时重新校验
+     * @note 默认无缓存，不做任何处理
+     */
+    virtual void invalidateCache() {}
+
 private:
     bool checkType();
 
@@ -164,6 +190,10 @@ public:
         return m_driver->canParallelLoad();
     }
 
+    bool isSupportKType(const KQuery::KType& ktype) {
+        return m_driver->isSupportKType(ktype);
+    }
+
     size_t getCount(const string& market, const string& code, KQuery::KType kType) {
         return m_driver->getCount(market, code, kType);
     }
@@ -185,6 +215,10 @@ public:
         return m_driver->getTransList(market, code, query);
     }
 
+    void invalidateCache() {
+        m_driver->invalidateCache();
+    }
+
 private:
     KDataDriverPtr m_driver;
 };
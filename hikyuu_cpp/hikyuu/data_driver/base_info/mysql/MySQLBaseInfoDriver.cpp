@@ -139,6 +139,13 @@ StockWeightList MySQLBaseInfoDriver::getStockWeightList(const string &market, co
     return result;
 }
 
+unordered_map<string, StockWeightList> MySQLBaseInfoDriver::getAllStockWeightList() {
+    HKU_CHECK(m_pool, "Connect pool ptr is null!");
+    auto con = m_pool->getConnect();
+    HKU_CHECK(con, "Failed fetch connect!");
+    return _loadAllStockWeightList(*con);
+}
+
 vector<StockInfo> MySQLBaseInfoDriver::getAllStockInfo() {
     vector<StockInfo> result;
     HKU_ERROR_IF_RETURN(!m_pool, result, "Connect pool ptr is null!");
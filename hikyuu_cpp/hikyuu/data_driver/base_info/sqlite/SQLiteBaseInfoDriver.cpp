@@ -157,6 +157,13 @@ StockWeightList SQLiteBaseInfoDriver::getStockWeightList(const string& market, c
     return result;
 }
 
+unordered_map<string, StockWeightList> SQLiteBaseInfoDriver::getAllStockWeightList() {
+    HKU_CHECK(m_pool, "Connect pool ptr is null!");
+    auto con = m_pool->getConnect();
+    HKU_CHECK(con, "Failed fetch connect!");
+    return _loadAllStockWeightList(*con);
+}
+
 Parameter SQLiteBaseInfoDriver ::getFinanceInfo(const string& market, const string& code) {
     Parameter result;
     HKU_IF_RETURN(!m_pool, result);
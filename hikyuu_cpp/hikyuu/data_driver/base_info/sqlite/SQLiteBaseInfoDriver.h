@@ -29,6 +29,7 @@ public:
     virtual Parameter getFinanceInfo(const string& market, const string& code) override;
     virtual StockWeightList getStockWeightList(const string& market, const string& code,
                                                Datetime start, Datetime end) override;
+    virtual unordered_map<string, StockWeightList> getAllStockWeightList() override;
     virtual MarketInfo getMarketInfo(const string& market) override;
     virtual StockTypeInfo getStockTypeInfo(uint32_t type) override;
     virtual StockInfo getStockInfo(string market, const string& code) override;
@@ -7,7 +7,9 @@
 
 #include <fstream>
 #include <boost/algorithm/string.hpp>
+#include <boost/filesystem.hpp>
 #include "../../../utilities/util.h"
+#include "../../../StockManager.h"
 #include "QLBlockInfoDriver.h"
 
 namespace hku {
@@ -15,100 +17,57 @@ namespace hku {
 QLBlockInfoDriver::~QLBlockInfoDriver() {}
 
 bool QLBlockInfoDriver::_init() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_files.clear();
     return true;
 }
 
-Block QLBlockInfoDriver ::getBlock(const string& category, const string& name) {
-    Block result(category, name);
-    HKU_ERROR_IF_RETURN(!haveParam("dir"), result, "Missing 'dir' param!");
-    HKU_INFO_IF_RETURN(!haveParam(category), result, "No such category ({})!", category);
+QLBlockInfoDriver::BlockFilePtr QLBlockInfoDriver::_getBlockFile(const string& category) {
+    HKU_ERROR_IF_RETURN(!haveParam("dir"), BlockFilePtr(), "Missing 'dir' param!");
+    HKU_INFO_IF_RETURN(!haveParam(category), BlockFilePtr(), "No such category ({})!", category);
 
     string filename;
     try {
         filename = getParam<string>("dir") + "/" + getParam<string>(category);
     } catch (...) {
         HKU_ERROR("Maybe parameters errors!");
-        return result;
+        return BlockFilePtr();
     }
 
-    std::ifstream inifile(filename.c_str(), std::ifstream::in);
-    HKU_ERROR_IF_RETURN(!inifile, result, "Can't open file({})!", filename);
+    boost::system::error_code ec;
+    uintmax_t size = boost::filesystem::file_size(filename, ec);
+    HKU_ERROR_IF_RETURN(ec, BlockFilePtr(), "Can't open file({})!", filename);
+    std::time_t mtime = boost::filesystem::last_write_time(filename, ec);
 
-    string line_str;
-    string section, market, code;
-    bool is_find = false;
-    string gb_name = utf8_to_gb(name);
-    while (std::getline(inifile, line_str)) {
-        boost::trim(line_str);
+    // 证券列表变化时（如重新初始化），缓存中的证券编号可能失效，需重新解析
+    size_t stock_count = StockManager::instance().denseIdCount();
 
-        //空行或注释行，跳过
-        if (line_str.empty() || line_str.at(0) == ';') {
-            continue;
-        }
-
-        //检查第一个出现的注释符，并将其及其之后的字符清除
-        size_t pos = line_str.find(';');
-        if (pos != std::string::npos) {
-            line_str.assign(line_str, 0, pos);
-            boost::trim(line_str);
-        }
-
-        // section行
-        if (line_str.at(0) == '[') {
-            if (is_find) {
-                break;  //跳出循环
-            }
-            size_t len = line_str.size();
-            if (line_str[len - 1] != ']') {
-                continue;
-            }
-
-            section.assign(line_str, 1, len - 2);
-            boost::trim(section);
-            if (section.empty()) {
-                continue;
-            }
-
-            if (section == gb_name) {
-                is_find = true;
-            }
-        }
-
-        if (is_find) {
-            pos = line_str.find(',');
-            if (pos != std::string::npos) {
-                market.assign(line_str, 0, pos);
-                code.assign(line_str, pos + 1, line_str.size());
-                boost::trim(market);
-                boost::trim(code);
-                if (market == "0") {
-                    result.add("SH" + code);
-                } else {
-                    result.add("SZ" + code);
-                }
-            }
-        }
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto iter = m_files.find(category);
+    if (iter != m_files.end() && iter->second->mtime == mtime && iter->second->size == size &&
+        iter->second->stock_count == stock_count) {
+        return iter->second;
     }
 
-    inifile.close();
-    return result;
-}
-
-BlockList QLBlockInfoDriver::getBlockList(const string& category) {
-    BlockList result;
-    HKU_ERROR_IF_RETURN(!haveParam("dir"), result, "Missing 'dir' param!");
-    HKU_INFO_IF_RETURN(!haveParam(category), result, "No such category ({})!", category);
-
-    string filename;
-    try {
-        filename = getParam<string>("dir") + "/" + getParam<string>(category);
-    } catch (...) {
-        HKU_ERROR("Maybe parameters errors!");
-        return result;
+    BlockFilePtr file = _loadBlockFile(filename, category, mtime, size, stock_count);
+    if (file) {
+        m_files[category] = file;
     }
+    return file;
+}
 
+QLBlockInfoDriver::BlockFilePtr QLBlockInfoDriver::_loadBlockFile(const string& filename,
+                                                                  const string& category,
+                                                                  std::time_t mtime,
+                                                                  uintmax_t size,
+                                                                  size_t stock_count) {
     std::ifstream inifile(filename.c_str(), std::ifstream::in);
-    HKU_ERROR_IF_RETURN(!inifile, result, "Can't open file({})!", filename);
+    HKU_ERROR_IF_RETURN(!inifile, BlockFilePtr(), "Can't open file({})!", filename);
+
+    auto file = make_shared<BlockFile>();
+    file->mtime = mtime;
+    file->size = size;
+    file->stock_count = stock_count;
 
     std::string section;
     std::string key;
@@ -141,7 +100,8 @@ BlockList QLBlockInfoDriver::getBlockList(const string& category) {
                 continue;
 
             block = Block(category, gb_to_utf8(section));
-            result.push_back(block);
+            file->index.insert(std::make_pair(block.name(), file->blocks.size()));
+            file->blocks.push_back(block);
 
         } else {
             if (section.empty())
@@ -170,6 +130,25 @@ BlockList QLBlockInfoDriver::getBlockList(const string& category) {
     }
 
     inifile.close();
+    return file;
+}
+
+Block QLBlockInfoDriver ::getBlock(const string& category, const string& name) {
+    BlockFilePtr file = _getBlockFile(category);
+    HKU_IF_RETURN(!file, Block(category, name));
+    auto iter = file->index.find(name);
+    HKU_IF_RETURN(iter == file->index.end(), Block(category, name));
+    return file->blocks[iter->second].clone();
+}
+
+BlockList QLBlockInfoDriver::getBlockList(const string& category) {
+    BlockList result;
+    BlockFilePtr file = _getBlockFile(category);
+    HKU_IF_RETURN(!file, result);
+    result.reserve(file->blocks.size());
+    for (auto iter = file->blocks.begin(); iter != file->blocks.end(); ++iter) {
+        result.push_back(iter->clone());
+    }
     return result;
 }
 
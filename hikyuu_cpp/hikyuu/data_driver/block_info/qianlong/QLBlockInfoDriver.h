@@ -9,10 +9,18 @@
 #ifndef DATA_DRIVER_BLOCK_INFO_QIANLONG_QLBLOCKINFODRIVER_H_
 #define DATA_DRIVER_BLOCK_INFO_QIANLONG_QLBLOCKINFODRIVER_H_
 
+#include <ctime>
+#include <mutex>
 #include "../../BlockInfoDriver.h"
 
 namespace hku {
 
+/**
+ * 钱龙格式板块信息驱动
+ * @details 各分类的板块文件只在首次访问或文件修改时间、大小变化时解析一次，解析结果按
+ *          分类 -> 板块名称索引缓存于内存，板块成员以证券连续编号位图保存。返回的板块为
+ *          缓存的深度复制，调用方可自由修改。
+ */
 class QLBlockInfoDriver : public BlockInfoDriver {
 public:
     QLBlockInfoDriver() : BlockInfoDriver("qianlong"){};
@@ -22,6 +30,27 @@ public:
     virtual Block getBlock(const string&, const string&) override;
     virtual BlockList getBlockList(const string& category) override;
     virtual BlockList getBlockList() override;
+
+private:
+    /** 已解析的分类板块文件 */
+    struct BlockFile {
+        std::time_t mtime;
+        uintmax_t size;
+        size_t stock_count;                   // 解析时 StockManager 中的证券数量
+        BlockList blocks;                     // 按文件中的顺序
+        unordered_map<string, size_t> index;  // 板块名称 -> blocks 中的位置
+    };
+    typedef shared_ptr<const BlockFile> BlockFilePtr;
+
+    /** 获取指定分类已解析的板块文件，失败时返回空指针 */
+    BlockFilePtr _getBlockFile(const string& category);
+
+    static BlockFilePtr _loadBlockFile(const string& filename, const string& category,
+                                       std::time_t mtime, uintmax_t size, size_t stock_count);
+
+private:
+    std::mutex m_mutex;
+    unordered_map<string, BlockFilePtr> m_files;  // 分类 -> 已解析的板块文件
 };
 
 } /* namespace hku */
@@ -15,6 +15,7 @@ namespace hku {
 
 /**
  * 获取临时载入的CSV文件
+ * @details 文件以内存映射方式读取，较大的文件将分段并行解析 @see readKRecordCsv
  * @ingroup DataDriver
  */
 class KDataTempCsvDriver : public KDataDriver {
@@ -74,30 +75,12 @@ public:
                                        const KQuery& query) override;
 
 private:
-    void _get_title_column(const string&);
-    void _get_token(const string&);
-    string _get_filename();
-
     KRecordList _getKRecordListByIndex(const string& market, const string& code, int64_t start_ix,
                                        int64_t end_ix, KQuery::KType kType);
 
 private:
     string m_day_filename;
     string m_min_filename;
-
-    enum COLUMN {
-        DATE = 0,
-        OPEN = 1,
-        HIGH = 2,
-        LOW = 3,
-        CLOSE = 4,
-        VOLUME = 5,
-        AMOUNT = 6,
-        LAST = 7
-    };
-
-    size_t m_column[LAST];
-    vector<string> m_token_buf;
 };
 
 } /* namespace hku */
@@ -0,0 +1,424 @@
+/*
+ *  Copyright(C) 2026 hikyuu.org
+ *
+ *  Create on: 2026-10-18
+ *     Author: fasiondog
+ */
+
+#include <cstring>
+#include <exception>
+#include <thread>
+#include <boost/filesystem.hpp>
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+#include <boost/lexical_cast.hpp>
+#include "../../../utilities/arithmetic.h"
+#include "KRecordCsvParser.h"
+
+namespace hku {
+
+static inline bool is_blank(char c) {
+    return c == ' ' || c == '\t' || c == '\r' || c == '\n' || c == '\v' || c == '\f';
+}
+
+static inline bool is_digit(char c) {
+    return c >= '0' && c <= '9';
+}
+
+static inline void trim(const char*& first, const char*& last) {
+    while (first < last && is_blank(*first)) {
+        first++;
+    }
+    while (last > first && is_blank(*(last - 1))) {
+        last--;
+    }
+}
+
+/* 读取至多 max_count 位数字，返回实际读取的位数 */
+static inline int read_digits(const char*& p, const char* last, int max_count, long& value) {
+    int count = 0;
+    value = 0;
+    while (p < last && count < max_count && is_digit(*p)) {
+        value = value * 10 + (*p - '0');
+        p++;
+        count++;
+    }
+    return count;
+}
+
+/* 读取小数秒（至多 6 位），转换为微秒 */
+static inline bool read_fraction(const char*& p, const char* last, long& microseconds) {
+    long value = 0;
+    int count = read_digits(p, last, 7, value);
+    if (count == 0 || count > 6) {
+        return false;
+    }
+    for (; count < 6; count++) {
+        value *= 10;
+    }
+    microseconds = value;
+    return true;
+}
+
+KRecordCsvParser::KRecordCsvParser() {}
+
+void KRecordCsvParser::parseTitle(const char* first, const char* last) {
+    m_fields.clear();
+    const char* p = first;
+    for (;;) {
+        const char* sep = static_cast<const char*>(std::memchr(p, ',', last - p));
+        const char* token_first = p;
+        const char* token_last = sep ? sep : last;
+        trim(token_first, token_last);
+        string token(token_first, token_last);
+        to_upper(token);
+
+        int column = NONE;
+        if ("DATE" == token || "DATETIME" == token || "日期" == token) {
+            column = DATE;
+        } else if ("OPEN" == token || "开盘价" == token) {
+            column = OPEN;
+        } else if ("HIGH" == token || "最高价" == token) {
+            column = HIGH;
+        } else if ("LOW" == token || "最低价" == token) {
+            column = LOW;
+        } else if ("CLOSE" == token || "收盘价" == token) {
+            column = CLOSE;
+        } else if ("AMOUNT" == token || "成交金额" == token) {
+            column = AMOUNT;
+        } else if ("VOLUME" == token || "COUNT" == token || "VOL" == token || "成交量" == token) {
+            column = VOLUME;
+        }
+        m_fields.push_back(column);
+
+        if (!sep) {
+            break;
+        }
+        p = sep + 1;
+    }
+
+    // 去除末尾无用的字段，解析数据行时可提前结束
+    while (!m_fields.empty() && m_fields.back() == NONE) {
+        m_fields.pop_back();
+    }
+}
+
+bool KRecordCsvParser::parseLine(const char* first, const char* last, KRecord& out) const {
+    const char* p = first;
+    for (size_t i = 0, total = m_fields.size(); i < total; i++) {
+        const char* sep = static_cast<const char*>(std::memchr(p, ',', last - p));
+        const char* field_last = sep ? sep : last;
+        switch (m_fields[i]) {
+            case DATE:
+                HKU_IF_RETURN(!parseDatetime(p, field_last, out.datetime), false);
+                break;
+            case OPEN:
+                HKU_IF_RETURN(!parsePrice(p, field_last, out.openPrice), false);
+                break;
+            case HIGH:
+                HKU_IF_RETURN(!parsePrice(p, field_last, out.highPrice), false);
+                break;
+            case LOW:
+                HKU_IF_RETURN(!parsePrice(p, field_last, out.lowPrice), false);
+                break;
+            case CLOSE:
+                HKU_IF_RETURN(!parsePrice(p, field_last, out.closePrice), false);
+                break;
+            case VOLUME:
+                HKU_IF_RETURN(!parsePrice(p, field_last, out.transCount), false);
+                break;
+            case AMOUNT:
+                HKU_IF_RETURN(!parsePrice(p, field_last, out.transAmount), false);
+                break;
+            default:
+                break;
+        }
+
+        // 缺少的字段保持默认值
+        if (!sep) {
+            break;
+        }
+        p = sep + 1;
+    }
+    return true;
+}
+
+size_t KRecordCsvParser::parseLines(const char* first, const char* last, KRecordList& out,
+                                    vector<size_t>& invalid_lines) const {
+    size_t line_no = 0;
+    const char* p = first;
+    while (p < last) {
+        const char* eol = static_cast<const char*>(std::memchr(p, '\n', last - p));
+        const char* line_last = eol ? eol : last;
+        const char* line_first = p;
+        trim(line_first, line_last);
+        if (line_first < line_last) {
+            KRecord record;
+            if (parseLine(line_first, line_last, record)) {
+                out.push_back(record);
+            } else {
+                invalid_lines.push_back(line_no);
+            }
+        }
+
+        line_no++;
+        if (!eol) {
+            break;
+        }
+        p = eol + 1;
+    }
+    return line_no;
+}
+
+bool KRecordCsvParser::parsePrice(const char* first, const char* last, price_t& out) {
+    // 10^0 ~ 10^22 均可由 double 精确表示
+    static const double s_pow10[] = {1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,
+                                     1e8,  1e9,  1e10, 1e11, 1e12, 1e13, 1e14, 1e15,
+                                     1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+
+    trim(first, last);
+    const char* p = first;
+    bool negative = false;
+    if (p < last && (*p == '-' || *p == '+')) {
+        negative = *p == '-';
+        p++;
+    }
+
+    // 至多保留 19 位有效数字，超出时不再精确，交由回退路径处理
+    uint64_t mantissa = 0;
+    int digits = 0;
+    int exp10 = 0;
+    bool have_digit = false;
+    bool exact = true;
+    while (p < last && is_digit(*p)) {
+        have_digit = true;
+        if (digits < 19) {
+            mantissa = mantissa * 10 + (*p - '0');
+            if (mantissa) {
+                digits++;
+            }
+        } else {
+            exp10++;
+            exact = false;
+        }
+        p++;
+    }
+    if (p < last && *p == '.') {
+        p++;
+        while (p < last && is_digit(*p)) {
+            have_digit = true;
+            if (digits < 19) {
+                mantissa = mantissa * 10 + (*p - '0');
+                if (mantissa) {
+                    digits++;
+                }
+                exp10--;
+            } else {
+                exact = false;
+            }
+            p++;
+        }
+    }
+    if (have_digit && p < last && (*p == 'e' || *p == 'E')) {
+        p++;
+        bool exp_negative = false;
+        if (p < last && (*p == '-' || *p == '+')) {
+            exp_negative = *p == '-';
+            p++;
+        }
+        long value = 0;
+        int count = read_digits(p, last, 4, value);
+        if (count == 0) {
+            exact = false;
+        }
+        exp10 += exp_negative ? -int(value) : int(value);
+    }
+
+    if (have_digit && exact && p == last && mantissa <= (uint64_t(1) << 53) && exp10 >= -22 &&
+        exp10 <= 22) {
+        // 尾数与 10 的幂次均可精确表示，一次乘除即可得到正确舍入的结果
+        double value = double(mantissa);
+        value = exp10 < 0 ? value / s_pow10[-exp10] : value * s_pow10[exp10];
+        out = negative ? -value : value;
+        return true;
+    }
+
+    HKU_IF_RETURN(first == last, false);
+    try {
+        out = boost::lexical_cast<price_t>(first, last - first);
+    } catch (...) {
+        return false;
+    }
+    return true;
+}
+
+bool KRecordCsvParser::parseDatetime(const char* first, const char* last, Datetime& out) {
+    trim(first, last);
+    const char* p = first;
+    long year = 0, month = 0, day = 0, hour = 0, minute = 0, second = 0, microseconds = 0;
+    bool fast = false;
+
+    long value = 0;
+    int count = read_digits(p, last, 8, value);
+    if (count == 8 && (p == last || *p == 'T')) {
+        // YYYYMMDD 或 YYYYMMDDTHHMMSS[.ffffff]
+        year = value / 10000;
+        month = value / 100 % 100;
+        day = value % 100;
+        fast = true;
+        if (p < last) {
+            p++;
+            fast = read_digits(p, last, 6, value) == 6;
+            hour = value / 10000;
+            minute = value / 100 % 100;
+            second = value % 100;
+            if (fast && p < last && *p == '.') {
+                p++;
+                fast = read_fraction(p, last, microseconds);
+            }
+        }
+
+    } else if (count == 4 && p < last && (*p == '-' || *p == '/')) {
+        // YYYY-MM-DD[ HH:MM:SS[.ffffff]]，年月日之间也可以为 '/'
+        char sep = *p++;
+        year = value;
+        fast = read_digits(p, last, 2, month) > 0 && p < last && *p++ == sep &&
+               read_digits(p, last, 2, day) > 0;
+        if (fast && p < last) {
+            fast = *p == ' ';
+            while (p < last && *p == ' ') {
+                p++;
+            }
+            fast = fast && read_digits(p, last, 2, hour) > 0 && p < last && *p++ == ':' &&
+                   read_digits(p, last, 2, minute) > 0 && p < last && *p++ == ':' &&
+                   read_digits(p, last, 2, second) > 0;
+            if (fast && p < last && *p == '.') {
+                p++;
+                fast = read_fraction(p, last, microseconds);
+            }
+        }
+    }
+
+    if (fast && p == last && month >= 1 && month <= 12 && day >= 1 && day <= 31 && hour < 24 &&
+        minute < 60 && second < 60) {
+        try {
+            out = Datetime(year, month, day, hour, minute, second, microseconds / 1000,
+                           microseconds % 1000);
+        } catch (...) {
+            return false;
+        }
+        return true;
+    }
+
+    // 其他格式
+    HKU_IF_RETURN(first == last, false);
+    try {
+        out = Datetime(string(first, last));
+    } catch (...) {
+        return false;
+    }
+    return true;
+}
+
+KRecordList HKU_API readKRecordCsv(const string& filename, size_t parallel_min_size) {
+    KRecordList result;
+    boost::system::error_code ec;
+    uintmax_t file_size = boost::filesystem::file_size(filename, ec);
+    HKU_ERROR_IF_RETURN(ec, result, "Can't open this file: {}", filename);
+    HKU_IF_RETURN(file_size == 0, result);
+
+    try {
+        boost::interprocess::file_mapping mapping(filename.c_str(), boost::interprocess::read_only);
+        boost::interprocess::mapped_region region(mapping, boost::interprocess::read_only);
+        const char* data = static_cast<const char*>(region.get_address());
+        const char* last = data + region.get_size();
+
+        // 跳过 UTF-8 BOM
+        if (last - data >= 3 && std::memcmp(data, "\xEF\xBB\xBF", 3) == 0) {
+            data += 3;
+        }
+
+        KRecordCsvParser parser;
+        const char* eol = static_cast<const char*>(std::memchr(data, '\n', last - data));
+        parser.parseTitle(data, eol ? eol : last);
+        HKU_IF_RETURN(!eol, result);
+
+        // 按首条数据行的长度估算记录数
+        const char* body = eol + 1;
+        size_t body_size = last - body;
+        eol = static_cast<const char*>(std::memchr(body, '\n', body_size));
+        size_t line_size = eol ? eol - body + 1 : body_size + 1;
+
+        size_t chunk_count = 1;
+        if (parallel_min_size > 0 && body_size >= 2 * parallel_min_size) {
+            size_t cpu_num = std::thread::hardware_concurrency();
+            chunk_count = std::min(body_size / parallel_min_size, cpu_num > 0 ? cpu_num : 1);
+        }
+
+        // 按行边界切分
+        vector<const char*> bounds(chunk_count + 1);
+        bounds[0] = body;
+        bounds[chunk_count] = last;
+        for (size_t i = 1; i < chunk_count; i++) {
+            const char* pos = std::max(body + body_size / chunk_count * i, bounds[i - 1]);
+            eol = static_cast<const char*>(std::memchr(pos, '\n', last - pos));
+            bounds[i] = eol ? eol + 1 : last;
+        }
+
+        vector<KRecordList> parts(chunk_count);
+        vector<vector<size_t>> invalid_lines(chunk_count);
+        vector<size_t> line_counts(chunk_count, 0);
+        vector<std::exception_ptr> errors(chunk_count);
+        auto parse_chunk = [&](size_t i) {
+            try {
+                parts[i].reserve((bounds[i + 1] - bounds[i]) / line_size + 1);
+                line_counts[i] = parser.parseLines(bounds[i], bounds[i + 1], parts[i],
+                                                   invalid_lines[i]);
+            } catch (...) {
+                errors[i] = std::current_exception();
+            }
+        };
+
+        vector<std::thread> threads;
+        for (size_t i = 1; i < chunk_count; i++) {
+            threads.emplace_back(parse_chunk, i);
+        }
+        parse_chunk(0);
+        for (auto& t : threads) {
+            t.join();
+        }
+
+        size_t total = 0;
+        size_t line_no = 2;  // 行号从 1 开始，且跳过标题行
+        for (size_t i = 0; i < chunk_count; i++) {
+            if (errors[i]) {
+                std::rethrow_exception(errors[i]);
+            }
+            for (size_t invalid : invalid_lines[i]) {
+                HKU_WARN("Invalid data in line {}! ({})", line_no + invalid, filename);
+            }
+            line_no += line_counts[i];
+            total += parts[i].size();
+        }
+
+        if (chunk_count == 1) {
+            result.swap(parts[0]);
+        } else {
+            result.reserve(total);
+            for (size_t i = 0; i < chunk_count; i++) {
+                result.insert(result.end(), parts[i].begin(), parts[i].end());
+            }
+        }
+
+    } catch (std::exception& e) {
+        HKU_ERROR("Failed read {}! {}", filename, e.what());
+        result.clear();
+    } catch (...) {
+        HKU_ERROR("Failed read {}! Unknown error!", filename);
+        result.clear();
+    }
+
+    return result;
+}
+
+} /* namespace hku */
@@ -0,0 +1,95 @@
+/*
+ *  Copyright(C) 2026 hikyuu.org
+ *
+ *  Create on: 2026-10-18
+ *     Author: fasiondog
+ */
+
+#pragma once
+#ifndef DATA_DRIVER_KRECORDCSVPARSER_H_
+#define DATA_DRIVER_KRECORDCSVPARSER_H_
+
+#include "../../../KRecord.h"
+
+namespace hku {
+
+/**
+ * CSV 格式 K 线数据解析器
+ * @details 首行为标题行，按列名（如 date/open/high/low/close/amount/volume 或对应中文名）确定
+ *          各列位置，其余每行为一条 K 线记录。直接在内存中逐字符解析，数值与日期的常见格式
+ *          走快速路径，不产生任何内存分配，少见格式回退至 boost::lexical_cast 与 Datetime
+ *          字符串构造，解析结果与二者一致。无法解析的行将被跳过。
+ * @ingroup DataDriver
+ */
+class HKU_API KRecordCsvParser {
+public:
+    KRecordCsvParser();
+
+    /**
+     * 解析标题行，确定各列位置
+     * @param first 行首
+     * @param last 行尾（不含换行符）
+     */
+    void parseTitle(const char* first, const char* last);
+
+    /**
+     * 解析一行数据，标题行中不存在的列保持 KRecord 的默认值
+     * @param first 行首
+     * @param last 行尾（不含换行符）
+     * @param out [out] 解析结果
+     * @return 该行存在无法解析的字段时返回 false
+     */
+    bool parseLine(const char* first, const char* last, KRecord& out) const;
+
+    /**
+     * 解析多行数据，空行与无法解析的行将被跳过
+     * @param first 起始位置
+     * @param last 结束位置
+     * @param out [out] 解析结果追加至此
+     * @param invalid_lines [out] 无法解析的行在 [first, last) 中的行号（从 0 开始）
+     * @return [first, last) 中的总行数
+     */
+    size_t parseLines(const char* first, const char* last, KRecordList& out,
+                      vector<size_t>& invalid_lines) const;
+
+    /**
+     * 解析数值，与 boost::lexical_cast<price_t> 结果一致，忽略首尾空白
+     * @return 无法解析时返回 false
+     */
+    static bool parsePrice(const char* first, const char* last, price_t& out);
+
+    /**
+     * 解析日期时间，与 Datetime(const std::string&) 结果一致，忽略首尾空白
+     * @return 无法解析时返回 false
+     */
+    static bool parseDatetime(const char* first, const char* last, Datetime& out);
+
+private:
+    enum COLUMN {
+        NONE = -1,
+        DATE = 0,
+        OPEN = 1,
+        HIGH = 2,
+        LOW = 3,
+        CLOSE = 4,
+        VOLUME = 5,
+        AMOUNT = 6,
+        LAST = 7
+    };
+
+    vector<int> m_fields;  // 字段序号 -> 对应的列，NONE 表示忽略
+};
+
+/**
+ * 读取 CSV 格式的 K 线数据文件
+ * @details 以内存映射方式读取，文件大于 parallel_min_size 时按行边界切分为多段并行解析
+ * @param filename 文件名
+ * @param parallel_min_size 每段的最小字节数，为 0 时不并行
+ * @return 按文件顺序排列的 K 线记录，文件不存在或为空时返回空列表
+ */
+KRecordList HKU_API readKRecordCsv(const string& filename,
+                                   size_t parallel_min_size = 16 * 1024 * 1024);
+
+} /* namespace hku */
+
+#endif /* DATA_DRIVER_KRECORDCSVPARSER_H_ */
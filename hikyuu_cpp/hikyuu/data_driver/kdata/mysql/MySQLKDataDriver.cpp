@@ -5,14 +5,27 @@
  *      Author: fasiondog
  */
 
+#include <algorithm>
 #include <boost/lexical_cast.hpp>
 #include "../../../Log.h"
+#include "../../../utilities/db_connect/mysql/MySQLStatement.h"
 #include "MySQLKDataDriver.h"
 #include "KRecordTable.h"
 
 namespace hku {
 
-MySQLKDataDriver::MySQLKDataDriver() : KDataDriver("mysql"), m_connect(nullptr) {}
+// K线记录查询的字段，与 _loadKRecordList 读取顺序一致
+static const char* KRECORD_COLUMNS = "`date`,`open`,`high`,`low`,`close`,`amount`,`count`";
+
+// 批量查询时单条语句包含的最大子查询数
+static const size_t BATCH_QUERY_SIZE = 64;
+
+std::mutex MySQLKDataDriver::ms_index_mutex;
+unordered_map<string, MySQLKDataDriver::DateIndexPtr> MySQLKDataDriver::ms_index_cache;
+unordered_map<string, MySQLKDataDriver::DateIndexPtr> MySQLKDataDriver::ms_stale_cache;
+
+MySQLKDataDriver::MySQLKDataDriver()
+: KDataDriver("mysql"), m_connect(nullptr), m_index_check_interval(5) {}
 
 MySQLKDataDriver::~MySQLKDataDriver() {
     if (m_connect) {
@@ -31,6 +44,20 @@ bool MySQLKDataDriver::_init() {
     unsigned int port = boost::lexical_cast<unsigned int>(port_str);
     connect_param.set<int>("port", port);
     m_connect = new MySQLConnect(connect_param);
+
+    // 数据库名称包含在表名中，以服务地址区分即可
+    m_index_prefix = fmt::format("{}:{}/", connect_param.get<string>("host"), port);
+    // 驱动参数一般来自配置文件，可能以字符串保存
+    int interval = m_params.tryGet<int>("index_check_interval", -1);
+    if (interval < 0 && m_params.have("index_check_interval")) {
+        try {
+            string value = m_params.tryGet<string>("index_check_interval", "");
+            interval = boost::lexical_cast<int>(value);
+        } catch (...) {
+            HKU_WARN("Invalid mysql kdata driver param index_check_interval!");
+        }
+    }
+    m_index_check_interval = std::chrono::seconds(interval >= 0 ? interval : 5);
     return true;
 }
 
@@ -53,33 +80,185 @@ KRecordList MySQLKDataDriver::getKRecordList(const string& market, const string&
     return result;
 }
 
+SQLStatementPtr MySQLKDataDriver::_getStreamingStatement(const string& sql) {
+    auto st = std::make_shared<MySQLStatement>(m_connect, sql);
+    st->setStreaming(true);
+    return st;
+}
+
+void MySQLKDataDriver::_loadKRecordList(const SQLStatementPtr& st, int first_column,
+                                        KRecordList& out) {
+    int64_t date = 0;
+    KRecord k;
+    st->getColumn(first_column, date, k.openPrice, k.highPrice, k.lowPrice, k.closePrice,
+                  k.transAmount, k.transCount);
+    try {
+        k.datetime = date == 0 ? Null<Datetime>() : Datetime((uint64_t)date);
+        out.push_back(k);
+    } catch (...) {
+        HKU_ERROR("Failed get record: {}(date), {}(open), {}(high), {}(low), {}(close), "
+                  "{}(amount), {}(count)",
+                  date, k.openPrice, k.highPrice, k.lowPrice, k.closePrice, k.transAmount,
+                  k.transCount);
+    }
+}
+
+int64_t MySQLKDataDriver::_queryLastDate(const string& tablename) {
+    SQLStatementPtr st =
+      m_connect->getStatement(fmt::format("select max(date) from {}", tablename));
+    st->exec();
+    int64_t result = 0;
+    if (st->moveNext()) {
+        st->getColumn(0, result);
+    }
+    return result;
+}
+
+void MySQLKDataDriver::invalidateCache() {
+    std::lock_guard<std::mutex> lock(ms_index_mutex);
+    for (auto& item : ms_index_cache) {
+        ms_stale_cache[item.first] = std::move(item.second);
+    }
+    ms_index_cache.clear();
+}
+
+MySQLKDataDriver::DateIndexPtr MySQLKDataDriver::_getCachedDateIndex(const string& tablename) {
+    std::lock_guard<std::mutex> lock(ms_index_mutex);
+    auto iter = ms_index_cache.find(m_index_prefix + tablename);
+    return iter != ms_index_cache.end() ? iter->second : DateIndexPtr();
+}
+
+MySQLKDataDriver::DateIndexPtr MySQLKDataDriver::_getDateIndex(const string& tablename) {
+    string key = m_index_prefix + tablename;
+    auto now = std::chrono::steady_clock::now();
+    DateIndexPtr index;
+    {
+        std::lock_guard<std::mutex> lock(ms_index_mutex);
+        auto iter = ms_index_cache.find(key);
+        if (iter != ms_index_cache.end()) {
+            // 校验间隔内直接使用，超出后需与数据库校验，以便发现新追加的记录
+            HKU_IF_RETURN(now - iter->second->check_time < m_index_check_interval, iter->second);
+            index = iter->second;
+        } else {
+            iter = ms_stale_cache.find(key);
+            if (iter != ms_stale_cache.end()) {
+                index = iter->second;
+            }
+        }
+    }
+
+    // 无索引时直接全量建立；已失效的索引查询一次最后日期，未变化时沿用，仅有尾部追加时增量更新
+    // 表不存在时抛出异常，由调用方处理
+    auto new_index = std::make_shared<DateIndex>();
+    string sql = fmt::format("select date from {} order by date", tablename);
+    bool need_load = true;
+    if (index) {
+        int64_t last_date = _queryLastDate(tablename);
+        if (index->last_date == last_date) {
+            *new_index = *index;
+            need_load = false;
+        } else if (index->total > 0 && last_date > index->last_date) {
+            *new_index = *index;
+            sql = fmt::format("select date from {} where date>{} order by date", tablename,
+                              index->last_date);
+        }
+    }
+
+    if (need_load) {
+        SQLStatementPtr st = _getStreamingStatement(sql);
+        st->exec();
+        int64_t date = 0;
+        while (st->moveNext()) {
+            st->getColumn(0, date);
+            if (new_index->total % DATE_INDEX_STEP == 0) {
+                new_index->dates.push_back(date);
+            }
+            new_index->total++;
+            new_index->last_date = date;
+        }
+    }
+    new_index->check_time = now;
+
+    std::lock_guard<std::mutex> lock(ms_index_mutex);
+    ms_index_cache[key] = new_index;
+    ms_stale_cache.erase(key);
+    return new_index;
+}
+
+vector<MySQLKDataDriver::DateIndexPtr> MySQLKDataDriver::_getDateIndexBatch(
+  const vector<string>& tablenames) {
+    // 校验间隔内的已缓存索引直接使用，其余逐个建立或校验
+    size_t total = tablenames.size();
+    vector<DateIndexPtr> result(total);
+    for (size_t i = 0; i < total; i++) {
+        try {
+            result[i] = _getDateIndex(tablenames[i]);
+        } catch (...) {
+            // 表可能不存在
+            result[i].reset();
+        }
+    }
+    return result;
+}
+
+size_t MySQLKDataDriver::_countBefore(const string& tablename, const DateIndex& index,
+                                      const Datetime& date) {
+    HKU_IF_RETURN(date.isNull() || date > Datetime::max(), index.total);
+    int64_t number = int64_t(date.number());
+    HKU_IF_RETURN(index.total == 0 || number <= index.dates.front(), 0);
+    HKU_IF_RETURN(number > index.last_date, index.total);
+
+    // 最后一个起始日期小于指定日期的分段，其后只需在分段内计数
+    size_t block =
+      std::lower_bound(index.dates.begin(), index.dates.end(), number) - index.dates.begin() - 1;
+    size_t count = m_connect->queryInt(fmt::format(
+      "select count(1) from {} where date>={} and date<{}", tablename, index.dates[block], number));
+    return block * DATE_INDEX_STEP + count;
+}
+
+string MySQLKDataDriver::_getSelectSQL(const string& columns, const string& tablename,
+                                       const DateIndex& index, size_t start_ix, size_t end_ix) {
+    // 由所在分段的起始日期定位，offset 不超过分段长度
+    size_t block = start_ix / DATE_INDEX_STEP;
+    return fmt::format("select {} from {} where date>={} order by date limit {}, {}", columns,
+                       tablename, index.dates[block], start_ix % DATE_INDEX_STEP,
+                       end_ix - start_ix);
+}
+
+size_t MySQLKDataDriver::_estimateCount(const DateIndex& index, const Datetime& start_date,
+                                        const Datetime& end_date) {
+    HKU_IF_RETURN(index.total == 0, 0);
+    int64_t start = int64_t(start_date.number());
+    size_t first =
+      std::upper_bound(index.dates.begin(), index.dates.end(), start) - index.dates.begin();
+    size_t last = index.dates.size();
+    if (!end_date.isNull() && end_date <= Datetime::max()) {
+        int64_t end = int64_t(end_date.number());
+        last = std::lower_bound(index.dates.begin(), index.dates.end(), end) - index.dates.begin();
+    }
+    size_t blocks = last >= first ? last - first + 1 : 1;
+    return std::min(blocks * DATE_INDEX_STEP, index.total);
+}
+
 KRecordList MySQLKDataDriver::_getKRecordList(const string& market, const string& code,
                                               KQuery::KType kType, size_t start_ix, size_t end_ix) {
     KRecordList result;
     HKU_IF_RETURN(start_ix >= end_ix, result);
 
     try {
-        KRecordTable r(market, code, kType);
-        SQLStatementPtr st = m_connect->getStatement(fmt::format(
-          "{} order by date limit {}, {}", r.getSelectSQL(), start_ix, end_ix - start_ix));
+        string tablename = _getTableName(market, code, kType);
+        DateIndexPtr index = _getDateIndex(tablename);
+        if (end_ix > index->total) {
+            end_ix = index->total;
+        }
+        HKU_IF_RETURN(start_ix >= end_ix, result);
 
+        result.reserve(end_ix - start_ix);
+        SQLStatementPtr st = _getStreamingStatement(
+          _getSelectSQL(KRECORD_COLUMNS, tablename, *index, start_ix, end_ix));
         st->exec();
         while (st->moveNext()) {
-            KRecordTable record;
-            try {
-                record.load(st);
-                KRecord k;
-                k.datetime = record.date();
-                k.openPrice = record.open();
-                k.highPrice = record.high();
-                k.lowPrice = record.low();
-                k.closePrice = record.close();
-                k.transAmount = record.amount();
-                k.transCount = record.count();
-                result.push_back(k);
-            } catch (...) {
-                HKU_ERROR("Failed get record: {}", record.str());
-            }
+            _loadKRecordList(st, 0, result);
         }
     } catch (...) {
         // 表可能不存在
@@ -94,27 +273,19 @@ KRecordList MySQLKDataDriver::_getKRecordList(const string& market, const string
     HKU_IF_RETURN(start_date >= end_date, result);
 
     try {
-        KRecordTable r(market, code, ktype);
-        SQLStatementPtr st = m_connect->getStatement(
-          fmt::format("{} where date >= {} and date < {} order by date", r.getSelectSQL(),
-                      start_date.number(), end_date.number()));
+        string tablename = _getTableName(market, code, ktype);
+        // 已有索引时据此预分配，不额外发起查询
+        DateIndexPtr index = _getCachedDateIndex(tablename);
+        if (index) {
+            result.reserve(_estimateCount(*index, start_date, end_date));
+        }
+
+        SQLStatementPtr st = _getStreamingStatement(
+          fmt::format("select {} from {} where date >= {} and date < {} order by date",
+                      KRECORD_COLUMNS, tablename, start_date.number(), end_date.number()));
         st->exec();
         while (st->moveNext()) {
-            KRecordTable record;
-            try {
-                record.load(st);
-                KRecord k;
-                k.datetime = record.date();
-                k.openPrice = record.open();
-                k.highPrice = record.high();
-                k.lowPrice = record.low();
-                k.closePrice = record.close();
-                k.transAmount = record.amount();
-                k.transCount = record.count();
-                result.push_back(k);
-            } catch (...) {
-                HKU_ERROR("Failed get record: {}", record.str());
-            }
+            _loadKRecordList(st, 0, result);
         }
     } catch (...) {
         // 表可能不存在
@@ -122,12 +293,87 @@ KRecordList MySQLKDataDriver::_getKRecordList(const string& market, const string
     return result;
 }
 
+vector<KRecordList> MySQLKDataDriver::getKRecordListBatch(const string& market,
+                                                          const vector<string>& codes,
+                                                          const KQuery& query) {
+    size_t total = codes.size();
+    vector<KRecordList> result(total);
+    HKU_IF_RETURN(total == 0, result);
+
+    vector<string> tablenames(total);
+    for (size_t i = 0; i < total; i++) {
+        tablenames[i] = _getTableName(market, codes[i], query.kType());
+    }
+    vector<DateIndexPtr> indexes = _getDateIndexBatch(tablenames);
+
+    // 生成各证券的子查询，表不存在或无数据的证券跳过
+    vector<string> sub_sqls;
+    for (size_t i = 0; i < total; i++) {
+        const DateIndexPtr& index = indexes[i];
+        if (!index || index->total == 0) {
+            continue;
+        }
+
+        if (query.queryType() == KQuery::INDEX) {
+            int64_t count = int64_t(index->total);
+            int64_t start = query.start() < 0 ? std::max<int64_t>(count + query.start(), 0)
+                                              : std::min<int64_t>(query.start(), count);
+            int64_t end = query.end() == Null<int64_t>() ? count
+                          : query.end() < 0 ? std::max<int64_t>(count + query.end(), 0)
+                                            : std::min<int64_t>(query.end(), count);
+            if (start >= end) {
+                continue;
+            }
+            result[i].reserve(end - start);
+            string columns = fmt::format("{} as ix, {}", i, KRECORD_COLUMNS);
+            sub_sqls.push_back(
+              fmt::format("({})", _getSelectSQL(columns, tablenames[i], *index, start, end)));
+        } else {
+            if (query.startDatetime() >= query.endDatetime()) {
+                continue;
+            }
+            result[i].reserve(_estimateCount(*index, query.startDatetime(), query.endDatetime()));
+            sub_sqls.push_back(fmt::format(
+              "(select {} as ix, {} from {} where date >= {} and date < {} order by date)", i,
+              KRECORD_COLUMNS, tablenames[i], query.startDatetime().number(),
+              query.endDatetime().number()));
+        }
+    }
+
+    // 每 BATCH_QUERY_SIZE 个子查询合并为一次请求，结果按 ix 分发
+    for (size_t pos = 0; pos < sub_sqls.size(); pos += BATCH_QUERY_SIZE) {
+        size_t end = std::min(pos + BATCH_QUERY_SIZE, sub_sqls.size());
+        string sql;
+        for (size_t i = pos; i < end; i++) {
+            if (i != pos) {
+                sql.append(" union all ");
+            }
+            sql.append(sub_sqls[i]);
+        }
+        try {
+            SQLStatementPtr st = _getStreamingStatement(sql);
+            st->exec();
+            int64_t ix = 0;
+            while (st->moveNext()) {
+                st->getColumn(0, ix);
+                if (ix >= 0 && ix < int64_t(total)) {
+                    _loadKRecordList(st, 1, result[ix]);
+                }
+            }
+        } catch (std::exception& e) {
+            HKU_ERROR("Failed batch load kdata! {}", e.what());
+        } catch (...) {
+            HKU_ERROR("Failed batch load kdata! Unknown error!");
+        }
+    }
+    return result;
+}
+
 size_t MySQLKDataDriver::getCount(const string& market, const string& code, KQuery::KType kType) {
     size_t result = 0;
 
     try {
-        result = m_connect->queryInt(
-          fmt::format("select count(1) from {}", _getTableName(market, code, kType)));
+        result = _getDateIndex(_getTableName(market, code, kType))->total;
     } catch (...) {
         // 表可能不存在, 不打印异常信息
         result = 0;
@@ -148,10 +394,10 @@ bool MySQLKDataDriver::getIndexRangeByDate(const string& market, const string& c
 
     string tablename = _getTableName(market, code, query.kType());
     try {
-        out_start = m_connect->queryInt(fmt::format("select count(1) from {} where date<{}",
-                                                    tablename, query.startDatetime().number()));
-        out_end = m_connect->queryInt(fmt::format("select count(1) from {} where date<{}",
-                                                  tablename, query.endDatetime().number()));
+        // 借助日期索引，每个端点只需在一个分段内计数
+        DateIndexPtr index = _getDateIndex(tablename);
+        out_start = _countBefore(tablename, *index, query.startDatetime());
+        out_end = _countBefore(tablename, *index, query.endDatetime());
     } catch (...) {
         // 表可能不存在, 不打印异常信息
         out_start = 0;
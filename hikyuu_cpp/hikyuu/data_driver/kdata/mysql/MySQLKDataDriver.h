@@ -9,6 +9,8 @@
 #ifndef MYSQLKDATADRIVERIMP_H_
 #define MYSQLKDATADRIVERIMP_H_
 
+#include <chrono>
+#include <mutex>
 #include "../../../utilities/db_connect/DBConnect.h"
 #include "../../../utilities/db_connect/mysql/MySQLConnect.h"
 #include "../../KDataDriver.h"
@@ -48,15 +50,57 @@ public:
     virtual KRecordList getKRecordList(const string& market, const string& code,
                                        const KQuery& query) override;
 
+    virtual vector<KRecordList> getKRecordListBatch(const string& market,
+                                                    const vector<string>& codes,
+                                                    const KQuery& query) override;
+
+    virtual void invalidateCache() override;
+
 private:
+    /**
+     * 日期稀疏索引，每隔 DATE_INDEX_STEP 条记录保存一个日期，用于将位置索引转换为日期键值定位，
+     * 避免 limit offset 扫描并丢弃大量记录
+     * @note 索引建立后在驱动参数 index_check_interval（秒，默认 5）内直接使用，不逐次查询校验；
+     *       超出该间隔或调用 invalidateCache 后，首次使用时查询最后一条记录的日期，未变化时沿用，
+     *       仅有尾部追加时增量更新，否则重新建立
+     */
+    struct DateIndex {
+        vector<int64_t> dates;  // dates[i] 为第 i * DATE_INDEX_STEP 条记录的日期
+        size_t total = 0;       // 记录总数
+        int64_t last_date = 0;  // 最后一条记录的日期，无记录时为 0
+        std::chrono::steady_clock::time_point check_time;  // 最近一次与数据库校验的时刻
+    };
+    typedef shared_ptr<const DateIndex> DateIndexPtr;
+
+    static constexpr size_t DATE_INDEX_STEP = 256;
+
     string _getTableName(const string& market, const string& code, KQuery::KType ktype);
     KRecordList _getKRecordList(const string& market, const string& code, KQuery::KType kType,
                                 size_t start_ix, size_t end_ix);
     KRecordList _getKRecordList(const string& market, const string& code, KQuery::KType ktype,
                                 Datetime start_date, Datetime end_date);
 
+    SQLStatementPtr _getStreamingStatement(const string& sql);
+    int64_t _queryLastDate(const string& tablename);
+    DateIndexPtr _getDateIndex(const string& tablename);
+    DateIndexPtr _getCachedDateIndex(const string& tablename);
+    vector<DateIndexPtr> _getDateIndexBatch(const vector<string>& tablenames);
+    size_t _countBefore(const string& tablename, const DateIndex& index, const Datetime& date);
+    string _getSelectSQL(const string& columns, const string& tablename, const DateIndex& index,
+                         size_t start_ix, size_t end_ix);
+    static size_t _estimateCount(const DateIndex& index, const Datetime& start_date,
+                                 const Datetime& end_date);
+    static void _loadKRecordList(const SQLStatementPtr& st, int first_column, KRecordList& out);
+
 private:
     MySQLConnect* m_connect;
+    string m_index_prefix;                         // 索引缓存键值前缀，区分不同的数据库服务
+    std::chrono::seconds m_index_check_interval;  // 索引校验间隔
+
+    // 各表的日期索引，以数据库服务地址及表名为键值，由连接同一服务的驱动实例共享
+    static std::mutex ms_index_mutex;
+    static unordered_map<string, DateIndexPtr> ms_index_cache;  // 可直接使用的索引
+    static unordered_map<string, DateIndexPtr> ms_stale_cache;  // 已失效、待校验的索引
 };
 
 } /* namespace hku */
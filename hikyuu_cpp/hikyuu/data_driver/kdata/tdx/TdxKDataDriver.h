@@ -32,6 +32,10 @@ public:
         return true;
     }
 
+    virtual bool isSupportKType(const KQuery::KType& ktype) override {
+        return ktype == KQuery::MIN || ktype == KQuery::MIN5 || ktype == KQuery::DAY;
+    }
+
     virtual size_t getCount(const string& market, const string& code, KQuery::KType kType) override;
     virtual bool getIndexRangeByDate(const string& market, const string& code, const KQuery& query,
                                      size_t& out_start, size_t& out_end) override;
@@ -29,14 +29,23 @@ void releaseGlobalSpotAgent() {
     }
 }
 
-static string getSpotMarketCode(const SpotRecord& spot) {
-    std::stringstream market_code_buf;
-    market_code_buf << spot.market << spot.code;
-    return market_code_buf.str();
+// 优先按 SpotAgent 接收时填写的证券连续编号定位，无需再按代码查找
+static Stock getSpotStock(const SpotRecord& spot) {
+    const StockManager& sm = StockManager::instance();
+    if (spot.stock_id != Null<uint32_t>()) {
+        Stock stk = sm.getStockByDenseId(spot.stock_id);
+        if (!stk.isNull()) {
+            return stk;
+        }
+    }
+    string market_code;
+    market_code.reserve(spot.market.size() + spot.code.size());
+    market_code.append(spot.market).append(spot.code);
+    return sm.getStock(market_code);
 }
 
 static void updateStockDayData(const SpotRecord& spot) {
-    Stock stk = StockManager::instance().getStock(getSpotMarketCode(spot));
+    Stock stk = getSpotStock(spot);
     HKU_IF_RETURN(stk.isNull(), void());
     HKU_IF_RETURN(!stk.isTransactionTime(spot.datetime), void());
     KRecord krecord(Datetime(spot.datetime.year(), spot.datetime.month(), spot.datetime.day()),
@@ -44,121 +53,23 @@ static void updateStockDayData(const SpotRecord& spot) {
     stk.realtimeUpdate(krecord, KQuery::DAY);
 }
 
-static void updateStockDayUpData(const SpotRecord& spot, KQuery::KType ktype) {
-    Stock stk = StockManager::instance().getStock(getSpotMarketCode(spot));
+// 日线以上及分钟级K线由 Stock 内部维护的增量聚合状态更新，无需逐笔查询历史数据
+static void updateStockBarData(const SpotRecord& spot, KQuery::KType ktype) {
+    Stock stk = getSpotStock(spot);
     HKU_IF_RETURN(stk.isNull(), void());
     HKU_IF_RETURN(!stk.isTransactionTime(spot.datetime), void());
-
-    std::function<Datetime(Datetime*)> endOfPhase;
-    std::function<Datetime(Datetime*)> startOfPhase;
-
-    if (KQuery::WEEK == ktype) {
-        endOfPhase = &Datetime::endOfWeek;
-        startOfPhase = &Datetime::startOfWeek;
-    } else if (KQuery::MONTH == ktype) {
-        endOfPhase = &Datetime::endOfMonth;
-        startOfPhase = &Datetime::startOfMonth;
-    } else if (KQuery::QUARTER == ktype) {
-        endOfPhase = &Datetime::endOfQuarter;
-        startOfPhase = &Datetime::startOfQuarter;
-    } else if (KQuery::HALFYEAR == ktype) {
-        endOfPhase = &Datetime::endOfHalfyear;
-        startOfPhase = &Datetime::startOfHalfyear;
-    } else if (KQuery::YEAR == ktype) {
-        endOfPhase = &Datetime::endOfYear;
-        startOfPhase = &Datetime::startOfYear;
-    } else {
-        HKU_THROW("Invalid ktype: {}", ktype);
-    }
-
-    Datetime spot_day = Datetime(spot.datetime.year(), spot.datetime.month(), spot.datetime.day());
-    Datetime spot_end_of_phase = endOfPhase(&spot_day);
-    if (KQuery::WEEK == ktype) {
-        spot_end_of_phase = spot_end_of_phase - TimeDelta(2);  // 周五日期
-    }
-    size_t total = stk.getCount(ktype);
-
-    // 没有历史数据，则直接更新并返回
-    if (total == 0) {
-        stk.realtimeUpdate(KRecord(spot_end_of_phase, spot.open, spot.high, spot.low, spot.close,
-                                   spot.amount, spot.volumn),
-                           ktype);
-        return;
-    }
-
-    KRecord last_record = stk.getKRecord(total - 1, ktype);
-    if (spot_end_of_phase > last_record.datetime) {
-        // 如果当前的日期大于最后记录的日期，则为新增数据，直接更新并返回
-        stk.realtimeUpdate(KRecord(spot_end_of_phase, spot.open, spot.high, spot.low, spot.close,
-                                   spot.amount, spot.volumn),
-                           ktype);
-
-    } else if (spot_end_of_phase == last_record.datetime) {
-        // 如果当前日期等于最后记录的日期，则需要重新计算最高价、最低价、交易金额、交易量
-        Datetime spot_start_of_phase = startOfPhase(&spot_day);
-        KRecordList klist =
-          stk.getKRecordList(KQuery(spot_start_of_phase, spot_end_of_phase + TimeDelta(1), ktype));
-        price_t amount = 0.0, volumn = 0.0;
-        for (auto& k : klist) {
-            amount += k.transAmount;
-            volumn += k.transCount;
-        }
-        stk.realtimeUpdate(
-          KRecord(spot_end_of_phase, last_record.openPrice,
-                  spot.high > last_record.highPrice ? spot.high : last_record.highPrice,
-                  spot.low < last_record.lowPrice ? spot.low : last_record.lowPrice, spot.close,
-                  amount, volumn),
-          ktype);
-    } else {
-        // 不应该出现的情况：当前日期小于最后记录的日期
-        HKU_WARN(
-          "Ignore, What should not happen, the current date is less than the last recorded date!");
-    }
+    stk.realtimeUpdateFromSpot(KRecord(spot.datetime, spot.open, spot.high, spot.low, spot.close,
+                                       spot.amount, spot.volumn),
+                               ktype);
 }
 
-static void updateStockMinData(const SpotRecord& spot, KQuery::KType ktype) {
-    Stock stk = StockManager::instance().getStock(getSpotMarketCode(spot));
+// 分笔、分时缓存由 Stock 内部维护的当日累计成交量状态增量更新
+static void updateStockTickData(const SpotRecord& spot) {
+    Stock stk = getSpotStock(spot);
     HKU_IF_RETURN(stk.isNull(), void());
     HKU_IF_RETURN(!stk.isTransactionTime(spot.datetime), void());
-
-    TimeDelta gap;
-    if (KQuery::MIN == ktype) {
-        gap = TimeDelta(0, 0, 1);
-    } else if (KQuery::MIN5 == ktype) {
-        gap = TimeDelta(0, 0, 5);
-    } else if (KQuery::MIN15 == ktype) {
-        gap = TimeDelta(0, 0, 15);
-    } else if (KQuery::MIN30 == ktype) {
-        gap = TimeDelta(0, 0, 30);
-    } else if (KQuery::MIN60 == ktype) {
-        gap = TimeDelta(0, 0, 60);
-    } else if (KQuery::MIN3 == ktype) {
-        gap = TimeDelta(0, 0, 3);
-    } else if (KQuery::HOUR2 == ktype) {
-        gap = TimeDelta(0, 2);
-    } else if (KQuery::HOUR4 == ktype) {
-        gap = TimeDelta(0, 4);
-    } else if (KQuery::HOUR6 == ktype) {
-        gap = TimeDelta(0, 6);
-    } else if (KQuery::HOUR12 == ktype) {
-        gap = TimeDelta(0, 12);
-    } else {
-        HKU_THROW("Invalid ktype: {}", ktype);
-    }
-
-    Datetime minute = spot.datetime;
-    minute = minute - (minute - minute.startOfDay()) % gap;
-    KRecordList klist = stk.getKRecordList(KQuery(minute, minute + gap, ktype));
-    price_t sum_amount = 0.0, sum_volumn = 0.0;
-    for (auto& k : klist) {
-        sum_amount += k.transAmount;
-        sum_volumn += k.transCount;
-    }
-
-    price_t amount = spot.amount > sum_amount ? spot.amount - sum_amount : spot.amount;
-    price_t volumn = spot.volumn > sum_volumn ? spot.volumn - sum_volumn : spot.volumn;
-    KRecord krecord(minute, spot.open, spot.high, spot.low, spot.close, amount, volumn);
-    stk.realtimeUpdate(krecord, ktype);
+    stk.realtimeUpdateTickFromSpot(KRecord(spot.datetime, spot.open, spot.high, spot.low,
+                                           spot.close, spot.amount, spot.volumn));
 }
 
 void HKU_API startSpotAgent(bool print) {
@@ -169,7 +80,7 @@ void HKU_API startSpotAgent(bool print) {
 
     const auto& preloadParam = StockManager::instance().getPreloadParameter();
     if (preloadParam.tryGet<bool>("min", false)) {
-        agent.addProcess(std::bind(updateStockMinData, std::placeholders::_1, KQuery::MIN));
+        agent.addProcess(std::bind(updateStockBarData, std::placeholders::_1, KQuery::MIN));
     }
 
     if (preloadParam.tryGet<bool>("day", false)) {
@@ -177,59 +88,64 @@ void HKU_API startSpotAgent(bool print) {
     }
 
     if (preloadParam.tryGet<bool>("week", false)) {
-        agent.addProcess(std::bind(updateStockDayUpData, std::placeholders::_1, KQuery::WEEK));
+        agent.addProcess(std::bind(updateStockBarData, std::placeholders::_1, KQuery::WEEK));
     }
 
     if (preloadParam.tryGet<bool>("month", false)) {
-        agent.addProcess(std::bind(updateStockDayUpData, std::placeholders::_1, KQuery::MONTH));
+        agent.addProcess(std::bind(updateStockBarData, std::placeholders::_1, KQuery::MONTH));
     }
 
     if (preloadParam.tryGet<bool>("quarter", false)) {
-        agent.addProcess(std::bind(updateStockDayUpData, std::placeholders::_1, KQuery::QUARTER));
+        agent.addProcess(std::bind(updateStockBarData, std::placeholders::_1, KQuery::QUARTER));
     }
 
     if (preloadParam.tryGet<bool>("halfyear", false)) {
-        agent.addProcess(std::bind(updateStockDayUpData, std::placeholders::_1, KQuery::HALFYEAR));
+        agent.addProcess(std::bind(updateStockBarData, std::placeholders::_1, KQuery::HALFYEAR));
     }
 
     if (preloadParam.tryGet<bool>("year", false)) {
-        agent.addProcess(std::bind(updateStockDayUpData, std::placeholders::_1, KQuery::YEAR));
+        agent.addProcess(std::bind(updateStockBarData, std::placeholders::_1, KQuery::YEAR));
     }
 
     if (preloadParam.tryGet<bool>("min5", false)) {
-        agent.addProcess(std::bind(updateStockMinData, std::placeholders::_1, KQuery::MIN5));
+        agent.addProcess(std::bind(updateStockBarData, std::placeholders::_1, KQuery::MIN5));
     }
 
     if (preloadParam.tryGet<bool>("min15", false)) {
-        agent.addProcess(std::bind(updateStockMinData, std::placeholders::_1, KQuery::MIN15));
+        agent.addProcess(std::bind(updateStockBarData, std::placeholders::_1, KQuery::MIN15));
     }
 
     if (preloadParam.tryGet<bool>("min30", false)) {
-        agent.addProcess(std::bind(updateStockMinData, std::placeholders::_1, KQuery::MIN30));
+        agent.addProcess(std::bind(updateStockBarData, std::placeholders::_1, KQuery::MIN30));
     }
 
     if (preloadParam.tryGet<bool>("min60", false)) {
-        agent.addProcess(std::bind(updateStockMinData, std::placeholders::_1, KQuery::MIN60));
+        agent.addProcess(std::bind(updateStockBarData, std::placeholders::_1, KQuery::MIN60));
     }
 
     if (preloadParam.tryGet<bool>("min3", false)) {
-        agent.addProcess(std::bind(updateStockMinData, std::placeholders::_1, KQuery::MIN3));
+        agent.addProcess(std::bind(updateStockBarData, std::placeholders::_1, KQuery::MIN3));
     }
 
     if (preloadParam.tryGet<bool>("hour2", false)) {
-        agent.addProcess(std::bind(updateStockMinData, std::placeholders::_1, KQuery::HOUR2));
+        agent.addProcess(std::bind(updateStockBarData, std::placeholders::_1, KQuery::HOUR2));
     }
 
     if (preloadParam.tryGet<bool>("hour4", false)) {
-        agent.addProcess(std::bind(updateStockMinData, std::placeholders::_1, KQuery::HOUR4));
+        agent.addProcess(std::bind(updateStockBarData, std::placeholders::_1, KQuery::HOUR4));
     }
 
     if (preloadParam.tryGet<bool>("hour6", false)) {
-        agent.addProcess(std::bind(updateStockMinData, std::placeholders::_1, KQuery::HOUR6));
+        agent.addProcess(std::bind(updateStockBarData, std::placeholders::_1, KQuery::HOUR6));
     }
 
     if (preloadParam.tryGet<bool>("hour12", false)) {
-        agent.addProcess(std::bind(updateStockMinData, std::placeholders::_1, KQuery::HOUR12));
+        agent.addProcess(std::bind(updateStockBarData, std::placeholders::_1, KQuery::HOUR12));
+    }
+
+    if (preloadParam.tryGet<bool>("ticks", false) ||
+        preloadParam.tryGet<bool>("timeline", false)) {
+        agent.addProcess(updateStockTickData);
     }
 
     agent.start();
@@ -8,6 +8,7 @@
 #include <chrono>
 #include <nng/nng.h>
 #include <nng/protocol/pubsub0/sub.h>
+#include "../../StockManager.h"
 #include "SpotAgent.h"
 
 using namespace hikyuu::flat;
@@ -42,65 +43,133 @@ void SpotAgent::stop() {
     }
 }
 
+/** 批量处理任务，按顺序处理 spot 数据中指定位置的数据 */
 class ProcessTask {
 public:
-    ProcessTask(const std::function<void(const SpotRecord&)>& func, const SpotRecord& spot)
-    : m_func(func), m_spot(spot) {}
+    ProcessTask(const std::function<void(const SpotRecord&)>* func, const SpotRecord* data,
+                const vector<uint32_t>* positions)
+    : m_func(func), m_data(data), m_positions(positions) {}
 
     void operator()() {
-        m_func(m_spot);
+        for (auto pos : *m_positions) {
+            const SpotRecord* spot = m_data + pos;
+            try {
+                (*m_func)(*spot);
+            } catch (std::exception& e) {
+                HKU_ERROR("Failed process spot {}{}! {}", spot->market, spot->code, e.what());
+            } catch (...) {
+                HKU_ERROR("Failed process spot {}{}! Unknown error!", spot->market, spot->code);
+            }
+        }
     }
 
 private:
-    std::function<void(const SpotRecord&)> m_func;
-    SpotRecord m_spot;
+    const std::function<void(const SpotRecord&)>* m_func;
+    const SpotRecord* m_data;
+    const vector<uint32_t>* m_positions;
 };
 
-unique_ptr<SpotRecord> SpotAgent::parseFlatSpot(const hikyuu::flat::Spot* spot) {
-    SpotRecord* result = nullptr;
+static inline bool parseDigits(const char* buf, size_t n, long& value) {
+    value = 0;
+    for (size_t i = 0; i < n; i++) {
+        char c = buf[i];
+        if (c < '0' || c > '9') {
+            return false;
+        }
+        value = value * 10 + (c - '0');
+    }
+    return true;
+}
+
+/**
+ * 直接解析 "YYYY-MM-DD HH:MM:SS[.ffffff]" 格式的日期时间，避免通用字符串解析的开销
+ * @return 格式不符时返回 false
+ */
+static bool parseSpotDatetime(const char* buf, size_t len, Datetime& datetime) {
+    if (len < 19 || buf[4] != '-' || buf[7] != '-' || (buf[10] != ' ' && buf[10] != 'T') ||
+        buf[13] != ':' || buf[16] != ':') {
+        return false;
+    }
+
+    long year, month, day, hour, minute, second;
+    if (!parseDigits(buf, 4, year) || !parseDigits(buf + 5, 2, month) ||
+        !parseDigits(buf + 8, 2, day) || !parseDigits(buf + 11, 2, hour) ||
+        !parseDigits(buf + 14, 2, minute) || !parseDigits(buf + 17, 2, second)) {
+        return false;
+    }
+
+    long microsec = 0;
+    if (len > 19) {
+        size_t n = len - 20;
+        if (buf[19] != '.' || n == 0 || n > 6 || !parseDigits(buf + 20, n, microsec)) {
+            return false;
+        }
+        for (; n < 6; n++) {
+            microsec *= 10;
+        }
+    }
+
+    datetime = Datetime(year, month, day, hour, minute, second, microsec / 1000, microsec % 1000);
+    return true;
+}
+
+bool SpotAgent::parseFlatSpot(const hikyuu::flat::Spot* spot, SpotRecord& result) {
     try {
-        result = new SpotRecord;
-        result->market = spot->market()->str();
-        result->code = spot->code()->str();
-        result->name = spot->name()->str();
-        result->datetime = Datetime(spot->datetime()->str());
-        result->yesterday_close = spot->yesterday_close();
-        result->open = spot->open();
-        result->high = spot->high();
-        result->low = spot->low();
-        result->close = spot->close();
-        result->amount = spot->amount();
-        result->volumn = spot->volumn();
-        result->bid1 = spot->bid1();
-        result->bid1_amount = spot->bid1_amount();
-        result->bid2 = spot->bid2();
-        result->bid2_amount = spot->bid2_amount();
-        result->bid3 = spot->bid3();
-        result->bid3_amount = spot->bid3_amount();
-        result->bid4 = spot->bid4();
-        result->bid4_amount = spot->bid4_amount();
-        result->bid5 = spot->bid5();
-        result->bid5_amount = spot->bid5_amount();
-        result->ask1 = spot->ask1();
-        result->ask1_amount = spot->ask1_amount();
-        result->ask2 = spot->ask2();
-        result->ask2_amount = spot->ask2_amount();
-        result->ask3 = spot->ask3();
-        result->ask3_amount = spot->ask3_amount();
-        result->ask4 = spot->ask4();
-        result->ask4_amount = spot->ask4_amount();
-        result->ask5 = spot->ask5();
-        result->ask5_amount = spot->ask5_amount();
+        auto* market = spot->market();
+        auto* code = spot->code();
+        auto* name = spot->name();
+        auto* datetime = spot->datetime();
+        HKU_ERROR_IF_RETURN(!market || !code || !datetime, false,
+                            "Missing spot market, code or datetime!");
+
+        // 复用已有字符串的内存
+        result.market.assign(market->c_str(), market->size());
+        result.code.assign(code->c_str(), code->size());
+        if (name) {
+            result.name.assign(name->c_str(), name->size());
+        } else {
+            result.name.clear();
+        }
+        if (!parseSpotDatetime(datetime->c_str(), datetime->size(), result.datetime)) {
+            result.datetime = Datetime(datetime->str());
+        }
+
+        result.yesterday_close = spot->yesterday_close();
+        result.open = spot->open();
+        result.high = spot->high();
+        result.low = spot->low();
+        result.close = spot->close();
+        result.amount = spot->amount();
+        result.volumn = spot->volumn();
+        result.bid1 = spot->bid1();
+        result.bid1_amount = spot->bid1_amount();
+        result.bid2 = spot->bid2();
+        result.bid2_amount = spot->bid2_amount();
+        result.bid3 = spot->bid3();
+        result.bid3_amount = spot->bid3_amount();
+        result.bid4 = spot->bid4();
+        result.bid4_amount = spot->bid4_amount();
+        result.bid5 = spot->bid5();
+        result.bid5_amount = spot->bid5_amount();
+        result.ask1 = spot->ask1();
+        result.ask1_amount = spot->ask1_amount();
+        result.ask2 = spot->ask2();
+        result.ask2_amount = spot->ask2_amount();
+        result.ask3 = spot->ask3();
+        result.ask3_amount = spot->ask3_amount();
+        result.ask4 = spot->ask4();
+        result.ask4_amount = spot->ask4_amount();
+        result.ask5 = spot->ask5();
+        result.ask5_amount = spot->ask5_amount();
+        return true;
 
     } catch (std::exception& e) {
-        result = nullptr;
         HKU_ERROR(e.what());
     } catch (...) {
-        result = nullptr;
         HKU_ERROR_UNKNOWN;
     }
 
-    return unique_ptr<SpotRecord>(result);
+    return false;
 }
 
 void SpotAgent::parseSpotData(const void* buf, size_t buf_len) {
@@ -111,22 +180,87 @@ void SpotAgent::parseSpotData(const void* buf, size_t buf_len) {
     flatbuffers::Verifier verify(spot_list_buf, buf_len);
     HKU_CHECK(VerifySpotListBuffer(verify), "Invalid data!");
 
-    // 更新日线数据
     auto* spot_list = GetSpotList(spot_list_buf);
     auto* spots = spot_list->spot();
     size_t total = spots->size();
     m_batch_count += total;
+
+    // 每条 spot 只解析一次，解析结果存放于可复用的缓冲区
+    if (m_used_spot_buffers >= m_spot_buffers.size()) {
+        m_spot_buffers.emplace_back();
+    }
+    auto& records = m_spot_buffers[m_used_spot_buffers++];
+    if (records.size() < total) {
+        records.resize(total);
+    }
+
+    // 每条 spot 只查找一次所属证券，各处理函数可据连续编号直接定位
+    const StockManager& sm = StockManager::instance();
+    string market_code;
+    size_t count = 0;
     for (size_t i = 0; i < total; i++) {
-        auto* spot = spots->Get(i);
-        for (auto& process : m_processList) {
-            auto spot_record = parseFlatSpot(spot);
-            if (spot_record) {
-                m_process_task_list.push_back(m_tg.submit(ProcessTask(process, *spot_record)));
+        SpotRecord& record = records[count];
+        if (parseFlatSpot(spots->Get(i), record)) {
+            market_code.assign(record.market).append(record.code);
+            record.stock_id = sm.getStock(market_code).denseId();
+            count++;
+        }
+    }
+    HKU_IF_RETURN(count == 0, void());
+
+    // 按证券连续编号分配至各任务，同一证券的数据总在同一任务中按顺序处理，
+    // 处理函数（如策略的最新行情表）对同一证券只有一个写入者
+    size_t worker_num = m_tg.worker_num() > 0 ? m_tg.worker_num() : 1;
+    if (m_lane_buffers.size() < m_used_spot_buffers) {
+        m_lane_buffers.resize(m_used_spot_buffers);
+    }
+    auto& lanes = m_lane_buffers[m_used_spot_buffers - 1];
+    lanes.resize(worker_num);
+    for (auto& lane : lanes) {
+        lane.clear();
+    }
+    for (size_t i = 0; i < count; i++) {
+        uint32_t id = records[i].stock_id;
+        size_t lane = id != Null<uint32_t>() ? id % worker_num
+                                             : std::hash<string>()(records[i].code) % worker_num;
+        lanes[lane].push_back(uint32_t(i));
+    }
+
+    // 上一条消息中可能有同一证券的数据，需等其处理完毕后再提交，解析仍与其处理并行
+    for (auto& task : m_process_task_list) {
+        task.get();
+    }
+    m_process_task_list.clear();
+
+    const SpotRecord* data = records.data();
+    for (auto& process : m_processList) {
+        for (const auto& lane : lanes) {
+            if (!lane.empty()) {
+                m_process_task_list.push_back(m_tg.submit(ProcessTask(&process, data, &lane)));
             }
         }
     }
 }
 
+void SpotAgent::finishBatch() {
+    for (auto& task : m_process_task_list) {
+        task.get();
+    }
+    m_process_task_list.clear();
+    m_used_spot_buffers = 0;
+    HKU_INFO_IF(m_print, "received count: {}", m_batch_count);
+    m_batch_count = 0;
+
+    // 执行后处理
+    for (auto& postProcess : m_postProcessList) {
+        postProcess(ms_start_rev_time);
+    }
+
+    m_batchLatency.add(std::chrono::duration_cast<std::chrono::microseconds>(
+                         std::chrono::steady_clock::now() - m_batch_start)
+                         .count());
+}
+
 void SpotAgent::work_thread() {
     nng_socket sock;
 
@@ -164,22 +298,14 @@ void SpotAgent::work_thread() {
                 case WAITING:
                     if (memcmp(buf, ms_startTag, ms_startTagLength) == 0) {
                         ms_start_rev_time = Datetime::now();
+                        m_batch_start = std::chrono::steady_clock::now();
                         m_status = RECEIVING;
                     }
                     break;
                 case RECEIVING:
                     if (memcmp(buf, ms_endTag, ms_endTagLength) == 0) {
                         m_status = WAITING;
-                        for (auto& task : m_process_task_list) {
-                            task.get();
-                        }
-                        HKU_INFO_IF(m_print, "received count: {}", m_batch_count);
-                        m_batch_count = 0;
-                        // 执行后处理
-                        for (auto& postProcess : m_postProcessList) {
-                            postProcess(ms_start_rev_time);
-                        }
-                        m_process_task_list.clear();
+                        finishBatch();
                     } else {
                         HKU_CHECK(memcmp(buf, ms_startTag, ms_startTagLength) != 0,
                                   "Data not received in time, maybe the send speed is too fast!");
@@ -7,11 +7,14 @@
 
 #pragma once
 
+#include <deque>
 #include <thread>
+#include <chrono>
 #include <functional>
 #include "spot_generated.h"
 #include "../../DataType.h"
 #include "../../utilities/thread/ThreadPool.h"
+#include "../../utilities/LatencyHistogram.h"
 
 namespace hku {
 
@@ -51,6 +54,9 @@ struct HKU_API SpotRecord {
     price_t ask4_amount;      ///< 卖四数量
     price_t ask5;             ///< 卖五价
     price_t ask5_amount;      ///< 卖五数量
+
+    /// 所属证券的连续编号（@see Stock::denseId），由 SpotAgent 接收时填写，无对应证券时为 Null
+    uint32_t stock_id = Null<uint32_t>();
 };
 
 /**
@@ -82,6 +88,8 @@ public:
 
     /**
      * 增加收到 Spot 数据时的处理函数
+     * @details 不同证券的数据并行处理；同一证券的数据始终在同一任务中按接收顺序处理，
+     *          处理函数对同一证券不会被并发调用
      * @note 仅能在停止状态时执行此操作，否则将抛出异常
      * @param process 处理函数，仅处理单条 spot 数据
      */
@@ -107,6 +115,14 @@ public:
      */
     void clearPostProcessList();
 
+    /**
+     * 批次数据处理耗时分布（微秒），自收到批次起始标记至全部处理及后处理完毕
+     * @note 可在代理运行时读取
+     */
+    const LatencyHistogram& getBatchLatency() const {
+        return m_batchLatency;
+    }
+
 private:
     static const char* ms_pubUrl;  // 数据发送服务地址
     static const char* ms_startTag;  // 批次数据接收起始标记，用于判断启动了新的批次数据接收
@@ -124,8 +140,9 @@ private:
     SpotAgent& operator=(const SpotAgent&) = delete;
     SpotAgent& operator=(SpotAgent&&) = delete;
 
-    unique_ptr<SpotRecord> parseFlatSpot(const hikyuu::flat::Spot* spot);
+    bool parseFlatSpot(const hikyuu::flat::Spot* spot, SpotRecord& record);
     void parseSpotData(const void* buf, size_t buf_len);
+    void finishBatch();
 
     void work_thread();
 
@@ -141,6 +158,18 @@ private:
     list<std::function<void(const SpotRecord&)>> m_processList;  // 已注册的 spot 处理函数列表
     list<std::function<void(Datetime)>> m_postProcessList;  // 已注册的批次后处理函数列表
     vector<std::future<void>> m_process_task_list;
+
+    // 解析后的 spot 数据缓冲区，每条批次消息使用其中一个，批次结束后复用，避免重复分配内存；
+    // 处理任务持有其中元素的指针，故在批次结束（全部任务完成）前不得修改已使用的缓冲区
+    vector<vector<SpotRecord>> m_spot_buffers;
+    size_t m_used_spot_buffers = 0;  // 本批次已使用的缓冲区数量
+
+    // 与 m_spot_buffers 一一对应，按证券分配至各处理任务的 spot 数据位置，同一证券总在同一任务中
+    // 处理任务持有其中各位置列表的指针，使用 deque 保证扩充时已有元素的地址不变
+    std::deque<vector<vector<uint32_t>>> m_lane_buffers;
+
+    std::chrono::steady_clock::time_point m_batch_start;  // 本批次开始接收的时刻
+    LatencyHistogram m_batchLatency;                      // 批次处理耗时分布
 };
 
 }  // namespace hku
\ No newline at end of file
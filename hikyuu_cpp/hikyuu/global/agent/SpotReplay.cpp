@@ -0,0 +1,232 @@
+/*
+ *  Copyright(C) 2026 hikyuu.org
+ *
+ *  Create on: 2026-10-18
+ *     Author: fasiondog
+ */
+
+#include <chrono>
+#include <cstring>
+#include <nng/nng.h>
+#include <nng/protocol/pubsub0/pub.h>
+#include <nng/protocol/pubsub0/sub.h>
+#include "SpotReplay.h"
+
+namespace hku {
+
+static const char g_spot_file_header[8] = {'H', 'K', 'U', 'S', 'P', 'O', 'T', 1};
+static const char* g_spot_topic = ":spot:";
+
+static void putLittleEndian(char* buf, uint64_t value, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        buf[i] = char(value & 0xff);
+        value >>= 8;
+    }
+}
+
+static uint64_t getLittleEndian(const char* buf, size_t n) {
+    uint64_t value = 0;
+    for (size_t i = n; i > 0; i--) {
+        value = (value << 8) | uint8_t(buf[i - 1]);
+    }
+    return value;
+}
+
+static int64_t nowMicroseconds() {
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+             std::chrono::system_clock::now().time_since_epoch())
+      .count();
+}
+
+SpotRecordWriter::~SpotRecordWriter() {
+    close();
+}
+
+bool SpotRecordWriter::open(const string& filename) {
+    close();
+    m_count = 0;
+
+    // 已有文件需校验文件头
+    std::ifstream exist(filename, std::ios::binary);
+    bool has_header = false;
+    if (exist) {
+        char header[sizeof(g_spot_file_header)];
+        exist.read(header, sizeof(header));
+        if (exist.gcount() > 0) {
+            HKU_ERROR_IF_RETURN(
+              exist.gcount() != sizeof(header) ||
+                memcmp(header, g_spot_file_header, sizeof(header)) != 0,
+              false, "Invalid spot record file: {}", filename);
+            has_header = true;
+        }
+    }
+    exist.close();
+
+    m_file.open(filename, std::ios::binary | std::ios::app);
+    HKU_ERROR_IF_RETURN(!m_file, false, "Can't open file: {}", filename);
+    if (!has_header) {
+        m_file.write(g_spot_file_header, sizeof(g_spot_file_header));
+    }
+    return true;
+}
+
+void SpotRecordWriter::close() {
+    if (m_file.is_open()) {
+        m_file.close();
+    }
+}
+
+void SpotRecordWriter::write(const void* buf, size_t len, int64_t time_us) {
+    HKU_IF_RETURN(!m_file.is_open(), void());
+    HKU_ERROR_IF_RETURN(len > MAX_MESSAGE_SIZE, void(), "Too long spot message: {}", len);
+    char head[12];
+    putLittleEndian(head, uint64_t(time_us), 8);
+    putLittleEndian(head + 8, uint64_t(len), 4);
+    m_file.write(head, sizeof(head));
+    m_file.write((const char*)buf, len);
+    m_count++;
+}
+
+bool SpotRecordReader::open(const string& filename) {
+    if (m_file.is_open()) {
+        m_file.close();
+    }
+    m_file.open(filename, std::ios::binary | std::ios::ate);
+    HKU_ERROR_IF_RETURN(!m_file, false, "Can't open file: {}", filename);
+    m_file_size = size_t(m_file.tellg());
+    m_file.seekg(0);
+    char header[sizeof(g_spot_file_header)];
+    m_file.read(header, sizeof(header));
+    HKU_ERROR_IF_RETURN(m_file.gcount() != sizeof(header) ||
+                          memcmp(header, g_spot_file_header, sizeof(header)) != 0,
+                        false, "Invalid spot record file: {}", filename);
+    return true;
+}
+
+bool SpotRecordReader::next(string& buf, int64_t& time_us) {
+    HKU_IF_RETURN(!m_file.is_open(), false);
+    char head[12];
+    m_file.read(head, sizeof(head));
+    HKU_IF_RETURN(m_file.gcount() != sizeof(head), false);
+    time_us = int64_t(getLittleEndian(head, 8));
+    size_t len = size_t(getLittleEndian(head + 8, 4));
+
+    // 长度字段可能已损坏，分配内存前先校验
+    size_t pos = size_t(m_file.tellg());
+    size_t remain = pos < m_file_size ? m_file_size - pos : 0;
+    HKU_WARN_IF_RETURN(len > SpotRecordWriter::MAX_MESSAGE_SIZE || len > remain, false,
+                       "Invalid spot record length: {}, remaining bytes: {}", len, remain);
+    buf.resize(len);
+    m_file.read(&buf[0], len);
+    HKU_WARN_IF_RETURN(size_t(m_file.gcount()) != len, false, "Incomplete spot record!");
+    return true;
+}
+
+SpotRecorder::SpotRecorder(const string& filename, const string& url)
+: m_filename(filename), m_url(url) {}
+
+SpotRecorder::~SpotRecorder() {
+    stop();
+}
+
+void SpotRecorder::start() {
+    HKU_IF_RETURN(!m_stop, void());
+    HKU_CHECK(m_writer.open(m_filename), "Can't open spot record file: {}", m_filename);
+    m_count = 0;
+    m_stop = false;
+    m_thread = std::thread([this]() { work_thread(); });
+}
+
+void SpotRecorder::stop() {
+    m_stop = true;
+    if (m_thread.joinable()) {
+        m_thread.join();
+    }
+    m_writer.close();
+}
+
+void SpotRecorder::work_thread() {
+    nng_socket sock;
+    int rv = nng_sub0_open(&sock);
+    HKU_ERROR_IF_RETURN(rv != 0, void(), "Can't open nng sub0! {}", nng_strerror(rv));
+
+    rv = nng_setopt(sock, NNG_OPT_SUB_SUBSCRIBE, g_spot_topic, strlen(g_spot_topic));
+    HKU_ERROR_IF_RETURN(rv != 0, void(), "Failed set nng socket option! {}", nng_strerror(rv));
+
+    rv = nng_setopt_ms(sock, NNG_OPT_RECVTIMEO, 100);
+    HKU_ERROR_IF_RETURN(rv != 0, void(), "Failed set receive timeout option!");
+
+    rv = -1;
+    while (!m_stop && rv != 0) {
+        rv = nng_dial(sock, m_url.c_str(), nullptr, 0);
+        if (rv != 0) {
+            HKU_WARN("Failed nng_dial {}, will retry after 1 seconds!", m_url);
+            std::this_thread::sleep_for(std::chrono::seconds(1));
+        }
+    }
+
+    while (!m_stop) {
+        char* buf = nullptr;
+        size_t length = 0;
+        rv = nng_recv(sock, &buf, &length, NNG_FLAG_ALLOC);
+        if (rv == 0 && buf && length > 0) {
+            m_writer.write(buf, length, nowMicroseconds());
+            m_count++;
+        }
+        if (buf) {
+            nng_free(buf, length);
+        }
+    }
+
+    nng_close(sock);
+}
+
+SpotReplayer::SpotReplayer(const string& filename, const string& url)
+: m_filename(filename), m_url(url) {}
+
+size_t SpotReplayer::run(double speed, int wait_ms) {
+    SpotRecordReader reader;
+    HKU_CHECK(reader.open(m_filename), "Can't open spot record file: {}", m_filename);
+
+    nng_socket sock;
+    int rv = nng_pub0_open(&sock);
+    HKU_CHECK(rv == 0, "Can't open nng pub0! {}", nng_strerror(rv));
+    rv = nng_listen(sock, m_url.c_str(), nullptr, 0);
+    if (rv != 0) {
+        nng_close(sock);
+        HKU_THROW("Failed listen {}! {}", m_url, nng_strerror(rv));
+    }
+
+    if (wait_ms > 0) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(wait_ms));
+    }
+
+    // 按录制时的时间间隔（除以回放速度）发布
+    size_t count = 0;
+    string buf;
+    int64_t time_us = 0, first_time_us = 0;
+    auto start = std::chrono::steady_clock::now();
+    while (reader.next(buf, time_us)) {
+        if (count == 0) {
+            first_time_us = time_us;
+        }
+        if (speed > 0.0) {
+            auto offset =
+              std::chrono::microseconds(int64_t(double(time_us - first_time_us) / speed));
+            std::this_thread::sleep_until(start + offset);
+        }
+        rv = nng_send(sock, &buf[0], buf.size(), 0);
+        if (rv != 0) {
+            HKU_ERROR("Failed nng_send! {}", nng_strerror(rv));
+            break;
+        }
+        count++;
+    }
+
+    // 关闭前稍作等待，以便已发布的消息送达
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    nng_close(sock);
+    return count;
+}
+
+}  // namespace hku
@@ -0,0 +1,160 @@
+/*
+ *  Copyright(C) 2026 hikyuu.org
+ *
+ *  Create on: 2026-10-18
+ *     Author: fasiondog
+ */
+
+#pragma once
+
+#include <atomic>
+#include <fstream>
+#include <thread>
+#include "../../DataType.h"
+
+namespace hku {
+
+/**
+ * spot 数据录制文件写入
+ * @details 文件为仅追加的二进制格式：8 字节文件头 "HKUSPOT" + 版本号，其后依次为各条
+ *          消息。每条消息为 8 字节接收时刻（自 1970-01-01 起的微秒数）、4 字节消息长度及
+ *          原始消息内容，整数均为小端字节序。消息内容为数据服务发布的原始数据，包含批次
+ *          起始、结束标记。
+ * @ingroup Agent
+ */
+class HKU_API SpotRecordWriter {
+public:
+    /** 单条消息的最大长度，超出的消息不写入，读取时视为文件损坏 */
+    static constexpr size_t MAX_MESSAGE_SIZE = 64 * 1024 * 1024;
+
+    SpotRecordWriter() = default;
+    ~SpotRecordWriter();
+
+    /**
+     * 打开文件，文件已存在时在其后追加
+     * @return 文件无法打开或已有文件格式不符时返回 false
+     */
+    bool open(const string& filename);
+
+    /** 关闭文件 */
+    void close();
+
+    /** 是否已打开 */
+    bool isOpen() const {
+        return m_file.is_open();
+    }
+
+    /**
+     * 写入一条消息
+     * @param buf 消息内容
+     * @param len 消息长度
+     * @param time_us 接收时刻（自 1970-01-01 起的微秒数）
+     */
+    void write(const void* buf, size_t len, int64_t time_us);
+
+    /** 已写入的消息数 */
+    size_t count() const {
+        return m_count;
+    }
+
+private:
+    std::ofstream m_file;
+    size_t m_count = 0;
+};
+
+/**
+ * spot 数据录制文件读取，格式参见 SpotRecordWriter
+ * @ingroup Agent
+ */
+class HKU_API SpotRecordReader {
+public:
+    SpotRecordReader() = default;
+
+    /**
+     * 打开文件
+     * @return 文件无法打开或格式不符时返回 false
+     */
+    bool open(const string& filename);
+
+    /**
+     * 读取下一条消息
+     * @param buf [out] 消息内容，复用已有内存
+     * @param time_us [out] 接收时刻（自 1970-01-01 起的微秒数）
+     * @return 已读至文件末尾、文件不完整或消息长度无效时返回 false
+     * @note 消息长度超过 SpotRecordWriter::MAX_MESSAGE_SIZE 或打开时文件的剩余字节数时，
+     *       视为文件损坏，不分配内存直接返回 false
+     */
+    bool next(string& buf, int64_t& time_us);
+
+private:
+    std::ifstream m_file;
+    size_t m_file_size = 0;  // 打开时的文件大小
+};
+
+/**
+ * 录制数据服务发布的 spot 数据
+ * @ingroup Agent
+ */
+class HKU_API SpotRecorder {
+public:
+    /**
+     * 构造函数
+     * @param filename 录制文件，已存在时在其后追加
+     * @param url 数据服务地址
+     */
+    explicit SpotRecorder(const string& filename,
+                          const string& url = "ipc:///tmp/hikyuu_real_pub.ipc");
+    ~SpotRecorder();
+
+    /** 启动录制，文件无法打开时抛出异常 */
+    void start();
+
+    /** 停止录制 */
+    void stop();
+
+    /** 已录制的消息数 */
+    size_t count() const {
+        return m_count;
+    }
+
+private:
+    void work_thread();
+
+private:
+    string m_filename;
+    string m_url;
+    SpotRecordWriter m_writer;
+    std::atomic_bool m_stop = true;
+    std::atomic<size_t> m_count = 0;
+    std::thread m_thread;
+};
+
+/**
+ * 回放录制的 spot 数据，以发布服务的方式供 SpotAgent 接收
+ * @ingroup Agent
+ */
+class HKU_API SpotReplayer {
+public:
+    /**
+     * 构造函数
+     * @param filename 录制文件
+     * @param url 发布地址，默认与数据服务地址相同
+     */
+    explicit SpotReplayer(const string& filename,
+                          const string& url = "ipc:///tmp/hikyuu_real_pub.ipc");
+
+    /**
+     * 回放全部消息，阻塞至回放结束
+     * @note 最快速度回放时，如接收方处理不及，消息可能被发布端丢弃
+     * @param speed 回放速度，1 为按原始时间间隔，大于 1 为加速，小于等于 0 为最快速度
+     * @param wait_ms 开始发布前的等待时长（毫秒），用于等待接收方完成连接
+     * @return 已发布的消息数，文件或发布地址无法打开时抛出异常
+     */
+    size_t run(double speed = 1.0, int wait_ms = 0);
+
+private:
+    string m_filename;
+    string m_url;
+};
+
+}  // namespace hku
@@ -19,6 +19,16 @@ namespace hku {
 
 static Parameter g_hikyuu_context;
 
+/* 数值型预加载参数，取值 "0"、"1" 时不能按布尔值解析 */
+static bool isPreloadIntOption(const string& name) {
+    auto ends_with = [&](const string& suffix) {
+        return name.size() > suffix.size() &&
+               name.compare(name.size() - suffix.size(), suffix.size(), suffix) == 0;
+    };
+    return ends_with("_max") || ends_with("_priority") || name == "memory_limit" ||
+           name == "io_concurrency";
+}
+
 void hikyuu_init(const string& config_file_name, bool ignore_preload,
                  const StrategyContext& context) {
     IniParser config;
@@ -66,6 +76,17 @@ void hikyuu_init(const string& config_file_name, bool ignore_preload,
     option = config.getOptionList("preload");
 
     for (auto iter = option->begin(); iter != option->end(); ++iter) {
+        if (isPreloadIntOption(*iter)) {
+            if (!ignore_preload) {
+                try {
+                    preloadParam.set<int>(*iter, config.getInt("preload", *iter));
+                } catch (...) {
+                    HKU_WARN("Invalid option: {}", *iter);
+                }
+            }
+            continue;
+        }
+
         try {
             preloadParam.set<bool>(*iter,
                                    ignore_preload ? false : config.getBool("preload", *iter));
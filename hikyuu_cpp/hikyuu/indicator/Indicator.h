@@ -132,6 +132,14 @@ public:
      */
     PriceList getResultAsPriceList(size_t num) const;
 
+    /**
+     * 获取指定结果集的数据地址，可直接访问 size() 个连续的数据
+     * @param num 指定的结果集
+     * @return 结果集不存在时返回 nullptr
+     * @note 指标重新计算（如 setContext）后原地址失效
+     */
+    const price_t* data(size_t num = 0) const;
+
     /**
      * 获取 DatetimeList
      */
@@ -208,6 +216,10 @@ inline size_t Indicator::size() const {
     return m_imp ? m_imp->size() : 0;
 }
 
+inline const price_t* Indicator::data(size_t num) const {
+    return m_imp ? m_imp->data(num) : nullptr;
+}
+
 inline Indicator Indicator::operator()() {
     return clone();
 }
@@ -202,6 +202,11 @@ PriceList IndicatorImp::getResultAsPriceList(size_t result_num) {
     return (*m_pBuffer[result_num]);
 }
 
+const price_t* IndicatorImp::data(size_t result_num) const {
+    HKU_IF_RETURN(result_num >= m_result_num || m_pBuffer[result_num] == NULL, nullptr);
+    return m_pBuffer[result_num]->data();
+}
+
 IndicatorImpPtr IndicatorImp::getResult(size_t result_num) {
     HKU_IF_RETURN(result_num >= m_result_num || m_pBuffer[result_num] == NULL, IndicatorImpPtr());
     IndicatorImpPtr imp = make_shared<IndicatorImp>();
@@ -35,6 +35,8 @@
 #include <boost/serialization/shared_ptr.hpp>
 #include <boost/serialization/assume_abstract.hpp>
 #include <boost/serialization/base_object.hpp>
+#include <boost/serialization/version.hpp>
+#include "../serialization/BinaryArray_serialization.h"
 
 // linux 下，PriceList_serialization 始终无法特化（及时拷贝到本文件内也一样），取消引用
 //#if HKU_SUPPORT_XML_ARCHIVE || HKU_SUPPORT_TEXT_ARCHIVE
@@ -109,6 +111,9 @@ public:
     /** 以PriceList方式获取指定的输出集 */
     PriceList getResultAsPriceList(size_t result_num);
 
+    /** 获取指定输出集的数据地址，输出集不存在时返回 nullptr，重新计算后失效 */
+    const price_t* data(size_t result_num = 0) const;
+
     /** 以Indicator的方式获取指定的输出集，该方式包含了discard的信息 */
     IndicatorImpPtr getResult(size_t result_num);
 
@@ -220,6 +225,14 @@ private:
             }
         }
         ar& BOOST_SERIALIZATION_NVP(act_result_num);
+        if constexpr (is_binary_archive<Archive>::value) {
+            // 二进制存档直接保存原始数组
+            for (size_t i = 0; i < act_result_num; ++i) {
+                save_binary_array(ar, m_pBuffer[i]->data(), m_pBuffer[i]->size());
+            }
+            return;
+        }
+
         string nan("nan");
         string inf;
         for (size_t i = 0; i < act_result_num; ++i) {
@@ -253,6 +266,17 @@ private:
         ar& BOOST_SERIALIZATION_NVP(m_three);
         size_t act_result_num = 0;
         ar& BOOST_SERIALIZATION_NVP(act_result_num);
+        if constexpr (is_binary_archive<Archive>::value) {
+            // 版本 0 的二进制存档仍为逐项保存
+            if (version >= 1) {
+                for (size_t i = 0; i < act_result_num; ++i) {
+                    m_pBuffer[i] = new PriceList();
+                    load_binary_array(ar, *m_pBuffer[i]);
+                }
+                return;
+            }
+        }
+
         for (size_t i = 0; i < act_result_num; ++i) {
             m_pBuffer[i] = new PriceList();
             size_t count = 0;
@@ -344,4 +368,9 @@ inline KData IndicatorImp::getContext() const {
 
 } /* namespace hku */
 
+#if HKU_SUPPORT_SERIALIZATION
+// 版本 1：二进制存档中的结果数组改为紧凑格式保存
+BOOST_CLASS_VERSION(hku::IndicatorImp, 1)
+#endif
+
 #endif /* INDICATORIMP_H_ */
@@ -40,6 +40,19 @@ void ITimeLine::_calculate(const Indicator& data) {
     KQuery q = k.getQuery();
     Stock stk = k.getStock();
 
+    bool is_price = getParam<string>("part") == "price";
+
+    // 分时数据已缓存时，直接从列式缓存中复制
+    PriceList values;
+    if (stk.getTimeLineFromBuffer(q, !is_price, values)) {
+        size_t total = values.size();
+        HKU_IF_RETURN(total == 0, void());
+        _readyBuffer(total, 1);
+        m_discard = 0;
+        std::copy(values.begin(), values.end(), m_pBuffer[0]->begin());
+        return;
+    }
+
     TimeLineList time_line = stk.getTimeLineList(q);
     size_t total = time_line.size();
     HKU_IF_RETURN(total == 0, void());
@@ -47,7 +60,7 @@ void ITimeLine::_calculate(const Indicator& data) {
     _readyBuffer(total, 1);
 
     m_discard = 0;
-    if (getParam<string>("part") == "price") {
+    if (is_price) {
         for (size_t i = m_discard; i < total; i++) {
             _set(time_line[i].price, i);
         }
@@ -0,0 +1,95 @@
+/*
+ *  Copyright(C) 2026 hikyuu.org
+ *
+ *  Create on: 2026-10-18
+ *     Author: fasiondog
+ */
+
+#pragma once
+#ifndef BINARYARRAY_SERIALIZATION_H_
+#define BINARYARRAY_SERIALIZATION_H_
+
+#include "../config.h"
+#include "../DataType.h"
+
+#if HKU_SUPPORT_SERIALIZATION
+#include <algorithm>
+#include <boost/endian/conversion.hpp>
+
+namespace boost {
+namespace archive {
+class binary_oarchive;
+class binary_iarchive;
+}  // namespace archive
+}  // namespace boost
+
+namespace hku {
+
+/**
+ * 是否为二进制存档，二进制存档中的数值数组及枚举值以紧凑格式保存，文本与 xml 存档保持可移植格式
+ */
+template <class Archive>
+struct is_binary_archive : std::false_type {};
+
+template <>
+struct is_binary_archive<boost::archive::binary_oarchive> : std::true_type {};
+
+template <>
+struct is_binary_archive<boost::archive::binary_iarchive> : std::true_type {};
+
+/** 逐元素翻转字节序 */
+inline void reverse_array_bytes(char* data, size_t item_size, size_t count) {
+    for (size_t i = 0; i < count; i++) {
+        std::reverse(data + i * item_size, data + (i + 1) * item_size);
+    }
+}
+
+/**
+ * 以紧凑格式保存数值数组，仅用于二进制存档
+ * @details 依次保存元素字节数、元素个数及小端字节序的原始数据，nan、inf 按位原样保存
+ */
+template <class Archive, typename T>
+void save_binary_array(Archive& ar, const T* data, size_t count) {
+    static_assert(std::is_arithmetic<T>::value, "Only support arithmetic type!");
+    uint32_t item_size = sizeof(T);
+    uint64_t total = count;
+    ar << item_size;
+    ar << total;
+    HKU_IF_RETURN(count == 0, void());
+
+    if (boost::endian::order::native == boost::endian::order::little) {
+        ar.save_binary(data, count * sizeof(T));
+    } else {
+        vector<char> buf((const char*)data, (const char*)data + count * sizeof(T));
+        reverse_array_bytes(buf.data(), sizeof(T), count);
+        ar.save_binary(buf.data(), buf.size());
+    }
+}
+
+/**
+ * 读取由 save_binary_array 保存的数值数组
+ * @exception 元素字节数与 T 不一致时抛出 hku::exception
+ */
+template <class Archive, typename T>
+void load_binary_array(Archive& ar, vector<T>& out) {
+    static_assert(std::is_arithmetic<T>::value, "Only support arithmetic type!");
+    uint32_t item_size = 0;
+    uint64_t total = 0;
+    ar >> item_size;
+    ar >> total;
+    HKU_CHECK(item_size == sizeof(T), "Mismatched item size in archive: {}, expected: {}",
+              item_size, sizeof(T));
+
+    out.resize(total);
+    HKU_IF_RETURN(total == 0, void());
+    ar.load_binary(out.data(), total * sizeof(T));
+    if (boost::endian::order::native != boost::endian::order::little) {
+        reverse_array_bytes((char*)out.data(), sizeof(T), total);
+    }
+}
+
+}  // namespace hku
+
+#endif /* HKU_SUPPORT_SERIALIZATION */
+
+#endif /* BINARYARRAY_SERIALIZATION_H_ */
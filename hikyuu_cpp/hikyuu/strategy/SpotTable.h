@@ -0,0 +1,216 @@
+/*
+ *  Copyright(C) 2026 hikyuu.org
+ *
+ *  Create on: 2026-10-18
+ *     Author: fasiondog
+ */
+
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include "../Stock.h"
+#include "../global/agent/SpotAgent.h"
+
+namespace hku {
+
+/**
+ * 各证券最新行情表
+ * @details 初始化时按证券列表预分配定长槽位，之后不再分配内存。每个槽位以序列号（seqlock）
+ *          保护：写入时序列号为奇数，写入完成后为偶数；读取方在序列号前后一致且为偶数时
+ *          得到一致的快照，否则重试。写入方不加锁、不等待，读取方不会阻塞写入方。
+ *          不同槽位可在多个线程中同时写入（update），但同一槽位同一时刻只能有一个写入方
+ *          （SpotAgent 保证同一证券的行情在同一任务中按顺序处理）；读取（get）可在任意线程中
+ *          进行；collectChanged 仅能在同一个读取线程中调用。
+ * @note init 不能与其他操作并发执行
+ * @ingroup Strategy
+ */
+class SpotTable {
+public:
+    SpotTable() = default;
+
+    /** 按证券列表初始化，槽位编号即为证券在列表中的位置，无效证券将被忽略 */
+    void init(const StockList& stock_list) {
+        m_stock_list.clear();
+        m_index.clear();
+        m_slot_by_id.clear();
+        m_stock_list.reserve(stock_list.size());
+        for (const auto& stk : stock_list) {
+            if (!stk.isNull() && m_index.find(stk.market_code()) == m_index.end()) {
+                size_t slot = m_stock_list.size();
+                m_index[stk.market_code()] = slot;
+                m_stock_list.push_back(stk);
+                uint32_t id = stk.denseId();
+                if (id != Null<uint32_t>()) {
+                    if (id >= m_slot_by_id.size()) {
+                        m_slot_by_id.resize(size_t(id) + 1, Null<size_t>());
+                    }
+                    m_slot_by_id[id] = slot;
+                }
+            }
+        }
+        m_slots.reset(m_stock_list.empty() ? nullptr : new Slot[m_stock_list.size()]);
+        m_last_seen.assign(m_stock_list.size(), 0);
+    }
+
+    /** 槽位数量 */
+    size_t size() const {
+        return m_stock_list.size();
+    }
+
+    /** 槽位对应的证券 */
+    const Stock& getStock(size_t slot) const {
+        return m_stock_list[slot];
+    }
+
+    /** 证券对应的槽位，不存在时返回 Null<size_t>() */
+    size_t getSlot(const Stock& stk) const {
+        // 优先按证券连续编号直接定位
+        uint32_t id = stk.denseId();
+        if (id < m_slot_by_id.size()) {
+            size_t slot = m_slot_by_id[id];
+            if (slot != Null<size_t>() && m_stock_list[slot] == stk) {
+                return slot;
+            }
+        }
+        HKU_IF_RETURN(stk.isNull(), Null<size_t>());
+        auto iter = m_index.find(stk.market_code());
+        return iter != m_index.end() ? iter->second : Null<size_t>();
+    }
+
+    /**
+     * 更新行情，按 SpotAgent 填写的证券连续编号直接定位槽位
+     * @return 行情所属证券不在表中时返回 false
+     */
+    bool update(const SpotRecord& spot) {
+        size_t slot = Null<size_t>();
+        if (spot.stock_id < m_slot_by_id.size()) {
+            slot = m_slot_by_id[spot.stock_id];
+        }
+        if (slot == Null<size_t>() || m_stock_list[slot].denseId() != spot.stock_id) {
+            // 非 SpotAgent 接收的行情（未填写连续编号）或连续编号已变化时，按代码查找
+            HKU_IF_RETURN(spot.stock_id < m_slot_by_id.size() && slot == Null<size_t>(), false);
+            string market_code(spot.market);
+            market_code.append(spot.code);
+            to_upper(market_code);
+            auto iter = m_index.find(market_code);
+            HKU_IF_RETURN(iter == m_index.end(), false);
+            slot = iter->second;
+        }
+        update(slot, spot);
+        return true;
+    }
+
+    /**
+     * 更新指定槽位的行情
+     * @note 同一槽位同一时刻只能有一个写入方
+     */
+    void update(size_t slot, const SpotRecord& spot) {
+        Slot& s = m_slots[slot];
+        uint64_t seq = s.seq.load(std::memory_order_relaxed);
+        s.seq.store(seq + 1, std::memory_order_relaxed);
+        // 保证序列号变为奇数先于以下数据写入对读取方可见
+        std::atomic_thread_fence(std::memory_order_release);
+
+        s.datetime.store(spot.datetime.isNull() ? Null<int64_t>()
+                                                : (spot.datetime - Datetime::min()).ticks(),
+                         std::memory_order_relaxed);
+        const price_t values[VALUE_COUNT] = {
+          spot.yesterday_close, spot.open,        spot.high,        spot.low,
+          spot.close,           spot.amount,      spot.volumn,      spot.bid1,
+          spot.bid1_amount,     spot.bid2,        spot.bid2_amount, spot.bid3,
+          spot.bid3_amount,     spot.bid4,        spot.bid4_amount, spot.bid5,
+          spot.bid5_amount,     spot.ask1,        spot.ask1_amount, spot.ask2,
+          spot.ask2_amount,     spot.ask3,        spot.ask3_amount, spot.ask4,
+          spot.ask4_amount,     spot.ask5,        spot.ask5_amount};
+        for (size_t i = 0; i < VALUE_COUNT; i++) {
+            s.values[i].store(values[i], std::memory_order_relaxed);
+        }
+
+        s.seq.store(seq + 2, std::memory_order_release);
+    }
+
+    /**
+     * 读取指定槽位的最新行情快照
+     * @return 该槽位尚无行情时返回 false
+     */
+    bool get(size_t slot, SpotRecord& spot) const {
+        HKU_IF_RETURN(slot >= size(), false);
+        const Slot& s = m_slots[slot];
+        int64_t datetime = 0;
+        price_t values[VALUE_COUNT];
+        uint64_t seq1 = 0, seq2 = 0;
+        do {
+            seq1 = s.seq.load(std::memory_order_acquire);
+            if (seq1 & 1) {
+                seq2 = seq1 + 1;
+                continue;
+            }
+            datetime = s.datetime.load(std::memory_order_relaxed);
+            for (size_t i = 0; i < VALUE_COUNT; i++) {
+                values[i] = s.values[i].load(std::memory_order_relaxed);
+            }
+            std::atomic_thread_fence(std::memory_order_acquire);
+            seq2 = s.seq.load(std::memory_order_relaxed);
+        } while (seq1 != seq2);
+        HKU_IF_RETURN(seq1 == 0, false);
+
+        const Stock& stk = m_stock_list[slot];
+        spot.market = stk.market();
+        spot.code = stk.code();
+        spot.name = stk.name();
+        spot.datetime = datetime == Null<int64_t>()
+                          ? Null<Datetime>()
+                          : Datetime::min() + TimeDelta::fromTicks(datetime);
+        price_t* fields[VALUE_COUNT] = {
+          &spot.yesterday_close, &spot.open,        &spot.high,        &spot.low,
+          &spot.close,           &spot.amount,      &spot.volumn,      &spot.bid1,
+          &spot.bid1_amount,     &spot.bid2,        &spot.bid2_amount, &spot.bid3,
+          &spot.bid3_amount,     &spot.bid4,        &spot.bid4_amount, &spot.bid5,
+          &spot.bid5_amount,     &spot.ask1,        &spot.ask1_amount, &spot.ask2,
+          &spot.ask2_amount,     &spot.ask3,        &spot.ask3_amount, &spot.ask4,
+          &spot.ask4_amount,     &spot.ask5,        &spot.ask5_amount};
+        for (size_t i = 0; i < VALUE_COUNT; i++) {
+            *fields[i] = values[i];
+        }
+        return true;
+    }
+
+    /**
+     * 获取自上次调用以来行情有更新的槽位
+     * @param changed [out] 有更新的槽位，按槽位编号升序排列
+     */
+    void collectChanged(vector<size_t>& changed) {
+        changed.clear();
+        for (size_t i = 0, total = size(); i < total; i++) {
+            uint64_t seq = m_slots[i].seq.load(std::memory_order_acquire);
+            if (seq != m_last_seen[i] && !(seq & 1)) {
+                m_last_seen[i] = seq;
+                changed.push_back(i);
+            }
+        }
+    }
+
+private:
+    static constexpr size_t VALUE_COUNT = 27;
+
+    struct Slot {
+        std::atomic<uint64_t> seq{0};
+        std::atomic<int64_t> datetime{0};
+        std::atomic<price_t> values[VALUE_COUNT];
+
+        Slot() {
+            for (auto& value : values) {
+                value.store(0.0, std::memory_order_relaxed);
+            }
+        }
+    };
+
+    StockList m_stock_list;
+    unordered_map<string, size_t> m_index;  // 市场简称证券代码（大写）-> 槽位
+    vector<size_t> m_slot_by_id;            // 证券连续编号 -> 槽位
+    std::unique_ptr<Slot[]> m_slots;
+    vector<uint64_t> m_last_seen;  // 读取线程最近一次看到的各槽位序列号
+};
+
+}  // namespace hku
@@ -148,6 +148,7 @@ void StrategyBase::run() {
         }
     }
     HKU_WARN_IF(m_stock_list.empty(), "[Strategy {}] stock list is empty!", m_name);
+    m_spot_table.init(m_stock_list);
 
     if (m_stock_list.size() > 0) {
         Stock& ref_stk = m_stock_list[0];
@@ -175,15 +176,23 @@ void StrategyBase::run() {
 }
 
 void StrategyBase::receivedSpot(const SpotRecord& spot) {
-    Stock stk = getStock(format("{}{}", spot.market, spot.code));
-    if (!stk.isNull()) {
-        m_spot_map[stk] = spot;
+    m_spot_table.update(spot);
+}
+
+void StrategyBase::_updateChangedStocks() {
+    m_spot_table.collectChanged(m_changed_slots);
+    m_changed_stocks.clear();
+    for (auto slot : m_changed_slots) {
+        m_changed_stocks.push_back(m_spot_table.getStock(slot));
     }
 }
 
 void StrategyBase::finishReceivedSpot(Datetime revTime) {
     HKU_IF_RETURN(m_stock_list.empty(), void());
-    event([this]() { this->onTick(); });
+    event([this]() {
+        this->_updateChangedStocks();
+        this->onTick();
+    });
 
     Stock& ref_stk = m_stock_list[0];
     const auto& ktype_list = getKTypeList();
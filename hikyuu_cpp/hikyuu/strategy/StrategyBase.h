@@ -14,6 +14,7 @@
 #include "../utilities/thread/FuncWrapper.h"
 #include "../utilities/thread/ThreadSafeQueue.h"
 #include "../global/GlobalSpotAgent.h"
+#include "SpotTable.h"
 #include "../trade_sys/portfolio/Portfolio.h"
 
 namespace hku {
@@ -85,6 +86,23 @@ public:
     void receivedSpot(const SpotRecord& spot);
     void finishReceivedSpot(Datetime revTime);
 
+    /**
+     * 自上次 onTick 以来行情有更新的证券，仅在 onTick 中有效
+     */
+    const StockList& getChangedStocks() const {
+        return m_changed_stocks;
+    }
+
+    /**
+     * 获取指定证券的最新行情
+     * @param stk 指定证券，需在策略的证券列表中
+     * @param spot [out] 最新行情
+     * @return 证券不在策略的证券列表中或尚未收到其行情时返回 false
+     */
+    bool getSpot(const Stock& stk, SpotRecord& spot) const {
+        return m_spot_table.get(m_spot_table.getSlot(stk), spot);
+    }
+
     virtual void init() {}
     virtual void onTick() {}
     virtual void onBar(const KQuery::KType& ktype){};
@@ -101,7 +119,9 @@ private:
 
     StockList m_stock_list;
     std::unordered_map<KQuery::KType, Datetime> m_ref_last_time;
-    std::unordered_map<Stock, SpotRecord> m_spot_map;
+    SpotTable m_spot_table;         // 各证券最新行情，由行情接收线程写入
+    vector<size_t> m_changed_slots;  // 自上次 onTick 以来有更新的槽位，仅在事件线程中使用
+    StockList m_changed_stocks;
 
 private:
     void _initDefaultParam();
@@ -141,6 +161,7 @@ private:
 #endif
 
     void _startEventLoop();
+    void _updateChangedStocks();
 };
 
 typedef shared_ptr<StrategyBase> StrategyPtr;
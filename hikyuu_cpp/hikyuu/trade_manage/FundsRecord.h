@@ -68,6 +68,9 @@ private:
 #endif
 };
 
+/** @ingroup TradeManagerClass */
+typedef vector<FundsRecord> FundsRecordList;
+
 /**
  * 输出TradeRecord信息
  * @ingroup TradeManagerClass
@@ -7,6 +7,7 @@
 
 #include "boost/date_time/gregorian/gregorian.hpp"
 #include "boost/lexical_cast.hpp"
+#include "../StockManager.h"
 #include "Performance.h"
 
 namespace hku {
@@ -62,6 +63,10 @@ Performance::Performance() {
     m_name_list.push_back("最大单笔亏损R乘数");
     m_name_list.push_back("最大连续赢利R乘数");
     m_name_list.push_back("最大连续亏损R乘数");
+    m_name_list.push_back("最大回撤%");
+    m_name_list.push_back("年化波动率%");
+    m_name_list.push_back("夏普比率");
+    m_name_list.push_back("年化换手率");
 
     list<string>::iterator iter = m_name_list.begin();
     for (; iter != m_name_list.end(); ++iter) {
@@ -110,7 +115,7 @@ string Performance::report(const TradeManagerPtr& tm, const Datetime& datetime)
     return buf.str();
 }
 
-void Performance ::statistics(const TradeManagerPtr& tm, const Datetime& datetime) {
+void Performance::statistics(const TradeManagerPtr& tm, const Datetime& datetime) {
     //清除上次统计结果
     reset();
 
@@ -124,9 +129,82 @@ void Performance ::statistics(const TradeManagerPtr& tm, const Datetime& datetim
         return;
     }
 
-    int precision = tm->precision();
-    m_result["帐户初始金额"] = tm->initCash();
-    FundsRecord funds = tm->getFunds(datetime, KQuery::DAY);
+    //按交易日生成每日资产，截止时刻本身作为最后一项（当前资产）
+    DatetimeList dates;
+    Datetime end_date = datetime == Null<Datetime>() ? Datetime::now() : datetime;
+    Datetime start_date = tm->initDatetime();
+    if (start_date != Null<Datetime>() && start_date.startOfDay() < end_date.startOfDay()) {
+        dates = StockManager::instance().getTradingCalendar(
+          KQueryByDate(start_date.startOfDay(), end_date.startOfDay(), KQuery::DAY));
+    }
+    dates.push_back(datetime);
+
+    FundsRecordList funds_list = tm->getFundsList(dates, KQuery::DAY);
+    statistics(tm->getTradeList(), tm->getHistoryPositionList(), dates, funds_list, datetime,
+               tm->precision());
+}
+
+void Performance::statistics(const TradeRecordList& trade_list,
+                             const PositionRecordList& his_position, const DatetimeList& dates,
+                             const FundsRecordList& funds_list, const Datetime& datetime,
+                             int precision) {
+    //清除上次统计结果
+    reset();
+
+    HKU_ERROR_IF_RETURN(dates.size() != funds_list.size(), void(),
+                        "The length of dates({}) and funds_list({}) is not match!", dates.size(),
+                        funds_list.size());
+    HKU_ERROR_IF_RETURN(funds_list.empty(), void(), "funds_list is empty!");
+
+    //遍历一次交易记录：初始资金、红利、首次买入时刻、占用现金比例及成交金额
+    Datetime first_datetime, last_datetime;
+    double max_percent = 0.0, sum_percent = 0.0;
+    int trade_number = 0;
+    price_t trade_money = 0.0;
+    for (const TradeRecord& record : trade_list) {
+        last_datetime = record.datetime;
+        switch (record.business) {
+            case BUSINESS_INIT:
+                m_result["帐户初始金额"] = record.realPrice;
+                break;
+
+            case BUSINESS_BONUS:
+                m_result["累计红利"] += record.realPrice;
+                break;
+
+            case BUSINESS_BUY: {
+                if (first_datetime == Null<Datetime>()) {
+                    first_datetime = record.datetime;
+                }
+                trade_number++;
+                price_t hold_cash =
+                  roundEx(record.realPrice * record.number + record.cost.total, precision);
+                price_t total_cash = roundEx(hold_cash + record.cash, precision);
+                double percent = (total_cash != 0.0) ? hold_cash / total_cash : 0.0;
+                sum_percent += percent;
+                if (percent > max_percent) {
+                    max_percent = percent;
+                }
+                trade_money += record.realPrice * record.number;
+                break;
+            }
+
+            case BUSINESS_SELL:
+                trade_money += record.realPrice * record.number;
+                break;
+
+            default:
+                break;
+        }
+    }
+
+    m_result["单笔交易最大占用现金比例%"] = 100 * max_percent;
+    if (trade_number != 0) {
+        m_result["交易平均占用现金比例%"] = 100 * sum_percent / trade_number;
+    }
+
+    //当前资产
+    const FundsRecord& funds = funds_list.back();
     m_result["现金余额"] = funds.cash;
     m_result["累计投入本金"] = funds.base_cash;
     m_result["累计投入资产"] = funds.base_asset;
@@ -137,11 +215,44 @@ void Performance ::statistics(const TradeManagerPtr& tm, const Datetime& datetim
       funds.cash + funds.market_value - funds.borrow_cash - funds.borrow_asset;
     price_t total_money = funds.base_cash + funds.base_asset;
 
-    const TradeRecordList& trade_list = tm->getTradeList();
-    TradeRecordList::const_iterator trade_iter = trade_list.begin();
-    for (; trade_iter != trade_list.end(); ++trade_iter) {
-        if (trade_iter->business == BUSINESS_BONUS) {
-            m_result["累计红利"] += trade_iter->realPrice;
+    //遍历一次每日资产：剔除资金存取影响后的日收益率、净值回撤及平均净资产
+    double nav = 1.0, max_nav = 1.0, max_drawdown = 0.0;
+    double mean_return = 0.0, m2_return = 0.0, sum_equity = 0.0;
+    size_t return_count = 0;
+    price_t pre_equity = 0.0, pre_invest = 0.0;
+    for (size_t i = 0, total = funds_list.size(); i < total; i++) {
+        const FundsRecord& cur = funds_list[i];
+        price_t equity = cur.cash + cur.market_value - cur.borrow_cash - cur.borrow_asset;
+        price_t invest = cur.base_cash + cur.base_asset;
+        sum_equity += equity;
+        if (i > 0 && pre_equity > 0.0) {
+            double ret = (equity - pre_equity - (invest - pre_invest)) / pre_equity;
+            nav *= (1.0 + ret);
+            if (nav > max_nav) {
+                max_nav = nav;
+            } else if (max_nav > 0.0) {
+                double drawdown = (max_nav - nav) / max_nav;
+                if (drawdown > max_drawdown) {
+                    max_drawdown = drawdown;
+                }
+            }
+
+            // Welford 算法计算均值与方差
+            return_count++;
+            double delta = ret - mean_return;
+            mean_return += delta / return_count;
+            m2_return += delta * (ret - mean_return);
+        }
+        pre_equity = equity;
+        pre_invest = invest;
+    }
+
+    m_result["最大回撤%"] = 100 * max_drawdown;
+    if (return_count > 1) {
+        double std_return = std::sqrt(m2_return / (return_count - 1));
+        m_result["年化波动率%"] = 100 * std_return * std::sqrt(252.0);
+        if (std_return > 0.0) {
+            m_result["夏普比率"] = mean_return / std_return * std::sqrt(252.0);
         }
     }
 
@@ -167,7 +278,6 @@ void Performance ::statistics(const TradeManagerPtr& tm, const Datetime& datetim
     CalData earn, loss;
 
     bool pre_earn = true;
-    const PositionRecordList& his_position = tm->getHistoryPositionList();
     price_t total_r = 0.0;
     m_result["已平仓交易总数"] = (double)his_position.size();
     PositionRecordList::const_iterator his_iter = his_position.begin();
@@ -322,11 +432,11 @@ void Performance ::statistics(const TradeManagerPtr& tm, const Datetime& datetim
                              (1 - 0.01 * m_result["赢利交易比例%"]) * m_result["亏损交易平均亏损"];
 
     int duration = 0;
-    if (tm->firstDatetime() != Null<Datetime>()) {
+    if (first_datetime != Null<Datetime>()) {
         if (datetime == Null<Datetime>()) {
-            duration = (Datetime::now().date() - tm->firstDatetime().date()).days();
+            duration = (Datetime::now().date() - first_datetime.date()).days();
         } else {
-            duration = (datetime.date() - tm->firstDatetime().date()).days();
+            duration = (datetime.date() - first_datetime.date()).days();
         }
     }
 
@@ -345,74 +455,49 @@ void Performance ::statistics(const TradeManagerPtr& tm, const Datetime& datetim
           100 * ((std::pow(10, (std::log10(m_result["当前总资产"] / total_money) / years)) - 1));
     }
 
-    double max_percent = 0.0, sum_percent = 0.0;
-    int trade_number = 0;
-    trade_iter = trade_list.begin();
-    for (; trade_iter != trade_list.end(); ++trade_iter) {
-        if (trade_iter->business == BUSINESS_BUY) {
-            trade_number++;
-            const TradeRecord& record = *trade_iter;
-            price_t hold_cash =
-              roundEx(record.realPrice * record.number + record.cost.total, precision);
-            price_t total_cash = roundEx(hold_cash + record.cash, precision);
-            double percent = (total_cash != 0.0) ? hold_cash / total_cash : 0.0;
-            sum_percent += percent;
-            if (percent > max_percent) {
-                max_percent = percent;
-            }
-        }
-    }
-
-    m_result["单笔交易最大占用现金比例%"] = 100 * max_percent;
-    if (trade_number != 0) {
-        m_result["交易平均占用现金比例%"] = 100 * sum_percent / trade_number;
+    if (years != 0.0 && sum_equity > 0.0) {
+        double avg_equity = sum_equity / funds_list.size();
+        m_result["年化换手率"] = trade_money / 2.0 / avg_equity / years;
     }
 
-    PositionRecordList cur_position = tm->getPositionList();
-    PositionRecordList::const_iterator cur_iter;
+    //空仓统计：按建仓时间排序后扫描，维护已建仓记录中的最晚平仓时间，
+    //某日处于持仓状态当且仅当该最晚平仓时间大于当日
+    //注：与原有统计口径一致，当前未平仓的持仓不计入持仓时间
     int short_number = 0;
     int short_days = 0;
     int total_short_days = 0;
     int max_short_days = 0;
     bool pre_short = false;
 
-    if (tm->firstDatetime() != Null<Datetime>()) {
+    if (first_datetime != Null<Datetime>()) {
         Datetime end_day;
         if (datetime == Null<Datetime>()) {
-            end_day = Datetime(tm->lastDatetime().date() + bd::days(1));
+            end_day = Datetime(last_datetime.date() + bd::days(1));
         } else {
             end_day = Datetime(datetime.date() + bd::days(1));
         }
 
-        DatetimeList day_range = getDateRange(tm->firstDatetime(), end_day);
+        vector<std::pair<Datetime, Datetime>> intervals;
+        intervals.reserve(his_position.size());
+        for (const PositionRecord& pos : his_position) {
+            intervals.emplace_back(pos.takeDatetime, pos.cleanDatetime);
+        }
+        std::sort(intervals.begin(), intervals.end());
+
+        size_t interval_pos = 0;
+        size_t interval_total = intervals.size();
+        Datetime max_clean = Datetime::min();
+        DatetimeList day_range = getDateRange(first_datetime, end_day);
         DatetimeList::const_iterator day_iter = day_range.begin();
         for (; day_iter != day_range.end(); ++day_iter) {
-            bool hold = false;
-            his_iter = his_position.begin();
-            for (; his_iter != his_position.end(); ++his_iter) {
-                if (his_iter->takeDatetime <= *day_iter && *day_iter < his_iter->cleanDatetime) {
-                    hold = true;
-                    break;
-                }
-            }
-
-            if (hold) {
-                if (pre_short) {
-                    short_days = 0;
-                    pre_short = false;
-                }
-                continue;
-            }
-
-            cur_iter = cur_position.begin();
-            for (; cur_iter != cur_position.end(); ++cur_iter) {
-                if (cur_iter->takeDatetime <= *day_iter) {
-                    hold = false;
-                    break;
+            while (interval_pos < interval_total && intervals[interval_pos].first <= *day_iter) {
+                if (intervals[interval_pos].second > max_clean) {
+                    max_clean = intervals[interval_pos].second;
                 }
+                interval_pos++;
             }
 
-            if (hold) {
+            if (max_clean > *day_iter) {
                 if (pre_short) {
                     short_days = 0;
                     pre_short = false;
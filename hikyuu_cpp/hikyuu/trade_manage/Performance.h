@@ -50,6 +50,21 @@ public:
      */
     void statistics(const TradeManagerPtr& tm, const Datetime& datetime = Datetime::now());
 
+    /**
+     * 根据已获取的交易记录、已平仓记录及每日资产，顺序计算一次截至某一时刻的系统绩效，
+     * 不再访问交易管理实例，可供批量/并行回测直接使用
+     * @note funds_list 须与 dates 一一对应且按日期递增，最后一项视为截止时刻的当前资产
+     * @param trade_list 按时间顺序的交易记录
+     * @param his_position 已平仓记录（按平仓顺序）
+     * @param dates 统计使用的日期列表
+     * @param funds_list 与 dates 对应的资产详情
+     * @param datetime 统计截止时刻
+     * @param precision 价格精度
+     */
+    void statistics(const TradeRecordList& trade_list, const PositionRecordList& his_position,
+                    const DatetimeList& dates, const FundsRecordList& funds_list,
+                    const Datetime& datetime, int precision = 2);
+
     typedef map<string, double> map_type;
 
 private:
@@ -10,6 +10,7 @@
 #include <boost/bind.hpp>
 #include <boost/lexical_cast.hpp>
 #include <algorithm>
+#include <numeric>
 #include "TradeManager.h"
 #include "../trade_sys/system/SystemPart.h"
 #include "../utilities/util.h"
@@ -94,7 +95,7 @@ TradeManager::TradeManager(const Datetime& datetime, price_t initcash, const Tra
                                        m_init_cash, 0.0, 0, CostRecord(), 0.0, m_cash,
                                        PART_INVALID));
     m_broker_last_datetime = Datetime::now();
-    _saveAction(m_trade_list.back());
+    _saveAction(m_trade_list.size() - 1);
 }
 
 TradeManager::~TradeManager() {}
@@ -120,7 +121,7 @@ void TradeManager::_reset() {
     // m_broker_list
     // m_broker_last_datetime = Datetime::now();
     m_actions.clear();
-    _saveAction(m_trade_list.back());
+    _saveAction(m_trade_list.size() - 1);
 }
 
 TradeManagerPtr TradeManager::_clone() {
@@ -387,7 +388,7 @@ bool TradeManager::checkin(const Datetime& datetime, price_t cash) {
     m_checkin_cash = roundEx(m_checkin_cash + in_cash, precision);
     m_trade_list.push_back(TradeRecord(Null<Stock>(), datetime, BUSINESS_CHECKIN, in_cash, in_cash,
                                        0.0, 0, CostRecord(), 0.0, m_cash, PART_INVALID));
-    _saveAction(m_trade_list.back());
+    _saveAction(m_trade_list.size() - 1);
     return true;
 }
 
@@ -409,7 +410,7 @@ bool TradeManager::checkout(const Datetime& datetime, price_t cash) {
     m_checkout_cash = roundEx(m_checkout_cash + out_cash, precision);
     m_trade_list.push_back(TradeRecord(Null<Stock>(), datetime, BUSINESS_CHECKOUT, out_cash,
                                        out_cash, 0.0, 0, CostRecord(), 0.0, m_cash, PART_INVALID));
-    _saveAction(m_trade_list.back());
+    _saveAction(m_trade_list.size() - 1);
     return true;
 }
 
@@ -790,6 +791,7 @@ TradeRecord TradeManager::buy(const Datetime& datetime, const Stock& stock, pric
     //加入交易记录
     result = TradeRecord(stock, datetime, BUSINESS_BUY, planPrice, realPrice, goalPrice, number,
                          cost, stoploss, m_cash, from);
+    size_t trade_pos = m_trade_list.size();
     m_trade_list.push_back(result);
 
     //更新当前持仓记录
@@ -820,7 +822,7 @@ TradeRecord TradeManager::buy(const Datetime& datetime, const Stock& stock, pric
         }
     }
 
-    _saveAction(result);
+    _saveAction(trade_pos);
 
     return result;
 }
@@ -876,6 +878,7 @@ TradeRecord TradeManager::sell(const Datetime& datetime, const Stock& stock, pri
     //更新交易记录
     result = TradeRecord(stock, datetime, BUSINESS_SELL, planPrice, realPrice, goalPrice,
                          real_number, cost, stoploss, m_cash, from);
+    size_t trade_pos = m_trade_list.size();
     m_trade_list.push_back(result);
 
     //更新当前持仓情况
@@ -907,7 +910,7 @@ TradeRecord TradeManager::sell(const Datetime& datetime, const Stock& stock, pri
         }
     }
 
-    _saveAction(result);
+    _saveAction(trade_pos);
 
     return result;
 }
@@ -1120,6 +1123,242 @@ FundsRecord TradeManager::getFunds(KQuery::KType inktype) const {
     return funds;
 }
 
+/*
+ * 按时间顺序依次累积交易记录，计算历史某一时刻的资产情况
+ * 供 getFunds(datetime) 及 getFundsList 使用，后者只需顺序遍历一次交易记录
+ */
+class TradeManager::HistoryFunds {
+public:
+    HistoryFunds(price_t init_cash, int precision)
+    : m_cash(init_cash),
+      m_checkin_cash(0.0),
+      m_checkout_cash(0.0),
+      m_checkin_stock(0.0),
+      m_checkout_stock(0.0),
+      m_borrow_cash(0.0),
+      m_borrow_asset(0.0),
+      m_precision(precision) {}
+
+    void add(const TradeRecord& record);
+    FundsRecord getFunds(const Datetime& datetime, KQuery::KType ktype) const;
+
+private:
+    struct Stock_Number {
+        Stock_Number() : number(0) {}
+        Stock_Number(const Stock& stock, size_t number) : stock(stock), number(number) {}
+
+        Stock stock;
+        size_t number;
+    };
+
+    price_t m_cash;
+    price_t m_checkin_cash;
+    price_t m_checkout_cash;
+    price_t m_checkin_stock;
+    price_t m_checkout_stock;
+    price_t m_borrow_cash;
+    price_t m_borrow_asset;
+    int m_precision;
+    map<uint64_t, Stock_Number> m_stock_map;
+    map<uint64_t, Stock_Number> m_short_stock_map;
+    map<uint64_t, BorrowRecord> m_bor_stock_map;
+};
+
+void TradeManager::HistoryFunds::add(const TradeRecord& record) {
+    int precision = m_precision;
+    map<uint64_t, Stock_Number>::iterator stock_iter;
+    map<uint64_t, Stock_Number>::iterator short_stock_iter;
+    map<uint64_t, BorrowRecord>::iterator bor_stock_iter;
+
+    m_cash = record.cash;
+    switch (record.business) {
+        case BUSINESS_INIT:
+            m_checkin_cash += record.realPrice;
+            break;
+
+        case BUSINESS_BUY:
+        case BUSINESS_GIFT:
+            stock_iter = m_stock_map.find(record.stock.id());
+            if (stock_iter != m_stock_map.end()) {
+                stock_iter->second.number += record.number;
+            } else {
+                m_stock_map[record.stock.id()] = Stock_Number(record.stock, record.number);
+            }
+            break;
+
+        case BUSINESS_SELL:
+            stock_iter = m_stock_map.find(record.stock.id());
+            if (stock_iter != m_stock_map.end()) {
+                stock_iter->second.number -= record.number;
+            } else {
+                HKU_WARN("{} {} Sell error in m_trade_list!", record.datetime,
+                         record.stock.market_code());
+            }
+            break;
+
+        case BUSINESS_SELL_SHORT:
+            short_stock_iter = m_short_stock_map.find(record.stock.id());
+            if (short_stock_iter != m_short_stock_map.end()) {
+                short_stock_iter->second.number += record.number;
+            } else {
+                m_short_stock_map[record.stock.id()] = Stock_Number(record.stock, record.number);
+            }
+            break;
+
+        case BUSINESS_BUY_SHORT:
+            short_stock_iter = m_short_stock_map.find(record.stock.id());
+            if (short_stock_iter != m_short_stock_map.end()) {
+                short_stock_iter->second.number -= record.number;
+            } else {
+                HKU_WARN("{} {} BuyShort Error in m_trade_list!", record.datetime,
+                         record.stock.market_code());
+            }
+            break;
+
+        case BUSINESS_BONUS:
+            break;
+
+        case BUSINESS_CHECKIN:
+            m_checkin_cash += record.realPrice;
+            break;
+
+        case BUSINESS_CHECKOUT:
+            m_checkout_cash += record.realPrice;
+            break;
+
+        case BUSINESS_CHECKIN_STOCK:
+            stock_iter = m_stock_map.find(record.stock.id());
+            if (stock_iter != m_stock_map.end()) {
+                m_stock_map[record.stock.id()].number += record.number;
+            } else {
+                m_stock_map[record.stock.id()] = Stock_Number(record.stock, record.number);
+            }
+            m_checkin_stock = roundEx(
+              m_checkin_stock + record.realPrice * record.number * record.stock.unit(), precision);
+            break;
+
+        case BUSINESS_CHECKOUT_STOCK:
+            stock_iter = m_stock_map.find(record.stock.id());
+            if (stock_iter != m_stock_map.end()) {
+                m_stock_map[record.stock.id()].number -= record.number;
+            } else {
+                HKU_WARN("{} {} CheckoutStock Error in m_trade_list!", record.datetime,
+                         record.stock.market_code());
+            }
+            m_checkout_stock = roundEx(
+              m_checkout_stock + record.realPrice * record.number * record.stock.unit(), precision);
+            break;
+
+        case BUSINESS_BORROW_CASH:
+            m_borrow_cash += record.realPrice;
+            break;
+
+        case BUSINESS_RETURN_CASH:
+            m_borrow_cash -= record.realPrice;
+            break;
+
+        case BUSINESS_BORROW_STOCK:
+            m_borrow_asset =
+              roundEx(m_borrow_asset + record.realPrice * record.number * record.stock.unit(),
+                      precision);
+            bor_stock_iter = m_bor_stock_map.find(record.stock.id());
+            if (bor_stock_iter == m_bor_stock_map.end()) {
+                BorrowRecord bor;
+                BorrowRecord::Data data(record.datetime, record.realPrice, record.number);
+                bor.record_list.push_back(data);
+                m_bor_stock_map[record.stock.id()] = bor;
+            } else {
+                BorrowRecord::Data data(record.datetime, record.realPrice, record.number);
+                bor_stock_iter->second.record_list.push_back(data);
+            }
+            break;
+
+        case BUSINESS_RETURN_STOCK:
+            bor_stock_iter = m_bor_stock_map.find(record.stock.id());
+            if (bor_stock_iter == m_bor_stock_map.end()) {
+                HKU_WARN("{} {} Error return stock in m_trade_list!", record.datetime,
+                         record.stock.market_code());
+
+            } else {
+                BorrowRecord& bor = bor_stock_iter->second;
+                size_t remain_num = record.number;
+                do {
+                    list<BorrowRecord::Data>::iterator bor_iter = bor.record_list.begin();
+                    if (remain_num == bor_iter->number) {
+                        m_borrow_asset -=
+                          roundEx(bor_iter->price * remain_num * record.stock.unit(), precision);
+                        bor.record_list.pop_front();
+                        break;
+
+                    } else if (remain_num < bor_iter->number) {
+                        m_borrow_asset -=
+                          roundEx(bor_iter->price * remain_num * record.stock.unit(), precision);
+                        bor_iter->number -= remain_num;
+                        break;
+
+                    } else {  // remain_num > bor_iter->number
+                        m_borrow_asset -= roundEx(
+                          bor_iter->price * bor_iter->number * record.stock.unit(), precision);
+                        remain_num -= bor_iter->number;
+                        bor.record_list.pop_front();
+                    }
+                } while (!bor.record_list.empty());
+
+                if (bor.record_list.empty()) {
+                    m_bor_stock_map.erase(bor_stock_iter);
+                }
+            }
+
+            break;
+
+        default:
+            HKU_WARN("{} {} Unknown business in m_trade_list!", record.datetime,
+                     record.stock.market_code());
+            break;
+    }
+}
+
+FundsRecord TradeManager::HistoryFunds::getFunds(const Datetime& datetime,
+                                                  KQuery::KType ktype) const {
+    int precision = m_precision;
+    price_t market_value = 0.0;
+    price_t short_market_value = 0.0;
+
+    map<uint64_t, Stock_Number>::const_iterator stock_iter = m_stock_map.begin();
+    for (; stock_iter != m_stock_map.end(); ++stock_iter) {
+        const size_t& number = stock_iter->second.number;
+        if (number == 0) {
+            continue;
+        }
+
+        price_t price = stock_iter->second.stock.getMarketValue(datetime, ktype);
+        market_value =
+          roundEx(market_value + price * number * stock_iter->second.stock.unit(), precision);
+    }
+
+    map<uint64_t, Stock_Number>::const_iterator short_stock_iter = m_short_stock_map.begin();
+    for (; short_stock_iter != m_short_stock_map.end(); ++short_stock_iter) {
+        const size_t& number = short_stock_iter->second.number;
+        if (number == 0) {
+            continue;
+        }
+
+        price_t price = short_stock_iter->second.stock.getMarketValue(datetime, ktype);
+        short_market_value = roundEx(
+          short_market_value + price * number * short_stock_iter->second.stock.unit(), precision);
+    }
+
+    FundsRecord funds;
+    funds.cash = m_cash;
+    funds.market_value = market_value;
+    funds.short_market_value = short_market_value;
+    funds.base_cash = m_checkin_cash - m_checkout_cash;
+    funds.base_asset = m_checkin_stock - m_checkout_stock;
+    funds.borrow_cash = m_borrow_cash;
+    funds.borrow_asset = m_borrow_asset;
+    return funds;
+}
+
 FundsRecord TradeManager::getFunds(const Datetime& indatetime, KQuery::KType ktype) {
     FundsRecord funds;
     int precision = getParam<int>("precision");
@@ -1166,219 +1405,64 @@ FundsRecord TradeManager::getFunds(const Datetime& indatetime, KQuery::KType kty
     }  // if datetime >= lastDatetime()
 
     //当查询日期小于最后交易日期时，遍历交易记录，计算当日的市值和现金
-    price_t cash = m_init_cash;
-    struct Stock_Number {
-        Stock_Number() : number(0) {}
-        Stock_Number(const Stock& stock, size_t number) : stock(stock), number(number) {}
-
-        Stock stock;
-        size_t number;
-    };
-
-    price_t checkin_cash = 0.0;
-    price_t checkout_cash = 0.0;
-    price_t checkin_stock = 0.0;
-    price_t checkout_stock = 0.0;
-    map<uint64_t, Stock_Number> stock_map;
-    map<uint64_t, Stock_Number> short_stock_map;
-    map<uint64_t, Stock_Number>::iterator stock_iter;
-    map<uint64_t, Stock_Number>::iterator short_stock_iter;
-    map<uint64_t, BorrowRecord> bor_stock_map;
-    map<uint64_t, BorrowRecord>::iterator bor_stock_iter;
-
+    HistoryFunds history(m_init_cash, precision);
     TradeRecordList::const_iterator iter = m_trade_list.begin();
     for (; iter != m_trade_list.end(); ++iter) {
         if (iter->datetime > datetime) {
             //如果交易记录的日期大于指定的日期则跳出循环，处理完毕
             break;
         }
+        history.add(*iter);
+    }
 
-        cash = iter->cash;
-        switch (iter->business) {
-            case BUSINESS_INIT:
-                checkin_cash += iter->realPrice;
-                break;
-
-            case BUSINESS_BUY:
-            case BUSINESS_GIFT:
-                stock_iter = stock_map.find(iter->stock.id());
-                if (stock_iter != stock_map.end()) {
-                    stock_iter->second.number += iter->number;
-                } else {
-                    stock_map[iter->stock.id()] = Stock_Number(iter->stock, iter->number);
-                }
-                break;
-
-            case BUSINESS_SELL:
-                stock_iter = stock_map.find(iter->stock.id());
-                if (stock_iter != stock_map.end()) {
-                    stock_iter->second.number -= iter->number;
-                } else {
-                    HKU_WARN("{} {} Sell error in m_trade_list!", datetime,
-                             iter->stock.market_code());
-                }
-                break;
-
-            case BUSINESS_SELL_SHORT:
-                short_stock_iter = short_stock_map.find(iter->stock.id());
-                if (short_stock_iter != short_stock_map.end()) {
-                    short_stock_iter->second.number += iter->number;
-                } else {
-                    short_stock_map[iter->stock.id()] = Stock_Number(iter->stock, iter->number);
-                }
-                break;
-
-            case BUSINESS_BUY_SHORT:
-                short_stock_iter = short_stock_map.find(iter->stock.id());
-                if (short_stock_iter != short_stock_map.end()) {
-                    short_stock_iter->second.number -= iter->number;
-                } else {
-                    HKU_WARN("{} {} BuyShort Error in m_trade_list!", datetime,
-                             iter->stock.market_code());
-                }
-                break;
-
-            case BUSINESS_BONUS:
-                break;
-
-            case BUSINESS_CHECKIN:
-                checkin_cash += iter->realPrice;
-                break;
-
-            case BUSINESS_CHECKOUT:
-                checkout_cash += iter->realPrice;
-                break;
-
-            case BUSINESS_CHECKIN_STOCK:
-                stock_iter = stock_map.find(iter->stock.id());
-                if (stock_iter != stock_map.end()) {
-                    stock_map[iter->stock.id()].number += iter->number;
-                } else {
-                    stock_map[iter->stock.id()] = Stock_Number(iter->stock, iter->number);
-                }
-                checkin_stock = roundEx(
-                  checkin_stock + iter->realPrice * iter->number * iter->stock.unit(), precision);
-                break;
-
-            case BUSINESS_CHECKOUT_STOCK:
-                stock_iter = stock_map.find(iter->stock.id());
-                if (stock_iter != stock_map.end()) {
-                    stock_map[iter->stock.id()].number -= iter->number;
-                } else {
-                    HKU_WARN("{} {} CheckoutStock Error in m_trade_list!", datetime,
-                             iter->stock.market_code());
-                }
-                checkout_stock = roundEx(
-                  checkout_stock + iter->realPrice * iter->number * iter->stock.unit(), precision);
-                break;
-
-            case BUSINESS_BORROW_CASH:
-                funds.borrow_cash += iter->realPrice;
-                break;
-
-            case BUSINESS_RETURN_CASH:
-                funds.borrow_cash -= iter->realPrice;
-                break;
-
-            case BUSINESS_BORROW_STOCK:
-                funds.borrow_asset =
-                  roundEx(funds.borrow_asset + iter->realPrice * iter->number * iter->stock.unit(),
-                          precision);
-                bor_stock_iter = bor_stock_map.find(iter->stock.id());
-                if (bor_stock_iter == bor_stock_map.end()) {
-                    BorrowRecord bor;
-                    BorrowRecord::Data data(iter->datetime, iter->realPrice, iter->number);
-                    bor.record_list.push_back(data);
-                    bor_stock_map[iter->stock.id()] = bor;
-                } else {
-                    BorrowRecord::Data data(iter->datetime, iter->realPrice, iter->number);
-                    bor_stock_iter->second.record_list.push_back(data);
-                }
-                break;
-
-            case BUSINESS_RETURN_STOCK:
-                bor_stock_iter = bor_stock_map.find(iter->stock.id());
-                if (bor_stock_iter == bor_stock_map.end()) {
-                    HKU_WARN("{} {} Error return stock in m_trade_list!", iter->datetime,
-                             iter->stock.market_code());
-
-                } else {
-                    BorrowRecord& bor = bor_stock_iter->second;
-                    size_t remain_num = iter->number;
-                    do {
-                        list<BorrowRecord::Data>::iterator bor_iter = bor.record_list.begin();
-                        if (remain_num == bor_iter->number) {
-                            funds.borrow_asset -=
-                              roundEx(bor_iter->price * remain_num * iter->stock.unit(), precision);
-                            bor.record_list.pop_front();
-                            break;
-
-                        } else if (remain_num < bor_iter->number) {
-                            funds.borrow_asset -=
-                              roundEx(bor_iter->price * remain_num * iter->stock.unit(), precision);
-                            bor_iter->number -= remain_num;
-                            break;
-
-                        } else {  // remain_num > bor_iter->number
-                            funds.borrow_asset -= roundEx(
-                              bor_iter->price * bor_iter->number * iter->stock.unit(), precision);
-                            remain_num -= bor_iter->number;
-                            bor.record_list.pop_front();
-                        }
-                    } while (!bor.record_list.empty());
-
-                    if (bor.record_list.empty()) {
-                        bor_stock_map.erase(bor_stock_iter);
-                    }
-                }
+    return history.getFunds(datetime, ktype);
+}
 
-                break;
+FundsRecordList TradeManager::getFundsList(const DatetimeList& dates, KQuery::KType ktype) {
+    size_t total = dates.size();
+    FundsRecordList result(total);
+    int precision = getParam<int>("precision");
 
-            default:
-                HKU_WARN("{} {} Unknown business in m_trade_list!", datetime,
-                         iter->stock.market_code());
-                break;
-        }
+    // 按日期递增顺序处理，交易记录只需顺序遍历一次；dates 无序时按排序后的下标依次处理
+    vector<size_t> order(total);
+    std::iota(order.begin(), order.end(), 0);
+    if (!std::is_sorted(dates.begin(), dates.end())) {
+        std::stable_sort(order.begin(), order.end(),
+                         [&dates](size_t a, size_t b) { return dates[a] < dates[b]; });
     }
 
-    stock_iter = stock_map.begin();
-    for (; stock_iter != stock_map.end(); ++stock_iter) {
-        const size_t& number = stock_iter->second.number;
-        if (number == 0) {
+    HistoryFunds history(m_init_cash, precision);
+    size_t trade_pos = 0;
+    for (size_t i : order) {
+        const Datetime& indatetime = dates[i];
+        if (indatetime == Null<Datetime>() || indatetime == lastDatetime()) {
+            result[i] = getFunds(ktype);
             continue;
         }
 
-        price_t price = stock_iter->second.stock.getMarketValue(datetime, ktype);
-        market_value =
-          roundEx(market_value + price * number * stock_iter->second.stock.unit(), precision);
-    }
-
-    short_stock_iter = short_stock_map.begin();
-    for (; short_stock_iter != short_stock_map.end(); ++short_stock_iter) {
-        const size_t& number = short_stock_iter->second.number;
-        if (number == 0) {
+        Datetime datetime(indatetime.year(), indatetime.month(), indatetime.day(), 11, 59);
+        if (datetime > lastDatetime()) {
+            result[i] = getFunds(indatetime, ktype);
             continue;
         }
 
-        price_t price = short_stock_iter->second.stock.getMarketValue(datetime, ktype);
-        short_market_value =
-          roundEx(short_market_value + price * number * stock_iter->second.stock.unit(), precision);
+        while (trade_pos < m_trade_list.size() && m_trade_list[trade_pos].datetime <= datetime) {
+            history.add(m_trade_list[trade_pos]);
+            trade_pos++;
+        }
+        result[i] = history.getFunds(datetime, ktype);
     }
 
-    funds.cash = cash;
-    funds.market_value = market_value;
-    funds.short_market_value = short_market_value;
-    funds.base_cash = checkin_cash - checkout_cash;
-    funds.base_asset = checkin_stock - checkout_stock;
-    return funds;
+    return result;
 }
 
 PriceList TradeManager::getFundsCurve(const DatetimeList& dates, KQuery::KType ktype) {
     size_t total = dates.size();
     PriceList result(total);
     int precision = getParam<int>("precision");
+    FundsRecordList funds_list = getFundsList(dates, ktype);
     for (size_t i = 0; i < total; ++i) {
-        FundsRecord funds = getFunds(dates[i], ktype);
+        const FundsRecord& funds = funds_list[i];
         result[i] = roundEx(
           funds.cash + funds.market_value - funds.borrow_cash - funds.borrow_asset, precision);
     }
@@ -1402,8 +1486,10 @@ PriceList TradeManager::getProfitCurve(const DatetimeList& dates, KQuery::KType
         i++;
     }
     int precision = getParam<int>("precision");
-    for (; i < total; ++i) {
-        FundsRecord funds = getFunds(dates[i], ktype);
+    DatetimeList valid_dates(dates.begin() + i, dates.end());
+    FundsRecordList funds_list = getFundsList(valid_dates, ktype);
+    for (size_t j = 0; i < total; ++i, ++j) {
+        const FundsRecord& funds = funds_list[j];
         result[i] = roundEx(funds.cash + funds.market_value - funds.borrow_cash -
                               funds.borrow_asset - funds.base_cash - funds.base_asset,
                             precision);
@@ -1497,8 +1583,39 @@ void TradeManager::_update(const Datetime& datetime) {
     }
 }
 
-void TradeManager::_saveAction(const TradeRecord& record) {
+void TradeManager::_saveAction(size_t trade_pos) {
     HKU_IF_RETURN(getParam<bool>("save_action") == false, void());
+    m_actions.push_back(trade_pos);
+}
+
+void TradeManager::_rebuildActions() {
+    m_actions.clear();
+    HKU_IF_RETURN(getParam<bool>("save_action") == false, void());
+    for (size_t i = 0, total = m_trade_list.size(); i < total; i++) {
+        switch (m_trade_list[i].business) {
+            case BUSINESS_INIT:
+            case BUSINESS_CHECKIN:
+            case BUSINESS_CHECKOUT:
+            case BUSINESS_BUY:
+            case BUSINESS_SELL:
+                m_actions.push_back(i);
+                break;
+
+            default:
+                break;
+        }
+    }
+}
+
+list<string> TradeManager::_getActionList() const {
+    list<string> result;
+    for (size_t pos : m_actions) {
+        result.push_back(_actionToString(m_trade_list[pos]));
+    }
+    return result;
+}
+
+string TradeManager::_actionToString(const TradeRecord& record) const {
     std::stringstream buf(std::stringstream::out);
     string my_tm("td = my_tm.");
     string sep(", ");
@@ -1539,7 +1656,7 @@ void TradeManager::_saveAction(const TradeRecord& record) {
             break;
     }
 
-    m_actions.push_back(buf.str());
+    return buf.str();
 }
 
 void TradeManager::tocsv(const string& path) {
@@ -1653,9 +1770,8 @@ void TradeManager::tocsv(const string& path) {
     //导出已平仓记录
     file.open(filename4.c_str());
     HKU_ERROR_IF_RETURN(!file, void(), "Can't create file {}!", filename4);
-    list<string>::const_iterator action_iter = m_actions.begin();
-    for (; action_iter != m_actions.end(); ++action_iter) {
-        file << *action_iter << std::endl;
+    for (size_t pos : m_actions) {
+        file << _actionToString(m_trade_list[pos]) << std::endl;
     }
     file.close();
 }
@@ -1746,6 +1862,7 @@ bool TradeManager::_add_buy_tr(const TradeRecord& tr) {
 
     m_cash = roundEx(m_cash - money - tr.cost.total, precision);
     new_tr.cash = m_cash;
+    size_t trade_pos = m_trade_list.size();
     m_trade_list.push_back(new_tr);
 
     //更新当前持仓记录
@@ -1768,7 +1885,7 @@ bool TradeManager::_add_buy_tr(const TradeRecord& tr) {
                   precision);
     }
 
-    _saveAction(new_tr);
+    _saveAction(trade_pos);
 
     return true;
 }
@@ -1795,6 +1912,7 @@ bool TradeManager::_add_sell_tr(const TradeRecord& tr) {
     //更新交易记录
     TradeRecord new_tr(tr);
     new_tr.cash = m_cash;
+    size_t trade_pos = m_trade_list.size();
     m_trade_list.push_back(new_tr);
 
     //更新当前持仓情况
@@ -1812,7 +1930,7 @@ bool TradeManager::_add_sell_tr(const TradeRecord& tr) {
         m_position.erase(tr.stock.id());
     }
 
-    _saveAction(new_tr);
+    _saveAction(trade_pos);
 
     return true;
 }
@@ -1861,7 +1979,7 @@ bool TradeManager::_add_checkin_tr(const TradeRecord& tr) {
     m_checkin_cash = roundEx(m_checkin_cash + in_cash, precision);
     m_trade_list.push_back(TradeRecord(Null<Stock>(), tr.datetime, BUSINESS_CHECKIN, in_cash,
                                        in_cash, 0.0, 0, CostRecord(), 0.0, m_cash, PART_INVALID));
-    _saveAction(m_trade_list.back());
+    _saveAction(m_trade_list.size() - 1);
     return true;
 }
 
@@ -1876,7 +1994,7 @@ bool TradeManager::_add_checkout_tr(const TradeRecord& tr) {
     m_checkout_cash = roundEx(m_checkout_cash + out_cash, precision);
     m_trade_list.push_back(TradeRecord(Null<Stock>(), tr.datetime, BUSINESS_CHECKOUT, out_cash,
                                        out_cash, 0.0, 0, CostRecord(), 0.0, m_cash, PART_INVALID));
-    _saveAction(m_trade_list.back());
+    _saveAction(m_trade_list.size() - 1);
     return true;
 }
 
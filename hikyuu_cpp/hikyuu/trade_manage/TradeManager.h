@@ -12,6 +12,7 @@
 #include "TradeManagerBase.h"
 #include "../utilities/Parameter.h"
 #include "../utilities/util.h"
+#include "../utilities/FlatIdMap.h"
 #include "TradeRecord.h"
 #include "PositionRecord.h"
 #include "BorrowRecord.h"
@@ -147,6 +148,11 @@ public:
      */
     virtual TradeRecordList getTradeList(const Datetime& start, const Datetime& end) const override;
 
+    /** 获取交易记录总数（含存入、取出等记录），每次交易或资金、股票存取后增加 */
+    virtual size_t getTradeCount() const override {
+        return m_trade_list.size();
+    }
+
     /** 获取当前全部持仓记录 */
     virtual PositionRecordList getPositionList() const override;
 
@@ -332,6 +338,15 @@ public:
     virtual FundsRecord getFunds(const Datetime& datetime,
                                  KQuery::KType ktype = KQuery::DAY) override;
 
+    /**
+     * 获取指定日期列表对应的资产详情，只顺序遍历一次交易记录
+     * @param dates 日期列表，可为任意顺序，非递增时按日期排序后处理
+     * @param ktype K线类型，必须与日期列表匹配，默认KQuery::DAY
+     * @return 与日期列表一一对应的资产详情
+     */
+    virtual FundsRecordList getFundsList(const DatetimeList& dates,
+                                         KQuery::KType ktype = KQuery::DAY) override;
+
     /**
      * 获取资产净值曲线，含借入的资产
      * @param dates 日期列表，根据该日期列表获取其对应的资产净值曲线
@@ -380,11 +395,23 @@ public:
     virtual void tocsv(const string& path) override;
 
 private:
+    //按交易记录顺序累积计算历史资产
+    class HistoryFunds;
+
     //根据权息信息，更新交易记录及持仓
     void _update(const Datetime&);
 
-    //以脚本的形式保存交易动作，便于修正和校准
-    void _saveAction(const TradeRecord&);
+    //以脚本的形式保存交易动作，便于修正和校准，仅记录对应交易记录的位置
+    void _saveAction(size_t trade_pos);
+
+    //将交易动作转换为脚本文本
+    string _actionToString(const TradeRecord&) const;
+
+    //获取全部交易动作的脚本文本
+    list<string> _getActionList() const;
+
+    //根据交易记录重建交易动作索引
+    void _rebuildActions();
 
     bool _add_init_tr(const TradeRecord&);
     bool _add_buy_tr(const TradeRecord&);
@@ -415,12 +442,12 @@ private:
 
     list<LoanRecord> m_loan_list;  //当前融资情况
 
-    typedef map<uint64_t, BorrowRecord> borrow_stock_map_type;
+    typedef FlatIdMap<BorrowRecord> borrow_stock_map_type;
     borrow_stock_map_type m_borrow_stock;  //当前借入的股票及其数量
 
     TradeRecordList m_trade_list;  //交易记录
 
-    typedef map<uint64_t, PositionRecord> position_map_type;
+    typedef FlatIdMap<PositionRecord> position_map_type;
     position_map_type m_position;  //当前持仓交易对象的持仓记录 ["sh000001"-> ]
     PositionRecordList m_position_history;        //持仓历史记录
     position_map_type m_short_position;           //空头仓位记录
@@ -429,7 +456,7 @@ private:
     // list<OrderBrokerPtr> m_broker_list;  //订单代理列表
     // Datetime m_broker_last_datetime;     //订单代理最近一次执行操作的时刻
 
-    list<string> m_actions;  //记录交易动作，便于修改或校准实盘时的交易
+    vector<size_t> m_actions;  //记录交易动作对应的交易记录位置，便于修改或校准实盘时的交易
 
 //==================================================
 // 支持序列化
@@ -459,7 +486,8 @@ private:
         ar& bs::make_nvp<PositionRecordList>("m_short_position", position);
         ar& BOOST_SERIALIZATION_NVP(m_short_position_history);
         ar& BOOST_SERIALIZATION_NVP(m_trade_list);
-        ar& BOOST_SERIALIZATION_NVP(m_actions);
+        list<string> actions = _getActionList();
+        ar& bs::make_nvp<list<string>>("m_actions", actions);
     }
 
     template <class Archive>
@@ -497,7 +525,9 @@ private:
         }
         ar& BOOST_SERIALIZATION_NVP(m_short_position_history);
         ar& BOOST_SERIALIZATION_NVP(m_trade_list);
-        ar& BOOST_SERIALIZATION_NVP(m_actions);
+        list<string> actions;
+        ar& bs::make_nvp<list<string>>("m_actions", actions);
+        _rebuildActions();
     }
 
     BOOST_SERIALIZATION_SPLIT_MEMBER()
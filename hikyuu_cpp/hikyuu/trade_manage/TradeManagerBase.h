@@ -324,6 +324,11 @@ public:
         return TradeRecordList();
     }
 
+    /** 获取交易记录总数（含存入、取出等记录），每次交易或资金、股票存取后增加 */
+    virtual size_t getTradeCount() const {
+        return getTradeList().size();
+    }
+
     /** 获取当前全部持仓记录 */
     virtual PositionRecordList getPositionList() const {
         HKU_WARN("The subclass does not implement this method");
@@ -567,6 +572,21 @@ public:
         return FundsRecord();
     }
 
+    /**
+     * 获取指定日期列表对应的资产详情
+     * @param dates 日期列表，可为任意顺序
+     * @param ktype K线类型，必须与日期列表匹配，默认KQuery::DAY
+     * @return 与日期列表一一对应的资产详情
+     */
+    virtual FundsRecordList getFundsList(const DatetimeList& dates,
+                                         KQuery::KType ktype = KQuery::DAY) {
+        FundsRecordList result(dates.size());
+        for (size_t i = 0, total = dates.size(); i < total; i++) {
+            result[i] = getFunds(dates[i], ktype);
+        }
+        return result;
+    }
+
     /**
      * 获取资产净值曲线，含借入的资产
      * @param dates 日期列表，根据该日期列表获取其对应的资产净值曲线
@@ -15,6 +15,7 @@
 
 #include "../serialization/Datetime_serialization.h"
 #include "../serialization/Stock_serialization.h"
+#include "../serialization/BinaryArray_serialization.h"
 
 namespace hku {
 
@@ -89,8 +90,14 @@ private:
         ar& BOOST_SERIALIZATION_NVP(stock);
         hku::uint64_t date_number = datetime.number();
         ar& bs::make_nvp("datetime", date_number);
-        string business_name = getBusinessName(business);
-        ar& bs::make_nvp<string>("business", business_name);
+        if constexpr (is_binary_archive<Archive>::value) {
+            // 二进制存档中的枚举值直接保存为整数
+            int32_t business_value = business;
+            ar& BOOST_SERIALIZATION_NVP(business_value);
+        } else {
+            string business_name = getBusinessName(business);
+            ar& bs::make_nvp<string>("business", business_name);
+        }
         ar& BOOST_SERIALIZATION_NVP(planPrice);
         ar& BOOST_SERIALIZATION_NVP(realPrice);
         ar& BOOST_SERIALIZATION_NVP(goalPrice);
@@ -98,8 +105,13 @@ private:
         ar& BOOST_SERIALIZATION_NVP(cost);
         ar& BOOST_SERIALIZATION_NVP(stoploss);
         ar& BOOST_SERIALIZATION_NVP(cash);
-        string part_name(getSystemPartName(from));
-        ar& bs::make_nvp<string>("from", part_name);
+        if constexpr (is_binary_archive<Archive>::value) {
+            int32_t part_value = from;
+            ar& BOOST_SERIALIZATION_NVP(part_value);
+        } else {
+            string part_name(getSystemPartName(from));
+            ar& bs::make_nvp<string>("from", part_name);
+        }
     }
 
     template <class Archive>
@@ -109,9 +121,20 @@ private:
         hku::uint64_t date_number;
         ar& bs::make_nvp("datetime", date_number);
         datetime = Datetime(date_number);
-        string business_name;
-        ar& bs::make_nvp<string>("business", business_name);
-        business = getBusinessEnum(business_name);
+        // 版本 0 的二进制存档中枚举值仍以名称保存
+        bool enum_as_value = false;
+        if constexpr (is_binary_archive<Archive>::value) {
+            enum_as_value = version >= 1;
+        }
+        if (enum_as_value) {
+            int32_t business_value = 0;
+            ar& BOOST_SERIALIZATION_NVP(business_value);
+            business = BUSINESS(business_value);
+        } else {
+            string business_name;
+            ar& bs::make_nvp<string>("business", business_name);
+            business = getBusinessEnum(business_name);
+        }
         ar& BOOST_SERIALIZATION_NVP(planPrice);
         ar& BOOST_SERIALIZATION_NVP(realPrice);
         ar& BOOST_SERIALIZATION_NVP(goalPrice);
@@ -119,9 +142,15 @@ private:
         ar& BOOST_SERIALIZATION_NVP(cost);
         ar& BOOST_SERIALIZATION_NVP(stoploss);
         ar& BOOST_SERIALIZATION_NVP(cash);
-        string part_name;
-        ar& bs::make_nvp<string>("from", part_name);
-        from = getSystemPartEnum(part_name);
+        if (enum_as_value) {
+            int32_t part_value = 0;
+            ar& BOOST_SERIALIZATION_NVP(part_value);
+            from = SystemPart(part_value);
+        } else {
+            string part_name;
+            ar& bs::make_nvp<string>("from", part_name);
+            from = getSystemPartEnum(part_name);
+        }
     }
 
     BOOST_SERIALIZATION_SPLIT_MEMBER()
@@ -142,4 +171,11 @@ HKU_API std::ostream& operator<<(std::ostream&, const TradeRecord&);
 bool HKU_API operator==(const TradeRecord& d1, const TradeRecord& d2);
 
 } /* namespace hku */
+
+#if HKU_SUPPORT_SERIALIZATION
+#include <boost/serialization/version.hpp>
+// 版本 1：二进制存档中的枚举值改为整数保存
+BOOST_CLASS_VERSION(hku::TradeRecord, 1)
+#endif
+
 #endif /* TRADERECORD_H_ */
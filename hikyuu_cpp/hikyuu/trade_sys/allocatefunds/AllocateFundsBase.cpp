@@ -6,7 +6,8 @@
  */
 
 #include <unordered_set>
-#include <functional>
+#include <algorithm>
+#include <numeric>
 #include "AllocateFundsBase.h"
 
 namespace hku {
@@ -47,6 +48,7 @@ void AllocateFundsBase::reset() {
     m_count = 0;
     m_pre_date = Datetime::min();
     m_reserve_percent = 0;
+    m_sub_funds.clear();
     _reset();
 }
 
@@ -95,16 +97,40 @@ void AllocateFundsBase ::adjustFunds(const Datetime& date, const SystemList& se_
     }
 }
 
-price_t AllocateFundsBase::_getTotalFunds(const std::list<SYSPtr>& running_list) {
+price_t AllocateFundsBase::_getSubFunds(const SYSPtr& sys, const Datetime& date,
+                                        KQuery::KType ktype) {
+    TMPtr sub_tm = sys->getTM();
+    price_t cash = sub_tm->currentCash();
+    size_t stock_num = sub_tm->getStockNumber();
+
+    // 空仓且不支持融券的子账户，其资产净值即为现金，无需查询行情
+    if (stock_num == 0 && !sub_tm->getParam<bool>("support_borrow_stock")) {
+        return cash;
+    }
+
+    // 同一日期内，子账户未新增任何交易记录时，直接使用缓存结果
+    size_t trade_count = sub_tm->getTradeCount();
+    auto iter = m_sub_funds.find(sys);
+    if (iter != m_sub_funds.end()) {
+        const SubFunds& cache = iter->second;
+        if (cache.date == date && cache.ktype == ktype && cache.trade_count == trade_count) {
+            return cache.value;
+        }
+    }
+
+    FundsRecord funds = sub_tm->getFunds(ktype);
+    price_t value = funds.cash + funds.market_value + funds.borrow_asset - funds.short_market_value;
+    m_sub_funds[sys] = SubFunds{date, ktype, trade_count, value};
+    return value;
+}
+
+price_t AllocateFundsBase::_getTotalFunds(const Datetime& date,
+                                          const std::list<SYSPtr>& running_list) {
     price_t total_value = 0;
 
     // 计算运行中的子系统总资产净值
     for (auto& sub_sys : running_list) {
-        TMPtr sub_tm = sub_sys->getTM();
-        KQuery sub_query = sub_sys->getTO().getQuery();
-        FundsRecord funds = sub_tm->getFunds(sub_query.kType());
-        total_value +=
-          funds.cash + funds.market_value + funds.borrow_asset - funds.short_market_value;
+        total_value += _getSubFunds(sub_sys, date, sub_sys->getTO().getQuery().kType());
     }
 
     // 加上当前总账户现金余额
@@ -113,6 +139,27 @@ price_t AllocateFundsBase::_getTotalFunds(const std::list<SYSPtr>& running_list)
     return total_value;
 }
 
+void AllocateFundsBase::_sortTopWeight(SystemWeightList& sw_list, size_t top_num) {
+    // 只需有序的前 top_num 个系统实例，使用部分排序代替全排序
+    // 部分排序不稳定，等权重时按原有位置先后排列，以保证结果确定
+    size_t total = sw_list.size();
+    top_num = top_num < total ? top_num : total;
+    vector<size_t> order(total);
+    std::iota(order.begin(), order.end(), 0);
+    std::partial_sort(order.begin(), order.begin() + top_num, order.end(),
+                      [&sw_list](size_t a, size_t b) {
+                          double wa = sw_list[a].getWeight(), wb = sw_list[b].getWeight();
+                          return wa > wb || (wa == wb && a < b);
+                      });
+
+    SystemWeightList result;
+    result.reserve(total);
+    for (size_t i : order) {
+        result.push_back(std::move(sw_list[i]));
+    }
+    sw_list.swap(result);
+}
+
 void AllocateFundsBase::_adjust_with_running(const Datetime& date, const SystemList& se_list,
                                              const std::list<SYSPtr>& running_list) {
     // 计算当前选中系统列表的权重
@@ -156,24 +203,17 @@ void AllocateFundsBase::_adjust_with_running(const Datetime& date, const SystemL
         }
     }
 
-    // 按权重升序排序（注意：无法保证等权重的相对顺序，即使用stable_sort也一样，后面要倒序遍历）
-    std::sort(
-      sw_list.begin(), sw_list.end(),
-      std::bind(std::less<double>(), std::bind(&SystemWeight::m_weight, std::placeholders::_1),
-                std::bind(&SystemWeight::m_weight, std::placeholders::_2)));
+    // 按权重从大到小排列前 max_num 个系统实例
+    _sortTopWeight(sw_list, max_num);
 
-    // 按权重从大到小遍历，构建不超过最大允许的运行子系统数的新权重列表（此时按从大到小顺序存放）
+    // 前 max_num 个构成新权重列表（此时按从大到小顺序存放）
     // 同时，将超出最大允许的运行子系统数范围外的运行中子系统清仓回收资金
-    std::list<SystemWeight> new_sw_list;  // 存放新的权重列表
-    size_t count = 0;
-    for (auto iter = sw_list.rbegin(); iter != sw_list.rend(); ++iter) {
-        if (count < max_num) {
-            // 小于最大允许运行数，保存至新的权重列表
-            new_sw_list.push_back(*iter);
-
-        } else if (selected_running_sets.find(iter->getSYS()) != selected_running_sets.end()) {
+    size_t top_num = sw_list.size() < max_num ? sw_list.size() : max_num;
+    std::list<SystemWeight> new_sw_list(sw_list.begin(), sw_list.begin() + top_num);
+    for (size_t i = top_num, total = sw_list.size(); i < total; i++) {
+        if (selected_running_sets.find(sw_list[i].getSYS()) != selected_running_sets.end()) {
             // 超出最大允许运行数且属于正在运行的子系统，则尝试清仓并回收资金
-            auto sys = iter->getSYS();
+            auto sys = sw_list[i].getSYS();
             KRecord record = sys->getTO().getKRecord(date);
             auto tr = sys->_sell(record, PART_ALLOCATEFUNDS);
             if (!tr.isNull()) {
@@ -189,11 +229,10 @@ void AllocateFundsBase::_adjust_with_running(const Datetime& date, const SystemL
                 }
             }
         }
-        count++;
     }
 
     //获取当前总账户资产净值，并计算每单位权重代表的资金
-    price_t total_funds = _getTotalFunds(running_list);
+    price_t total_funds = _getTotalFunds(date, running_list);
 
     // 计算需保留的资产
     price_t reserve_funds = total_funds * m_reserve_percent;
@@ -225,9 +264,7 @@ void AllocateFundsBase::_adjust_with_running(const Datetime& date, const SystemL
         // 获取系统账户的当前资产市值
         SYSPtr sys = iter->getSYS();
         TMPtr tm = sys->getTM();
-        FundsRecord funds = tm->getFunds(m_query.kType());
-        price_t funds_value =
-          funds.cash + funds.market_value + funds.borrow_asset - funds.short_market_value;
+        price_t funds_value = _getSubFunds(sys, date, m_query.kType());
 
         price_t will_funds_value =
           roundDown((iter->getWeight() / weight_unit) * per_weight_funds, precision);
@@ -355,28 +392,19 @@ void AllocateFundsBase::_adjust_without_running(const Datetime& date, const Syst
     SystemWeightList sw_list = _allocateWeight(date, pure_se_list);
     HKU_IF_RETURN(sw_list.size() == 0, void());
 
-    //按权重升序排序（注意：无法保证等权重的相对顺序，即使用stable_sort也一样，后面要倒序遍历）
-    std::sort(
-      sw_list.begin(), sw_list.end(),
-      std::bind(std::less<double>(), std::bind(&SystemWeight::m_weight, std::placeholders::_1),
-                std::bind(&SystemWeight::m_weight, std::placeholders::_2)));
-
-    //倒序遍历，在遇到权重为0或等于运行的最大运行时系统数时结束遍历
-    size_t count = 0;
-    auto sw_iter = sw_list.rbegin();
-    for (; sw_iter != sw_list.rend(); ++sw_iter) {
-        if (sw_iter->getWeight() <= 0.0 || count >= max_num)
+    //按权重从大到小排列前 max_num 个系统实例，在遇到权重为0或等于运行的最大运行时系统数时结束
+    _sortTopWeight(sw_list, max_num);
+    size_t end_pos = 0;
+    for (size_t total = sw_list.size(); end_pos < total; end_pos++) {
+        if (sw_list[end_pos].getWeight() <= 0.0 || end_pos >= max_num)
             break;
-        count++;
     }
 
-    auto end_iter = sw_iter;  // 记录结束位置
-
     // 总账号资金精度
     int precision = m_shadow_tm->getParam<int>("precision");
 
     // 获取当前总资产市值
-    price_t total_funds = _getTotalFunds(running_list);
+    price_t total_funds = _getTotalFunds(date, running_list);
 
     // 计算需保留的资产
     price_t reserve_funds = total_funds * m_reserve_percent;
@@ -390,8 +418,8 @@ void AllocateFundsBase::_adjust_without_running(const Datetime& date, const Syst
     // 再次遍历选中子系统列表，并将剩余现金按权重比例转入子账户
     double weight_unit = getParam<double>("weight_unit");
     price_t per_cash = total_funds * weight_unit;  // 每单位权重资金
-    sw_iter = sw_list.rbegin();
-    for (; sw_iter != end_iter; ++sw_iter) {
+    for (auto sw_iter = sw_list.begin(), end_iter = sw_list.begin() + end_pos; sw_iter != end_iter;
+         ++sw_iter) {
         // 该系统期望分配的资金
         price_t will_cash = roundDown(per_cash * (sw_iter->getWeight() / weight_unit), precision);
         if (will_cash <= std::abs(roundDown(0.0, precision))) {
@@ -9,6 +9,7 @@
 #ifndef TRADE_SYS_ALLOCATEFUNDS_ALLOCATEFUNDSBASE_H_
 #define TRADE_SYS_ALLOCATEFUNDS_ALLOCATEFUNDSBASE_H_
 
+#include <unordered_map>
 #include "../../utilities/Parameter.h"
 #include "../allocatefunds/SystemWeight.h"
 
@@ -104,6 +105,16 @@ public:
      */
     virtual SystemWeightList _allocateWeight(const Datetime& date, const SystemList& se_list) = 0;
 
+    /**
+     * 获取子系统账户当前的资产净值
+     * @details 同一日期内缓存计算结果，子账户发生任何交易或资金、股票存取（交易记录数变化）时
+     *          重新计算；日期变化时总是重新计算，不做增量更新
+     */
+    price_t _getSubFunds(const SYSPtr& sys, const Datetime& date, KQuery::KType ktype);
+
+    /** 按权重从大到小排列前 top_num 个系统实例，等权重时保持原有先后，其余部分不保证顺序 */
+    static void _sortTopWeight(SystemWeightList& sw_list, size_t top_num);
+
 private:
     /* 同时调整已运行中的子系统（已分配资金或已持仓） */
     void _adjust_with_running(const Datetime& date, const SystemList& se_list,
@@ -114,7 +125,15 @@ private:
                                  const std::list<SYSPtr>& running_list);
 
     /* 计算当前的资产总值 */
-    price_t _getTotalFunds(const std::list<SYSPtr>& running_list);
+    price_t _getTotalFunds(const Datetime& date, const std::list<SYSPtr>& running_list);
+
+    /* 子账户资产的同日缓存 */
+    struct SubFunds {
+        Datetime date;        // 计算时的日期
+        KQuery::KType ktype;  // 计算时的K线类型
+        size_t trade_count;   // 计算时的子账户交易记录数
+        price_t value;        // 子账户资产净值
+    };
 
 private:
     string m_name;
@@ -126,6 +145,9 @@ private:
 
     double m_reserve_percent;  //保留资产比例，不参与资产分配
 
+    // 各子系统账户资产净值的同日缓存，无需序列化，复位时清除
+    std::unordered_map<SYSPtr, SubFunds> m_sub_funds;
+
 //============================================
 // 序列化支持
 //============================================
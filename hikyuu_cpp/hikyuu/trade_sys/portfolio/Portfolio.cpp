@@ -5,7 +5,10 @@
  *      Author: fasiondog
  */
 
+#include <unordered_map>
+#include <numeric>
 #include <boost/bind.hpp>
+#include "../../StockManager.h"
 #include "../../trade_manage/crt/crtTM.h"
 
 #include "Portfolio.h"
@@ -223,37 +226,294 @@ FundsRecord Portfolio::getFunds(const Datetime& datetime, KQuery::KType ktype) {
     return total_funds;
 }
 
-PriceList Portfolio::getFundsCurve(const DatetimeList& dates, KQuery::KType ktype) {
+namespace {
+
+/*
+ * 按时刻顺序推进的证券价格游标，同一证券在各子账户间共享
+ * 取值规则与 Stock::getMarketValue 一致，即取小于等于指定时刻的最后一条K线的收盘价
+ */
+class PortfolioPriceCursor {
+public:
+    /* last 为需取值的最后时刻（不含 Null），为 Null 时加载至最后一条K线 */
+    PortfolioPriceCursor(const Stock& stock, KQuery::KType ktype, const Datetime& last)
+    : m_stock(stock),
+      m_ktype(ktype),
+      m_last(last),
+      m_pos(0),
+      m_price(0.0),
+      m_index(Null<size_t>()) {}
+
+    price_t get(const DatetimeList& times, size_t index) {
+        HKU_IF_RETURN(index >= times.size(), 0.0);
+        HKU_IF_RETURN(index == m_index, m_price);
+        const Datetime& datetime = times[index];
+        HKU_IF_RETURN(!m_stock.valid() && datetime > m_stock.lastDatetime(), 0.0);
+
+        if (m_index == Null<size_t>() || datetime < m_datetime) {
+            // 首次取值或时刻回退时，直接查询并重新加载后续K线
+            m_price = m_stock.getMarketValue(datetime, m_ktype);
+            Datetime end =
+              m_last.isNull() || m_last < datetime ? Null<Datetime>() : m_last + Minutes(1);
+            m_records = m_stock.getKRecordList(KQueryByDate(datetime, end, m_ktype));
+            m_pos = 0;
+        } else {
+            while (m_pos < m_records.size() && m_records[m_pos].datetime <= datetime) {
+                m_price = m_records[m_pos].closePrice;
+                m_pos++;
+            }
+        }
+
+        m_index = index;
+        m_datetime = datetime;
+        return m_price;
+    }
+
+private:
+    Stock m_stock;
+    KQuery::KType m_ktype;
+    Datetime m_last;
+    KRecordList m_records;
+    size_t m_pos;
+    price_t m_price;
+    size_t m_index;       // 最近一次取值的日期索引
+    Datetime m_datetime;  // 最近一次取值的时刻
+};
+
+/*
+ * 按交易记录顺序累积计算子账户的历史资产，与 TradeManager::getFundsList 结果一致
+ * 子账户存在融券交易时，直接使用 TradeManager 的计算结果
+ */
+class PortfolioSubFunds {
+public:
+    PortfolioSubFunds(const TMPtr& tm)
+    : m_tm(tm),
+      m_trade_list(tm->getTradeList()),
+      m_pos(0),
+      m_precision(tm->getParam<int>("precision")),
+      m_reinvest(tm->getParam<bool>("reinvest")),
+      m_support_short(false),
+      m_cash(tm->initCash()),
+      m_checkin_cash(0.0),
+      m_checkout_cash(0.0),
+      m_checkin_stock(0.0),
+      m_checkout_stock(0.0),
+      m_borrow_cash(0.0) {
+        for (auto& record : m_trade_list) {
+            if (record.business == BUSINESS_SELL_SHORT || record.business == BUSINESS_BUY_SHORT ||
+                record.business == BUSINESS_BORROW_STOCK ||
+                record.business == BUSINESS_RETURN_STOCK) {
+                m_support_short = true;
+                break;
+            }
+        }
+    }
+
+    /*
+     * 计算指定日期的资产
+     * @param dates 原始日期列表
+     * @param times 按 TradeManager 规则调整后的查询时刻，需按时刻先后依次计算
+     * @param last 最后的非 Null 查询时刻
+     */
+    FundsRecord getFunds(const DatetimeList& dates, const DatetimeList& times, size_t index,
+                         const Datetime& last, KQuery::KType ktype,
+                         std::unordered_map<uint64_t, PortfolioPriceCursor>& cursors) {
+        const Datetime& date = dates[index];
+        Datetime last_datetime = m_tm->lastDatetime();
+        if (m_support_short || date == Null<Datetime>() || date == last_datetime ||
+            (m_reinvest && times[index] > last_datetime)) {
+            return m_tm->getFunds(date, ktype);
+        }
+
+        const Datetime& datetime = times[index];
+        while (m_pos < m_trade_list.size() && m_trade_list[m_pos].datetime <= datetime) {
+            _add(m_trade_list[m_pos]);
+            m_pos++;
+        }
+
+        price_t market_value = 0.0;
+        for (auto& item : m_stock_map) {
+            const Stock& stock = item.second.first;
+            double number = item.second.second;
+            if (number == 0) {
+                continue;
+            }
+
+            auto iter = cursors.find(item.first);
+            if (iter == cursors.end()) {
+                iter = cursors.emplace(item.first, PortfolioPriceCursor(stock, ktype, last)).first;
+            }
+            price_t price = iter->second.get(times, index);
+            market_value = roundEx(market_value + price * number * stock.unit(), m_precision);
+        }
+
+        FundsRecord funds;
+        funds.cash = m_cash;
+        funds.market_value = market_value;
+        funds.base_cash = m_checkin_cash - m_checkout_cash;
+        funds.base_asset = m_checkin_stock - m_checkout_stock;
+        funds.borrow_cash = m_borrow_cash;
+        return funds;
+    }
+
+    const Datetime& initDatetime() const {
+        return m_tm->initDatetime();
+    }
+
+    int precision() const {
+        return m_precision;
+    }
+
+private:
+    void _add(const TradeRecord& record) {
+        m_cash = record.cash;
+        switch (record.business) {
+            case BUSINESS_INIT:
+            case BUSINESS_CHECKIN:
+                m_checkin_cash += record.realPrice;
+                break;
+
+            case BUSINESS_CHECKOUT:
+                m_checkout_cash += record.realPrice;
+                break;
+
+            case BUSINESS_BUY:
+            case BUSINESS_GIFT:
+                _addNumber(record.stock, record.number);
+                break;
+
+            case BUSINESS_SELL:
+                _addNumber(record.stock, -record.number);
+                break;
+
+            case BUSINESS_CHECKIN_STOCK:
+                _addNumber(record.stock, record.number);
+                m_checkin_stock = roundEx(
+                  m_checkin_stock + record.realPrice * record.number * record.stock.unit(),
+                  m_precision);
+                break;
+
+            case BUSINESS_CHECKOUT_STOCK:
+                _addNumber(record.stock, -record.number);
+                m_checkout_stock = roundEx(
+                  m_checkout_stock + record.realPrice * record.number * record.stock.unit(),
+                  m_precision);
+                break;
+
+            case BUSINESS_BORROW_CASH:
+                m_borrow_cash += record.realPrice;
+                break;
+
+            case BUSINESS_RETURN_CASH:
+                m_borrow_cash -= record.realPrice;
+                break;
+
+            default:
+                break;
+        }
+    }
+
+    void _addNumber(const Stock& stock, double number) {
+        auto iter = m_stock_map.find(stock.id());
+        if (iter == m_stock_map.end()) {
+            m_stock_map[stock.id()] = std::make_pair(stock, number);
+        } else {
+            iter->second.second += number;
+        }
+    }
+
+private:
+    TMPtr m_tm;
+    TradeRecordList m_trade_list;
+    size_t m_pos;
+    int m_precision;
+    bool m_reinvest;
+    bool m_support_short;
+    price_t m_cash;
+    price_t m_checkin_cash;
+    price_t m_checkout_cash;
+    price_t m_checkin_stock;
+    price_t m_checkout_stock;
+    price_t m_borrow_cash;
+    map<uint64_t, std::pair<Stock, double>> m_stock_map;
+};
+
+}  // namespace
+
+PortfolioCurves Portfolio::getCurves(const DatetimeList& dates, KQuery::KType ktype) {
+    PortfolioCurves result;
     size_t total = dates.size();
-    PriceList result(total);
+    result.funds.resize(total);
+    result.profit.resize(total);
+
+    // 与 TradeManager::getFunds 一致，按当日 11:59 查询
+    DatetimeList times(total);
+    for (size_t i = 0; i < total; i++) {
+        const Datetime& date = dates[i];
+        times[i] = date == Null<Datetime>()
+                     ? date
+                     : Datetime(date.year(), date.month(), date.day(), 11, 59);
+    }
+
+    std::vector<PortfolioSubFunds> sub_funds;
+    sub_funds.reserve(m_all_sys_set.size());
     for (auto& sub_sys : m_all_sys_set) {
-        auto curve = sub_sys->getTM()->getFundsCurve(dates, ktype);
-        for (auto i = 0; i < total; i++) {
-            result[i] += curve[i];
+        result.sys_list.push_back(sub_sys);
+        sub_funds.emplace_back(sub_sys->getTM());
+    }
+    size_t sys_total = sub_funds.size();
+    result.sys_funds.resize(sys_total, PriceList(total));
+
+    // 子账户按交易记录顺序累积，日期列表无序时按排序后的顺序计算，结果写回原位置
+    vector<size_t> order(total);
+    std::iota(order.begin(), order.end(), 0);
+    if (!std::is_sorted(times.begin(), times.end())) {
+        std::stable_sort(order.begin(), order.end(),
+                         [&times](size_t a, size_t b) { return times[a] < times[b]; });
+    }
+
+    Datetime last;
+    for (auto iter = order.rbegin(); iter != order.rend() && last.isNull(); ++iter) {
+        last = times[*iter];
+    }
+
+    // 同一证券在各子账户间共享价格游标，按时刻顺序推进
+    std::unordered_map<uint64_t, PortfolioPriceCursor> cursors;
+    for (size_t i : order) {
+        for (size_t j = 0; j < sys_total; j++) {
+            PortfolioSubFunds& sub = sub_funds[j];
+            FundsRecord funds = sub.getFunds(dates, times, i, last, ktype, cursors);
+            price_t value =
+              funds.cash + funds.market_value - funds.borrow_cash - funds.borrow_asset;
+            price_t funds_value = roundEx(value, sub.precision());
+            result.sys_funds[j][i] = funds_value;
+            result.funds[i] += funds_value;
+            if (dates[i] >= sub.initDatetime()) {
+                result.profit[i] +=
+                  roundEx(value - funds.base_cash - funds.base_asset, sub.precision());
+            }
         }
     }
+
     return result;
 }
 
+PriceList Portfolio::getFundsCurve(const DatetimeList& dates, KQuery::KType ktype) {
+    return getCurves(dates, ktype).funds;
+}
+
 PriceList Portfolio::getFundsCurve() {
-    DatetimeList dates = getDateRange(m_shadow_tm->initDatetime(), Datetime::now());
+    DatetimeList dates = StockManager::instance().getTradingCalendar(
+      KQueryByDate(m_shadow_tm->initDatetime(), Null<Datetime>(), KQuery::DAY));
     return getFundsCurve(dates, KQuery::DAY);
 }
 
 PriceList Portfolio::getProfitCurve(const DatetimeList& dates, KQuery::KType ktype) {
-    size_t total = dates.size();
-    PriceList result(total);
-    for (auto& sub_sys : m_all_sys_set) {
-        auto curve = sub_sys->getTM()->getProfitCurve(dates, ktype);
-        for (auto i = 0; i < total; i++) {
-            result[i] += curve[i];
-        }
-    }
-    return result;
+    return getCurves(dates, ktype).profit;
 }
 
 PriceList Portfolio::getProfitCurve() {
-    DatetimeList dates = getDateRange(m_shadow_tm->initDatetime(), Datetime::now());
+    DatetimeList dates = StockManager::instance().getTradingCalendar(
+      KQueryByDate(m_shadow_tm->initDatetime(), Null<Datetime>(), KQuery::DAY));
     return getProfitCurve(dates, KQuery::DAY);
 }
 
@@ -20,6 +20,17 @@
 
 namespace hku {
 
+/**
+ * 资产组合的资产曲线，由 Portfolio::getCurves 一次计算得到
+ * @ingroup Portfolio
+ */
+struct HKU_API PortfolioCurves {
+    PriceList funds;              ///< 资产净值曲线
+    PriceList profit;             ///< 收益曲线
+    SystemList sys_list;          ///< 子系统列表
+    vector<PriceList> sys_funds;  ///< 与 sys_list 一一对应的各子系统资产净值曲线
+};
+
 /*
  * 资产组合
  * @ingroup Portfolio
@@ -114,7 +125,7 @@ public:
     PriceList getFundsCurve(const DatetimeList& dates, KQuery::KType ktype = KQuery::DAY);
 
     /**
-     * 获取从账户建立日期到系统当前日期的资产净值曲线（按自然日）
+     * 获取从账户建立日期到系统当前日期的资产净值曲线（按交易日）
      * @return 资产净值列表
      */
     PriceList getFundsCurve();
@@ -128,11 +139,20 @@ public:
     PriceList getProfitCurve(const DatetimeList& dates, KQuery::KType ktype = KQuery::DAY);
 
     /**
-     * 获取获取从账户建立日期到系统当前日期的收益曲线
+     * 获取获取从账户建立日期到系统当前日期的收益曲线（按交易日）
      * @return 收益曲线
      */
     PriceList getProfitCurve();
 
+    /**
+     * 按日期顺序合并所有子账户的交易记录，一次计算资产净值曲线、收益曲线及各子系统的资产净值曲线
+     * @details 同一证券的价格在各子账户间共享，按日期顺序推进，无需逐日逐账户查询行情
+     * @param dates 日期列表，应为递增顺序
+     * @param ktype K线类型，必须与日期列表匹配，默认KQuery::DAY
+     * @return 资产曲线
+     */
+    PortfolioCurves getCurves(const DatetimeList& dates, KQuery::KType ktype = KQuery::DAY);
+
 protected:
     string m_name;
     TMPtr m_tm;
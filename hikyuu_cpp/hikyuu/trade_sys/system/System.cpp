@@ -105,6 +105,9 @@ void System::initParam() {
 
     //在没有持仓时，是否支持借入证券，融券
     setParam<bool>("support_borrow_stock", false);
+
+    //是否使用快速回测模式（仅跳过不会引起状态变化的Bar，交易结果与逐Bar执行一致）
+    setParam<bool>("fast_run", false);
 }
 
 void System::reset(bool with_tm, bool with_ev) {
@@ -276,6 +279,16 @@ void System::run(const KQuery& query, bool reset) {
 
     setTO(kdata);
     size_t total = kdata.size();
+    if (getParam<bool>("fast_run")) {
+        Datetime init_datetime = m_tm->initDatetime();
+        size_t start = 0;
+        while (start < total && kdata[start].datetime < init_datetime) {
+            start++;
+        }
+        _runFast(kdata, start);
+        return;
+    }
+
     for (size_t i = 0; i < total; ++i) {
         if (kdata[i].datetime >= m_tm->initDatetime()) {
             runMoment(kdata[i]);
@@ -283,6 +296,126 @@ void System::run(const KQuery& query, bool reset) {
     }
 }
 
+/*
+ * 快速回测
+ * 逐Bar执行时，即使没有任何信号，每个Bar也需执行各部件的虚函数调用及TM持仓查询。
+ * 这里预先将EV/CN/SG计算为标志序列，在未持仓、无延迟请求且无信号的Bar上仅更新
+ * 前一时刻的有效标志；持仓期间仅计算止损/止赢/目标价，一旦可能触发交易，则完全
+ * 交由_runMoment处理，以保证交易记录与逐Bar执行完全一致。
+ */
+void System::_runFast(const KData& kdata, size_t start) {
+    enum : uint8_t {
+        BAR_CAN_TRADE = 0x01,
+        BAR_EV_VALID = 0x02,
+        BAR_CN_VALID = 0x04,
+        BAR_SG_BUY = 0x08,
+        BAR_SG_SELL = 0x10,
+    };
+
+    size_t total = kdata.size();
+    HKU_IF_RETURN(start >= total, void());
+
+    bool can_trade_when_high_eq_low = getParam<bool>("can_trade_when_high_eq_low");
+    bool ev_open_position = getParam<bool>("ev_open_position");
+    bool cn_open_position = getParam<bool>("cn_open_position");
+
+    KRecordList records(total - start);
+    vector<uint8_t> flags(total - start, 0);
+    for (size_t i = start; i < total; i++) {
+        KRecord& k = records[i - start];
+        k = kdata[i];
+        uint8_t flag = 0;
+        if ((k.highPrice != k.lowPrice && k.closePrice <= k.highPrice &&
+             k.closePrice >= k.lowPrice) ||
+            can_trade_when_high_eq_low) {
+            flag |= BAR_CAN_TRADE;
+        }
+        if (_environmentIsValid(k.datetime)) {
+            flag |= BAR_EV_VALID;
+        }
+        if (_conditionIsValid(k.datetime)) {
+            flag |= BAR_CN_VALID;
+        }
+        if (m_sg->shouldBuy(k.datetime)) {
+            flag |= BAR_SG_BUY;
+        }
+        if (m_sg->shouldSell(k.datetime)) {
+            flag |= BAR_SG_SELL;
+        }
+        flags[i - start] = flag;
+    }
+
+    // 持仓状态只在交易操作后发生变化，仅在执行完整的_runMoment后刷新
+    PositionRecord position = m_tm->getPosition(m_stock);
+    bool have = m_tm->have(m_stock);
+
+    size_t count = records.size();
+    for (size_t i = 0; i < count; i++) {
+        const KRecord& today = records[i];
+        uint8_t flag = flags[i];
+        m_buy_days++;
+        m_sell_short_days++;
+
+        if (!(flag & BAR_CAN_TRADE)) {
+            continue;
+        }
+
+        bool quiet = !haveDelayRequest();
+        bool ev_valid = flag & BAR_EV_VALID;
+        bool cn_valid = flag & BAR_CN_VALID;
+        price_t take_profit = 0.0;
+        if (quiet) {
+            if (!ev_valid) {
+                quiet = !have;
+            } else if (!m_pre_ev_valid && ev_open_position) {
+                quiet = false;
+            } else if (!cn_valid) {
+                quiet = !have;
+            } else if (!m_pre_cn_valid && cn_open_position) {
+                quiet = false;
+            } else if (flag & BAR_SG_BUY) {
+                quiet = false;
+            } else if (flag & BAR_SG_SELL) {
+                quiet = !have;
+            } else if (position.number != 0) {
+                price_t current_price = today.closePrice;
+                if (current_price <= position.stoploss ||
+                    current_price >= _getGoalPrice(today.datetime, current_price)) {
+                    quiet = false;
+                } else {
+                    take_profit = _getTakeProfitPrice(today.datetime);
+                    if (take_profit != 0.0 &&
+                        current_price <= std::max(take_profit, m_lastTakeProfit)) {
+                        quiet = false;
+                    }
+                }
+            }
+        }
+
+        if (!quiet) {
+            _runMoment(today);
+            position = m_tm->getPosition(m_stock);
+            have = m_tm->have(m_stock);
+            continue;
+        }
+
+        // 以下和_runMoment中未触发任何操作时的状态变化保持一致
+        if (!ev_valid) {
+            m_pre_ev_valid = false;
+            continue;
+        }
+        m_pre_ev_valid = true;
+        if (!cn_valid) {
+            m_pre_cn_valid = false;
+            continue;
+        }
+        m_pre_cn_valid = true;
+        if (take_profit != 0.0 && take_profit >= m_lastTakeProfit) {
+            m_lastTakeProfit = take_profit;
+        }
+    }
+}
+
 void System::run(const Stock& stock, const KQuery& query, bool reset) {
     m_stock = stock;
     run(query, reset);
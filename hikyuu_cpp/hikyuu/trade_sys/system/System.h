@@ -223,6 +223,9 @@ public:
 
     TradeRecord _runMoment(const KRecord& record);
 
+    //快速回测，预先计算EV/CN/SG序列，只在可能发生状态变化的Bar上执行_runMoment
+    void _runFast(const KData& kdata, size_t start);
+
 protected:
     TradeManagerPtr m_tm;
     MoneyManagerPtr m_mm;
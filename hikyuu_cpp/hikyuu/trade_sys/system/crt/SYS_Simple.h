@@ -23,6 +23,7 @@ namespace hku {
  * 延迟操作时使用上一时刻计算的数量，因为实际人工操作时，可能无法实时计算买入数量
  * support_borrow_cash [bool | false]：在现金不足时，是否支持借入现金，融资
  * support_borrow_stock [bool | fals]): 在没有持仓时，是否支持借入证券，融券
+ * fast_run [bool | false]: 快速回测模式，仅在可能发生状态变化的Bar上执行完整判断
  *
  * 本系统参数：
  * ev_dealy [bool | true]: 系统环境失效时，是否延迟在下一时刻开盘执行
@@ -0,0 +1,204 @@
+/*
+ * FlatIdMap.h
+ *
+ *  Copyright (c) 2026 hikyuu.org
+ *
+ *  Created on: 2026-10-18
+ *      Author: fasiondog
+ */
+
+#pragma once
+#ifndef HIKYUU_UTILITIES_FLATIDMAP_H
+#define HIKYUU_UTILITIES_FLATIDMAP_H
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+
+namespace hku {
+
+/**
+ * @ingroup Utilities
+ * @{
+ */
+
+/**
+ * 以 uint64_t 为键（如 Stock::id()）的开放寻址哈希表
+ * @details 值按插入顺序连续存放，索引表使用线性探测，删除时以末尾元素填补空位，
+ *          故遍历顺序不固定。接口与 std::map 的常用部分保持一致，迭代器的 first 为键，
+ *          second 为值。插入或删除后，已有迭代器及引用均可能失效。
+ */
+template <typename T>
+class FlatIdMap {
+public:
+    typedef uint64_t key_type;
+    typedef T mapped_type;
+    typedef std::pair<uint64_t, T> value_type;
+    typedef typename std::vector<value_type>::iterator iterator;
+    typedef typename std::vector<value_type>::const_iterator const_iterator;
+
+    FlatIdMap() = default;
+    FlatIdMap(const FlatIdMap&) = default;
+    FlatIdMap(FlatIdMap&&) = default;
+    FlatIdMap& operator=(const FlatIdMap&) = default;
+    FlatIdMap& operator=(FlatIdMap&&) = default;
+
+    iterator begin() {
+        return m_values.begin();
+    }
+
+    iterator end() {
+        return m_values.end();
+    }
+
+    const_iterator begin() const {
+        return m_values.begin();
+    }
+
+    const_iterator end() const {
+        return m_values.end();
+    }
+
+    std::size_t size() const {
+        return m_values.size();
+    }
+
+    bool empty() const {
+        return m_values.empty();
+    }
+
+    void clear() {
+        m_values.clear();
+        m_index.clear();
+    }
+
+    iterator find(uint64_t key) {
+        std::size_t slot = _findSlot(key);
+        return slot == npos ? m_values.end() : m_values.begin() + m_index[slot];
+    }
+
+    const_iterator find(uint64_t key) const {
+        std::size_t slot = _findSlot(key);
+        return slot == npos ? m_values.end() : m_values.begin() + m_index[slot];
+    }
+
+    std::size_t count(uint64_t key) const {
+        return _findSlot(key) == npos ? 0 : 1;
+    }
+
+    /** 获取指定键的值，不存在时插入默认值 */
+    T& operator[](uint64_t key) {
+        std::size_t slot = _findSlot(key);
+        if (slot != npos) {
+            return m_values[m_index[slot]].second;
+        }
+
+        // 保持负载因子不超过 1/2
+        if ((m_values.size() + 1) * 2 > m_index.size()) {
+            _rehash(m_index.empty() ? 16 : m_index.size() * 2);
+        }
+        m_values.emplace_back(key, T());
+        m_index[_emptySlot(key)] = uint32_t(m_values.size() - 1);
+        return m_values.back().second;
+    }
+
+    /** 删除指定键，返回删除的元素数 */
+    std::size_t erase(uint64_t key) {
+        std::size_t slot = _findSlot(key);
+        if (slot == npos) {
+            return 0;
+        }
+        _eraseSlot(slot);
+        return 1;
+    }
+
+    /** 删除迭代器所指元素，返回指向原位置（已由末尾元素填补）的迭代器 */
+    iterator erase(iterator iter) {
+        std::size_t pos = iter - m_values.begin();
+        _eraseSlot(_findSlot(iter->first));
+        return m_values.begin() + pos;
+    }
+
+private:
+    static constexpr std::size_t npos = std::numeric_limits<std::size_t>::max();
+    static constexpr uint32_t EMPTY = std::numeric_limits<uint32_t>::max();
+
+    static std::size_t _hash(uint64_t key) {
+        // splitmix64 混合，Stock::id() 为指针地址，低位分布不均
+        key ^= key >> 30;
+        key *= 0xbf58476d1ce4e5b9ULL;
+        key ^= key >> 27;
+        key *= 0x94d049bb133111ebULL;
+        key ^= key >> 31;
+        return std::size_t(key);
+    }
+
+    std::size_t _findSlot(uint64_t key) const {
+        if (m_index.empty()) {
+            return npos;
+        }
+        std::size_t mask = m_index.size() - 1;
+        std::size_t slot = _hash(key) & mask;
+        while (m_index[slot] != EMPTY) {
+            if (m_values[m_index[slot]].first == key) {
+                return slot;
+            }
+            slot = (slot + 1) & mask;
+        }
+        return npos;
+    }
+
+    std::size_t _emptySlot(uint64_t key) const {
+        std::size_t mask = m_index.size() - 1;
+        std::size_t slot = _hash(key) & mask;
+        while (m_index[slot] != EMPTY) {
+            slot = (slot + 1) & mask;
+        }
+        return slot;
+    }
+
+    void _rehash(std::size_t capacity) {
+        m_index.assign(capacity, EMPTY);
+        for (std::size_t i = 0, total = m_values.size(); i < total; i++) {
+            m_index[_emptySlot(m_values[i].first)] = uint32_t(i);
+        }
+    }
+
+    void _eraseSlot(std::size_t slot) {
+        std::size_t mask = m_index.size() - 1;
+        uint32_t pos = m_index[slot];
+
+        // 线性探测的后移删除，保证后续键仍可被找到
+        std::size_t hole = slot;
+        std::size_t next = (hole + 1) & mask;
+        while (m_index[next] != EMPTY) {
+            std::size_t home = _hash(m_values[m_index[next]].first) & mask;
+            if (((next - home) & mask) >= ((next - hole) & mask)) {
+                m_index[hole] = m_index[next];
+                hole = next;
+            }
+            next = (next + 1) & mask;
+        }
+        m_index[hole] = EMPTY;
+
+        // 以末尾元素填补被删除元素的位置
+        uint32_t last = uint32_t(m_values.size() - 1);
+        if (pos != last) {
+            m_index[_findSlot(m_values[last].first)] = pos;
+            m_values[pos] = std::move(m_values[last]);
+        }
+        m_values.pop_back();
+    }
+
+private:
+    std::vector<value_type> m_values;  // 按插入顺序连续存放的键值对
+    std::vector<uint32_t> m_index;     // 开放寻址索引，存放 m_values 中的下标
+};
+
+/** @} */
+
+}  // namespace hku
+
+#endif /* HIKYUU_UTILITIES_FLATIDMAP_H */
@@ -0,0 +1,137 @@
+/*
+ * LatencyHistogram.h
+ *
+ *  Copyright (c) 2026 hikyuu.org
+ *
+ *  Created on: 2026-10-18
+ *      Author: fasiondog
+ */
+
+#pragma once
+#ifndef HIKYUU_UTILITIES_LATENCYHISTOGRAM_H
+#define HIKYUU_UTILITIES_LATENCYHISTOGRAM_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <fmt/format.h>
+
+namespace hku {
+
+/**
+ * @ingroup Utilities
+ * @{
+ */
+
+/**
+ * 耗时分布统计（微秒），按 2 的幂次划分区间
+ * @details 第 i 个区间对应 [2^(i-1), 2^i) 微秒，第 0 个区间对应 0 微秒。记录与读取均为无锁操作，
+ *          可在记录线程之外的线程中读取统计结果，读取结果为近似的瞬时值。
+ */
+class LatencyHistogram {
+public:
+    static constexpr size_t BUCKET_COUNT = 64;
+
+    LatencyHistogram() {
+        clear();
+    }
+
+    /** 记录一次耗时（微秒），负值按 0 处理 */
+    void add(int64_t us) {
+        uint64_t value = us > 0 ? uint64_t(us) : 0;
+        m_buckets[_bucket(value)].fetch_add(1, std::memory_order_relaxed);
+        m_count.fetch_add(1, std::memory_order_relaxed);
+        m_sum.fetch_add(value, std::memory_order_relaxed);
+        uint64_t pre = m_max.load(std::memory_order_relaxed);
+        while (value > pre &&
+               !m_max.compare_exchange_weak(pre, value, std::memory_order_relaxed)) {
+        }
+    }
+
+    /** 清除全部记录 */
+    void clear() {
+        for (auto& bucket : m_buckets) {
+            bucket.store(0, std::memory_order_relaxed);
+        }
+        m_count.store(0, std::memory_order_relaxed);
+        m_sum.store(0, std::memory_order_relaxed);
+        m_max.store(0, std::memory_order_relaxed);
+    }
+
+    /** 记录次数 */
+    uint64_t count() const {
+        return m_count.load(std::memory_order_relaxed);
+    }
+
+    /** 最大耗时（微秒） */
+    uint64_t max() const {
+        return m_max.load(std::memory_order_relaxed);
+    }
+
+    /** 平均耗时（微秒） */
+    double mean() const {
+        uint64_t total = count();
+        return total == 0 ? 0.0 : double(m_sum.load(std::memory_order_relaxed)) / double(total);
+    }
+
+    /** 指定区间内的记录次数 */
+    uint64_t bucketCount(size_t i) const {
+        return i < BUCKET_COUNT ? m_buckets[i].load(std::memory_order_relaxed) : 0;
+    }
+
+    /**
+     * 分位数耗时（微秒），返回分位数所在区间的上界，且不超过最大耗时
+     * @param p 分位数，取值范围 [0, 1]，如 0.99
+     */
+    uint64_t percentile(double p) const {
+        uint64_t total = count();
+        if (total == 0) {
+            return 0;
+        }
+        p = p < 0.0 ? 0.0 : (p > 1.0 ? 1.0 : p);
+        uint64_t target = uint64_t(p * double(total));
+        if (target == 0) {
+            target = 1;
+        }
+        uint64_t acc = 0;
+        for (size_t i = 0; i < BUCKET_COUNT; i++) {
+            acc += m_buckets[i].load(std::memory_order_relaxed);
+            if (acc >= target) {
+                uint64_t upper = i == 0 ? 0 : (i >= 63 ? UINT64_MAX : (uint64_t(1) << i) - 1);
+                uint64_t max_value = max();
+                return upper < max_value ? upper : max_value;
+            }
+        }
+        return max();
+    }
+
+    /** 统计信息摘要 */
+    std::string str() const {
+        return fmt::format("count: {}, mean: {:.1f}us, p50: {}us, p90: {}us, p99: {}us, max: {}us",
+                           count(), mean(), percentile(0.5), percentile(0.9), percentile(0.99),
+                           max());
+    }
+
+private:
+    static size_t _bucket(uint64_t value) {
+        size_t i = 0;
+        while (value > 0 && i < BUCKET_COUNT - 1) {
+            value >>= 1;
+            i++;
+        }
+        return i;
+    }
+
+private:
+    std::atomic<uint64_t> m_buckets[BUCKET_COUNT];
+    std::atomic<uint64_t> m_count;
+    std::atomic<uint64_t> m_sum;
+    std::atomic<uint64_t> m_max;
+};
+
+/** @} */
+
+}  // namespace hku
+
+#endif /* HIKYUU_UTILITIES_LATENCYHISTOGRAM_H */
@@ -11,11 +11,16 @@
 #include "../datetime/Datetime.h"
 #include "../Log.h"
 #include "thread/ThreadPool.h"
+#include "LatencyHistogram.h"
+#include "TimingWheel.h"
 
 namespace hku {
 
 /**
  * 定时管理与调度
+ * @details 定时任务以分层时间轮（1 毫秒一格）调度，添加、移除均为 O(1)。检测线程每次唤醒时
+ *          批量取出全部到期任务，在释放锁后提交至任务执行线程池，并记录任务实际开始执行时刻
+ *          与计划时刻的偏差。
  * @ingroup Utilities
  */
 class TimerManager {
@@ -32,15 +37,14 @@ public:
      * @param work_num 定时任务执行线程池线程数量
      */
     TimerManager(size_t work_num = std::thread::hardware_concurrency())
-    : m_current_timer_id(-1), m_stop(true), m_work_num(work_num) {}
+    : m_stop(true), m_current_timer_id(-1), m_work_num(work_num) {}
 
     /** 析构函数 */
     ~TimerManager() {
         if (!m_stop) {
-            IntervalS s;
-            s.m_time_point = Datetime::min();
             std::unique_lock<std::mutex> lock(m_mutex);
-            m_queue.push(s);
+            m_quit = true;
+            m_wheel.reset(_nowTicks());
             lock.unlock();
             m_cond.notify_all();
             if (m_detect_thread.joinable()) {
@@ -67,6 +71,8 @@ public:
 
             std::forward_list<int> invalid_timers;  // 记录已无效的 timer
             std::unique_lock<std::mutex> lock(m_mutex);
+            m_quit = false;
+            m_wheel.reset(_nowTicks());
             for (auto iter = m_timers.begin(); iter != m_timers.end(); ++iter) {
                 int time_id = iter->first;
                 Timer* timer = iter->second;
@@ -79,47 +85,45 @@ public:
                     continue;
                 }
 
-                IntervalS s;
-                s.m_timer_id = time_id;
+                Datetime time_point;
                 if (timer->m_start_time < TimeDelta()) {
                     Datetime first_start_time = timer->m_start_date + timer->m_end_time;
                     if (first_start_time >= now) {
-                        s.m_time_point = first_start_time;
+                        time_point = first_start_time;
                     } else {
                         if (timer->m_repeat_num <= 1) {
                             invalid_timers.push_front(time_id);
                             continue;
                         }
-                        s.m_time_point = now.startOfDay() + timer->m_end_time;
-                        if (s.m_time_point < now) {
-                            s.m_time_point = s.m_time_point + TimeDelta(1);
+                        time_point = now.startOfDay() + timer->m_end_time;
+                        if (time_point < now) {
+                            time_point = time_point + TimeDelta(1);
                         }
                     }
 
                 } else {
-                    s.m_time_point =
-                      timer->m_start_date >= now.startOfDay()
-                        ? timer->m_start_date + timer->m_start_time + timer->m_duration
-                        : now + timer->m_duration;
+                    time_point = timer->m_start_date >= now.startOfDay()
+                                   ? timer->m_start_date + timer->m_start_time + timer->m_duration
+                                   : now + timer->m_duration;
                     if (timer->m_start_time != timer->m_end_time) {
-                        Datetime point_date = s.m_time_point.startOfDay();
-                        TimeDelta point = s.m_time_point - point_date;
+                        Datetime point_date = time_point.startOfDay();
+                        TimeDelta point = time_point - point_date;
                         if (point < timer->m_start_time) {
-                            s.m_time_point = point_date + timer->m_start_time;
+                            time_point = point_date + timer->m_start_time;
                         } else if (point > timer->m_end_time) {
-                            s.m_time_point = point_date + timer->m_start_time + TimeDelta(1);
+                            time_point = point_date + timer->m_start_time + TimeDelta(1);
                         } else {
                             TimeDelta gap = point - timer->m_start_time;
                             if (gap % timer->m_duration != TimeDelta()) {
                                 int x = int(gap / timer->m_duration) + 1;
-                                s.m_time_point =
+                                time_point =
                                   point_date + timer->m_start_time + timer->m_duration * double(x);
                             }
                         }
                     }
                 }
 
-                m_queue.push(s);
+                _schedule(timer, time_point);
             }
 
             // 清除已无效的 timer
@@ -138,8 +142,7 @@ public:
     void stop() {
         if (!m_stop) {
             std::unique_lock<std::mutex> lock(m_mutex);
-            std::priority_queue<IntervalS> queue;
-            m_queue.swap(queue);
+            m_wheel.reset(_nowTicks());
             m_stop = true;
             lock.unlock();
             m_cond.notify_all();
@@ -279,71 +282,119 @@ public:
      */
     void removeTimer(int timerid) {
         std::unique_lock<std::mutex> lock(m_mutex);
-        auto iter = m_timers.find(timerid);
-        if (iter != m_timers.end()) {
-            iter->second->m_repeat_num = 0;
+        if (m_timers.find(timerid) != m_timers.end()) {
+            _removeTimer(timerid);
         }
     }
 
+    /** 定时任务数量 */
+    size_t size() const {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        return m_timers.size();
+    }
+
+    /**
+     * 任务实际开始执行时刻与计划时刻的偏差统计（微秒），包含在执行线程池中排队等待的时间
+     */
+    const LatencyHistogram& getJitter() const {
+        return m_jitter;
+    }
+
 private:
+    class Timer;
+
     void _removeTimer(int id) {
-        delete m_timers[id];
-        m_timers.erase(id);
+        auto iter = m_timers.find(id);
+        m_wheel.remove(&iter->second->m_node);
+        delete iter->second;
+        m_timers.erase(iter);
+    }
+
+    /* 以 Datetime::min() 为原点的微秒数，作为时间轮的时间 */
+    static int64_t _toTicks(const Datetime& d) {
+        return (d - Datetime::min()).ticks();
+    }
+
+    static int64_t _nowTicks() {
+        return _toTicks(Datetime::now());
+    }
+
+    void _schedule(Timer* timer, const Datetime& time_point) {
+        timer->m_time_point = time_point;
+        timer->m_node.expire = _toTicks(time_point);
+        m_wheel.add(&timer->m_node);
     }
 
     void detectThread() {
-        while (!m_stop) {
+        std::vector<int> expired;                                  // 本轮到期的 timer
+        std::vector<std::pair<Datetime, std::function<void()>>> tasks;  // 本轮待提交的任务
+        std::unique_lock<std::mutex> lock(m_mutex);
+        while (!m_stop && !m_quit) {
             Datetime now = Datetime::now();
-            std::unique_lock<std::mutex> lock(m_mutex);
-            if (m_queue.empty()) {
-                m_cond.wait(lock);
-                continue;
-            }
+            expired.clear();
+            m_wheel.advance(_toTicks(now),
+                            [&](TimingWheel::Node* node) { expired.push_back(node->id); });
 
-            IntervalS s = m_queue.top();
-            if (s.m_time_point == Datetime::min()) {
-                break;  // 结束检测线程，用于 dll 能够安全退出，因为atomic在dll退出时可能无效
-            }
+            for (int id : expired) {
+                auto timer_iter = m_timers.find(id);
+                if (timer_iter == m_timers.end()) {
+                    continue;
+                }
 
-            TimeDelta diff = s.m_time_point - now;
-            if (diff > TimeDelta()) {
-                m_cond.wait_for(lock, std::chrono::duration<int64_t, std::micro>(diff.ticks()));
-                continue;
-            }
+                auto timer = timer_iter->second;
+                tasks.emplace_back(timer->m_time_point, timer->m_func);
 
-            m_queue.pop();
-            auto timer_iter = m_timers.find(s.m_timer_id);
-            if (timer_iter == m_timers.end()) {
-                continue;
-            }
+                if (timer->m_repeat_num != std::numeric_limits<int>::max()) {
+                    timer->m_repeat_num--;
+                }
 
-            auto timer = timer_iter->second;
-            m_tg->submit(timer->m_func);
+                if (timer->m_repeat_num <= 0) {
+                    _removeTimer(id);
+                    continue;
+                }
 
-            if (timer->m_repeat_num != std::numeric_limits<int>::max()) {
-                timer->m_repeat_num--;
-            }
+                Datetime today = now.startOfDay();
+                Datetime time_point = timer->m_start_time >= TimeDelta()
+                                        ? timer->m_time_point + timer->m_duration
+                                        : timer->m_time_point + TimeDelta(1);
+                if (timer->m_end_date != Datetime::max() &&
+                    time_point > timer->m_end_date + timer->m_end_time) {
+                    _removeTimer(id);
+                    continue;
+                }
 
-            if (timer->m_repeat_num <= 0) {
-                _removeTimer(s.m_timer_id);
-                continue;
+                if (timer->m_start_time >= TimeDelta() &&
+                    timer->m_start_time != timer->m_end_time &&
+                    time_point > today + timer->m_end_time) {
+                    time_point = today + timer->m_start_time + TimeDelta(1);
+                }
+                HKU_TRACE("time_point: {}", time_point.repr());
+                _schedule(timer, time_point);
             }
 
-            Datetime today = now.startOfDay();
-            s.m_time_point = timer->m_start_time >= TimeDelta() ? s.m_time_point + timer->m_duration
-                                                                : s.m_time_point + TimeDelta(1);
-            if (timer->m_end_date != Datetime::max() &&
-                s.m_time_point > timer->m_end_date + timer->m_end_time) {
-                _removeTimer(s.m_timer_id);
+            // 到期任务在锁外批量提交，避免阻塞定时任务的添加与移除
+            if (!tasks.empty()) {
+                lock.unlock();
+                for (auto& task : tasks) {
+                    m_tg->submit([this, point = task.first, func = std::move(task.second)]() {
+                        m_jitter.add((Datetime::now() - point).ticks());
+                        func();
+                    });
+                }
+                tasks.clear();
+                lock.lock();
                 continue;
             }
 
-            if (timer->m_start_time >= TimeDelta() && timer->m_start_time != timer->m_end_time &&
-                s.m_time_point > today + timer->m_end_time) {
-                s.m_time_point = today + timer->m_start_time + TimeDelta(1);
+            int64_t next = m_wheel.nextExpire();
+            if (next == INT64_MAX) {
+                m_cond.wait(lock);
+            } else {
+                int64_t diff = next - _nowTicks();
+                if (diff > 0) {
+                    m_cond.wait_for(lock, std::chrono::duration<int64_t, std::micro>(diff));
+                }
             }
-            HKU_TRACE("s.m_time_point: {}", s.m_time_point.repr());
-            m_queue.push(s);
         }
     }
 
@@ -390,14 +441,9 @@ private:
         TimeDelta m_duration;    // 延迟时长或间隔时长
         int m_repeat_num = 1;    // 重复执行次数，max标识无限循环
         std::function<void()> m_func;
-    };
 
-    struct IntervalS {
-        Datetime m_time_point;  // 执行的精确时间点
-        int m_timer_id = -1;    // 对应的 Timer, 负数无效
-        bool operator<(const IntervalS& other) const {
-            return m_time_point > other.m_time_point;
-        }
+        Datetime m_time_point;     // 下次执行的精确时间点
+        TimingWheel::Node m_node;  // 在时间轮中的节点，m_node.id 为 timer id
     };
 
     template <typename F, typename... Args>
@@ -421,35 +467,37 @@ private:
         timer->m_duration = duration;
         timer->m_func = std::bind(std::forward<F>(f), std::forward<Args>(args)...);
 
-        IntervalS s;
+        Datetime time_point;
         if (start_time < TimeDelta()) {
             Datetime first_start_time = start_date + end_time;
             if (first_start_time >= now) {
-                s.m_time_point = first_start_time;
+                time_point = first_start_time;
             } else {
-                HKU_CHECK(repeat_num > 1, "The time has expired! expect time {}, but now is {}",
-                          first_start_time, now);
-                s.m_time_point = today + end_time;
-                if (s.m_time_point < now) {
-                    s.m_time_point = s.m_time_point + TimeDelta(1);
+                if (repeat_num <= 1) {
+                    delete timer;
+                    HKU_THROW("The time has expired! expect time {}, but now is {}",
+                              first_start_time, now);
+                }
+                time_point = today + end_time;
+                if (time_point < now) {
+                    time_point = time_point + TimeDelta(1);
                 }
             }
 
         } else {
-            s.m_time_point =
-              start_date >= today ? start_date + start_time + duration : now + duration;
+            time_point = start_date >= today ? start_date + start_time + duration : now + duration;
             if (timer->m_start_time != timer->m_end_time) {
-                Datetime point_date = s.m_time_point.startOfDay();
-                TimeDelta point = s.m_time_point - point_date;
+                Datetime point_date = time_point.startOfDay();
+                TimeDelta point = time_point - point_date;
                 if (point < timer->m_start_time) {
-                    s.m_time_point = point_date + timer->m_start_time;
+                    time_point = point_date + timer->m_start_time;
                 } else if (point > timer->m_end_time) {
-                    s.m_time_point = point_date + timer->m_start_time + TimeDelta(1);
+                    time_point = point_date + timer->m_start_time + TimeDelta(1);
                 } else {
                     TimeDelta gap = point - timer->m_start_time;
                     if (gap % timer->m_duration != TimeDelta()) {
                         int x = int(gap / timer->m_duration) + 1;
-                        s.m_time_point =
+                        time_point =
                           point_date + timer->m_start_time + timer->m_duration * double(x);
                     }
                 }
@@ -465,20 +513,24 @@ private:
         }
 
         m_timers[id] = timer;
-        s.m_timer_id = id;
-        HKU_TRACE("s.m_time_point: {}", s.m_time_point.repr());
-        m_queue.push(s);
+        timer->m_node.id = id;
+        HKU_TRACE("time_point: {}", time_point.repr());
+        if (!m_stop) {
+            _schedule(timer, time_point);
+        }
         lock.unlock();
         m_cond.notify_all();
         return id;
     }
 
 private:
-    std::priority_queue<IntervalS> m_queue;
+    TimingWheel m_wheel;  // 待执行的定时任务
     std::atomic_bool m_stop;
-    std::mutex m_mutex;
+    bool m_quit = false;  // 结束检测线程，用于 dll 能够安全退出，因为atomic在dll退出时可能无效
+    mutable std::mutex m_mutex;
     std::condition_variable m_cond;
     std::thread m_detect_thread;
+    LatencyHistogram m_jitter;  // 任务执行时刻偏差统计
 
     std::unordered_map<int, Timer*> m_timers;
     int m_current_timer_id;
@@ -0,0 +1,335 @@
+/*
+ *  Copyright(C) 2026 hikyuu.org
+ *
+ *  Create on: 2026-10-18
+ *     Author: fasiondog
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+
+namespace hku {
+
+/**
+ * 分层时间轮
+ * @details 以 1 毫秒为一格，第 0 层 256 格，其上 4 层各 64 格，可覆盖约 49.7 天，更远的定时项
+ *          暂存于最高层最远的格中，随逐层下移重新定位。插入、删除均为 O(1)；推进时批量取出
+ *          到期项并借助非空格位图跳过空格，高层的格在低层转满一圈时整体下移。
+ *          定时项为调用方持有的侵入式节点，时间单位为微秒，时间原点由调用方自行约定。
+ * @note 非线程安全，由调用方加锁保护
+ * @ingroup Utilities
+ */
+class TimingWheel {
+public:
+    /** 定时项节点，由调用方持有，加入时间轮期间不可释放 */
+    struct Node {
+        int64_t expire = 0;  // 到期时刻（微秒）
+        int id = -1;         // 调用方自定义标识
+
+    private:
+        friend class TimingWheel;
+        Node* prev = nullptr;
+        Node* next = nullptr;
+        int level = -1;  // 所在层，-1 表示不在时间轮中
+        int slot = 0;    // 所在格
+    };
+
+    /**
+     * 构造函数
+     * @param now 当前时刻（微秒）
+     */
+    explicit TimingWheel(int64_t now = 0) : m_current(now / TICK), m_cascaded(-1), m_size(0) {
+        for (int level = 0; level < LEVEL_COUNT; level++) {
+            for (int i = 0; i < SLOT_COUNT; i++) {
+                Node& head = m_slots[level][i];
+                head.prev = head.next = &head;
+            }
+        }
+        for (auto& bits : m_bitmap) {
+            bits = 0;
+        }
+        for (auto& bits : m_level_bitmap) {
+            bits = 0;
+        }
+    }
+
+    TimingWheel(const TimingWheel&) = delete;
+    TimingWheel& operator=(const TimingWheel&) = delete;
+
+    /** 定时项数量 */
+    size_t size() const {
+        return m_size;
+    }
+
+    /** 是否为空 */
+    bool empty() const {
+        return m_size == 0;
+    }
+
+    /** 节点是否在时间轮中 */
+    static bool linked(const Node* node) {
+        return node->level >= 0;
+    }
+
+    /** 移除全部定时项，并将当前时刻重置为指定时刻（微秒） */
+    void reset(int64_t now) {
+        for (int level = 0; level < LEVEL_COUNT; level++) {
+            for (int i = 0; i < SLOT_COUNT; i++) {
+                Node& head = m_slots[level][i];
+                while (head.next != &head) {
+                    _unlink(head.next);
+                }
+            }
+        }
+        m_current = now / TICK;
+        m_cascaded = -1;
+    }
+
+    /** 加入定时项，如节点已在时间轮中则先移除 */
+    void add(Node* node) {
+        if (linked(node)) {
+            remove(node);
+        }
+        _insert(node);
+        m_size++;
+    }
+
+    /** 移除定时项，节点不在时间轮中时忽略 */
+    void remove(Node* node) {
+        if (linked(node)) {
+            _unlink(node);
+        }
+    }
+
+    /**
+     * 推进至指定时刻，依次取出所有已到期（expire <= now）的定时项
+     * @param now 当前时刻（微秒）
+     * @param on_expire 到期回调 void(Node*)，调用时节点已移出时间轮，可在回调中重新加入
+     */
+    template <typename F>
+    void advance(int64_t now, F&& on_expire) {
+        int64_t now_tick = now / TICK;
+        while (m_current <= now_tick) {
+            if (m_cascaded != m_current) {
+                _cascade();
+                m_cascaded = m_current;
+            }
+
+            Node& head = m_slots[0][m_current & SLOT0_MASK];
+            if (m_current < now_tick) {
+                // 整格均已到期
+                while (head.next != &head) {
+                    Node* node = head.next;
+                    _unlink(node);
+                    on_expire(node);
+                }
+                // 跳过其间的空格，直接前往下一个非空格或下一次高层下移
+                int64_t next = now_tick;
+                int64_t tick = _nextOccupiedTick();
+                if (tick >= 0 && tick < next) {
+                    next = tick;
+                }
+                tick = _nextCascadeTick();
+                if (tick < next) {
+                    next = tick;
+                }
+                m_current = next;
+            } else {
+                // 当前格只取出已到期的项
+                Node* node = head.next;
+                while (node != &head) {
+                    Node* next = node->next;
+                    if (node->expire <= now) {
+                        _unlink(node);
+                        on_expire(node);
+                    }
+                    node = next;
+                }
+                break;
+            }
+        }
+    }
+
+    /**
+     * 下次需要推进的时刻（微秒），调用方可据此休眠
+     * @return 第 0 层最近一个非空格中的最早到期时刻与高层最近一次下移时刻中的较小者；
+     *         时间轮为空时返回 INT64_MAX
+     */
+    int64_t nextExpire() const {
+        if (m_size == 0) {
+            return INT64_MAX;
+        }
+        if (m_cascaded != m_current) {
+            // 尚未推进过，当前格可能需要先下移高层
+            return m_current * TICK;
+        }
+
+        int64_t result = INT64_MAX;
+        int64_t tick = _nextOccupiedTick();
+        if (tick >= 0) {
+            const Node& head = m_slots[0][tick & SLOT0_MASK];
+            for (const Node* node = head.next; node != &head; node = node->next) {
+                if (node->expire < result) {
+                    result = node->expire;
+                }
+            }
+        }
+
+        tick = _nextCascadeTick();
+        if (tick != INT64_MAX && tick * TICK < result) {
+            result = tick * TICK;
+        }
+        return result;
+    }
+
+private:
+    static constexpr int64_t TICK = 1000;  // 每格时长（微秒）
+    static constexpr int LEVEL_COUNT = 5;
+    static constexpr int SLOT0_BITS = 8;
+    static constexpr int SLOTN_BITS = 6;
+    static constexpr int SLOT_COUNT = 1 << SLOT0_BITS;
+    static constexpr int64_t SLOT0_MASK = (1 << SLOT0_BITS) - 1;
+    static constexpr int64_t SLOTN_MASK = (1 << SLOTN_BITS) - 1;
+    static constexpr int64_t MAX_SPAN = (int64_t(1) << (SLOT0_BITS + SLOTN_BITS * 4)) - 1;
+
+    void _insert(Node* node) {
+        int64_t tick = node->expire / TICK;
+        int64_t delta = tick - m_current;
+        int level = 0;
+        int slot = 0;
+        if (delta < 0) {
+            // 已过期，放入当前格，下次推进时立即取出
+            slot = int(m_current & SLOT0_MASK);
+        } else {
+            if (delta > MAX_SPAN) {
+                tick = m_current + MAX_SPAN;
+                delta = MAX_SPAN;
+            }
+            if (delta < (int64_t(1) << SLOT0_BITS)) {
+                slot = int(tick & SLOT0_MASK);
+            } else {
+                level = 1;
+                while (level < LEVEL_COUNT - 1 &&
+                       delta >= (int64_t(1) << (SLOT0_BITS + SLOTN_BITS * level))) {
+                    level++;
+                }
+                slot = int((tick >> (SLOT0_BITS + SLOTN_BITS * (level - 1))) & SLOTN_MASK);
+            }
+        }
+
+        Node& head = m_slots[level][slot];
+        node->level = level;
+        node->slot = slot;
+        node->prev = head.prev;
+        node->next = &head;
+        head.prev->next = node;
+        head.prev = node;
+        if (level == 0) {
+            m_bitmap[slot >> 6] |= uint64_t(1) << (slot & 63);
+        } else {
+            m_level_bitmap[level] |= uint64_t(1) << slot;
+        }
+    }
+
+    void _unlink(Node* node) {
+        node->prev->next = node->next;
+        node->next->prev = node->prev;
+        Node& head = m_slots[node->level][node->slot];
+        if (head.next == &head) {
+            if (node->level == 0) {
+                m_bitmap[node->slot >> 6] &= ~(uint64_t(1) << (node->slot & 63));
+            } else {
+                m_level_bitmap[node->level] &= ~(uint64_t(1) << node->slot);
+            }
+        }
+        node->prev = node->next = nullptr;
+        node->level = -1;
+        m_size--;
+    }
+
+    /* 当前格为低层一圈的起点时，将高层对应格中的定时项下移，需从高层至低层依次处理 */
+    void _cascade() {
+        if ((m_current & SLOT0_MASK) != 0) {
+            return;
+        }
+        int top = 1;
+        while (top < LEVEL_COUNT - 1 &&
+               ((m_current >> (SLOT0_BITS + SLOTN_BITS * (top - 1))) & SLOTN_MASK) == 0) {
+            top++;
+        }
+        for (int level = top; level >= 1; level--) {
+            int slot = int((m_current >> (SLOT0_BITS + SLOTN_BITS * (level - 1))) & SLOTN_MASK);
+            Node& head = m_slots[level][slot];
+            while (head.next != &head) {
+                Node* node = head.next;
+                _unlink(node);
+                _insert(node);
+                m_size++;
+            }
+        }
+    }
+
+    /* 第 0 层中自当前格起的第一个非空格对应的 tick，无则返回 -1 */
+    int64_t _nextOccupiedTick() const {
+        int start = int(m_current & SLOT0_MASK);
+        for (int i = 0; i <= 4; i++) {
+            int word = ((start >> 6) + i) & 3;
+            uint64_t bits = m_bitmap[word];
+            if (i == 0) {
+                bits &= ~uint64_t(0) << (start & 63);
+            } else if (i == 4) {
+                bits &= (start & 63) == 0 ? 0 : ~(~uint64_t(0) << (start & 63));
+            }
+            if (bits) {
+                int slot = word * 64 + _ctz(bits);
+                int offset = (slot - start + SLOT_COUNT) & int(SLOT0_MASK);
+                return m_current + offset;
+            }
+        }
+        return -1;
+    }
+
+    /* 高层中最近一次需要下移的 tick（总在当前 tick 之后），高层均为空时返回 INT64_MAX */
+    int64_t _nextCascadeTick() const {
+        int64_t result = INT64_MAX;
+        for (int level = 1; level < LEVEL_COUNT; level++) {
+            uint64_t bits = m_level_bitmap[level];
+            if (bits == 0) {
+                continue;
+            }
+            // 自下一个单位起循环查找第一个非空格
+            int shift = SLOT0_BITS + SLOTN_BITS * (level - 1);
+            int64_t next = (m_current >> shift) + 1;
+            int start = int(next & SLOTN_MASK);
+            if (start != 0) {
+                bits = (bits >> start) | (bits << (64 - start));
+            }
+            int64_t tick = (next + _ctz(bits)) << shift;
+            if (tick < result) {
+                result = tick;
+            }
+        }
+        return result;
+    }
+
+    static int _ctz(uint64_t x) {
+        int n = 0;
+        while ((x & 1) == 0) {
+            x >>= 1;
+            n++;
+        }
+        return n;
+    }
+
+private:
+    Node m_slots[LEVEL_COUNT][SLOT_COUNT];  // 各层格的链表头，第 1 层以上只用前 64 格
+    uint64_t m_bitmap[SLOT_COUNT / 64];     // 第 0 层非空格位图
+    uint64_t m_level_bitmap[LEVEL_COUNT];   // 第 1 层以上各层非空格位图
+    int64_t m_current;                      // 当前 tick，之前的格均已处理
+    int64_t m_cascaded;                     // 已完成高层下移的 tick
+    size_t m_size;
+};
+
+}  // namespace hku
@@ -10,6 +10,9 @@
 #ifndef HIKYUU_DB_CONNECT_DBCONNECTBASE_H
 #define HIKYUU_DB_CONNECT_DBCONNECTBASE_H
 
+#include <algorithm>
+#include <list>
+#include <unordered_map>
 #include "../../DataType.h"
 #include "../../utilities/Parameter.h"
 #include "DBCondition.h"
@@ -28,7 +31,13 @@ class HKU_API DBConnectBase {
 public:
     /**
      * 构造函数
-     * @param param 数据库连接参数
+     * @param param 数据库连接参数，除各子类的连接参数外，还支持如下参数（仅在构造时读取）：
+     * <pre>
+     * int statement_cache_size - 缓存的已预处理 SQLStatement 数量，按最近最少使用淘汰，
+     *                            为 0 时不缓存，默认 64
+     * int batch_insert_size - batchSave 时单条 INSERT 语句最多插入的记录数，仅在子类支持多行
+     *                         INSERT 时生效（@see sub_getMultiRowInsertIdStep），默认 200
+     * </pre>
      */
     explicit DBConnectBase(const Parameter& param);
     virtual ~DBConnectBase() = default;
@@ -51,12 +60,51 @@ public:
     /** 执行无返回结果的 SQL */
     virtual void exec(const string& sql_string) = 0;
 
-    /** 获取 SQLStatement */
-    virtual SQLStatementPtr getStatement(const string& sql_statement) = 0;
+    /**
+     * 创建新的 SQLStatement，不经过缓存，新实现的子类应重载该方法 @see getStatement
+     * @note 兼容早期版本，仍直接重载 getStatement 的子类可不重载该方法
+     */
+    virtual SQLStatementPtr sub_getStatement(const string& sql_statement) {
+        HKU_THROW("Subclass must override sub_getStatement or getStatement! sql: {}",
+                  sql_statement);
+    }
 
     /** 判断表是否存在 */
     virtual bool tableExist(const string& tablename) = 0;
 
+    /**
+     * 单条多行 INSERT 语句插入记录时，生成的自增 id 之间的步长
+     * @return 不支持多行 INSERT 或无法保证生成的 id 连续时返回 0，此时 batchSave 逐条插入
+     */
+    virtual uint64_t sub_getMultiRowInsertIdStep() {
+        return 0;
+    }
+
+    //-------------------------------------------------------------------------
+    // SQLStatement 缓存
+    //-------------------------------------------------------------------------
+    /**
+     * 获取 SQLStatement，带参数（含 "?" 占位符）的 SQL 语句优先复用缓存中已预处理的语句
+     * @details 语句在使用者释放后被重置（释放未读取完的结果集及数据库锁）并保留在缓存中，
+     *          仍在使用中的相同语句（如嵌套查询）不会被复用，此时另行创建。
+     *          复用的语句保留上次绑定的参数，使用者应重新绑定全部参数。
+     *          不带参数的语句（值直接写在 SQL 中）很少重复，不进入缓存，以免挤出可复用的语句。
+     * @note 返回的 SQLStatement 应在连接释放前释放。早期版本中该方法为纯虚函数，
+     *       仍重载该方法的子类将不使用缓存
+     */
+    virtual SQLStatementPtr getStatement(const string& sql_statement);
+
+    /** 清空 SQLStatement 缓存，使用中的语句不受影响 */
+    void clearStatementCache();
+
+    /** 从缓存中移除指定的语句（如执行失败、已失效的语句），使用中的语句在释放后销毁 */
+    void removeStatementCache(const SQLStatementBase* st);
+
+    /** 当前缓存的 SQLStatement 数量 */
+    size_t getStatementCacheCount() const {
+        return m_statement_list.size();
+    }
+
     //-------------------------------------------------------------------------
     // 模板方法
     //-------------------------------------------------------------------------
@@ -104,6 +152,8 @@ public:
 
     /**
      * 批量保存，迭代器中的数据必须是通过 TABLE_BIND 绑定的表模型
+     * @details 子类支持多行 INSERT 时（如 MySQL），按 batch_insert_size 分块以单条语句插入多条
+     *          记录；否则（如 SQLite）复用同一已预处理的语句逐条插入
      * @param first 迭代器起始点
      * @param last 迭代器终止点
      * @param autotrans 启动事务
@@ -229,6 +279,28 @@ public:
 
 private:
     DBConnectBase() = delete;
+
+    /** 多行 INSERT 批量保存，id_step 为生成的自增 id 之间的步长 */
+    template <class InputIterator>
+    void _batchSaveMultiRow(InputIterator first, InputIterator last, uint64_t id_step);
+
+    /**
+     * 将形如 "insert into t (a,b) values (?,?)" 的单行 INSERT 语句扩展为 rows 行
+     * @param sql 单行 INSERT 语句
+     * @param rows 行数
+     * @param out_sql [out] 多行 INSERT 语句
+     * @param out_param_num [out] 单行的参数个数
+     * @return 无法识别的语句返回 false
+     */
+    static bool _getMultiRowInsertSQL(const string& sql, size_t rows, string& out_sql,
+                                      int& out_param_num);
+
+private:
+    typedef std::list<std::pair<string, SQLStatementPtr>> StatementList;
+    StatementList m_statement_list;  // 最近使用的在前
+    std::unordered_map<string, StatementList::iterator> m_statement_map;
+    size_t m_statement_cache_size;
+    size_t m_batch_insert_size;
 };
 
 /** @ingroup DBConnect */
@@ -238,7 +310,74 @@ typedef shared_ptr<DBConnectBase> DBConnectPtr;
 // inline方法实现
 //-------------------------------------------------------------------------
 
-inline DBConnectBase::DBConnectBase(const Parameter& param) : m_params(param) {}
+inline DBConnectBase::DBConnectBase(const Parameter& param) : m_params(param) {
+    int cache_size = getParamFromOther<int>(param, "statement_cache_size", 64);
+    int batch_size = getParamFromOther<int>(param, "batch_insert_size", 200);
+    m_statement_cache_size = cache_size > 0 ? cache_size : 0;
+    m_batch_insert_size = batch_size > 0 ? batch_size : 1;
+}
+
+inline SQLStatementPtr DBConnectBase::getStatement(const string& sql_statement) {
+    HKU_IF_RETURN(m_statement_cache_size == 0 || sql_statement.find('?') == string::npos,
+                  sub_getStatement(sql_statement));
+
+    SQLStatementPtr st;
+    auto iter = m_statement_map.find(sql_statement);
+    if (iter != m_statement_map.end()) {
+        m_statement_list.splice(m_statement_list.begin(), m_statement_list, iter->second);
+        // 仅被缓存持有时可复用，否则说明仍在使用中
+        HKU_IF_RETURN(iter->second->second.use_count() > 1, sub_getStatement(sql_statement));
+        st = iter->second->second;
+    } else {
+        st = sub_getStatement(sql_statement);
+        m_statement_list.emplace_front(sql_statement, st);
+        m_statement_map[sql_statement] = m_statement_list.begin();
+        if (m_statement_list.size() > m_statement_cache_size) {
+            m_statement_map.erase(m_statement_list.back().first);
+            m_statement_list.pop_back();
+        }
+    }
+
+    // 使用者释放时重置语句，以便及时释放结果集及数据库锁
+    return SQLStatementPtr(st.get(), [st](SQLStatementBase* p) {
+        try {
+            p->reset();
+        } catch (...) {
+        }
+    });
+}
+
+inline void DBConnectBase::clearStatementCache() {
+    m_statement_map.clear();
+    m_statement_list.clear();
+}
+
+inline void DBConnectBase::removeStatementCache(const SQLStatementBase* st) {
+    HKU_IF_RETURN(!st, void());
+    auto iter = m_statement_map.find(st->getSqlString());
+    HKU_IF_RETURN(iter == m_statement_map.end() || iter->second->second.get() != st, void());
+    m_statement_list.erase(iter->second);
+    m_statement_map.erase(iter);
+}
+
+inline bool DBConnectBase::_getMultiRowInsertSQL(const string& sql, size_t rows,
+                                                 string& out_sql, int& out_param_num) {
+    // 定位 values 后的参数列表，如 "(?,?)"
+    size_t pos = sql.rfind(" values ");
+    HKU_IF_RETURN(pos == string::npos, false);
+    string values = sql.substr(pos + 8);
+    HKU_IF_RETURN(values.size() < 3 || values.front() != '(' || values.back() != ')', false);
+    out_param_num = int(std::count(values.begin(), values.end(), '?'));
+    HKU_IF_RETURN(out_param_num == 0, false);
+
+    out_sql.reserve(sql.size() + (values.size() + 1) * (rows - 1));
+    out_sql = sql;
+    for (size_t i = 1; i < rows; i++) {
+        out_sql.push_back(',');
+        out_sql.append(values);
+    }
+    return true;
+}
 
 inline int DBConnectBase::queryInt(const string& query) {
     SQLStatementPtr st = getStatement(query);
@@ -304,16 +443,22 @@ inline void DBConnectBase::batchSave(Container& container, bool autotrans) {
 
 template <class InputIterator>
 void DBConnectBase::batchSave(InputIterator first, InputIterator last, bool autotrans) {
-    SQLStatementPtr st = getStatement(InputIterator::value_type::getInsertSQL());
+    string sql(InputIterator::value_type::getInsertSQL());
+    uint64_t id_step = m_batch_insert_size > 1 ? sub_getMultiRowInsertIdStep() : 0;
     if (autotrans) {
         transaction();
     }
 
     try {
-        for (InputIterator iter = first; iter != last; ++iter) {
-            iter->save(st);
-            st->exec();
-            iter->id(st->getLastRowid());
+        if (id_step > 0) {
+            _batchSaveMultiRow(first, last, id_step);
+        } else {
+            SQLStatementPtr st = getStatement(sql);
+            for (InputIterator iter = first; iter != last; ++iter) {
+                iter->save(st);
+                st->exec();
+                iter->id(st->getLastRowid());
+            }
         }
 
         if (autotrans) {
@@ -324,19 +469,67 @@ void DBConnectBase::batchSave(InputIterator first, InputIterator last, bool auto
         if (autotrans) {
             rollback();
         }
-        SQL_THROW(e.errcode(), "failed batch save! sql: {}! {}", st->getSqlString(), e.what());
+        SQL_THROW(e.errcode(), "failed batch save! sql: {}! {}", sql, e.what());
 
     } catch (std::exception& e) {
         if (autotrans) {
             rollback();
         }
-        HKU_THROW("failed batch save! sql: {}! {}", st->getSqlString(), e.what());
+        HKU_THROW("failed batch save! sql: {}! {}", sql, e.what());
 
     } catch (...) {
         if (autotrans) {
             rollback();
         }
-        HKU_THROW("failed batch save! sql: {}! Unknown error!", st->getSqlString());
+        HKU_THROW("failed batch save! sql: {}! Unknown error!", sql);
+    }
+}
+
+template <class InputIterator>
+void DBConnectBase::_batchSaveMultiRow(InputIterator first, InputIterator last,
+                                       uint64_t id_step) {
+    string sql(InputIterator::value_type::getInsertSQL());
+    string multi_sql;
+    int param_num = 0;
+    if (!_getMultiRowInsertSQL(sql, 1, multi_sql, param_num)) {
+        SQLStatementPtr st = getStatement(sql);
+        for (InputIterator iter = first; iter != last; ++iter) {
+            iter->save(st);
+            st->exec();
+            iter->id(st->getLastRowid());
+        }
+        return;
+    }
+
+    // 单条语句的参数个数不能超过 65535（MySQL 限制）
+    size_t max_rows = std::min<size_t>(m_batch_insert_size, 65535 / param_num);
+    max_rows = std::max<size_t>(max_rows, 1);
+    InputIterator iter = first;
+    while (iter != last) {
+        InputIterator chunk_first = iter;
+        size_t rows = 0;
+        while (iter != last && rows < max_rows) {
+            ++iter;
+            ++rows;
+        }
+
+        _getMultiRowInsertSQL(sql, rows, multi_sql, param_num);
+        SQLStatementPtr st = getStatement(multi_sql);
+        int offset = 0;
+        for (InputIterator item = chunk_first; item != iter; ++item) {
+            st->setBindOffset(offset);
+            item->save(st);
+            offset += param_num;
+        }
+        st->setBindOffset(0);
+        st->exec();
+
+        // 多行 INSERT 返回的是第一条记录的 id
+        uint64_t id = st->getLastRowid();
+        for (InputIterator item = chunk_first; item != iter; ++item) {
+            item->id(id);
+            id += id_step;
+        }
     }
 }
 
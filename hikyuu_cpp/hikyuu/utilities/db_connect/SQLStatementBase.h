@@ -56,6 +56,15 @@ public:
     /** 移动至下一结果 */
     bool moveNext();
 
+    /** 重置语句，释放未读取完的结果集，已绑定的参数保持不变 */
+    void reset();
+
+    /**
+     * 设置绑定参数时的索引偏移，之后 bind(idx, ...) 实际绑定至 idx + offset 指定的参数
+     * @details 用于在多行 INSERT 中以相同的方式逐行绑定参数，使用完毕后应恢复为 0
+     */
+    void setBindOffset(int offset);
+
     /** 将 null 绑定至 idx 指定的 SQL 参数中 */
     void bind(int idx);  // bind_null
 
@@ -116,6 +125,7 @@ public:
     virtual void sub_exec() = 0;              ///< 子类接口 @see exec
     virtual bool sub_moveNext() = 0;          ///< 子类接口 @see moveNext
     virtual uint64_t sub_getLastRowid() = 0;  ///< 子类接口 @see getLastRowid();
+    virtual void sub_reset() {}               ///< 子类接口 @see reset，默认不做处理
 
     virtual void sub_bindNull(int idx) = 0;                      ///< 子类接口 @see bind
     virtual void sub_bindInt(int idx, int64_t value) = 0;        ///< 子类接口 @see bind
@@ -135,13 +145,14 @@ private:
 protected:
     DBConnectBase* m_driver;  ///< 数据库连接
     string m_sql_string;      ///< 原始 SQL 语句
+    int m_bind_offset;        ///< 绑定参数时的索引偏移
 };
 
 /** @ingroup DBConnect */
 typedef shared_ptr<SQLStatementBase> SQLStatementPtr;
 
 inline SQLStatementBase ::SQLStatementBase(DBConnectBase* driver, const string& sql_statement)
-: m_driver(driver), m_sql_string(sql_statement) {
+: m_driver(driver), m_sql_string(sql_statement), m_bind_offset(0) {
     HKU_CHECK(driver, "driver is null!");
 }
 
@@ -165,20 +176,28 @@ inline bool SQLStatementBase::moveNext() {
     return sub_moveNext();
 }
 
+inline void SQLStatementBase::reset() {
+    sub_reset();
+}
+
+inline void SQLStatementBase::setBindOffset(int offset) {
+    m_bind_offset = offset;
+}
+
 inline void SQLStatementBase::bind(int idx) {
-    sub_bindNull(idx);
+    sub_bindNull(m_bind_offset + idx);
 }
 
 inline void SQLStatementBase::bind(int idx, const string& item) {
-    sub_bindText(idx, item);
+    sub_bindText(m_bind_offset + idx, item);
 }
 
 inline void SQLStatementBase::bind(int idx, double item) {
-    sub_bindDouble(idx, item);
+    sub_bindDouble(m_bind_offset + idx, item);
 }
 
 inline void SQLStatementBase::bindBlob(int idx, const string& item) {
-    sub_bindBlob(idx, item);
+    sub_bindBlob(m_bind_offset + idx, item);
 }
 
 inline uint64_t SQLStatementBase::getLastRowid() {
@@ -206,7 +225,7 @@ inline void SQLStatementBase::getColumn(int idx, string& item) {
 template <typename T>
 typename std::enable_if<std::numeric_limits<T>::is_integer>::type SQLStatementBase::bind(
   int idx, const T& item) {
-    sub_bindInt(idx, item);
+    sub_bindInt(m_bind_offset + idx, item);
 }
 
 template <typename T>
@@ -215,7 +234,7 @@ typename std::enable_if<!std::numeric_limits<T>::is_integer>::type SQLStatementB
     std::ostringstream sout;
     boost::archive::binary_oarchive oa(sout);
     oa << BOOST_SERIALIZATION_NVP(item);
-    sub_bindBlob(idx, sout.str());
+    sub_bindBlob(m_bind_offset + idx, sout.str());
 }
 
 template <typename T>
@@ -11,7 +11,8 @@
 
 namespace hku {
 
-MySQLConnect::MySQLConnect(const Parameter& param) : DBConnectBase(param), m_mysql(nullptr) {
+MySQLConnect::MySQLConnect(const Parameter& param)
+: DBConnectBase(param), m_mysql(nullptr), m_thread_id(0), m_insert_id_step(-1) {
     try {
         m_mysql = new MYSQL;
         HKU_CHECK(mysql_init(m_mysql) != NULL, "Initial MySQL handle error!");
@@ -33,6 +34,7 @@ MySQLConnect::MySQLConnect(const Parameter& param) : DBConnectBase(param), m_mys
                   mysql_errno(m_mysql), "Failed to connect to database! {}", mysql_error(m_mysql));
         SQL_CHECK(mysql_set_character_set(m_mysql, "utf8") == 0, mysql_errno(m_mysql),
                   "mysql_set_character_set error! {}", mysql_error(m_mysql));
+        m_thread_id = mysql_thread_id(m_mysql);
 
     } catch (std::bad_alloc& e) {
         HKU_THROW("Failed allocate MySQLConnect! {}", e.what());
@@ -56,6 +58,8 @@ MySQLConnect::~MySQLConnect() {
 }
 
 void MySQLConnect::close() {
+    // 缓存的语句须在关闭连接前释放
+    clearStatementCache();
     if (m_mysql) {
         mysql_close(m_mysql);
         delete m_mysql;
@@ -68,9 +72,20 @@ bool MySQLConnect::ping() {
     auto ret = mysql_ping(m_mysql);
     HKU_ERROR_IF_RETURN(ret, false, "mysql_ping error code: {}, msg: {}", ret,
                         mysql_error(m_mysql));
+    _checkReconnect();
     return true;
 }
 
+void MySQLConnect::_checkReconnect() {
+    unsigned long thread_id = mysql_thread_id(m_mysql);
+    if (thread_id != m_thread_id) {
+        HKU_DEBUG("MySQL reconnected, clear statement cache.");
+        m_thread_id = thread_id;
+        m_insert_id_step = -1;
+        clearStatementCache();
+    }
+}
+
 void MySQLConnect::exec(const string& sql_string) {
     int ret = mysql_query(m_mysql, sql_string.c_str());
     if (ret) {
@@ -110,10 +125,31 @@ void MySQLConnect::exec(const string& sql_string) {
     } while (!mysql_next_result(m_mysql));
 }
 
-SQLStatementPtr MySQLConnect::getStatement(const string& sql_statement) {
+SQLStatementPtr MySQLConnect::sub_getStatement(const string& sql_statement) {
     return make_shared<MySQLStatement>(this, sql_statement);
 }
 
+uint64_t MySQLConnect::sub_getMultiRowInsertIdStep() {
+    HKU_IF_RETURN(m_insert_id_step >= 0, m_insert_id_step);
+    m_insert_id_step = 0;
+    try {
+        SQLStatementPtr st =
+          getStatement("select @@innodb_autoinc_lock_mode, @@auto_increment_increment");
+        st->exec();
+        if (st->moveNext()) {
+            int64_t lock_mode = 2, increment = 0;
+            st->getColumn(0, lock_mode, increment);
+            // 0 - traditional，1 - consecutive，2 - interleaved（并发插入时 id 可能不连续）
+            if (lock_mode <= 1 && increment > 0) {
+                m_insert_id_step = increment;
+            }
+        }
+    } catch (std::exception& e) {
+        HKU_WARN("Failed get innodb_autoinc_lock_mode, disable multi-row insert! {}", e.what());
+    }
+    return m_insert_id_step;
+}
+
 bool MySQLConnect::tableExist(const string& tablename) {
     bool result = false;
     try {
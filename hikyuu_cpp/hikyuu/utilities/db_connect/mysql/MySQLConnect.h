@@ -33,9 +33,15 @@ public:
     virtual bool ping() override;
 
     virtual void exec(const string& sql_string) override;
-    virtual SQLStatementPtr getStatement(const string& sql_statement) override;
+    virtual SQLStatementPtr sub_getStatement(const string& sql_statement) override;
     virtual bool tableExist(const string& tablename) override;
 
+    /**
+     * 仅在 innodb_autoinc_lock_mode 为 0 或 1 时，单条多行 INSERT 生成的自增 id 连续，
+     * 步长为 auto_increment_increment
+     */
+    virtual uint64_t sub_getMultiRowInsertIdStep() override;
+
     virtual void transaction() override;
     virtual void commit() override;
     virtual void rollback() override;
@@ -43,9 +49,14 @@ public:
 private:
     void close();
 
+    /** 检测是否已自动重连，重连后服务端的预处理语句全部失效，需清空缓存 */
+    void _checkReconnect();
+
 private:
     friend class MySQLStatement;
     MYSQL* m_mysql;
+    unsigned long m_thread_id;  // 当前连接在服务端的线程 id，重连后改变
+    int64_t m_insert_id_step;   // 多行 INSERT 时自增 id 的步长，小于 0 表示未获取
 };
 
 }  // namespace hku
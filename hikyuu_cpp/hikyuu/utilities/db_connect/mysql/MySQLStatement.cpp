@@ -10,6 +10,14 @@
 #include "MySQLStatement.h"
 #include "MySQLConnect.h"
 
+#if defined(_MSC_VER)
+#include <errmsg.h>
+#include <mysqld_error.h>
+#else
+#include <mysql/errmsg.h>
+#include <mysql/mysqld_error.h>
+#endif
+
 namespace hku {
 
 MySQLStatement::MySQLStatement(DBConnectBase* driver, const string& sql_statement)
@@ -18,7 +26,8 @@ MySQLStatement::MySQLStatement(DBConnectBase* driver, const string& sql_statemen
   m_stmt(nullptr),
   m_meta_result(nullptr),
   m_needs_reset(false),
-  m_has_bind_result(false) {
+  m_has_bind_result(false),
+  m_streaming(false) {
     m_stmt = mysql_stmt_init(m_db);
     HKU_CHECK(m_stmt != nullptr, "Failed mysql_stmt_init!");
     int ret = mysql_stmt_prepare(m_stmt, sql_statement.c_str(), sql_statement.size());
@@ -34,6 +43,8 @@ MySQLStatement::MySQLStatement(DBConnectBase* driver, const string& sql_statemen
     if (param_count > 0) {
         m_param_bind.resize(param_count);
         memset(m_param_bind.data(), 0, param_count * sizeof(MYSQL_BIND));
+        // 复用语句时覆盖原有的参数缓存，避免重复绑定时缓存不断增长
+        m_param_buffer.resize(param_count);
     }
 
     m_meta_result = mysql_stmt_result_metadata(m_stmt);
@@ -76,11 +87,28 @@ void MySQLStatement::sub_exec() {
         SQL_CHECK(ret == 0, ret, "Failed mysql_stmt_bind_param! {}", mysql_stmt_error(m_stmt));
     }
     ret = mysql_stmt_execute(m_stmt);
-    SQL_CHECK(ret == 0, ret, "Failed mysql_stmt_execute: {}", mysql_stmt_error(m_stmt));
+    if (ret != 0) {
+        // 连接断开或重连后，服务端的预处理语句已失效，不再缓存该语句
+        // 其余语句在重连检测（ping）或各自执行失败时清除
+        unsigned int errcode = mysql_stmt_errno(m_stmt);
+        if (errcode == CR_SERVER_GONE_ERROR || errcode == CR_SERVER_LOST ||
+            errcode == ER_UNKNOWN_STMT_HANDLER) {
+            m_driver->removeStatementCache(this);
+        }
+        SQL_THROW(ret, "Failed mysql_stmt_execute: {}", mysql_stmt_error(m_stmt));
+    }
+}
+
+void MySQLStatement::sub_reset() {
+    _reset();
 }
 
 void MySQLStatement::_bindResult() {
     HKU_IF_RETURN(!m_meta_result, void());
+    // 复用语句时结果缓存已在重置时释放，需从第一列重新绑定
+    m_result_buffer.clear();
+    m_result_buffer.reserve(m_result_bind.size());
+    mysql_field_seek(m_meta_result, 0);
     MYSQL_FIELD* field;
     int idx = 0;
     while ((field = mysql_fetch_field(m_meta_result))) {
@@ -150,8 +178,11 @@ bool MySQLStatement::sub_moveNext() {
         ret = mysql_stmt_bind_result(m_stmt, m_result_bind.data());
         SQL_CHECK(ret == 0, ret, "Failed mysql_stmt_bind_result! {}", mysql_stmt_error(m_stmt));
 
-        ret = mysql_stmt_store_result(m_stmt);
-        SQL_CHECK(ret == 0, ret, "Failed mysql_stmt_store_result! {}", mysql_stmt_error(m_stmt));
+        if (!m_streaming) {
+            ret = mysql_stmt_store_result(m_stmt);
+            SQL_CHECK(ret == 0, ret, "Failed mysql_stmt_store_result! {}",
+                      mysql_stmt_error(m_stmt));
+        }
     }
 
     ret = mysql_stmt_fetch(m_stmt);
@@ -172,8 +203,8 @@ void MySQLStatement::sub_bindNull(int idx) {
 void MySQLStatement::sub_bindInt(int idx, int64_t value) {
     HKU_CHECK(idx < m_param_bind.size(), "idx out of range! idx: {}, total: {}", idx,
               m_param_bind.size());
-    m_param_buffer.push_back(value);
-    auto& buf = m_param_buffer.back();
+    m_param_buffer[idx] = value;
+    auto& buf = m_param_buffer[idx];
     m_param_bind[idx].buffer_type = MYSQL_TYPE_LONGLONG;
     m_param_bind[idx].buffer = boost::any_cast<int64_t>(&buf);
 }
@@ -181,8 +212,8 @@ void MySQLStatement::sub_bindInt(int idx, int64_t value) {
 void MySQLStatement::sub_bindDouble(int idx, double item) {
     HKU_CHECK(idx < m_param_bind.size(), "idx out of range! idx: {}, total: {}", idx,
               m_param_bind.size());
-    m_param_buffer.push_back(item);
-    auto& buf = m_param_buffer.back();
+    m_param_buffer[idx] = item;
+    auto& buf = m_param_buffer[idx];
     m_param_bind[idx].buffer_type = MYSQL_TYPE_DOUBLE;
     m_param_bind[idx].buffer = boost::any_cast<double>(&buf);
 }
@@ -190,8 +221,8 @@ void MySQLStatement::sub_bindDouble(int idx, double item) {
 void MySQLStatement::sub_bindText(int idx, const string& item) {
     HKU_CHECK(idx < m_param_bind.size(), "idx out of range! idx: {}, total: {}", idx,
               m_param_bind.size());
-    m_param_buffer.push_back(item);
-    auto& buf = m_param_buffer.back();
+    m_param_buffer[idx] = item;
+    auto& buf = m_param_buffer[idx];
     string* p = boost::any_cast<string>(&buf);
     m_param_bind[idx].buffer_type = MYSQL_TYPE_VAR_STRING;
     m_param_bind[idx].buffer = (void*)p->data();
@@ -202,8 +233,8 @@ void MySQLStatement::sub_bindText(int idx, const string& item) {
 void MySQLStatement::sub_bindBlob(int idx, const string& item) {
     HKU_CHECK(idx < m_param_bind.size(), "idx out of range! idx: {}, total: {}", idx,
               m_param_bind.size());
-    m_param_buffer.push_back(item);
-    auto& buf = m_param_buffer.back();
+    m_param_buffer[idx] = item;
+    auto& buf = m_param_buffer[idx];
     string* p = boost::any_cast<string>(&buf);
     m_param_bind[idx].buffer_type = MYSQL_TYPE_BLOB;
     m_param_bind[idx].buffer = (void*)p->data();
@@ -35,6 +35,7 @@ public:
     virtual void sub_exec() override;
     virtual bool sub_moveNext() override;
     virtual uint64_t sub_getLastRowid() override;
+    virtual void sub_reset() override;
 
     virtual void sub_bindNull(int idx) override;
     virtual void sub_bindInt(int idx, int64_t value) override;
@@ -48,6 +49,20 @@ public:
     virtual void sub_getColumnAsText(int idx, string& item) override;
     virtual void sub_getColumnAsBlob(int idx, string& item) override;
 
+    /**
+     * 设置是否流式读取结果集，需在 exec 之前设置，默认为 false
+     * @details 流式读取时不在客户端缓存完整结果集，每次 moveNext 从服务端按行读取，适合大结果集。
+     *          结果集读取完毕（或语句被重新执行、释放）之前，同一连接不能执行其他语句。
+     */
+    void setStreaming(bool streaming) {
+        m_streaming = streaming;
+    }
+
+    /** 是否流式读取结果集 */
+    bool isStreaming() const {
+        return m_streaming;
+    }
+
 private:
     void _reset();
     void _bindResult();
@@ -58,9 +73,10 @@ private:
     MYSQL_RES* m_meta_result;
     bool m_needs_reset;
     bool m_has_bind_result;
+    bool m_streaming;
     vector<MYSQL_BIND> m_param_bind;
     vector<MYSQL_BIND> m_result_bind;
-    vector<boost::any> m_param_buffer;
+    vector<boost::any> m_param_buffer;  // 与 m_param_bind 一一对应
     vector<boost::any> m_result_buffer;
     vector<unsigned long> m_result_length;
     vector<char> m_result_is_null;
@@ -60,6 +60,8 @@ SQLiteConnect::~SQLiteConnect() {
 }
 
 void SQLiteConnect::close() {
+    // 缓存的语句须在关闭连接前释放，否则 sqlite3_close 失败
+    clearStatementCache();
     if (m_db) {
         sqlite3_close(m_db);
         m_db = nullptr;
@@ -75,7 +77,7 @@ void SQLiteConnect::exec(const string& sql_string) {
     SQL_CHECK(rc == SQLITE_OK, rc, "SQL error: {}! ({})", sqlite3_errmsg(m_db), sql_string);
 }
 
-SQLStatementPtr SQLiteConnect::getStatement(const string& sql_statement) {
+SQLStatementPtr SQLiteConnect::sub_getStatement(const string& sql_statement) {
     return make_shared<SQLiteStatement>(this, sql_statement);
 }
 
@@ -43,7 +43,7 @@ public:
 
     virtual bool ping() override;
     virtual void exec(const string& sql_string) override;
-    virtual SQLStatementPtr getStatement(const string& sql_statement) override;
+    virtual SQLStatementPtr sub_getStatement(const string& sql_statement) override;
     virtual bool tableExist(const string& tablename) override;
 
     virtual void transaction() override;
@@ -47,6 +47,10 @@ void SQLiteStatement::_reset() {
     }
 }
 
+void SQLiteStatement::sub_reset() {
+    _reset();
+}
+
 void SQLiteStatement::sub_exec() {
     _reset();
     m_step_status = sqlite3_step(m_stmt);
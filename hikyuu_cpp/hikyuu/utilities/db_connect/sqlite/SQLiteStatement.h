@@ -36,6 +36,7 @@ public:
     virtual void sub_exec() override;
     virtual bool sub_moveNext() override;
     virtual uint64_t sub_getLastRowid() override;
+    virtual void sub_reset() override;
 
     virtual void sub_bindNull(int idx) override;
     virtual void sub_bindInt(int idx, int64_t value) override;
@@ -0,0 +1,161 @@
+/*
+ * MPMCQueue.h
+ *
+ *  Copyright (c) 2026 hikyuu.org
+ *
+ *  Created on: 2026-10-18
+ *      Author: fasiondog
+ */
+
+#pragma once
+#ifndef HIKYUU_UTILITIES_THREAD_MPMCQUEUE_H
+#define HIKYUU_UTILITIES_THREAD_MPMCQUEUE_H
+
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+
+namespace hku {
+
+/**
+ * 多生产者多消费者队列
+ * @details 主体为定长无锁环形队列（每个槽位以序列号标识可写/可读状态），入队、出队均只需
+ *          一次 CAS。环形队列已满时，新数据转入加锁的溢出队列；溢出队列非空期间，新数据
+ *          也只进入溢出队列，出队时先取完环形队列再取溢出队列，因此同一生产者入队的数据
+ *          保持先进先出。
+ */
+template <typename T>
+class MPMCQueue {
+public:
+    /**
+     * 构造函数
+     * @param capacity 无锁部分的容量，将向上取整为 2 的幂次
+     */
+    explicit MPMCQueue(size_t capacity = 4096) {
+        size_t n = 2;
+        while (n < capacity) {
+            n <<= 1;
+        }
+        m_mask = n - 1;
+        m_cells.reset(new Cell[n]);
+        for (size_t i = 0; i < n; i++) {
+            m_cells[i].seq.store(i, std::memory_order_relaxed);
+        }
+        m_enqueue_pos.store(0, std::memory_order_relaxed);
+        m_dequeue_pos.store(0, std::memory_order_relaxed);
+        m_overflow_size.store(0, std::memory_order_relaxed);
+    }
+
+    // 禁用赋值构造和赋值重载
+    MPMCQueue(const MPMCQueue&) = delete;
+    MPMCQueue& operator=(const MPMCQueue&) = delete;
+
+    /** 入队 */
+    void push(T item) {
+        // 溢出队列非空时不可再写入环形队列，否则后入队的数据将先于溢出队列中的数据出队
+        if (m_overflow_size.load(std::memory_order_acquire) != 0 || !try_push_ring(item)) {
+            std::lock_guard<std::mutex> lock(m_overflow_mutex);
+            m_overflow.push_back(std::move(item));
+            m_overflow_size.fetch_add(1, std::memory_order_release);
+        }
+    }
+
+    /**
+     * 尝试出队
+     * @param value 存储出队的数据
+     * @return 队列为空时返回 false
+     */
+    bool try_pop(T& value) {
+        if (try_pop_ring(value)) {
+            return true;
+        }
+        if (m_overflow_size.load(std::memory_order_acquire) == 0) {
+            return false;
+        }
+        std::lock_guard<std::mutex> lock(m_overflow_mutex);
+        if (m_overflow.empty()) {
+            return false;
+        }
+        value = std::move(m_overflow.front());
+        m_overflow.pop_front();
+        m_overflow_size.fetch_sub(1, std::memory_order_relaxed);
+        return true;
+    }
+
+    /** 队列大小，并发时为近似值 */
+    size_t size() const {
+        size_t enq = m_enqueue_pos.load(std::memory_order_relaxed);
+        size_t deq = m_dequeue_pos.load(std::memory_order_relaxed);
+        return (enq > deq ? enq - deq : 0) + m_overflow_size.load(std::memory_order_relaxed);
+    }
+
+    /** 队列是否为空，并发时为近似值 */
+    bool empty() const {
+        return size() == 0;
+    }
+
+private:
+    bool try_push_ring(T& item) {
+        size_t pos = m_enqueue_pos.load(std::memory_order_relaxed);
+        for (;;) {
+            Cell& cell = m_cells[pos & m_mask];
+            size_t seq = cell.seq.load(std::memory_order_acquire);
+            intptr_t diff = intptr_t(seq) - intptr_t(pos);
+            if (diff == 0) {
+                if (m_enqueue_pos.compare_exchange_weak(pos, pos + 1,
+                                                        std::memory_order_relaxed)) {
+                    cell.data = std::move(item);
+                    cell.seq.store(pos + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (diff < 0) {
+                // 已满
+                return false;
+            } else {
+                pos = m_enqueue_pos.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    bool try_pop_ring(T& value) {
+        size_t pos = m_dequeue_pos.load(std::memory_order_relaxed);
+        for (;;) {
+            Cell& cell = m_cells[pos & m_mask];
+            size_t seq = cell.seq.load(std::memory_order_acquire);
+            intptr_t diff = intptr_t(seq) - intptr_t(pos + 1);
+            if (diff == 0) {
+                if (m_dequeue_pos.compare_exchange_weak(pos, pos + 1,
+                                                        std::memory_order_relaxed)) {
+                    value = std::move(cell.data);
+                    cell.seq.store(pos + m_mask + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (diff < 0) {
+                // 为空
+                return false;
+            } else {
+                pos = m_dequeue_pos.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+private:
+    struct Cell {
+        std::atomic<size_t> seq;
+        T data;
+    };
+
+    std::unique_ptr<Cell[]> m_cells;
+    size_t m_mask;
+    alignas(64) std::atomic<size_t> m_enqueue_pos;
+    alignas(64) std::atomic<size_t> m_dequeue_pos;
+    alignas(64) std::atomic<size_t> m_overflow_size;
+    std::mutex m_overflow_mutex;
+    std::deque<T> m_overflow;
+};
+
+} /* namespace hku */
+
+#endif /* HIKYUU_UTILITIES_THREAD_MPMCQUEUE_H */
@@ -16,15 +16,22 @@
 #include <thread>
 #include <chrono>
 #include <vector>
-#include "ThreadSafeQueue.h"
+#include <condition_variable>
+#include "MPMCQueue.h"
 #include "WorkStealQueue.h"
 
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#endif
+
 namespace hku {
 
 /**
  * @brief 分布偷取式线程池
  * @note 主要用于存在递归情况，任务又创建任务加入线程池的情况，否则建议使用普通的线程池
- * @details
+ * @details 每个工作线程拥有一个无锁的任务偷取队列，工作线程内提交的任务进入本地队列；
+ *          外部线程提交的任务进入无锁的多生产者多消费者主队列。工作线程无任务可执行时，
+ *          先自旋等待一段时间，仍无任务时才阻塞，自旋次数根据最近自旋是否等到任务自适应调整。
  * @ingroup ThreadPool
  */
 class StealThreadPool {
@@ -37,15 +44,17 @@ public:
     /**
      * 构造函数，创建指定数量的线程
      * @param n 指定的线程数
+     * @param util_empty 已废弃，仅为兼容保留，join 总是等待全部已提交的任务执行完毕
      */
     explicit StealThreadPool(size_t n, bool util_empty = true)
-    : m_done(false), m_runnging_util_empty(util_empty), m_worker_num(n) {
+    : m_done(false), m_draining(false), m_worker_num(n) {
         try {
             // 先初始化相关资源，再启动线程
             for (int i = 0; i < m_worker_num; i++) {
                 // 创建工作线程及其任务队列
                 m_threads_status.push_back(nullptr);
                 m_queues.push_back(std::unique_ptr<WorkStealQueue>(new WorkStealQueue));
+                m_stats.push_back(std::unique_ptr<WorkerStat>(new WorkerStat));
             }
             for (int i = 0; i < m_worker_num; i++) {
                 m_threads.push_back(std::thread(&StealThreadPool::worker_thread, this, i));
@@ -70,6 +79,33 @@ public:
         return m_worker_num;
     }
 
+    /** 已执行的任务数 */
+    uint64_t executed_count() const {
+        uint64_t total = 0;
+        for (const auto& stat : m_stats) {
+            total += stat->executed.load(std::memory_order_relaxed);
+        }
+        return total;
+    }
+
+    /** 从其他工作线程队列中偷取的任务数 */
+    uint64_t steal_count() const {
+        uint64_t total = 0;
+        for (const auto& stat : m_stats) {
+            total += stat->stolen.load(std::memory_order_relaxed);
+        }
+        return total;
+    }
+
+    /** 工作线程因无任务而阻塞的次数 */
+    uint64_t park_count() const {
+        uint64_t total = 0;
+        for (const auto& stat : m_stats) {
+            total += stat->parked.load(std::memory_order_relaxed);
+        }
+        return total;
+    }
+
     /** 先线程池提交任务后返回的对应 future 的类型 */
     template <typename ResultType>
     using task_handle = std::future<ResultType>;
@@ -82,20 +118,20 @@ public:
     /** 向线程池提交任务 */
     template <typename FunctionType>
     task_handle<typename std::result_of<FunctionType()>::type> submit(FunctionType f) {
-        if (m_thread_need_stop || m_done) {
+        if (m_thread_need_stop || m_done || (m_draining && m_local_pool != this)) {
             throw std::logic_error("Can't submit a task to the stopped StealThreadPool!");
         }
 
         typedef typename std::result_of<FunctionType()>::type result_type;
         std::packaged_task<result_type()> task(f);
         task_handle<result_type> res(task.get_future());
-        if (m_local_work_queue) {
+        if (m_local_work_queue && m_local_pool == this) {
             // 本地线程任务从前部入队列（递归成栈）
             m_local_work_queue->push_front(std::move(task));
         } else {
             m_master_work_queue.push(std::move(task));
         }
-        m_cv.notify_one();
+        notify_one();
         return res;
     }
 
@@ -118,15 +154,14 @@ public:
 
         m_done = true;
 
-        // 同时加入结束任务指示，以便在dll退出时也能够终止
+        // 工作线程在每次取任务前检查结束标志，无需向队列加入结束任务
         for (size_t i = 0; i < m_worker_num; i++) {
             if (m_threads_status[i]) {
                 m_threads_status[i]->store(true);
             }
-            m_queues[i]->push_front(FuncWrapper());
         }
 
-        m_cv.notify_all();  // 唤醒所有工作线程
+        notify_all();  // 唤醒所有工作线程
 
         for (size_t i = 0; i < m_worker_num; i++) {
             if (m_threads[i].joinable()) {
@@ -139,6 +174,8 @@ public:
 
     /**
      * 等待并阻塞至线程池内所有任务完成
+     * @details 不再接受外部提交的任务，工作线程在本地队列、主队列均取不到、也偷取不到任务时
+     *          退出，执行中的任务仍可向本线程池递归提交任务
      * @note 至此线程池能工作线程结束不可再使用
      */
     void join() {
@@ -146,28 +183,9 @@ public:
             return;
         }
 
-        // 指示各工作线程在未获取到工作任务时，停止运行
-        if (m_runnging_util_empty) {
-            while (m_master_work_queue.size() != 0) {
-                std::this_thread::yield();
-            }
-            for (size_t i = 0; i < m_worker_num; i++) {
-                while (m_queues[i]->size() != 0) {
-                    std::this_thread::yield();
-                }
-                if (m_threads_status[i]) {
-                    m_threads_status[i]->store(true);
-                }
-            }
-            m_done = true;
-        }
-
-        for (size_t i = 0; i < m_worker_num; i++) {
-            m_master_work_queue.push(std::move(FuncWrapper()));
-        }
-
-        // 唤醒所有工作线程
-        m_cv.notify_all();
+        // 以排空标志代替向队列加入结束任务，避免结束任务先于已提交的任务被取出
+        m_draining.store(true, std::memory_order_seq_cst);
+        notify_all();
 
         // 等待线程结束
         for (size_t i = 0; i < m_worker_num; i++) {
@@ -176,32 +194,80 @@ public:
             }
         }
 
+        // 执行与 join 并发提交而未被工作线程取到的剩余任务，避免其 future 无法就绪
+        task_type task;
+        while (m_master_work_queue.try_pop(task)) {
+            task();
+        }
+
         m_done = true;
     }
 
 private:
     typedef FuncWrapper task_type;
+
+    /** 工作线程统计，各自独占缓存行，仅由对应的工作线程写入 */
+    struct alignas(64) WorkerStat {
+        std::atomic<uint64_t> executed{0};  // 已执行任务数
+        std::atomic<uint64_t> stolen{0};    // 偷取任务数
+        std::atomic<uint64_t> parked{0};    // 阻塞次数
+    };
+
+    static constexpr int MIN_SPIN = 16;    // 最小自旋次数
+    static constexpr int MAX_SPIN = 1024;  // 最大自旋次数
+
     std::atomic_bool m_done;       // 线程池全局需终止指示
-    bool m_runnging_util_empty;    // 运行直到队列空时停止
+    std::atomic_bool m_draining;   // 排空指示，工作线程取不到任务时退出
     size_t m_worker_num;           // 工作线程数量
     std::condition_variable m_cv;  // 信号量，无任务时阻塞线程并等待
     std::mutex m_cv_mutex;         // 配合信号量的互斥量
+    std::atomic<uint64_t> m_epoch{0};  // 任务提交计数，用于判断阻塞前是否有新任务提交
+    std::atomic<int> m_sleeping{0};    // 阻塞中的工作线程数，为 0 时提交任务无需唤醒
 
     std::vector<std::atomic_bool*> m_threads_status;         // 工作线程状态
-    ThreadSafeQueue<task_type> m_master_work_queue;          // 主线程任务队列
+    MPMCQueue<task_type> m_master_work_queue;                // 主线程任务队列
     std::vector<std::unique_ptr<WorkStealQueue> > m_queues;  // 任务队列（每个工作线程一个）
+    std::vector<std::unique_ptr<WorkerStat> > m_stats;       // 工作线程统计
     std::vector<std::thread> m_threads;                      // 工作线程
 
     // 线程本地变量
     inline static thread_local WorkStealQueue* m_local_work_queue = nullptr;  // 本地任务队列
+    inline static thread_local StealThreadPool* m_local_pool = nullptr;  // 所属线程池
     inline static thread_local int m_index = -1;  //在线程池中的序号
+    inline static thread_local int m_spin_limit = MIN_SPIN;  // 当前自旋次数上限
     inline static thread_local std::atomic_bool m_thread_need_stop = false;  // 线程停止运行指示
 
+    void notify_one() {
+        m_epoch.fetch_add(1, std::memory_order_seq_cst);
+        if (m_sleeping.load(std::memory_order_seq_cst) > 0) {
+            // 加锁以避免在工作线程检查条件后、进入等待前发出通知而丢失
+            { std::lock_guard<std::mutex> lk(m_cv_mutex); }
+            m_cv.notify_one();
+        }
+    }
+
+    void notify_all() {
+        m_epoch.fetch_add(1, std::memory_order_seq_cst);
+        { std::lock_guard<std::mutex> lk(m_cv_mutex); }
+        m_cv.notify_all();
+    }
+
+    static void cpu_relax() {
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+        _mm_pause();
+#elif defined(__i386__) || defined(__x86_64__)
+        __builtin_ia32_pause();
+#elif defined(__aarch64__)
+        asm volatile("yield" ::: "memory");
+#endif
+    }
+
     void worker_thread(int index) {
         m_index = index;
         m_thread_need_stop = false;
         m_threads_status[index] = &m_thread_need_stop;
         m_local_work_queue = m_queues[m_index].get();
+        m_local_pool = this;
         while (!m_thread_need_stop && !m_done) {
             run_pending_task();
         }
@@ -209,27 +275,65 @@ private:
     }
 
     void run_pending_task() {
-        // 从本地队列提前工作任务，如本地无任务则从主队列中提取任务
-        // 如果主队列中提取的任务是空任务，则认为需结束本线程，否则从其他工作队列中偷取任务
+        // 从本地队列提前工作任务，如本地无任务则从主队列中提取任务，否则从其他工作队列中偷取任务
+        // 排空标志须在取任务前读取，保证 join 前提交的任务对本次取任务可见
+        bool draining = m_draining.load(std::memory_order_seq_cst);
+        uint64_t epoch = m_epoch.load(std::memory_order_seq_cst);
+        if (try_run_task()) {
+            return;
+        }
+        if (draining) {
+            m_thread_need_stop = true;
+            return;
+        }
+
+        // 自旋等待新任务，根据本次自旋是否等到任务调整下次的自旋次数
+        for (int i = 0; i < m_spin_limit; i++) {
+            if ((i & 0x0f) == 0x0f) {
+                std::this_thread::yield();
+            } else {
+                cpu_relax();
+            }
+            if (m_epoch.load(std::memory_order_relaxed) != epoch) {
+                epoch = m_epoch.load(std::memory_order_seq_cst);
+                if (try_run_task()) {
+                    m_spin_limit = m_spin_limit * 2 < MAX_SPIN ? m_spin_limit * 2 : MAX_SPIN;
+                    return;
+                }
+            }
+            if (m_thread_need_stop || m_done || m_draining) {
+                return;
+            }
+        }
+        m_spin_limit = m_spin_limit / 2 > MIN_SPIN ? m_spin_limit / 2 : MIN_SPIN;
+
+        std::unique_lock<std::mutex> lk(m_cv_mutex);
+        m_sleeping.fetch_add(1, std::memory_order_seq_cst);
+        if (!m_done && !m_draining && m_epoch.load(std::memory_order_seq_cst) == epoch) {
+            m_stats[m_index]->parked.fetch_add(1, std::memory_order_relaxed);
+            m_cv.wait(lk, [=] {
+                return this->m_done || this->m_draining ||
+                       this->m_epoch.load(std::memory_order_seq_cst) != epoch;
+            });
+        }
+        m_sleeping.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    bool try_run_task() {
         task_type task;
+        WorkerStat& stat = *m_stats[m_index];
         if (pop_task_from_local_queue(task)) {
             task();
-            // std::this_thread::yield();
         } else if (pop_task_from_master_queue(task)) {
-            if (!task.isNullTask()) {
-                task();
-                // std::this_thread::yield();
-            } else {
-                m_thread_need_stop = true;
-            }
+            task();
         } else if (pop_task_from_other_thread_queue(task)) {
+            stat.stolen.fetch_add(1, std::memory_order_relaxed);
             task();
-            // std::this_thread::yield();
         } else {
-            // std::this_thread::yield();
-            std::unique_lock<std::mutex> lk(m_cv_mutex);
-            m_cv.wait(lk, [=] { return this->m_done || !this->m_master_work_queue.empty(); });
+            return false;
         }
+        stat.executed.fetch_add(1, std::memory_order_relaxed);
+        return true;
     }
 
     bool pop_task_from_master_queue(task_type& task) {
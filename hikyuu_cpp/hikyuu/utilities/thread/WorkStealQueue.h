@@ -11,83 +11,167 @@
 #ifndef HIKYUU_UTILITIES_THREAD_WORKSTEALQUEUE_H
 #define HIKYUU_UTILITIES_THREAD_WORKSTEALQUEUE_H
 
-#include <deque>
-#include <mutex>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
 #include "FuncWrapper.h"
 
 namespace hku {
 
 /**
- * 任务偷取队列
+ * 任务偷取队列（Chase-Lev 无锁双端队列）
+ * @details 队列归属于一个工作线程：仅该线程可调用 push_front、try_pop，从头部后进先出；
+ *          其他线程可随时调用 try_steal 从尾部偷取最早加入的任务。各操作均不加锁，
+ *          空间不足时由所属线程自动扩容，旧的缓冲区在队列析构时统一释放。
  */
 class WorkStealQueue {
 private:
     typedef FuncWrapper data_type;
-    std::deque<data_type> m_queue;
-    mutable std::mutex m_mutex;
+
+    /** 环形缓冲区，容量为 2 的幂次 */
+    struct Array {
+        int64_t capacity;
+        int64_t mask;
+        std::unique_ptr<std::atomic<data_type*>[]> buf;
+
+        explicit Array(int64_t n)
+        : capacity(n), mask(n - 1), buf(new std::atomic<data_type*>[n]) {}
+
+        data_type* get(int64_t i) const {
+            return buf[i & mask].load(std::memory_order_relaxed);
+        }
+
+        void put(int64_t i, data_type* x) {
+            buf[i & mask].store(x, std::memory_order_relaxed);
+        }
+    };
+
+    alignas(64) std::atomic<int64_t> m_top;     // 偷取端
+    alignas(64) std::atomic<int64_t> m_bottom;  // 所属线程端
+    std::atomic<Array*> m_array;
+    std::vector<std::unique_ptr<Array>> m_arrays;  // 当前及扩容前的缓冲区，仅所属线程修改
 
 public:
-    /** 构造函数 */
-    WorkStealQueue() {}
+    /**
+     * 构造函数
+     * @param capacity 初始容量，将向上取整为 2 的幂次
+     */
+    explicit WorkStealQueue(size_t capacity = 256) : m_top(0), m_bottom(0) {
+        int64_t n = 2;
+        while (n < int64_t(capacity)) {
+            n <<= 1;
+        }
+        m_arrays.emplace_back(new Array(n));
+        m_array.store(m_arrays.back().get(), std::memory_order_relaxed);
+    }
+
+    ~WorkStealQueue() {
+        Array* a = m_array.load(std::memory_order_relaxed);
+        int64_t b = m_bottom.load(std::memory_order_relaxed);
+        for (int64_t i = m_top.load(std::memory_order_relaxed); i < b; i++) {
+            delete a->get(i);
+        }
+    }
 
     // 禁用赋值构造和赋值重载
     WorkStealQueue(const WorkStealQueue& other) = delete;
     WorkStealQueue& operator=(const WorkStealQueue& other) = delete;
 
-    /** 将数据插入队列头部 */
+    /** 将数据插入队列头部，仅限所属线程调用 */
     void push_front(data_type data) {
-        std::lock_guard<std::mutex> lock(m_mutex);
-        m_queue.push_front(std::move(data));
-    }
-
-    /** 将数据插入队列尾部 */
-    void push_back(data_type data) {
-        std::lock_guard<std::mutex> lock(m_mutex);
-        m_queue.push_back(std::move(data));
+        data_type* x = new data_type(std::move(data));
+        int64_t b = m_bottom.load(std::memory_order_relaxed);
+        int64_t t = m_top.load(std::memory_order_acquire);
+        Array* a = m_array.load(std::memory_order_relaxed);
+        if (b - t > a->capacity - 1) {
+            a = grow(a, b, t);
+        }
+        a->put(b, x);
+        m_bottom.store(b + 1, std::memory_order_release);
     }
 
-    /** 队列是否为空 */
+    /** 队列是否为空，其他线程调用时为近似值 */
     bool empty() const {
-        std::lock_guard<std::mutex> lock(m_mutex);
-        return m_queue.empty();
+        return size() == 0;
     }
 
-    /** 队列大小，未加锁 */
+    /** 队列大小，其他线程调用时为近似值 */
     size_t size() const {
-        return m_queue.size();
+        int64_t b = m_bottom.load(std::memory_order_relaxed);
+        int64_t t = m_top.load(std::memory_order_relaxed);
+        return b > t ? size_t(b - t) : 0;
     }
 
     /**
-     * 尝试从队列头部弹出一条数数据
+     * 尝试从队列头部弹出一条数数据，仅限所属线程调用
      * @param res 存储弹出的数据
      * @return 如果原本队列为空返回 false，否则为 true
      */
     bool try_pop(data_type& res) {
-        std::lock_guard<std::mutex> lock(m_mutex);
-        if (m_queue.empty()) {
+        int64_t b = m_bottom.load(std::memory_order_relaxed) - 1;
+        Array* a = m_array.load(std::memory_order_relaxed);
+        // 先预留 bottom 再读取 top，二者均需全序，以便与偷取方正确竞争最后一个任务
+        m_bottom.store(b, std::memory_order_seq_cst);
+        int64_t t = m_top.load(std::memory_order_seq_cst);
+
+        if (t > b) {
+            // 队列为空
+            m_bottom.store(b + 1, std::memory_order_relaxed);
             return false;
         }
 
-        res = std::move(m_queue.front());
-        m_queue.pop_front();
+        data_type* x = a->get(b);
+        if (t == b) {
+            // 仅剩最后一个，与偷取方竞争
+            bool win = m_top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst,
+                                                     std::memory_order_relaxed);
+            m_bottom.store(b + 1, std::memory_order_relaxed);
+            if (!win) {
+                return false;
+            }
+        }
+
+        res = std::move(*x);
+        delete x;
         return true;
     }
 
     /**
-     * 尝试从队列尾部偷取一条数据
+     * 尝试从队列尾部偷取一条数据，可在任意线程中调用
      * @param res 存储偷取的数据
-     * @return 如果原本队列为空返回 false，否则为 true
+     * @return 如果原本队列为空或与其他线程竞争失败返回 false，否则为 true
      */
     bool try_steal(data_type& res) {
-        std::lock_guard<std::mutex> lock(m_mutex);
-        if (m_queue.empty()) {
+        int64_t t = m_top.load(std::memory_order_seq_cst);
+        int64_t b = m_bottom.load(std::memory_order_seq_cst);
+        if (t >= b) {
             return false;
         }
 
-        res = std::move(m_queue.back());
-        m_queue.pop_back();
+        Array* a = m_array.load(std::memory_order_acquire);
+        data_type* x = a->get(t);
+        if (!m_top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst,
+                                           std::memory_order_relaxed)) {
+            return false;
+        }
+
+        res = std::move(*x);
+        delete x;
         return true;
     }
+
+private:
+    Array* grow(Array* a, int64_t b, int64_t t) {
+        // 旧缓冲区可能仍在被偷取方读取，保留至队列析构
+        Array* na = new Array(a->capacity * 2);
+        for (int64_t i = t; i < b; i++) {
+            na->put(i, a->get(i));
+        }
+        m_arrays.emplace_back(na);
+        m_array.store(na, std::memory_order_release);
+        return na;
+    }
 };
 
 } /* namespace hku */
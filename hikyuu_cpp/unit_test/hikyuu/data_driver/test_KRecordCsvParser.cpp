@@ -0,0 +1,303 @@
+/*
+ *  Copyright(C) 2026 hikyuu.org
+ *
+ *  Create on: 2026-10-18
+ *     Author: fasiondog
+ */
+
+#include "doctest/doctest.h"
+#include <cmath>
+#include <fstream>
+#include <random>
+#include <boost/algorithm/string.hpp>
+#include <boost/filesystem.hpp>
+#include <boost/lexical_cast.hpp>
+#include <hikyuu/StockManager.h>
+#include <hikyuu/data_driver/kdata/cvs/KRecordCsvParser.h>
+
+using namespace hku;
+
+/**
+ * @defgroup test_hikyuu_KRecordCsvParser test_hikyuu_KRecordCsvParser
+ * @ingroup test_hikyuu_data_driver_suite
+ * @{
+ */
+
+/* 按原逐行读取、boost::lexical_cast 转换的方式解析，作为比对的基准 */
+static KRecordList read_csv_by_lexical_cast(const string& filename) {
+    KRecordList result;
+    std::ifstream infile(filename.c_str());
+    string line;
+    if (!std::getline(infile, line)) {
+        return result;
+    }
+
+    // 列名 -> 字段序号，顺序同 KRecord 各字段
+    const char* names[] = {"DATE", "OPEN", "HIGH", "LOW", "CLOSE", "AMOUNT", "COUNT"};
+    vector<string> tokens;
+    boost::split(tokens, line, boost::is_any_of(","));
+    size_t column[7];
+    for (int i = 0; i < 7; i++) {
+        column[i] = Null<size_t>();
+        for (size_t j = 0; j < tokens.size(); j++) {
+            string token = boost::to_upper_copy(boost::trim_copy(tokens[j]));
+            if (token == names[i]) {
+                column[i] = j;
+            }
+        }
+    }
+
+    while (std::getline(infile, line)) {
+        boost::trim(line);
+        if (line.empty()) {
+            continue;
+        }
+        boost::split(tokens, line, boost::is_any_of(","));
+        for (auto& token : tokens) {
+            boost::trim(token);
+        }
+
+        KRecord record;
+        try {
+            price_t* fields[] = {nullptr,           &record.openPrice,   &record.highPrice,
+                                 &record.lowPrice,  &record.closePrice,  &record.transAmount,
+                                 &record.transCount};
+            for (int i = 0; i < 7; i++) {
+                if (column[i] >= tokens.size()) {
+                    continue;
+                }
+                if (i == 0) {
+                    record.datetime = Datetime(tokens[column[i]]);
+                } else {
+                    *fields[i] = boost::lexical_cast<price_t>(tokens[column[i]]);
+                }
+            }
+            result.push_back(record);
+        } catch (...) {
+        }
+    }
+    return result;
+}
+
+static bool same_record(const KRecord& a, const KRecord& b) {
+    return a.datetime == b.datetime && a.openPrice == b.openPrice &&
+           a.highPrice == b.highPrice && a.lowPrice == b.lowPrice &&
+           a.closePrice == b.closePrice && a.transAmount == b.transAmount &&
+           a.transCount == b.transCount;
+}
+
+static bool same_record_list(const KRecordList& a, const KRecordList& b) {
+    if (a.size() != b.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < a.size(); i++) {
+        if (!same_record(a[i], b[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static string test_data_dir() {
+    boost::filesystem::path tmp_dir(StockManager::instance().tmpdir());
+    return tmp_dir.parent_path().string();
+}
+
+/** @par 检测点 */
+TEST_CASE("test_KRecordCsvParser_parsePrice") {
+    auto parse = [](const string& str, price_t& out) {
+        return KRecordCsvParser::parsePrice(str.data(), str.data() + str.size(), out);
+    };
+
+    /** @arg 与 boost::lexical_cast 的结果逐位一致 */
+    std::mt19937_64 rng(20261018);
+    std::uniform_real_distribution<double> dist(-100000.0, 100000.0);
+    vector<string> corpus = {"0",      "-0",     "+1",      "3233.0900", "0.0000", "1e5",
+                             "1.5E-3", "-2.5e+2", "12345678901234567890", "0.1",
+                             "123456789012345678.5", "1e30", "4.9e-324", "007.50", "5.",
+                             ".5",     "  12.5 ", "\t3\r"};
+    for (int i = 0; i < 2000; i++) {
+        double value = dist(rng);
+        corpus.push_back(fmt::format("{:.4f}", value));
+        corpus.push_back(fmt::format("{}", value));
+        corpus.push_back(fmt::format("{:e}", value));
+        corpus.push_back(fmt::format("{:.2f}", value / 1000.0));
+    }
+    for (const auto& str : corpus) {
+        price_t expect = Null<price_t>();
+        bool expect_ok = true;
+        try {
+            expect = boost::lexical_cast<price_t>(boost::trim_copy(str));
+        } catch (...) {
+            expect_ok = false;
+        }
+        price_t value = Null<price_t>();
+        CHECK_EQ(parse(str, value), expect_ok);
+        if (expect_ok) {
+            CHECK_EQ(value, expect);
+        }
+    }
+
+    /** @arg 无法解析的数值 */
+    price_t value = 0.0;
+    vector<string> invalid = {"", "  ", "abc", "1.2.3", "12a", "--1", "1e", ",", "1 2"};
+    for (const auto& str : invalid) {
+        CHECK_UNARY(!parse(str, value));
+    }
+}
+
+/** @par 检测点 */
+TEST_CASE("test_KRecordCsvParser_parseDatetime") {
+    auto parse = [](const string& str, Datetime& out) {
+        return KRecordCsvParser::parseDatetime(str.data(), str.data() + str.size(), out);
+    };
+
+    /** @arg 与 Datetime(const std::string&) 的结果一致 */
+    vector<string> corpus = {"2017-3-7 0:0:0",      "2017-03-07 09:30:00", "2017-03-07",
+                             "2017-3-7",            "2017/03/07",          "20170307",
+                             "20170307T093000",     "20170307T093000.25",  "2017-03-07 9:30:1.5",
+                             "2017-03-07 23:59:59.123456", " 2017-03-07 ", "+infinity",
+                             "1999-12-31 13:22:00", "2000-02-29 10:00:00", "201703070930"};
+    for (const auto& str : corpus) {
+        Datetime expect;
+        bool expect_ok = true;
+        try {
+            expect = Datetime(str);
+        } catch (...) {
+            expect_ok = false;
+        }
+        Datetime value;
+        CHECK_EQ(parse(str, value), expect_ok);
+        if (expect_ok) {
+            CHECK_EQ(value, expect);
+        }
+    }
+
+    /** @arg 无法解析的日期 */
+    Datetime value;
+    vector<string> invalid = {"", "abc", "2017-13-01", "2017-02-30", "20170230", "2017-3-"};
+    for (const auto& str : invalid) {
+        CHECK_UNARY(!parse(str, value));
+    }
+}
+
+/** @par 检测点 */
+TEST_CASE("test_KRecordCsvParser_parseLine") {
+    KRecordCsvParser parser;
+    string title("日期, 开盘价, 最高价, 最低价, 收盘价, 成交金额, 成交量, 备注");
+    parser.parseTitle(title.data(), title.data() + title.size());
+
+    /** @arg 正常数据行，无用的列被忽略 */
+    string line("2017-3-7 0:0:0, 1.5, 2.5, 1.0, 2.0, 100, 10, 备注");
+    KRecord record;
+    CHECK_UNARY(parser.parseLine(line.data(), line.data() + line.size(), record));
+    CHECK_EQ(record.datetime, Datetime(201703070000));
+    CHECK_EQ(record.openPrice, 1.5);
+    CHECK_EQ(record.highPrice, 2.5);
+    CHECK_EQ(record.lowPrice, 1.0);
+    CHECK_EQ(record.closePrice, 2.0);
+    CHECK_EQ(record.transAmount, 100.0);
+    CHECK_EQ(record.transCount, 10.0);
+
+    /** @arg 缺少的字段保持默认值 */
+    line = "2017-3-8,1.5,2.5";
+    record = KRecord();
+    CHECK_UNARY(parser.parseLine(line.data(), line.data() + line.size(), record));
+    CHECK_EQ(record.datetime, Datetime(201703080000));
+    CHECK_EQ(record.highPrice, 2.5);
+    CHECK_EQ(record.lowPrice, 0.0);
+
+    /** @arg 存在无法解析的字段 */
+    line = "2017-3-9,1.5,abc,1.0,2.0,100,10";
+    CHECK_UNARY(!parser.parseLine(line.data(), line.data() + line.size(), record));
+    line = "2017-3-9,1.5,,1.0,2.0,100,10";
+    CHECK_UNARY(!parser.parseLine(line.data(), line.data() + line.size(), record));
+}
+
+/** @par 检测点 */
+TEST_CASE("test_readKRecordCsv") {
+    string dir = test_data_dir();
+
+    /** @arg 与逐行 lexical_cast 解析的结果一致 */
+    string day_filename = dir + "/test_day_data.csv";
+    string min_filename = dir + "/test_min_data.csv";
+    KRecordList expect = read_csv_by_lexical_cast(day_filename);
+    KRecordList result = readKRecordCsv(day_filename);
+    CHECK_EQ(result.size(), 100);
+    CHECK_UNARY(same_record_list(result, expect));
+
+    expect = read_csv_by_lexical_cast(min_filename);
+    result = readKRecordCsv(min_filename);
+    CHECK_EQ(result.size(), 24000);
+    CHECK_UNARY(same_record_list(result, expect));
+
+    /** @arg 分段并行解析与顺序解析的结果一致 */
+    KRecordList parallel = readKRecordCsv(min_filename, 4096);
+    CHECK_UNARY(same_record_list(parallel, result));
+    parallel = readKRecordCsv(min_filename, 1);
+    CHECK_UNARY(same_record_list(parallel, result));
+
+    /** @arg 不存在的文件 */
+    result = readKRecordCsv(dir + "/not_exist_file.csv");
+    CHECK_UNARY(result.empty());
+}
+
+/** @par 检测点 */
+TEST_CASE("test_readKRecordCsv_corpus") {
+    string filename = StockManager::instance().tmpdir() + "/test_csv_corpus.csv";
+
+    /** @arg BOM、CRLF、空行、无效行、末行无换行符 */
+    {
+        std::ofstream out(filename.c_str(), std::ios::binary);
+        out << "\xEF\xBB\xBF"
+            << "Date, Open, High, Low, Close, Amount, Volume\r\n"
+            << "2017-3-7 0:0:0,3233.09,3242.66,3226.82,3242.41,20993120.6,164064235\r\n"
+            << "\r\n"
+            << "   \n"
+            << "2017-3-8 0:0:0,abc,3245.30,3230.61,3240.66,19822578.8,160731388\n"
+            << "20170309, 1e3, 1.5E+3, -2, +4.25, 0, 0\n"
+            << "2017/03/10,1,2,3,4,5,6\n"
+            << "2017-02-30,1,2,3,4,5,6\n"
+            << "20170313T093000,1,2,3,4\n"
+            << "2017-3-14 9:30:0,7,8,9,10,11,12";
+    }
+
+    KRecordList result = readKRecordCsv(filename);
+    CHECK_EQ(result.size(), 5);
+    CHECK_EQ(result[0].datetime, Datetime(201703070000));
+    CHECK_EQ(result[0].openPrice, 3233.09);
+    CHECK_EQ(result[0].transCount, 164064235.0);
+    CHECK_EQ(result[1].datetime, Datetime(201703090000));
+    CHECK_EQ(result[1].openPrice, 1000.0);
+    CHECK_EQ(result[1].highPrice, 1500.0);
+    CHECK_EQ(result[1].lowPrice, -2.0);
+    CHECK_EQ(result[1].closePrice, 4.25);
+    CHECK_EQ(result[2].datetime, Datetime(201703100000));
+    CHECK_EQ(result[2].transAmount, 5.0);
+    CHECK_EQ(result[2].transCount, 6.0);
+    CHECK_EQ(result[3].datetime, Datetime(201703130930));
+    CHECK_EQ(result[3].closePrice, 4.0);
+    CHECK_EQ(result[3].transAmount, 0.0);
+    CHECK_EQ(result[4].datetime, Datetime(201703140930));
+    CHECK_EQ(result[4].transCount, 12.0);
+
+    /** @arg 并行解析时切分点落在各类行上，结果不变 */
+    for (size_t chunk_size = 1; chunk_size < 64; chunk_size++) {
+        CHECK_UNARY(same_record_list(readKRecordCsv(filename, chunk_size), result));
+    }
+
+    /** @arg 只有标题行或为空文件 */
+    {
+        std::ofstream out(filename.c_str(), std::ios::binary);
+        out << "date, open, high, low, close, amount, count";
+    }
+    CHECK_UNARY(readKRecordCsv(filename).empty());
+    {
+        std::ofstream out(filename.c_str(), std::ios::binary);
+    }
+    CHECK_UNARY(readKRecordCsv(filename).empty());
+
+    boost::filesystem::remove(filename);
+}
+
+/** @} */
@@ -0,0 +1,89 @@
+/*
+ * test_SpotReplay.cpp
+ *
+ *  Created on: 2026-10-18
+ *      Author: fasiondog
+ */
+
+#include "doctest/doctest.h"
+#include <cstdio>
+#include <fstream>
+#include <hikyuu/global/agent/SpotReplay.h>
+
+using namespace hku;
+
+/**
+ * @defgroup test_hikyuu_SpotReplay test_hikyuu_SpotReplay
+ * @ingroup test_hikyuu_base_suite
+ * @{
+ */
+
+/** @par 检测点 */
+TEST_CASE("test_SpotRecordFile") {
+    std::string filename("test_spot_record.dat");
+    std::remove(filename.c_str());
+
+    /** @arg 写入后按顺序读出，包含空消息 */
+    SpotRecordWriter writer;
+    CHECK_UNARY(writer.open(filename));
+    string start_tag(":spot:[start spot]");
+    string data(":spot:\x01\x02\x00\xff", 10);
+    writer.write(start_tag.data(), start_tag.size(), 1000);
+    writer.write(data.data(), data.size(), 2000);
+    writer.close();
+    CHECK_EQ(writer.count(), 2);
+
+    /** @arg 追加写入 */
+    CHECK_UNARY(writer.open(filename));
+    string end_tag(":spot:[end spot]");
+    writer.write(end_tag.data(), end_tag.size(), 3000);
+    writer.write("", 0, 4000);
+    writer.close();
+
+    SpotRecordReader reader;
+    CHECK_UNARY(reader.open(filename));
+    string buf;
+    int64_t time_us = 0;
+    CHECK_UNARY(reader.next(buf, time_us));
+    CHECK_EQ(buf, start_tag);
+    CHECK_EQ(time_us, 1000);
+    CHECK_UNARY(reader.next(buf, time_us));
+    CHECK_EQ(buf, data);
+    CHECK_EQ(time_us, 2000);
+    CHECK_UNARY(reader.next(buf, time_us));
+    CHECK_EQ(buf, end_tag);
+    CHECK_EQ(time_us, 3000);
+    CHECK_UNARY(reader.next(buf, time_us));
+    CHECK_UNARY(buf.empty());
+    CHECK_EQ(time_us, 4000);
+    CHECK_UNARY(!reader.next(buf, time_us));
+
+    /** @arg 长度字段超出剩余字节数时视为文件损坏，不再继续读取 */
+    std::ofstream corrupt(filename, std::ios::binary | std::ios::app);
+    const char head[12] = {0, 0, 0, 0, 0, 0, 0, 0, '\xff', '\xff', '\xff', '\x7f'};
+    corrupt.write(head, sizeof(head));
+    corrupt.write("abc", 3);
+    corrupt.close();
+    CHECK_UNARY(reader.open(filename));
+    for (int i = 0; i < 4; i++) {
+        CHECK_UNARY(reader.next(buf, time_us));
+    }
+    CHECK_UNARY(!reader.next(buf, time_us));
+
+    /** @arg 超出最大长度的消息不写入 */
+    CHECK_UNARY(writer.open(filename));
+    writer.write(data.data(), SpotRecordWriter::MAX_MESSAGE_SIZE + 1, 5000);
+    CHECK_EQ(writer.count(), 0);
+    writer.close();
+
+    /** @arg 格式不符的文件 */
+    std::ofstream invalid(filename, std::ios::trunc);
+    invalid << "not a spot record file";
+    invalid.close();
+    CHECK_UNARY(!reader.open(filename));
+    CHECK_UNARY(!writer.open(filename));
+
+    std::remove(filename.c_str());
+}
+
+/** @} */
@@ -125,6 +125,74 @@ TEST_CASE("test_Block_2") {
     CHECK(!blk.empty());
     blk.clear();
     CHECK(blk.empty());
+    CHECK(!blk.have(sm["sh000002"]));
+}
+
+/** @par 检测点 */
+TEST_CASE("test_Block_set_operation") {
+    StockManager& sm = StockManager::instance();
+    Block a("test", "a"), b("test", "b");
+    a.add("sh000001");
+    a.add("sz000001");
+    a.add("sh000002");
+    b.add("sz000001");
+    b.add("sh000002");
+    b.add("sz000002");
+
+    /** @arg 按位图判断 Stock 实例是否在板块中 */
+    CHECK(a.have(sm["sh000001"]));
+    CHECK(!a.have(sm["sz000002"]));
+    CHECK(!a.have(Null<Stock>()));
+
+    /** @arg 并集 */
+    Block result = a | b;
+    CHECK_EQ(result.size(), 4);
+    CHECK_EQ(result.category(), "");
+    CHECK_EQ(result.name(), "");
+    CHECK(result.have(sm["sh000001"]));
+    CHECK(result.have(sm["sz000002"]));
+    CHECK(result.have("sz000001"));
+
+    /** @arg 交集 */
+    result = a & b;
+    CHECK_EQ(result.size(), 2);
+    CHECK(result.have(sm["sz000001"]));
+    CHECK(result.have(sm["sh000002"]));
+    CHECK(!result.have(sm["sh000001"]));
+    CHECK(!result.have(sm["sz000002"]));
+
+    /** @arg 差集 */
+    result = a - b;
+    CHECK_EQ(result.size(), 1);
+    CHECK(result.have(sm["sh000001"]));
+    CHECK(!result.have(sm["sz000001"]));
+    result = b - a;
+    CHECK_EQ(result.size(), 1);
+    CHECK(result.have("sz000002"));
+
+    /** @arg 与空板块运算 */
+    CHECK_EQ((a | Block()).size(), 3);
+    CHECK_EQ((Block() | a).size(), 3);
+    CHECK((a & Block()).empty());
+    CHECK_EQ((a - Block()).size(), 3);
+    CHECK((Block() - a).empty());
+
+    /** @arg 运算结果与原板块互不影响 */
+    result = a | b;
+    result.remove("sh000001");
+    CHECK(a.have(sm["sh000001"]));
+
+    /** @arg 深度复制 */
+    Block c = a.clone();
+    CHECK_EQ(c.category(), "test");
+    CHECK_EQ(c.name(), "a");
+    CHECK_EQ(c.size(), 3);
+    CHECK(c != a);
+    c.remove(sm["sh000001"]);
+    CHECK_EQ(c.size(), 2);
+    CHECK_EQ(a.size(), 3);
+    CHECK(a.have(sm["sh000001"]));
+    CHECK(Block().clone() == Block());
 }
 
 /** @} */
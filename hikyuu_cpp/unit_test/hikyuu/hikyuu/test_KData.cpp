@@ -1253,7 +1253,7 @@ TEST_CASE("test_getKData_recover") {
     CHECK_EQ(kdata[657],
              KRecord(Datetime(200208210000), 18.35, 18.75, 18.18, 18.55, 36409.8, 197640));
     CHECK_EQ(kdata[658],
-             KRecord(Datetime(200208220000), 18.77, 18.89, 18.62, 18.81, 13101.3, 106872));
+             KRecord(Datetime(200208220000), 18.77, 18.89, 18.62, 18.82, 13101.3, 106872));
 
     /** @arg 前向等比复权*/
     query = KQuery(0, Null<int64_t>(), KQuery::DAY, KQuery::EQUAL_FORWARD);
@@ -1278,7 +1278,43 @@ TEST_CASE("test_getKData_recover") {
     CHECK_EQ(kdata[657],
              KRecord(Datetime(200208210000), 18.32, 18.72, 18.15, 18.52, 36409.8, 197640));
     CHECK_EQ(kdata[658],
-             KRecord(Datetime(200208220000), 18.74, 18.86, 18.59, 18.79, 13101.3, 106872));
+             KRecord(Datetime(200208220000), 18.74, 18.87, 18.59, 18.79, 13101.3, 106872));
+}
+
+/** @par 检测点 */
+TEST_CASE("test_getKData_recover_for_up_day_cache") {
+    StockManager& sm = StockManager::instance();
+    Stock stock = sm.getStock("sh600000");
+    StockWeightList weights = stock.getWeight();
+
+    KQuery::RecoverType recover_types[] = {KQuery::FORWARD, KQuery::BACKWARD,
+                                           KQuery::EQUAL_FORWARD, KQuery::EQUAL_BACKWARD};
+    for (auto recover_type : recover_types) {
+        bool is_forward = recover_type == KQuery::FORWARD || recover_type == KQuery::EQUAL_FORWARD;
+        KQuery full_query(0, Null<int64_t>(), KQuery::WEEK, recover_type);
+        KQuery sub_query = is_forward ? KQuery(100, Null<int64_t>(), KQuery::WEEK, recover_type)
+                                      : KQuery(0, 200, KQuery::WEEK, recover_type);
+
+        /** @arg 重新设置权息信息会清除缓存，此时子区间为直接计算结果 */
+        stock.setWeightList(weights);
+        KData expect = stock.getKData(sub_query);
+
+        /** @arg 先获取全部数据，子区间从缓存中截取，结果应与直接计算一致 */
+        stock.setWeightList(weights);
+        KData full = stock.getKData(full_query);
+        KData result = stock.getKData(sub_query);
+        CHECK_EQ(result.size(), expect.size());
+        for (size_t i = 0, total = expect.size(); i < total; i++) {
+            CHECK_EQ(result[i], expect[i]);
+        }
+
+        /** @arg 重复获取结果一致 */
+        KData again = stock.getKData(full_query);
+        CHECK_EQ(again.size(), full.size());
+        for (size_t i = 0, total = full.size(); i < total; i++) {
+            CHECK_EQ(again[i], full[i]);
+        }
+    }
 }
 
 /** @par 检测点 */
@@ -1615,4 +1651,20 @@ TEST_CASE("test_getKRecord_By_Date") {
     CHECK_EQ(result, Null<KRecord>());
 }
 
+/** @par 检测点 */
+TEST_CASE("test_KData_data") {
+    /** @arg kdata为空 */
+    KData kdata;
+    CHECK_UNARY(kdata.data() == nullptr);
+
+    /** @arg 记录连续存放，与 getKRecord 一致 */
+    Stock stock = StockManager::instance().getStock("sh600000");
+    kdata = stock.getKData(KQuery(1, 10));
+    const KRecord* data = kdata.data();
+    CHECK_UNARY(data != nullptr);
+    for (size_t i = 0; i < kdata.size(); ++i) {
+        CHECK_EQ(data[i], kdata[i]);
+    }
+}
+
 /** @} */
@@ -0,0 +1,178 @@
+/*
+ * test_KDataResample.cpp
+ *
+ *  Created on: 2026-10-18
+ *      Author: fasiondog
+ */
+
+#include "doctest/doctest.h"
+#include <hikyuu/StockManager.h>
+#include <hikyuu/KDataResample.h>
+
+using namespace hku;
+
+/**
+ * @defgroup test_hikyuu_KDataResample test_hikyuu_KDataResample
+ * @ingroup test_hikyuu_base_suite
+ * @{
+ */
+
+/** @par 检测点 */
+TEST_CASE("test_getResampleBaseKType") {
+    CHECK_UNARY(getResampleBaseKType(KQuery::DAY).empty());
+    CHECK_UNARY(getResampleBaseKType(KQuery::MIN).empty());
+    CHECK_UNARY(getResampleBaseKType(KQuery::MIN5).empty());
+    CHECK_EQ(getResampleBaseKType(KQuery::MIN3), vector<KQuery::KType>{KQuery::MIN});
+    CHECK_EQ(getResampleBaseKType(KQuery::WEEK), vector<KQuery::KType>{KQuery::DAY});
+    CHECK_EQ(getResampleBaseKType(KQuery::HOUR2).front(), KQuery::MIN60);
+    CHECK_EQ(getResampleBaseKType(KQuery::HOUR2).back(), KQuery::MIN);
+}
+
+/** @par 检测点 */
+TEST_CASE("test_resampleKRecordList_day_to_week") {
+    StockManager& sm = StockManager::instance();
+    Stock stock = sm.getStock("sh600000");
+    KRecordList day_list = stock.getKRecordList(KQuery(0, Null<int64_t>(), KQuery::DAY));
+    KRecordList expect = stock.getKRecordList(KQuery(0, Null<int64_t>(), KQuery::WEEK));
+
+    /** @arg 由日线合成的周线与数据源中的周线一致 */
+    KRecordList result;
+    resampleKRecordList(day_list, 0, KQuery::WEEK, sm.getMarketInfo("SH"), result);
+    CHECK_EQ(result.size(), expect.size());
+    for (size_t i = 0, total = std::min(result.size(), expect.size()); i < total; i++) {
+        CHECK_EQ(result[i].datetime, expect[i].datetime);
+        CHECK_EQ(result[i].openPrice, doctest::Approx(expect[i].openPrice));
+        CHECK_EQ(result[i].highPrice, doctest::Approx(expect[i].highPrice));
+        CHECK_EQ(result[i].lowPrice, doctest::Approx(expect[i].lowPrice));
+        CHECK_EQ(result[i].closePrice, doctest::Approx(expect[i].closePrice));
+        CHECK_EQ(result[i].transAmount, doctest::Approx(expect[i].transAmount));
+        CHECK_EQ(result[i].transCount, doctest::Approx(expect[i].transCount));
+    }
+
+    /** @arg 从最后一个分组的起始位置增量合成，结果与全量合成一致 */
+    KRecordList part;
+    size_t half = day_list.size() / 2;
+    KRecordList first_half(day_list.begin(), day_list.begin() + half);
+    size_t group_start = resampleKRecordList(first_half, 0, KQuery::WEEK, MarketInfo(), part);
+    part.pop_back();
+    resampleKRecordList(day_list, group_start, KQuery::WEEK, MarketInfo(), part);
+    CHECK_EQ(part.size(), result.size());
+    for (size_t i = 0, total = std::min(part.size(), result.size()); i < total; i++) {
+        CHECK_EQ(part[i], result[i]);
+    }
+}
+
+/** @par 检测点 */
+TEST_CASE("test_resampleKRecordList_by_trading_session") {
+    StockManager& sm = StockManager::instance();
+    MarketInfo market_info = sm.getMarketInfo("SH");
+
+    // 构造一个交易日的5分钟线，上午 09:35 ~ 11:30，下午 13:05 ~ 15:00
+    KRecordList base;
+    Datetime day(201101040000L);
+    price_t price = 10.0;
+    for (Datetime t = day + Minutes(9 * 60 + 35); t <= day + Minutes(11 * 60 + 30);
+         t = t + Minutes(5)) {
+        price += 0.01;
+        base.push_back(KRecord(t, price, price + 0.05, price - 0.05, price, 10.0, 100.0));
+    }
+    for (Datetime t = day + Minutes(13 * 60 + 5); t <= day + Minutes(15 * 60); t = t + Minutes(5)) {
+        price += 0.01;
+        base.push_back(KRecord(t, price, price + 0.05, price - 0.05, price, 10.0, 100.0));
+    }
+    CHECK_EQ(base.size(), 48);
+
+    /** @arg 两小时线按上午、下午交易时段划分 */
+    KRecordList result;
+    size_t group_start = resampleKRecordList(base, 0, KQuery::HOUR2, market_info, result);
+    CHECK_EQ(result.size(), 2);
+    CHECK_EQ(group_start, 24);
+    CHECK_EQ(result[0].datetime, Datetime(201101041130L));
+    CHECK_EQ(result[0].openPrice, doctest::Approx(base[0].openPrice));
+    CHECK_EQ(result[0].closePrice, doctest::Approx(base[23].closePrice));
+    CHECK_EQ(result[0].highPrice, doctest::Approx(base[23].highPrice));
+    CHECK_EQ(result[0].lowPrice, doctest::Approx(base[0].lowPrice));
+    CHECK_EQ(result[0].transAmount, doctest::Approx(240.0));
+    CHECK_EQ(result[0].transCount, doctest::Approx(2400.0));
+    CHECK_EQ(result[1].datetime, Datetime(201101041500L));
+    CHECK_EQ(result[1].openPrice, doctest::Approx(base[24].openPrice));
+    CHECK_EQ(result[1].closePrice, doctest::Approx(base[47].closePrice));
+
+    /** @arg 4小时线及以上周期合并为全天一根K线 */
+    KRecordList result4;
+    resampleKRecordList(base, 0, KQuery::HOUR4, market_info, result4);
+    CHECK_EQ(result4.size(), 1);
+    CHECK_EQ(result4[0].datetime, Datetime(201101041500L));
+    CHECK_EQ(result4[0].transCount, doctest::Approx(4800.0));
+
+    KRecordList result12;
+    resampleKRecordList(base, 0, KQuery::HOUR12, market_info, result12);
+    CHECK_EQ(result12.size(), 1);
+
+    /** @arg 15分钟线时间为各分组的结束时刻 */
+    KRecordList result15;
+    resampleKRecordList(base, 0, KQuery::MIN15, market_info, result15);
+    CHECK_EQ(result15.size(), 16);
+    CHECK_EQ(result15[0].datetime, Datetime(201101040945L));
+    CHECK_EQ(result15[7].datetime, Datetime(201101041130L));
+    CHECK_EQ(result15[8].datetime, Datetime(201101041315L));
+    CHECK_EQ(result15[15].datetime, Datetime(201101041500L));
+
+    /** @arg 不同交易日不合并 */
+    KRecordList two_days = base;
+    for (auto& k : base) {
+        KRecord next = k;
+        next.datetime = k.datetime + Days(1);
+        two_days.push_back(next);
+    }
+    KRecordList result_days;
+    resampleKRecordList(two_days, 0, KQuery::HOUR4, market_info, result_days);
+    CHECK_EQ(result_days.size(), 2);
+    CHECK_EQ(result_days[1].datetime, Datetime(201101051500L));
+}
+
+/** @par 检测点 */
+TEST_CASE("test_getResampleTime") {
+    MarketInfo market_info = StockManager::instance().getMarketInfo("SH");
+    Datetime day(201101040000L);
+
+    /** @arg 分钟级为按交易时段对齐的周期结束时刻，不足整分钟的时刻归入下一分钟 */
+    CHECK_EQ(getResampleTime(day + Minutes(9 * 60 + 31), KQuery::MIN, market_info),
+             Datetime(201101040931L));
+    CHECK_EQ(getResampleTime(day + Seconds(34270), KQuery::MIN, market_info),
+             Datetime(201101040932L));
+    CHECK_EQ(getResampleTime(day + Seconds(34270), KQuery::MIN5, market_info),
+             Datetime(201101040935L));
+    CHECK_EQ(getResampleTime(day + Minutes(9 * 60 + 25), KQuery::MIN5, market_info),
+             Datetime(201101040935L));
+    CHECK_EQ(getResampleTime(day + Minutes(10 * 60), KQuery::HOUR2, market_info),
+             Datetime(201101041130L));
+    CHECK_EQ(getResampleTime(day + Minutes(11 * 60 + 30) + Seconds(5), KQuery::HOUR2, market_info),
+             Datetime(201101041130L));
+    CHECK_EQ(getResampleTime(day + Minutes(13 * 60) + Seconds(5), KQuery::HOUR2, market_info),
+             Datetime(201101041500L));
+    CHECK_EQ(getResampleTime(day + Minutes(15 * 60) + Seconds(5), KQuery::MIN15, market_info),
+             Datetime(201101041500L));
+
+    /** @arg 日线以上为自然周期的结束日期，周线为周五 */
+    CHECK_EQ(getResampleTime(day + Minutes(600), KQuery::WEEK, market_info),
+             Datetime(201101070000L));
+    CHECK_EQ(getResampleTime(day, KQuery::MONTH, market_info), Datetime(201101310000L));
+    CHECK_EQ(getResampleTime(day, KQuery::YEAR, market_info), Datetime(201112310000L));
+
+    /** @arg 不支持的类型 */
+    CHECK_UNARY(getResampleTime(day, KQuery::DAY, market_info).isNull());
+    CHECK_UNARY(getResampleTime(Null<Datetime>(), KQuery::MIN, market_info).isNull());
+}
+
+/** @par 检测点 */
+TEST_CASE("test_Stock_resample_unbuffered") {
+    /** @arg 基础K线均未缓存时不合成，也不缓存合成结果 */
+    Stock stk = StockManager::instance().getStock("sh600000");
+    CHECK_UNARY(!stk.isBuffer(KQuery::MIN));
+    CHECK_EQ(stk.getCount(KQuery::MIN3), 0);
+    CHECK_UNARY(stk.getKRecordList(KQuery(0, 10, KQuery::MIN3)).empty());
+    CHECK_UNARY(!stk.isBuffer(KQuery::MIN3));
+}
+
+/** @} */
@@ -0,0 +1,151 @@
+/*
+ * test_PreloadScheduler.cpp
+ *
+ *  Created on: 2026-10-18
+ *      Author: fasiondog
+ */
+
+#include "doctest/doctest.h"
+#include <hikyuu/StockManager.h>
+
+using namespace hku;
+
+/**
+ * @defgroup test_hikyuu_PreloadScheduler test_hikyuu_PreloadScheduler
+ * @ingroup test_hikyuu_base_suite
+ * @{
+ */
+
+/** @par 检测点 */
+TEST_CASE("test_PreloadScheduler_init") {
+    StockManager& sm = StockManager::instance();
+
+    /** @arg 初始化后可等待预加载完成，日线全部就绪 */
+    PreloadSchedulerPtr scheduler = sm.getPreloadScheduler();
+    CHECK_UNARY(scheduler);
+    scheduler->wait();
+    CHECK_UNARY(scheduler->done());
+    CHECK_UNARY(scheduler->isReady(KQuery::DAY));
+    CHECK_UNARY(scheduler->isReady(sm.getStock("sh000001")));
+    CHECK_UNARY(sm.getStock("sh000001").isBuffer(KQuery::DAY));
+
+    PreloadProgress progress = scheduler->progress();
+    CHECK_EQ(progress.total, progress.finished);
+    CHECK_EQ(progress.failed, 0);
+    CHECK_UNARY(progress.records > 0);
+
+    /** @arg 默认日线优先，分钟线先于分时、分笔 */
+    CHECK_LT(PreloadScheduler::getPriority(KQuery::DAY),
+             PreloadScheduler::getPriority(KQuery::WEEK));
+    CHECK_LT(PreloadScheduler::getPriority(KQuery::MIN60),
+             PreloadScheduler::getPriority(KQuery::MIN));
+    CHECK_LT(PreloadScheduler::getPriority(KQuery::MIN),
+             PreloadScheduler::getPriority(PreloadScheduler::TICKS));
+}
+
+/** @par 检测点 */
+TEST_CASE("test_PreloadScheduler_budget") {
+    StockManager& sm = StockManager::instance();
+    Stock stk = sm.getStock("sh600000");
+    size_t week_total = stk.getCount(KQuery::WEEK);
+    CHECK_UNARY(week_total > 0);
+
+    // 加载前按预加载的最大记录数预占预算，加载后按实际记录数修正
+    size_t week_max = sm.getPreloadParameter().tryGet<int>("week_max", 4096);
+    size_t week_bytes = week_max * sizeof(KRecord);
+    CHECK_LT(week_total, week_max);
+
+    /** @arg 预算仅够加载周线，后加入但优先级更高的周线先加载，月线被跳过 */
+    auto scheduler = make_shared<PreloadScheduler>(week_bytes);
+    scheduler->add(stk, KQuery::MONTH);
+    scheduler->add(stk, KQuery::WEEK);
+    CHECK_UNARY(!scheduler->isReady(stk));
+    CHECK_UNARY(!scheduler->isReady(KQuery::WEEK));
+    scheduler->run();
+    CHECK_UNARY(scheduler->done());
+    CHECK_UNARY(scheduler->isReady(stk));
+    CHECK_UNARY(stk.isBuffer(KQuery::WEEK));
+    CHECK_UNARY(!stk.isBuffer(KQuery::MONTH));
+    CHECK_EQ(stk.getCount(KQuery::WEEK), week_total);
+
+    PreloadProgress progress = scheduler->progress();
+    CHECK_EQ(progress.total, 2);
+    CHECK_EQ(progress.finished, 2);
+    CHECK_EQ(progress.skipped, 1);
+    CHECK_EQ(progress.failed, 0);
+    CHECK_EQ(progress.records, week_total);
+    CHECK_EQ(progress.bytes, week_total * sizeof(KRecord));
+
+    /** @arg 已启动后不能再增加任务 */
+    scheduler->add(stk, KQuery::MONTH);
+    CHECK_EQ(scheduler->progress().total, 2);
+
+    stk.releaseKDataBuffer(KQuery::WEEK);
+    CHECK_UNARY(!stk.isBuffer(KQuery::WEEK));
+
+    /** @arg 最大记录数远大于实际记录数时，加载后归还多占用的预算，后续任务仍可加载 */
+    Stock stk2 = sm.getStock("sz000001");
+    size_t week_total2 = stk2.getCount(KQuery::WEEK);
+    CHECK_LT(week_total2, week_max);
+    scheduler = make_shared<PreloadScheduler>(week_bytes + week_total * sizeof(KRecord));
+    scheduler->add(stk, KQuery::WEEK);
+    scheduler->add(stk2, KQuery::WEEK);
+    scheduler->run();
+    CHECK_UNARY(stk.isBuffer(KQuery::WEEK));
+    CHECK_UNARY(stk2.isBuffer(KQuery::WEEK));
+    progress = scheduler->progress();
+    CHECK_EQ(progress.skipped, 0);
+    CHECK_EQ(progress.records, week_total + week_total2);
+    CHECK_EQ(progress.bytes, (week_total + week_total2) * sizeof(KRecord));
+
+    stk.releaseKDataBuffer(KQuery::WEEK);
+    stk2.releaseKDataBuffer(KQuery::WEEK);
+}
+
+/** @par 检测点 */
+TEST_CASE("test_PreloadScheduler_async") {
+    StockManager& sm = StockManager::instance();
+    StockList stks{sm["sh600000"], sm["sz000001"], sm["sh000001"]};
+
+    /** @arg 异步执行，future 就绪时全部任务已结束 */
+    auto scheduler = make_shared<PreloadScheduler>();
+    size_t total = 0;
+    for (const auto& stk : stks) {
+        total += stk.getCount(KQuery::WEEK);
+        scheduler->add(stk, KQuery::WEEK);
+    }
+    std::shared_future<void> future = scheduler->start();
+    future.wait();
+    CHECK_UNARY(scheduler->waitFor(0));
+    CHECK_UNARY(scheduler->isReady(KQuery::WEEK));
+
+    PreloadProgress progress = scheduler->progress();
+    CHECK_EQ(progress.total, 3);
+    CHECK_EQ(progress.finished, 3);
+    CHECK_EQ(progress.skipped, 0);
+    CHECK_EQ(progress.records, total);
+    CHECK_EQ(progress.bytes, total * sizeof(KRecord));
+    CHECK_UNARY(progress.elapsed >= 0.0);
+
+    for (auto& stk : stks) {
+        CHECK_UNARY(scheduler->isReady(stk));
+        CHECK_UNARY(stk.isBuffer(KQuery::WEEK));
+        stk.releaseKDataBuffer(KQuery::WEEK);
+    }
+
+    /** @arg 启动前取消，全部任务直接结束 */
+    scheduler = make_shared<PreloadScheduler>();
+    scheduler->add(stks[0], KQuery::MONTH);
+    scheduler->cancel();
+    CHECK_UNARY(scheduler->done());
+    CHECK_UNARY(scheduler->isReady(stks[0]));
+    CHECK_EQ(scheduler->progress().total, 0);
+    CHECK_UNARY(!stks[0].isBuffer(KQuery::MONTH));
+
+    /** @arg 无任务时启动即结束 */
+    scheduler = make_shared<PreloadScheduler>();
+    scheduler->start().wait();
+    CHECK_UNARY(scheduler->done());
+}
+
+/** @} */
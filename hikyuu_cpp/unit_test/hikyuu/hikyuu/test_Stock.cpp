@@ -177,6 +177,45 @@ TEST_CASE("test_Stock_getWeight") {
     MEMORY_CHECK;
 }
 
+/** @par 检测点 */
+TEST_CASE("test_Stock_getRecoverFactor") {
+    StockManager& sm = StockManager::instance();
+    Stock stock = sm.getStock("sz000001");
+
+    /** @arg 仅包含影响价格的权息信息 */
+    StockRecoverFactorList factors = stock.getRecoverFactor();
+    CHECK_LT(factors.size(), stock.getWeight().size());
+
+    /** @arg 查询指定日期范围内的复权因子 */
+    factors = stock.getRecoverFactor(Datetime(199501010000), Datetime(199701010000));
+    CHECK_EQ(factors.size(), 2);
+    CHECK_EQ(factors[0].datetime, Datetime(199509250000));
+    CHECK_EQ(factors[0].denominator, doctest::Approx(1.2));
+    CHECK_EQ(factors[0].adjust, doctest::Approx(-0.3));
+    CHECK_EQ(factors[1].datetime, Datetime(199605270000));
+    CHECK_EQ(factors[1].denominator, doctest::Approx(2.0));
+    CHECK_EQ(factors[1].adjust, doctest::Approx(0.0));
+
+    /** @arg 起始日期大于等于结束日期 */
+    CHECK_UNARY(
+      stock.getRecoverFactor(Datetime(199701010000), Datetime(199501010000)).empty());
+
+    /** @arg 重新设置权息信息后，复权因子随之更新 */
+    Stock tmp("SZ", "TEST01", "test");
+    CHECK_UNARY(tmp.getRecoverFactor().empty());
+    StockWeightList weights;
+    weights.push_back(StockWeight(Datetime(201001010000), 0, 0, 0, 0, 0, 100, 100));
+    weights.push_back(StockWeight(Datetime(201101010000), 0, 0, 0, 5.0, 0, 100, 100));
+    tmp.setWeightList(weights);
+    factors = tmp.getRecoverFactor();
+    CHECK_EQ(factors.size(), 1);
+    CHECK_EQ(factors[0].datetime, Datetime(201101010000));
+    CHECK_EQ(factors[0].denominator, doctest::Approx(1.0));
+    CHECK_EQ(factors[0].adjust, doctest::Approx(-0.5));
+    tmp.setWeightList(StockWeightList());
+    CHECK_UNARY(tmp.getRecoverFactor().empty());
+}
+
 /** @par 检测点 */
 TEST_CASE("test_Stock_getCount") {
     StockManager& sm = StockManager::instance();
@@ -2122,4 +2161,61 @@ TEST_CASE("test_Stock_getFinanceInfo") {
     MEMORY_CHECK;
 }
 
+/** @par 检测点 */
+TEST_CASE("test_Stock_realtimeUpdateFromSpot") {
+    StockManager& sm = StockManager::instance();
+    Stock stk = sm.getStock("sh600000");
+    stk.loadKDataToBuffer(KQuery::WEEK);
+    size_t total = stk.getCount(KQuery::WEEK);
+    CHECK_UNARY(total > 0);
+
+    /** @arg 同一交易日内的多次行情，成交金额、成交量为当日累计值，不重复累加 */
+    stk.realtimeUpdateFromSpot(
+      KRecord(Datetime(203001071000L), 10.0, 10.5, 9.8, 10.2, 100.0, 1000.0), KQuery::WEEK);
+    CHECK_EQ(stk.getCount(KQuery::WEEK), total + 1);
+    stk.realtimeUpdateFromSpot(
+      KRecord(Datetime(203001071400L), 10.0, 10.6, 9.8, 10.4, 150.0, 1500.0), KQuery::WEEK);
+    CHECK_EQ(stk.getCount(KQuery::WEEK), total + 1);
+    KRecord k = stk.getKRecord(total, KQuery::WEEK);
+    CHECK_EQ(k.datetime, Datetime(203001110000L));
+    CHECK_EQ(k.openPrice, doctest::Approx(10.0));
+    CHECK_EQ(k.highPrice, doctest::Approx(10.6));
+    CHECK_EQ(k.lowPrice, doctest::Approx(9.8));
+    CHECK_EQ(k.closePrice, doctest::Approx(10.4));
+    CHECK_EQ(k.transAmount, doctest::Approx(150.0));
+    CHECK_EQ(k.transCount, doctest::Approx(1500.0));
+
+    /** @arg 同一周期内的新交易日，上一交易日成交计入累计 */
+    stk.realtimeUpdateFromSpot(
+      KRecord(Datetime(203001081000L), 10.3, 10.4, 9.5, 10.0, 80.0, 800.0), KQuery::WEEK);
+    k = stk.getKRecord(total, KQuery::WEEK);
+    CHECK_EQ(k.openPrice, doctest::Approx(10.0));
+    CHECK_EQ(k.highPrice, doctest::Approx(10.6));
+    CHECK_EQ(k.lowPrice, doctest::Approx(9.5));
+    CHECK_EQ(k.closePrice, doctest::Approx(10.0));
+    CHECK_EQ(k.transAmount, doctest::Approx(230.0));
+    CHECK_EQ(k.transCount, doctest::Approx(2300.0));
+
+    /** @arg 新周期重新开始聚合 */
+    stk.realtimeUpdateFromSpot(
+      KRecord(Datetime(203001141000L), 11.0, 11.2, 10.9, 11.1, 50.0, 500.0), KQuery::WEEK);
+    CHECK_EQ(stk.getCount(KQuery::WEEK), total + 2);
+    k = stk.getKRecord(total + 1, KQuery::WEEK);
+    CHECK_EQ(k.datetime, Datetime(203001180000L));
+    CHECK_EQ(k.openPrice, doctest::Approx(11.0));
+    CHECK_EQ(k.transAmount, doctest::Approx(50.0));
+
+    /** @arg 重新加载缓存后，聚合状态从缓存重新同步 */
+    stk.loadKDataToBuffer(KQuery::WEEK);
+    CHECK_EQ(stk.getCount(KQuery::WEEK), total);
+    stk.realtimeUpdateFromSpot(
+      KRecord(Datetime(203001141000L), 11.0, 11.2, 10.9, 11.1, 60.0, 600.0), KQuery::WEEK);
+    CHECK_EQ(stk.getCount(KQuery::WEEK), total + 1);
+    k = stk.getKRecord(total, KQuery::WEEK);
+    CHECK_EQ(k.transAmount, doctest::Approx(60.0));
+
+    stk.releaseKDataBuffer(KQuery::WEEK);
+    CHECK_UNARY(!stk.isBuffer(KQuery::WEEK));
+}
+
 /** @} */
@@ -59,6 +59,71 @@ TEST_CASE("test_StockManager_getStock") {
     CHECK_EQ(stock.maxTradeNumber(), 1000000);
 }
 
+/** @par 检测点 */
+TEST_CASE("test_StockManager_getStockByDenseId") {
+    StockManager& sm = StockManager::instance();
+
+    /** @arg 未加入 StockManager 的证券无连续编号 */
+    CHECK_EQ(Stock().denseId(), Null<uint32_t>());
+    Stock tmp("SH", "999999", "tmp");
+    CHECK_EQ(tmp.denseId(), Null<uint32_t>());
+
+    /** @arg 连续编号可反查对应的证券 */
+    Stock stk = sm.getStock("sh000001");
+    uint32_t id = stk.denseId();
+    CHECK_LT(id, sm.denseIdCount());
+    CHECK_EQ(sm.getStockByDenseId(id), stk);
+    CHECK_EQ(sm.getStock("SH000001").denseId(), id);
+
+    /** @arg 全部证券的连续编号互不相同且均可反查 */
+    std::vector<char> used(sm.denseIdCount(), 0);
+    size_t total = 0;
+    for (const auto& s : sm) {
+        uint32_t sid = s.denseId();
+        CHECK_UNARY(sid < used.size());
+        if (sid < used.size()) {
+            CHECK_EQ(used[sid], 0);
+            used[sid] = 1;
+        }
+        CHECK_EQ(sm.getStockByDenseId(sid), s);
+        total++;
+    }
+    CHECK_EQ(total, sm.size());
+
+    /** @arg 无效编号 */
+    CHECK_UNARY(sm.getStockByDenseId(Null<uint32_t>()).isNull());
+    CHECK_UNARY(sm.getStockByDenseId(uint32_t(sm.denseIdCount())).isNull());
+}
+
+/** @par 检测点 */
+TEST_CASE("test_StockManager_getAllStockWeightList") {
+    StockManager& sm = StockManager::instance();
+    auto driver = sm.getBaseInfoDriver();
+    CHECK_UNARY(driver);
+
+    auto all_weights = driver->getAllStockWeightList();
+    CHECK_UNARY(!all_weights.empty());
+
+    /** @arg 批量读取的结果与逐个证券读取一致 */
+    for (auto code : {"SZ000001", "SH600000", "SH000001"}) {
+        Stock stk = sm.getStock(code);
+        StockWeightList expect =
+          driver->getStockWeightList(stk.market(), stk.code(), Datetime::min(), Null<Datetime>());
+        auto iter = all_weights.find(stk.market_code());
+        StockWeightList weights = iter != all_weights.end() ? iter->second : StockWeightList();
+        CHECK_EQ(weights.size(), expect.size());
+        CHECK_UNARY(weights == expect);
+        for (size_t i = 0; i < expect.size() && i < weights.size(); i++) {
+            CHECK_EQ(weights[i].bonus(), expect[i].bonus());
+            CHECK_EQ(weights[i].totalCount(), expect[i].totalCount());
+        }
+        CHECK_UNARY(stk.getWeight() == expect);
+    }
+
+    /** @arg 没有权息记录的证券不在结果中 */
+    CHECK_UNARY(all_weights.find("SZ999999") == all_weights.end());
+}
+
 /** @par 检测点 */
 TEST_CASE("test_StockManager_getMarketInfo") {
     StockManager& sm = StockManager::instance();
@@ -157,7 +222,30 @@ TEST_CASE("test_StockManager_getBlock") {
         Block result = sm.getBlock("地域板块", "陕西");
         CHECK_NE(result.size(), 0);
 
+        /** @arg 重复获取时使用缓存，且修改返回的板块不影响后续获取的结果 */
+        size_t total = result.size();
+        Stock stk = *result.begin();
+        result.remove(stk);
+        Block again = sm.getBlock("地域板块", "陕西");
+        CHECK_EQ(again.size(), total);
+        CHECK(again.have(stk));
+
+        /** @arg 不存在的板块返回空板块 */
+        result = sm.getBlock("地域板块", "不存在的板块");
+        CHECK_EQ(result.category(), "地域板块");
+        CHECK(result.empty());
+
         BlockList blk_list = sm.getBlockList("地域板块");
+        CHECK_NE(blk_list.size(), 0);
+        bool found = false;
+        for (auto iter = blk_list.begin(); iter != blk_list.end(); ++iter) {
+            if (iter->name() == "陕西") {
+                CHECK_EQ(iter->size(), total);
+                found = true;
+            }
+        }
+        CHECK(found);
+
         blk_list = sm.getBlockList();
         CHECK_NE(blk_list.size(), 0);
     }
@@ -232,10 +320,49 @@ TEST_CASE("test_StockManager_TempCsvStock") {
     CHECK_LT((record.transAmount - 21912127.0), 0.00001);
     CHECK_LT((record.transCount - 162719306.0), 0.00001);
 
+    /** @arg 临时加入的Stock分配有连续编号 */
+    uint32_t id = stk.denseId();
+    CHECK_EQ(sm.getStockByDenseId(id), stk);
+
     /** @arg 删除临时加入的Stock */
     sm.removeTempCsvStock("test");
     stk = sm.getStock("tmptest");
     CHECK_EQ(stk.isNull(), true);
+    CHECK_UNARY(sm.getStockByDenseId(id).isNull());
+}
+
+/** @par 检测点 */
+TEST_CASE("test_StockManager_getHistoryFinanceInfo") {
+    StockManager& sm = StockManager::instance();
+    StockList stk_list{sm.getStock("sh600000"), Stock(), sm.getStock("sz000001")};
+
+    /** @arg 报告期文件不存在 */
+    CHECK_UNARY(sm.getHistoryFinanceInfo(Datetime(201106300000), stk_list).empty());
+
+    /** @arg 各行与逐个证券查询的结果一致，无效证券整行为 Null */
+    PriceList result = sm.getHistoryFinanceInfo(Datetime(201109300000), stk_list);
+    PriceList expect = stk_list[0].getHistoryFinanceInfo(Datetime(201109300000));
+    size_t field_count = expect.size();
+    CHECK_EQ(field_count, 286);
+    CHECK_EQ(result.size(), stk_list.size() * field_count);
+    for (size_t i = 0; i < field_count; i++) {
+        if (expect[i] == Null<price_t>()) {
+            CHECK_EQ(result[i], Null<price_t>());
+        } else {
+            CHECK_EQ(result[i], doctest::Approx(expect[i]));
+        }
+        CHECK_EQ(result[field_count + i], Null<price_t>());
+    }
+    CHECK_EQ(result[0], doctest::Approx(1.067).epsilon(0.00001));
+    CHECK_EQ(result[14], doctest::Approx(7.87818e+09).epsilon(0.00001));
+
+    expect = stk_list[2].getHistoryFinanceInfo(Datetime(201109300000));
+    CHECK_EQ(expect.size(), field_count);
+    for (size_t i = 0; i < field_count; i++) {
+        if (expect[i] != Null<price_t>()) {
+            CHECK_EQ(result[2 * field_count + i], doctest::Approx(expect[i]));
+        }
+    }
 }
 
 /** @par 检测点 */
@@ -0,0 +1,143 @@
+/*
+ * test_TickBuffer.cpp
+ *
+ *  Created on: 2026-10-18
+ *      Author: fasiondog
+ */
+
+#include "doctest/doctest.h"
+#include <hikyuu/TickBuffer.h>
+
+using namespace hku;
+
+/**
+ * @defgroup test_hikyuu_TickBuffer test_hikyuu_TickBuffer
+ * @ingroup test_hikyuu_base_suite
+ * @{
+ */
+
+/** @par 检测点 */
+TEST_CASE("test_TickBuffer_ring") {
+    TickBuffer buffer(3);
+    CHECK_EQ(buffer.capacity(), 3);
+    CHECK_UNARY(buffer.empty());
+
+    Datetime d(2019, 2, 11, 9, 30);
+    CHECK_EQ(TickBuffer::fromTicks(TickBuffer::toTicks(d)), d);
+
+    /** @arg 未满时追加 */
+    for (int i = 0; i < 2; i++) {
+        buffer.push_back(TickBuffer::toTicks(d + Seconds(i)), 10.0 + i, 100.0 * (i + 1),
+                         TransRecord::BUY);
+    }
+    CHECK_EQ(buffer.size(), 2);
+    CHECK_EQ(buffer.price(0), 10.0);
+    CHECK_EQ(buffer.vol(1), 200.0);
+
+    /** @arg 写满后覆盖最早的记录 */
+    for (int i = 2; i < 5; i++) {
+        buffer.push_back(TickBuffer::toTicks(d + Seconds(i)), 10.0 + i, 100.0 * (i + 1),
+                         i % 2 ? TransRecord::SELL : TransRecord::BUY);
+    }
+    CHECK_EQ(buffer.size(), 3);
+    TransList trans = buffer.getTransList(0, buffer.size());
+    CHECK_EQ(trans.size(), 3);
+    CHECK_EQ(trans[0], TransRecord(d + Seconds(2), 12.0, 300.0, TransRecord::BUY));
+    CHECK_EQ(trans[1], TransRecord(d + Seconds(3), 13.0, 400.0, TransRecord::SELL));
+    CHECK_EQ(trans[2], TransRecord(d + Seconds(4), 14.0, 500.0, TransRecord::BUY));
+
+    /** @arg 跨越环形边界复制列 */
+    PriceList price(3), vol(2);
+    buffer.copyPrice(0, 3, price.data());
+    buffer.copyVol(1, 3, vol.data());
+    PriceList expect_price{12.0, 13.0, 14.0}, expect_vol{400.0, 500.0};
+    CHECK_EQ(price, expect_price);
+    CHECK_EQ(vol, expect_vol);
+
+    /** @arg 修改最后一条记录 */
+    buffer.updateBack(14.5, 600.0);
+    TimeLineList time_line = buffer.getTimeLineList(2, 10);
+    CHECK_EQ(time_line.size(), 1);
+    CHECK_EQ(time_line[0], TimeLineRecord(d + Seconds(4), 14.5, 600.0));
+
+    buffer.clear();
+    CHECK_UNARY(buffer.empty());
+    CHECK_EQ(buffer.getTransList(0, 3).size(), 0);
+}
+
+/** @par 检测点 */
+TEST_CASE("test_TickBuffer_getIndexRange") {
+    TickBuffer buffer(4);
+    size_t start = 0, end = 0;
+    CHECK_UNARY(!buffer.getIndexRange(KQuery(), start, end));
+
+    Datetime d(2019, 2, 11, 9, 30);
+    for (int i = 0; i < 6; i++) {
+        buffer.push_back(TickBuffer::toTicks(d + Minutes(i)), 10.0, 100.0);
+    }
+
+    /** @arg 按索引查询，支持负数 */
+    CHECK_UNARY(buffer.getIndexRange(KQuery(), start, end));
+    CHECK_EQ(start, 0);
+    CHECK_EQ(end, 4);
+    CHECK_UNARY(buffer.getIndexRange(KQuery(-3, -1), start, end));
+    CHECK_EQ(start, 1);
+    CHECK_EQ(end, 3);
+    CHECK_UNARY(buffer.getIndexRange(KQuery(2, 10), start, end));
+    CHECK_EQ(start, 2);
+    CHECK_EQ(end, 4);
+    CHECK_UNARY(!buffer.getIndexRange(KQuery(4), start, end));
+    CHECK_UNARY(!buffer.getIndexRange(KQuery(-3, 0), start, end));
+
+    /** @arg 按日期查询，缓存中最早的记录为 d + 2 分钟 */
+    CHECK_UNARY(buffer.getIndexRange(KQueryByDate(d), start, end));
+    CHECK_EQ(start, 0);
+    CHECK_EQ(end, 4);
+    CHECK_UNARY(buffer.getIndexRange(KQueryByDate(d + Minutes(3), d + Minutes(5)), start, end));
+    CHECK_EQ(start, 1);
+    CHECK_EQ(end, 3);
+    CHECK_UNARY(buffer.getIndexRange(KQueryByDate(d + Seconds(150)), start, end));
+    CHECK_EQ(start, 1);
+    CHECK_EQ(end, 4);
+    CHECK_UNARY(!buffer.getIndexRange(KQueryByDate(d, d + Minutes(2)), start, end));
+    CHECK_UNARY(!buffer.getIndexRange(KQueryByDate(d + Minutes(6)), start, end));
+    CHECK_UNARY(!buffer.getIndexRange(KQueryByDate(d + Minutes(4), d + Minutes(4)), start, end));
+}
+
+/** @par 检测点 */
+TEST_CASE("test_TickBuffer_covers") {
+    Datetime d(2019, 2, 11, 9, 30);
+    TickBuffer buffer(4);
+
+    /** @arg 未截断时，任意查询均可由缓存响应 */
+    for (int i = 0; i < 3; i++) {
+        buffer.push_back(TickBuffer::toTicks(d + Minutes(i)), 10.0, 100.0);
+    }
+    CHECK_UNARY(!buffer.truncated());
+    CHECK_UNARY(buffer.covers(KQuery()));
+    CHECK_UNARY(buffer.covers(KQuery(1, 2)));
+    CHECK_UNARY(buffer.covers(KQueryByDate(d - Minutes(10))));
+
+    /** @arg 写满后覆盖即截断，仅响应完全落在缓存范围内的查询，缓存中最早的记录为 d + 2 分钟 */
+    for (int i = 3; i < 6; i++) {
+        buffer.push_back(TickBuffer::toTicks(d + Minutes(i)), 10.0, 100.0);
+    }
+    CHECK_UNARY(buffer.truncated());
+    CHECK_UNARY(!buffer.covers(KQuery()));
+    CHECK_UNARY(!buffer.covers(KQuery(1, 2)));
+    CHECK_UNARY(!buffer.covers(KQuery(-5)));
+    CHECK_UNARY(!buffer.covers(KQuery(-3, 10)));
+    CHECK_UNARY(buffer.covers(KQuery(-4)));
+    CHECK_UNARY(buffer.covers(KQuery(-3, -1)));
+    CHECK_UNARY(!buffer.covers(KQueryByDate(d)));
+    CHECK_UNARY(!buffer.covers(KQueryByDate(d + Minutes(2))));
+    CHECK_UNARY(buffer.covers(KQueryByDate(d + Seconds(150), d + Minutes(4))));
+
+    /** @arg 清除后不再截断 */
+    buffer.clear();
+    CHECK_UNARY(!buffer.truncated());
+    buffer.setTruncated(true);
+    CHECK_UNARY(!buffer.covers(KQuery(-1)));
+}
+
+/** @} */
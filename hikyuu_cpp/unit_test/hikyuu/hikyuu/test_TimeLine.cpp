@@ -8,6 +8,8 @@
 #include "doctest/doctest.h"
 #include <hikyuu/StockManager.h>
 #include <hikyuu/Stock.h>
+#include <hikyuu/indicator/crt/TIMELINE.h>
+#include <hikyuu/indicator/crt/TIMELINEVOL.h>
 
 using namespace hku;
 
@@ -187,4 +189,72 @@ TEST_CASE("test_TimeLine_query_by_date") {
     CHECK_EQ(result[2], TimeLineRecord(Datetime(201902011459), 11.20, 20572));
 }
 
+/** @par 检测点 */
+TEST_CASE("test_TimeLine_buffer") {
+    StockManager& sm = StockManager::instance();
+    Stock stock = sm["sz000001"];
+    CHECK_UNARY(!stock.isTimeLineBuffer());
+
+    int max_num = sm.getPreloadParameter().tryGet<int>("timeline_max", 5120);
+    TimeLineList expect = stock.getTimeLineList(KQuery(-max_num));
+
+    /** @arg 缓存最近的分时数据，查询结果与数据驱动一致 */
+    stock.loadTimeLineToBuffer();
+    CHECK_UNARY(stock.isTimeLineBuffer());
+    TimeLineList result = stock.getTimeLineList(KQuery(-max_num));
+    CHECK_EQ(result.size(), expect.size());
+    CHECK_EQ(result.front(), expect.front());
+    CHECK_EQ(result.back(), expect.back());
+
+    result = stock.getTimeLineList(KQueryByDate(Datetime(201902011457), Datetime(201902011459)));
+    CHECK_EQ(result.size(), 2);
+    CHECK_EQ(result[0], TimeLineRecord(Datetime(201902011457), 11.20, 46));
+    CHECK_EQ(result[1], TimeLineRecord(Datetime(201902011458), 11.20, 0));
+
+    /** @arg TIMELINE、TIMELINEVOL 直接读取缓存 */
+    KData k = stock.getKData(KQuery(-3));
+    Indicator price = TIMELINE(k);
+    Indicator vol = TIMELINEVOL(k);
+    CHECK_EQ(price.size(), 3);
+    CHECK_EQ(vol.size(), 3);
+    CHECK_EQ(price[2], doctest::Approx(11.20));
+    CHECK_EQ(vol[0], doctest::Approx(46));
+    CHECK_EQ(vol[2], doctest::Approx(20572));
+
+    /** @arg 查询范围超出缓存时从数据驱动获取 */
+    CHECK_EQ(stock.getTimeLineList(KQuery()).size(), 10320);
+    result = stock.getTimeLineList(KQueryByDate(Datetime(201812030000)));
+    CHECK_EQ(result.size(), 10320);
+    CHECK_EQ(result[0], TimeLineRecord(Datetime(201812030930), 10.61, 83391));
+
+    /** @arg 首个实时行情与缓存中最后一条记录同一分钟时，接续更新该分钟 */
+    price_t day_vol = 0.0;
+    for (const auto& record : stock.getTimeLineList(KQueryByDate(Datetime(201902010000)))) {
+        day_vol += record.vol;
+    }
+    stock.realtimeUpdateTickFromSpot(KRecord(Datetime(201902011459) + Seconds(30), 11.20, 11.25,
+                                             11.20, 11.25, 0, day_vol + 100));
+    result = stock.getTimeLineList(KQuery(-1));
+    CHECK_EQ(result.size(), 1);
+    CHECK_EQ(result[0], TimeLineRecord(Datetime(201902011459), 11.25, 20672));
+
+    /** @arg 实时行情更新分时，同一分钟内更新最后一条记录 */
+    Datetime day(2019, 2, 12);
+    stock.realtimeUpdateTickFromSpot(
+      KRecord(day + Seconds(34210), 11.30, 11.30, 11.30, 11.30, 11300, 1000));
+    stock.realtimeUpdateTickFromSpot(
+      KRecord(day + Seconds(34240), 11.30, 11.35, 11.30, 11.35, 17000, 1500));
+    stock.realtimeUpdateTickFromSpot(
+      KRecord(day + Seconds(34265), 11.30, 11.35, 11.30, 11.32, 20400, 1800));
+    result = stock.getTimeLineList(KQuery(-2));
+    CHECK_EQ(result.size(), 2);
+    CHECK_EQ(result[0], TimeLineRecord(day + Minutes(570), 11.35, 1500));
+    CHECK_EQ(result[1], TimeLineRecord(day + Minutes(571), 11.32, 300));
+
+    /** @arg 释放缓存后从数据驱动获取 */
+    stock.releaseTimeLineBuffer();
+    CHECK_UNARY(!stock.isTimeLineBuffer());
+    CHECK_EQ(stock.getTimeLineList(KQuery()).size(), 10320);
+}
+
 /** @} */
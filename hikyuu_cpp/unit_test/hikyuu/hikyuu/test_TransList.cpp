@@ -187,4 +187,57 @@ TEST_CASE("test_TransList_query_by_date") {
     CHECK_EQ(result[2], TransRecord(Datetime(2019, 2, 11, 15, 0, 0), 11.21, 5794, TransRecord::AUCTION));
 }
 
+/** @par 检测点 */
+TEST_CASE("test_TransList_buffer") {
+    StockManager& sm = StockManager::instance();
+    Stock stock = sm["sz000001"];
+    CHECK_UNARY(!stock.isTransBuffer());
+
+    int max_num = sm.getPreloadParameter().tryGet<int>("ticks_max", 5120);
+    TransList expect = stock.getTransList(KQuery(-max_num));
+
+    /** @arg 缓存最近的分笔数据，查询结果与数据驱动一致 */
+    stock.loadTransToBuffer();
+    CHECK_UNARY(stock.isTransBuffer());
+    TransList result = stock.getTransList(KQuery(-max_num));
+    CHECK_EQ(result.size(), expect.size());
+    CHECK_EQ(result.front(), expect.front());
+    CHECK_EQ(result.back(), expect.back());
+
+    result = stock.getTransList(KQuery(-3, -1));
+    CHECK_EQ(result.size(), 2);
+    CHECK_EQ(result[0], TransRecord(Datetime(2019, 2, 11, 14, 56, 59), 11.20, 210, TransRecord::SELL));
+    CHECK_EQ(result[1], TransRecord(Datetime(2019, 2, 11, 14, 57, 2), 11.20, 31, TransRecord::SELL));
+
+    result = stock.getTransList(KQueryByDate(Datetime(2019, 2, 11, 14, 56, 59)));
+    CHECK_EQ(result.size(), 3);
+    CHECK_EQ(result[2], TransRecord(Datetime(2019, 2, 11, 15, 0, 0), 11.21, 5794, TransRecord::AUCTION));
+
+    /** @arg 查询范围超出缓存时从数据驱动获取 */
+    CHECK_EQ(stock.getTransList(KQuery()).size(), 8884);
+    result = stock.getTransList(KQuery(0, 1));
+    CHECK_EQ(result.size(), 1);
+    CHECK_EQ(result[0], TransRecord(Datetime(2019, 2, 1, 9, 25, 2), 11.20, 15714, TransRecord::AUCTION));
+
+    /** @arg 实时行情追加分笔，成交量为当日累计值之差 */
+    Datetime day(2019, 2, 12);
+    stock.realtimeUpdateTickFromSpot(
+      KRecord(day + Minutes(9 * 60 + 25), 11.25, 11.25, 11.25, 11.25, 112500, 10000));
+    stock.realtimeUpdateTickFromSpot(
+      KRecord(day + Minutes(9 * 60 + 30), 11.25, 11.30, 11.25, 11.30, 140750, 12500));
+    stock.realtimeUpdateTickFromSpot(
+      KRecord(day + Minutes(9 * 60 + 31), 11.25, 11.30, 11.20, 11.20, 151950, 13500));
+    result = stock.getTransList(KQuery(-3));
+    CHECK_EQ(result.size(), 3);
+    CHECK_EQ(result[0],
+             TransRecord(day + Minutes(9 * 60 + 25), 11.25, 10000, TransRecord::AUCTION));
+    CHECK_EQ(result[1], TransRecord(day + Minutes(9 * 60 + 30), 11.30, 2500, TransRecord::BUY));
+    CHECK_EQ(result[2], TransRecord(day + Minutes(9 * 60 + 31), 11.20, 1000, TransRecord::SELL));
+
+    /** @arg 释放缓存后从数据驱动获取 */
+    stock.releaseTransBuffer();
+    CHECK_UNARY(!stock.isTransBuffer());
+    CHECK_EQ(stock.getTransList(KQuery()).size(), 8884);
+}
+
 /** @} */
@@ -696,4 +696,26 @@ TEST_CASE("test_LOGIC_OR") {
     CHECK_EQ(result.size(), 0);
 }
 
+/** @par 检测点 */
+TEST_CASE("test_Indicator_data") {
+    /** @arg 空指标 */
+    Indicator ind;
+    CHECK_UNARY(ind.data() == nullptr);
+
+    /** @arg 数据地址连续，与 get 一致 */
+    PriceList d;
+    for (size_t i = 0; i < 10; ++i) {
+        d.push_back(i);
+    }
+    ind = PRICELIST(d);
+    const price_t* data = ind.data();
+    CHECK_UNARY(data != nullptr);
+    for (size_t i = 0; i < ind.size(); ++i) {
+        CHECK_EQ(data[i], ind.get(i));
+    }
+
+    /** @arg 结果集不存在 */
+    CHECK_UNARY(ind.data(1) == nullptr);
+}
+
 /** @} */
@@ -166,6 +166,54 @@ TEST_CASE("test_MA_export") {
         CHECK_EQ(ma1[i], doctest::Approx(ma2[i]));
     }
 }
+
+#if HKU_SUPPORT_BINARY_ARCHIVE
+/** @par 检测点 */
+TEST_CASE("test_MA_binary_export") {
+    StockManager& sm = StockManager::instance();
+    string filename(sm.tmpdir());
+    filename += "/MA.bin";
+
+    Stock stock = sm.getStock("sh000001");
+    KData kdata = stock.getKData(KQuery(-20));
+    Indicator ma1 = MA(CLOSE(kdata), 10);
+
+    /** @arg 二进制存档按位保存 nan、inf */
+    PriceList values{1.0, Null<price_t>(), std::numeric_limits<price_t>::infinity(), -0.5};
+    Indicator p1 = PRICELIST(values);
+    {
+        std::ofstream ofs(filename, std::ios::binary);
+        boost::archive::binary_oarchive oa(ofs);
+        oa << BOOST_SERIALIZATION_NVP(ma1);
+        oa << BOOST_SERIALIZATION_NVP(p1);
+    }
+
+    Indicator ma2, p2;
+    {
+        std::ifstream ifs(filename, std::ios::binary);
+        boost::archive::binary_iarchive ia(ifs);
+        ia >> BOOST_SERIALIZATION_NVP(ma2);
+        ia >> BOOST_SERIALIZATION_NVP(p2);
+    }
+
+    CHECK_EQ(ma2.name(), "MA");
+    CHECK_EQ(ma1.size(), ma2.size());
+    CHECK_EQ(ma1.discard(), ma2.discard());
+    CHECK_EQ(ma1.getResultNumber(), ma2.getResultNumber());
+    for (size_t i = 0; i < ma1.size(); ++i) {
+        CHECK_EQ(ma1[i], ma2[i]);
+    }
+
+    CHECK_EQ(p1.size(), p2.size());
+    for (size_t i = 0; i < p1.size(); ++i) {
+        if (std::isnan(p1[i])) {
+            CHECK_UNARY(std::isnan(p2[i]));
+        } else {
+            CHECK_EQ(p1[i], p2[i]);
+        }
+    }
+}
+#endif /* HKU_SUPPORT_BINARY_ARCHIVE */
 #endif /* #if HKU_SUPPORT_SERIALIZATION */
 
 /** @} */
@@ -0,0 +1,112 @@
+/*
+ * test_SpotTable.cpp
+ *
+ *  Created on: 2026-10-18
+ *      Author: fasiondog
+ */
+
+#include "doctest/doctest.h"
+#include <thread>
+#include <hikyuu/StockManager.h>
+#include <hikyuu/strategy/SpotTable.h>
+
+using namespace hku;
+
+/**
+ * @defgroup test_hikyuu_SpotTable test_hikyuu_SpotTable
+ * @ingroup test_hikyuu_base_suite
+ * @{
+ */
+
+static SpotRecord makeSpot(const string& market, const string& code, price_t value) {
+    SpotRecord spot;
+    spot.market = market;
+    spot.code = code;
+    spot.datetime = Datetime(202101040930L);
+    spot.yesterday_close = spot.open = spot.high = spot.low = spot.close = value;
+    spot.amount = spot.volumn = value;
+    spot.bid1 = spot.bid1_amount = spot.bid2 = spot.bid2_amount = spot.bid3 = value;
+    spot.bid3_amount = spot.bid4 = spot.bid4_amount = spot.bid5 = spot.bid5_amount = value;
+    spot.ask1 = spot.ask1_amount = spot.ask2 = spot.ask2_amount = spot.ask3 = value;
+    spot.ask3_amount = spot.ask4 = spot.ask4_amount = spot.ask5 = spot.ask5_amount = value;
+    return spot;
+}
+
+/** @par 检测点 */
+TEST_CASE("test_SpotTable") {
+    StockManager& sm = StockManager::instance();
+    SpotTable table;
+    table.init({sm["sh600000"], sm["sz000001"], Stock(), sm["sh600000"]});
+
+    /** @arg 无效及重复的证券被忽略 */
+    CHECK_EQ(table.size(), 2);
+    CHECK_EQ(table.getSlot(sm["sz000001"]), 1);
+    CHECK_EQ(table.getSlot(sm["sh600004"]), Null<size_t>());
+
+    /** @arg 尚无行情 */
+    SpotRecord spot;
+    CHECK_UNARY(!table.get(0, spot));
+    CHECK_UNARY(!table.get(5, spot));
+    vector<size_t> changed;
+    table.collectChanged(changed);
+    CHECK_UNARY(changed.empty());
+
+    /** @arg 更新及读取，市场简称不区分大小写 */
+    CHECK_UNARY(table.update(makeSpot("sz", "000001", 10.0)));
+    CHECK_UNARY(!table.update(makeSpot("SH", "600004", 10.0)));
+    CHECK_UNARY(table.get(1, spot));
+    CHECK_EQ(spot.market, "SZ");
+    CHECK_EQ(spot.code, "000001");
+    CHECK_EQ(spot.datetime, Datetime(202101040930L));
+    CHECK_EQ(spot.close, 10.0);
+    CHECK_EQ(spot.ask5_amount, 10.0);
+
+    /** @arg 仅返回自上次调用以来有更新的槽位 */
+    table.collectChanged(changed);
+    CHECK_EQ(changed, vector<size_t>{1});
+    table.collectChanged(changed);
+    CHECK_UNARY(changed.empty());
+    table.update(makeSpot("SH", "600000", 11.0));
+    table.update(makeSpot("SZ", "000001", 12.0));
+    table.collectChanged(changed);
+    vector<size_t> expect{0, 1};
+    CHECK_EQ(changed, expect);
+
+    /** @arg 按连续编号定位槽位，不在表中的编号直接忽略 */
+    spot = makeSpot("XX", "000000", 13.0);
+    spot.stock_id = sm["sz000001"].denseId();
+    CHECK_UNARY(table.update(spot));
+    CHECK_UNARY(table.get(1, spot));
+    CHECK_EQ(spot.close, 13.0);
+    spot = makeSpot("SH", "600004", 13.0);
+    spot.stock_id = sm["sh600004"].denseId();
+    CHECK_UNARY(!table.update(spot));
+
+    /** @arg 各槽位分别由一个线程并发写入时，读取到的快照各字段一致 */
+    std::atomic_bool stop = false;
+    std::vector<std::thread> writers;
+    for (size_t slot = 0; slot < 2; slot++) {
+        writers.emplace_back([&table, &stop, slot]() {
+            for (int i = 0; !stop; i++) {
+                table.update(slot, makeSpot("SH", "600000", price_t(i)));
+            }
+        });
+    }
+    bool consistent = true;
+    for (int i = 0; i < 10000; i++) {
+        for (size_t slot = 0; slot < 2; slot++) {
+            table.get(slot, spot);
+            if (spot.open != spot.close || spot.amount != spot.close ||
+                spot.ask5_amount != spot.close || spot.bid1 != spot.close) {
+                consistent = false;
+            }
+        }
+    }
+    stop = true;
+    for (auto& w : writers) {
+        w.join();
+    }
+    CHECK_UNARY(consistent);
+}
+
+/** @} */
@@ -0,0 +1,103 @@
+/*
+ * test_Performance.cpp
+ *
+ *  Created on: 2026-10-18
+ *      Author: fasiondog
+ */
+
+#include "doctest/doctest.h"
+#include <hikyuu/StockManager.h>
+#include <hikyuu/trade_manage/crt/TC_TestStub.h>
+#include <hikyuu/trade_manage/crt/crtTM.h>
+#include <hikyuu/trade_manage/Performance.h>
+
+using namespace hku;
+
+/**
+ * @defgroup test_Performance test_Performance
+ * @ingroup test_hikyuu_trade_manage_suite
+ * @{
+ */
+
+static TradeManagerPtr make_performance_tm() {
+    StockManager& sm = StockManager::instance();
+    Stock stock = sm.getStock("sh600000");
+    TradeManagerPtr tm = crtTM(Datetime(199901010000), 100000, TC_TestStub());
+    tm->setParam<bool>("reinvest", false);
+    tm->buy(Datetime(199911170000), stock, 27.18, 1000, 27.0, 27.18, 27.18);
+    tm->sell(Datetime(199912010000), stock, 28.0, 1000);
+    tm->buy(Datetime(200007050000), stock, 23.24, 1000, 23.11, 23.25, 23.23);
+    tm->sell(Datetime(200008010000), stock, 22.0, 1000);
+    tm->buy(Datetime(200009010000), stock, 22.5, 500, 22.0, 22.5, 22.5);
+    return tm;
+}
+
+/** @par 检测点 */
+TEST_CASE("test_TradeManager_getFundsList") {
+    TradeManagerPtr tm = make_performance_tm();
+    DatetimeList dates = StockManager::instance().getTradingCalendar(
+      KQueryByDate(Datetime(199911010000), Datetime(200012310000), KQuery::DAY));
+    dates.push_back(Null<Datetime>());
+
+    /** @arg 与逐日调用 getFunds 结果一致 */
+    FundsRecordList funds_list = tm->getFundsList(dates);
+    CHECK_EQ(funds_list.size(), dates.size());
+    for (size_t i = 0, total = dates.size(); i < total; i++) {
+        CHECK_EQ(funds_list[i], tm->getFunds(dates[i]));
+    }
+
+    /** @arg 日期无序时，结果仍与逐日调用 getFunds 一致 */
+    DatetimeList unsorted(dates.rbegin(), dates.rend());
+    std::swap(unsorted[1], unsorted[unsorted.size() / 2]);
+    funds_list = tm->getFundsList(unsorted);
+    CHECK_EQ(funds_list.size(), unsorted.size());
+    for (size_t i = 0, total = unsorted.size(); i < total; i++) {
+        CHECK_EQ(funds_list[i], tm->getFunds(unsorted[i]));
+    }
+
+    /** @arg 空日期列表 */
+    CHECK_UNARY(tm->getFundsList(DatetimeList()).empty());
+}
+
+/** @par 检测点 */
+TEST_CASE("test_Performance_statistics") {
+    TradeManagerPtr tm = make_performance_tm();
+    Datetime end_date(200012310000);
+
+    Performance per;
+    per.statistics(tm, end_date);
+    CHECK_EQ(per["帐户初始金额"], doctest::Approx(100000.0));
+    CHECK_EQ(per["已平仓交易总数"], doctest::Approx(2.0));
+    CHECK_EQ(per["赢利交易数"], doctest::Approx(1.0));
+    CHECK_EQ(per["亏损交易数"], doctest::Approx(1.0));
+    CHECK_GT(per["最大回撤%"], 0.0);
+    CHECK_GT(per["年化波动率%"], 0.0);
+    CHECK_GT(per["年化换手率"], 0.0);
+    CHECK_EQ(per["当前总资产"], doctest::Approx(tm->getFunds(end_date).cash +
+                                                 tm->getFunds(end_date).market_value));
+
+    /** @arg 直接使用交易记录及每日资产计算，与从交易管理实例计算结果一致 */
+    DatetimeList dates = StockManager::instance().getTradingCalendar(
+      KQueryByDate(tm->initDatetime(), end_date, KQuery::DAY));
+    dates.push_back(end_date);
+    FundsRecordList funds_list = tm->getFundsList(dates);
+
+    Performance stream_per;
+    stream_per.statistics(tm->getTradeList(), tm->getHistoryPositionList(), dates, funds_list,
+                          end_date, tm->precision());
+    const char* names[] = {"当前总资产", "已平仓净利润总额", "赢利交易赢利总额",
+                           "亏损交易亏损总额", "空仓总时间", "最长空仓时间",
+                           "最大连续赢利金额", "R乘数期望值", "最大回撤%",
+                           "年化波动率%", "夏普比率", "年化换手率"};
+    for (auto name : names) {
+        CHECK_EQ(stream_per[name], doctest::Approx(per[name]));
+    }
+
+    /** @arg 日期列表与资产列表长度不一致 */
+    funds_list.pop_back();
+    stream_per.statistics(tm->getTradeList(), tm->getHistoryPositionList(), dates, funds_list,
+                          end_date, tm->precision());
+    CHECK_EQ(stream_per["已平仓交易总数"], 0.0);
+}
+
+/** @} */
@@ -11,6 +11,8 @@
 #include <fstream>
 #include <boost/archive/xml_oarchive.hpp>
 #include <boost/archive/xml_iarchive.hpp>
+#include <boost/archive/binary_oarchive.hpp>
+#include <boost/archive/binary_iarchive.hpp>
 #include <hikyuu/StockManager.h>
 #include <hikyuu/trade_manage/TradeManager.h>
 #include <hikyuu/trade_manage/crt/crtTM.h>
@@ -88,6 +90,39 @@ TEST_CASE("test_TradeRecord_export") {
     CHECK_EQ(record1, record2);
 }
 
+/** @par 检测点 */
+TEST_CASE("test_TradeRecordList_binary_export") {
+    StockManager& sm = StockManager::instance();
+    string filename(sm.tmpdir());
+    filename += "/TradeRecordList.bin";
+
+    TradeRecordList list1;
+    list1.push_back(TradeRecord(sm.getStock("sh600000"), Datetime(201305011935), BUSINESS_BUY,
+                                10.0, 10.13, 20.15, 1000, CostRecord(), 9.77, 99998.1,
+                                PART_SIGNAL));
+    list1.push_back(TradeRecord(sm.getStock("sz000001"), Datetime(201305021935), BUSINESS_SELL,
+                                11.0, 11.13, 0.0, 500, CostRecord(), 0.0, 105563.1,
+                                PART_STOPLOSS));
+    {
+        std::ofstream ofs(filename, std::ios::binary);
+        boost::archive::binary_oarchive oa(ofs);
+        oa << BOOST_SERIALIZATION_NVP(list1);
+    }
+
+    TradeRecordList list2;
+    {
+        std::ifstream ifs(filename, std::ios::binary);
+        boost::archive::binary_iarchive ia(ifs);
+        ia >> BOOST_SERIALIZATION_NVP(list2);
+    }
+
+    CHECK_EQ(list2.size(), 2);
+    CHECK_EQ(list1[0], list2[0]);
+    CHECK_EQ(list1[1], list2[1]);
+    CHECK_EQ(list2[1].business, BUSINESS_SELL);
+    CHECK_EQ(list2[1].from, PART_STOPLOSS);
+}
+
 /** @par 检测点 */
 TEST_CASE("test_PositionRecord_export") {
     StockManager& sm = StockManager::instance();
@@ -58,4 +58,61 @@ TEST_CASE("test_AllocateFunds") {
     /** @arg 最大持仓系统数为0 */
 }
 
+/** @par 检测点 */
+TEST_CASE("test_AllocateFunds_sortTopWeight") {
+    SystemList sys_list;
+    for (int i = 0; i < 5; i++) {
+        sys_list.push_back(SYS_Simple());
+    }
+
+    /** @arg 按权重从大到小排列前 top_num 个，等权重时保持原有先后 */
+    SystemWeightList sw_list{{sys_list[0], 0.5}, {sys_list[1], 1.0}, {sys_list[2], 0.5},
+                             {sys_list[3], 1.0}, {sys_list[4], 0.2}};
+    AllocateFundsBase::_sortTopWeight(sw_list, 3);
+    CHECK_EQ(sw_list.size(), 5);
+    CHECK_EQ(sw_list[0].getSYS(), sys_list[1]);
+    CHECK_EQ(sw_list[1].getSYS(), sys_list[3]);
+    CHECK_EQ(sw_list[2].getSYS(), sys_list[0]);
+
+    /** @arg top_num 超出列表长度时全部排序 */
+    sw_list = {{sys_list[0], 0.5}, {sys_list[1], 1.0}, {sys_list[2], 0.5}};
+    AllocateFundsBase::_sortTopWeight(sw_list, 10);
+    CHECK_EQ(sw_list[0].getSYS(), sys_list[1]);
+    CHECK_EQ(sw_list[1].getSYS(), sys_list[0]);
+    CHECK_EQ(sw_list[2].getSYS(), sys_list[2]);
+}
+
+/** @par 检测点 */
+TEST_CASE("test_AllocateFunds_getSubFunds") {
+    StockManager& sm = StockManager::instance();
+    Stock stk = sm["sh600000"];
+    AFPtr af = AF_EqualWeight();
+    SYSPtr sys = SYS_Simple(crtTM(Datetime(200101010000L), 100000));
+    TMPtr sub_tm = sys->getTM();
+    Datetime date(201101040000L);
+
+    auto expect = [&]() {
+        FundsRecord funds = sub_tm->getFunds(KQuery::DAY);
+        return funds.cash + funds.market_value + funds.borrow_asset - funds.short_market_value;
+    };
+
+    /** @arg 空仓时资产净值为现金 */
+    CHECK_EQ(af->_getSubFunds(sys, date, KQuery::DAY), doctest::Approx(100000));
+
+    /** @arg 买入后重新计算 */
+    size_t trade_count = sub_tm->getTradeCount();
+    CHECK_UNARY(!sub_tm->buy(date, stk, 10.0, 1000).isNull());
+    CHECK_EQ(sub_tm->getTradeCount(), trade_count + 1);
+    price_t value = af->_getSubFunds(sys, date, KQuery::DAY);
+    CHECK_EQ(value, doctest::Approx(expect()));
+    CHECK_EQ(af->_getSubFunds(sys, date, KQuery::DAY), value);
+
+    /** @arg 同日存入已持有的股票，现金及持仓股票数不变，仍需重新计算 */
+    CHECK_UNARY(sub_tm->checkinStock(date, stk, 10.0, 1000));
+    CHECK_EQ(sub_tm->getStockNumber(), 1);
+    price_t new_value = af->_getSubFunds(sys, date, KQuery::DAY);
+    CHECK_EQ(new_value, doctest::Approx(expect()));
+    CHECK_GT(new_value, value);
+}
+
 /** @} */
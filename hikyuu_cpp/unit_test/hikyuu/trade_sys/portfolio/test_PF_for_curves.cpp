@@ -0,0 +1,91 @@
+/*
+ * test_PF_for_curves.cpp
+ *
+ *  Created on: 2026-10-18
+ *      Author: fasiondog
+ */
+
+#include "doctest/doctest.h"
+#include <hikyuu/StockManager.h>
+#include <hikyuu/trade_manage/crt/crtTM.h>
+#include <hikyuu/trade_sys/portfolio/crt/PF_Simple.h>
+#include <hikyuu/trade_sys/selector/crt/SE_Fixed.h>
+#include <hikyuu/trade_sys/allocatefunds/crt/AF_EqualWeight.h>
+
+#include <hikyuu/trade_sys/system/crt/SYS_Simple.h>
+#include <hikyuu/trade_sys/signal/crt/SG_CrossGold.h>
+#include <hikyuu/trade_sys/moneymanager/crt/MM_FixedCount.h>
+#include <hikyuu/indicator/crt/EMA.h>
+
+using namespace hku;
+
+/**
+ * @defgroup test_Portfolio test_Portfolio
+ * @ingroup test_hikyuu_trade_sys_suite
+ * @{
+ */
+
+/** @par 检测点 资产组合曲线与各子账户曲线之和一致 */
+TEST_CASE("test_PF_for_curves") {
+    StockManager& sm = StockManager::instance();
+
+    SYSPtr sys = SYS_Simple();
+    sys->setSG(SG_CrossGold(EMA(12), EMA(26)));
+    sys->setMM(MM_FixedCount(100));
+
+    TMPtr tm = crtTM(Datetime(199001010000L), 500000);
+    SEPtr se = SE_Fixed();
+    se->addStockList({sm["sz000001"], sm["sz000063"], sm["sz000651"]}, sys);
+    AFPtr af = AF_EqualWeight();
+    PFPtr pf = PF_Simple(tm, se, af);
+
+    KQuery query = KQueryByDate(Datetime(201101010000L), Datetime(201201010000L), KQuery::DAY);
+    pf->run(query);
+
+    DatetimeList dates = sm.getTradingCalendar(
+      KQueryByDate(Datetime(201012010000L), Datetime(201203010000L), KQuery::DAY));
+    PortfolioCurves curves = pf->getCurves(dates);
+    CHECK_EQ(curves.funds.size(), dates.size());
+    CHECK_EQ(curves.profit.size(), dates.size());
+    CHECK_EQ(curves.sys_list.size(), pf->getAllSystem().size());
+    CHECK_EQ(curves.sys_funds.size(), curves.sys_list.size());
+
+    /** @arg 各子系统资产曲线与子账户计算结果一致 */
+    PriceList expect_funds(dates.size()), expect_profit(dates.size());
+    for (size_t i = 0; i < curves.sys_list.size(); i++) {
+        TMPtr sub_tm = curves.sys_list[i]->getTM();
+        PriceList funds = sub_tm->getFundsCurve(dates);
+        PriceList profit = sub_tm->getProfitCurve(dates);
+        for (size_t j = 0; j < dates.size(); j++) {
+            CHECK_EQ(curves.sys_funds[i][j], doctest::Approx(funds[j]));
+            expect_funds[j] += funds[j];
+            expect_profit[j] += profit[j];
+        }
+    }
+
+    /** @arg 资产组合曲线为各子账户曲线之和 */
+    for (size_t i = 0; i < dates.size(); i++) {
+        CHECK_EQ(curves.funds[i], doctest::Approx(expect_funds[i]));
+        CHECK_EQ(curves.profit[i], doctest::Approx(expect_profit[i]));
+    }
+
+    PriceList funds = pf->getFundsCurve(dates);
+    CHECK_EQ(funds.size(), dates.size());
+    for (size_t i = 0; i < dates.size(); i++) {
+        CHECK_EQ(funds[i], doctest::Approx(curves.funds[i]));
+    }
+
+    /** @arg 日期列表无序且末尾为 Null 时，与子账户计算结果仍一致 */
+    DatetimeList unsorted_dates(dates.rbegin(), dates.rend());
+    unsorted_dates.push_back(Null<Datetime>());
+    curves = pf->getCurves(unsorted_dates);
+    CHECK_EQ(curves.funds.size(), unsorted_dates.size());
+    for (size_t i = 0; i < curves.sys_list.size(); i++) {
+        PriceList funds = curves.sys_list[i]->getTM()->getFundsCurve(unsorted_dates);
+        for (size_t j = 0; j < unsorted_dates.size(); j++) {
+            CHECK_EQ(curves.sys_funds[i][j], doctest::Approx(funds[j]));
+        }
+    }
+}
+
+/** @} */
@@ -0,0 +1,127 @@
+/*
+ * test_Simple_SYS_for_fast.cpp
+ *
+ *  Created on: 2026-10-18
+ *      Author: fasiondog
+ */
+
+#include "doctest/doctest.h"
+#include "test_sys.h"
+#include <hikyuu/StockManager.h>
+#include <hikyuu/indicator/crt/MA.h>
+#include <hikyuu/trade_manage/crt/crtTM.h>
+#include <hikyuu/trade_sys/system/crt/SYS_Simple.h>
+#include <hikyuu/trade_sys/signal/crt/SG_Cross.h>
+#include <hikyuu/trade_sys/moneymanager/crt/MM_FixedCount.h>
+#include <hikyuu/trade_sys/stoploss/crt/ST_FixedPercent.h>
+#include <hikyuu/trade_sys/stoploss/crt/ST_Indicator.h>
+#include <hikyuu/trade_sys/profitgoal/crt/PG_FixedPercent.h>
+#include <hikyuu/trade_sys/profitgoal/crt/PG_FixedHoldDays.h>
+
+using namespace hku;
+
+/**
+ * @defgroup test_SYS_Simple test_SYS_Simple
+ * @ingroup test_hikyuu_trade_sys_suite
+ * @{
+ */
+
+static void check_same_trade_list(const TradeRecordList& x, const TradeRecordList& y) {
+    CHECK_EQ(x.size(), y.size());
+    size_t total = std::min(x.size(), y.size());
+    for (size_t i = 0; i < total; i++) {
+        CHECK_EQ(x[i].stock, y[i].stock);
+        CHECK_EQ(x[i].datetime, y[i].datetime);
+        CHECK_EQ(x[i].business, y[i].business);
+        CHECK_EQ(x[i].number, y[i].number);
+        CHECK_EQ(x[i].from, y[i].from);
+        CHECK_LT(std::fabs(x[i].realPrice - y[i].realPrice), 0.00001);
+        CHECK_LT(std::fabs(x[i].planPrice - y[i].planPrice), 0.00001);
+        CHECK_LT(std::fabs(x[i].cash - y[i].cash), 0.00001);
+        if (std::isnan(x[i].stoploss)) {
+            CHECK_UNARY(std::isnan(y[i].stoploss));
+        } else {
+            CHECK_LT(std::fabs(x[i].stoploss - y[i].stoploss), 0.00001);
+        }
+        if (std::isnan(x[i].goalPrice)) {
+            CHECK_UNARY(std::isnan(y[i].goalPrice));
+        } else {
+            CHECK_LT(std::fabs(x[i].goalPrice - y[i].goalPrice), 0.00001);
+        }
+    }
+}
+
+static void check_fast_run(const SYSPtr& sys, const Stock& stk, const KQuery& query) {
+    SYSPtr normal = sys->clone();
+    normal->setParam<bool>("fast_run", false);
+    normal->run(stk, query);
+
+    SYSPtr fast = sys->clone();
+    fast->setParam<bool>("fast_run", true);
+    fast->run(stk, query);
+
+    check_same_trade_list(normal->getTM()->getTradeList(), fast->getTM()->getTradeList());
+    check_same_trade_list(normal->getTradeRecordList(), fast->getTradeRecordList());
+    CHECK_EQ(normal->haveDelayRequest(), fast->haveDelayRequest());
+}
+
+/** @par 检测点（快速回测与逐Bar回测结果一致） */
+TEST_CASE("test_SYS_Simple_for_fast") {
+    StockManager& sm = StockManager::instance();
+
+    Datetime init_date(199001010000LL);
+    price_t init_cash = 100000;
+    Stock stk = sm["sh600000"];
+
+    TMPtr tm = crtTM(init_date, init_cash, TC_Zero(), "TEST_TM");
+    SGPtr sg = SG_Cross(MA(5), MA(10), "CLOSE");
+    MMPtr mm = MM_FixedCount(100);
+    STPtr st = ST_FixedPercent(0.01);
+    TPPtr tp = ST_Indicator(MA(5), "CLOSE");
+
+    KQuery query = KQuery(-1000);
+    KQuery date_query =
+      KQueryByDate(Datetime(199911100000LL), Datetime(200002250000LL), KQuery::DAY);
+
+    SYSPtr sys;
+    for (int delay = 0; delay < 2; delay++) {
+        /** @arg 只有信号指示器 */
+        sys = SYS_Simple(tm, mm, EVPtr(), CNPtr(), sg);
+        sys->setParam<bool>("delay", delay);
+        check_fast_run(sys, stk, query);
+
+        /** @arg 止损、止盈 */
+        sys = SYS_Simple(tm, mm, EVPtr(), CNPtr(), sg, st, tp);
+        sys->setParam<bool>("delay", delay);
+        check_fast_run(sys, stk, query);
+
+        /** @arg 止损、止盈、盈利目标 */
+        sys = SYS_Simple(tm, mm, EVPtr(), CNPtr(), sg, st, tp, PG_FixedPercent(0.05));
+        sys->setParam<bool>("delay", delay);
+        check_fast_run(sys, stk, query);
+
+        sys = SYS_Simple(tm, mm, EVPtr(), CNPtr(), sg, STPtr(), STPtr(), PG_FixedHoldDays(5));
+        sys->setParam<bool>("delay", delay);
+        check_fast_run(sys, stk, query);
+
+        /** @arg 市场环境、系统有效条件 */
+        EVPtr ev = make_shared<TestEV2>();
+        CNPtr cn = make_shared<TestCN2>();
+        sys = SYS_Simple(tm, mm, ev, CNPtr(), sg, st);
+        sys->setParam<bool>("delay", delay);
+        check_fast_run(sys, stk, date_query);
+
+        sys = SYS_Simple(tm, mm, EVPtr(), cn, sg, st);
+        sys->setParam<bool>("delay", delay);
+        check_fast_run(sys, stk, date_query);
+
+        /** @arg 使用市场环境、系统有效条件建仓 */
+        sys = SYS_Simple(tm, mm, ev, cn, sg, st, tp);
+        sys->setParam<bool>("delay", delay);
+        sys->setParam<bool>("ev_open_position", true);
+        sys->setParam<bool>("cn_open_position", true);
+        check_fast_run(sys, stk, date_query);
+    }
+}
+
+/** @} */
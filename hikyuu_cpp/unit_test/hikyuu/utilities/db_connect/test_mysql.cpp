@@ -179,4 +179,69 @@ TEST_CASE("test_mysql") {
 
     con->exec("drop database if exists test;");
 }
+
+TEST_CASE("test_mysql_batch_save_multi_row") {
+    Parameter param;
+    param.set<string>("host", HOST);
+    param.set<int>("port", 3306);
+    param.set<string>("usr", "root");
+    param.set<string>("pwd", PASSWORD);
+    param.set<int>("batch_insert_size", 2);
+    auto con = std::make_shared<MySQLConnect>(param);
+    con->exec("create database if not exists test; use test;");
+    con->exec(
+      "create table if not exists ttt_multi (id INTEGER PRIMARY KEY AUTO_INCREMENT, name "
+      "VARCHAR(50), age INT)");
+
+    class TTT {
+        TABLE_BIND2(ttt_multi, name, age)
+    public:
+        TTT() {}
+        TTT(const string& name, int age) : name(name), age(age) {}
+        string name;
+        int age;
+    };
+
+    /** @arg 按 batch_insert_size 分块以多行 INSERT 插入，并回填 id */
+    vector<TTT> t_list;
+    for (int i = 0; i < 5; i++) {
+        t_list.push_back(TTT(fmt::format("n{}", i), i));
+    }
+    con->batchSave(t_list);
+
+    vector<TTT> r_list;
+    con->batchLoad(r_list, "1=1 order by id");
+    CHECK(r_list.size() == 5);
+    for (int i = 0; i < 5; i++) {
+        CHECK(r_list[i].id() == t_list[i].id());
+        CHECK(r_list[i].name == t_list[i].name);
+        CHECK(r_list[i].age == i);
+    }
+
+    /** @arg 相同的带参数 SELECT 复用缓存，再次执行时结果重新绑定 */
+    CHECK(con->getStatementCacheCount() > 0);
+    string sql("select name, age from ttt_multi where age>=? order by age");
+    SQLStatementBase* raw = nullptr;
+    for (int start : {1, 3}) {
+        SQLStatementPtr st = con->getStatement(sql);
+        if (raw) {
+            CHECK(st.get() == raw);
+        }
+        raw = st.get();
+        st->bind(0, start);
+        st->exec();
+        int count = 0;
+        while (st->moveNext()) {
+            string name;
+            int age = 0;
+            st->getColumn(0, name, age);
+            CHECK(name == fmt::format("n{}", start + count));
+            CHECK(age == start + count);
+            count++;
+        }
+        CHECK(count == 5 - start);
+    }
+
+    con->exec("drop database if exists test;");
+}
 #endif
\ No newline at end of file
@@ -186,3 +186,64 @@ TEST_CASE("test_sqlite") {
         con->exec("drop table perf_test");
     }*/
 }
+
+TEST_CASE("test_sqlite_statement_cache") {
+    Parameter param;
+    param.set<string>("db", "test.db");
+    param.set<int>("statement_cache_size", 2);
+    auto con = std::make_shared<SQLiteConnect>(param);
+    con->exec("create table t_cache (name TEXT, age INT)");
+    con->exec("insert into t_cache (name, age) values ('aaa', 10), ('bbb', 20)");
+
+    /** @arg 相同的带参数 SQL 复用同一已预处理的语句 */
+    string sql("select age from t_cache where age>? order by age");
+    SQLStatementBase* raw = nullptr;
+    {
+        SQLStatementPtr st = con->getStatement(sql);
+        raw = st.get();
+        st->bind(0, 0);
+        st->exec();
+        CHECK(st->moveNext());
+    }
+    CHECK(con->getStatementCacheCount() == 1);
+    {
+        SQLStatementPtr st = con->getStatement(sql);
+        CHECK(st.get() == raw);
+        st->bind(0, 15);
+        st->exec();
+        int age = 0;
+        CHECK(st->moveNext());
+        st->getColumn(0, age);
+        CHECK(age == 20);
+        CHECK(!st->moveNext());
+
+        /** @arg 使用中的语句不被复用 */
+        SQLStatementPtr st2 = con->getStatement(sql);
+        CHECK(st2.get() != raw);
+    }
+
+    /** @arg 不带参数的语句不进入缓存 */
+    CHECK(con->queryInt("select count(1) from t_cache") == 2);
+    CHECK(con->queryInt("select max(age) from t_cache") == 20);
+    CHECK(con->getStatementCacheCount() == 1);
+
+    /** @arg 超出缓存数量时淘汰最近最少使用的语句 */
+    for (const char* other : {"select count(1) from t_cache where age>?",
+                              "select max(age) from t_cache where age>?"}) {
+        SQLStatementPtr st = con->getStatement(other);
+        st->bind(0, 0);
+        st->exec();
+        CHECK(st->moveNext());
+    }
+    CHECK(con->getStatementCacheCount() == 2);
+    {
+        // 复用的语句保留上次绑定的参数（15），被淘汰后新建的语句未绑定参数，查询结果为空
+        SQLStatementPtr st = con->getStatement(sql);
+        st->exec();
+        CHECK(!st->moveNext());
+    }
+
+    con->exec("drop table t_cache");
+    con->clearStatementCache();
+    CHECK(con->getStatementCacheCount() == 0);
+}
@@ -0,0 +1,84 @@
+/*
+ * test_FlatIdMap.cpp
+ *
+ *  Created on: 2026-10-18
+ *      Author: fasiondog
+ */
+
+#include "doctest/doctest.h"
+#include <map>
+#include <hikyuu/utilities/FlatIdMap.h>
+
+using namespace hku;
+
+/**
+ * @defgroup test_hikyuu_FlatIdMap test_hikyuu_FlatIdMap
+ * @ingroup test_hikyuu_utilities
+ * @{
+ */
+
+/** @par 检测点 */
+TEST_CASE("test_FlatIdMap") {
+    FlatIdMap<int> m;
+
+    /** @arg 空表 */
+    CHECK_UNARY(m.empty());
+    CHECK_EQ(m.size(), 0);
+    CHECK_EQ(m.count(1), 0);
+    CHECK_UNARY(m.find(1) == m.end());
+    CHECK_EQ(m.erase(1), 0);
+
+    /** @arg 插入及查找 */
+    m[100] = 1;
+    m[200] = 2;
+    CHECK_EQ(m.size(), 2);
+    CHECK_EQ(m.count(100), 1);
+    CHECK_EQ(m.find(200)->second, 2);
+    m[100] += 10;
+    CHECK_EQ(m[100], 11);
+    CHECK_EQ(m.size(), 2);
+
+    /** @arg 删除 */
+    CHECK_EQ(m.erase(100), 1);
+    CHECK_EQ(m.count(100), 0);
+    CHECK_EQ(m.find(200)->second, 2);
+    auto iter = m.erase(m.find(200));
+    CHECK_UNARY(iter == m.end());
+    CHECK_UNARY(m.empty());
+
+    /** @arg 大量插入删除，与 std::map 结果一致 */
+    std::map<uint64_t, int> expect;
+    for (int i = 0; i < 2000; i++) {
+        // 模拟指针地址，低位相同
+        uint64_t key = 0x7f0000000000ULL + uint64_t(i % 500) * 64;
+        if (i % 3 == 0) {
+            CHECK_EQ(m.erase(key), expect.erase(key));
+        } else {
+            m[key] = i;
+            expect[key] = i;
+        }
+    }
+
+    CHECK_EQ(m.size(), expect.size());
+    for (auto& item : expect) {
+        auto found = m.find(item.first);
+        CHECK_UNARY(found != m.end());
+        if (found != m.end()) {
+            CHECK_EQ(found->second, item.second);
+        }
+    }
+
+    size_t total = 0;
+    for (auto& item : m) {
+        CHECK_EQ(expect.count(item.first), 1);
+        total++;
+    }
+    CHECK_EQ(total, expect.size());
+
+    /** @arg 清空 */
+    m.clear();
+    CHECK_UNARY(m.empty());
+    CHECK_EQ(m.count(0x7f0000000000ULL), 0);
+}
+
+/** @} */
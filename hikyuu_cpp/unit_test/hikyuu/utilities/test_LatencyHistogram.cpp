@@ -0,0 +1,61 @@
+/*
+ * test_LatencyHistogram.cpp
+ *
+ *  Created on: 2026-10-18
+ *      Author: fasiondog
+ */
+
+#include "doctest/doctest.h"
+#include <hikyuu/utilities/LatencyHistogram.h>
+
+using namespace hku;
+
+/**
+ * @defgroup test_hikyuu_LatencyHistogram test_hikyuu_LatencyHistogram
+ * @ingroup test_hikyuu_utilities
+ * @{
+ */
+
+/** @par 检测点 */
+TEST_CASE("test_LatencyHistogram") {
+    LatencyHistogram h;
+
+    /** @arg 空统计 */
+    CHECK_EQ(h.count(), 0);
+    CHECK_EQ(h.max(), 0);
+    CHECK_EQ(h.mean(), 0.0);
+    CHECK_EQ(h.percentile(0.99), 0);
+
+    /** @arg 按 2 的幂次划分区间 */
+    h.add(0);
+    h.add(1);
+    h.add(3);
+    h.add(4);
+    h.add(-5);
+    CHECK_EQ(h.bucketCount(0), 2);
+    CHECK_EQ(h.bucketCount(1), 1);
+    CHECK_EQ(h.bucketCount(2), 1);
+    CHECK_EQ(h.bucketCount(3), 1);
+    CHECK_EQ(h.bucketCount(LatencyHistogram::BUCKET_COUNT), 0);
+    CHECK_EQ(h.count(), 5);
+    CHECK_EQ(h.max(), 4);
+    CHECK_EQ(h.mean(), doctest::Approx(8.0 / 5.0));
+
+    /** @arg 分位数为所在区间上界，且不超过最大值 */
+    h.clear();
+    for (int i = 0; i < 99; i++) {
+        h.add(100);
+    }
+    h.add(5000);
+    CHECK_EQ(h.percentile(0.5), 127);
+    CHECK_EQ(h.percentile(0.99), 127);
+    CHECK_EQ(h.percentile(1.0), 5000);
+    CHECK_EQ(h.max(), 5000);
+
+    /** @arg 清除 */
+    h.clear();
+    CHECK_EQ(h.count(), 0);
+    CHECK_EQ(h.bucketCount(7), 0);
+}
+
+/** @} */
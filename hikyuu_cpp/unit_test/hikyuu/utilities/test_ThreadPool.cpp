@@ -12,6 +12,7 @@
 #include <hikyuu/utilities/thread/ThreadPool.h>
 #include <hikyuu/utilities/thread/MQThreadPool.h>
 #include <hikyuu/utilities/thread/MQStealThreadPool.h>
+#include <hikyuu/utilities/thread/MPMCQueue.h>
 #include <hikyuu/utilities/SpendTimer.h>
 #include <hikyuu/Log.h>
 
@@ -68,6 +69,113 @@ TEST_CASE("test_StealThreadPool") {
     }
 }
 
+/** @par 检测点 */
+TEST_CASE("test_StealThreadPool_recursive") {
+    StealThreadPool tg(4);
+    std::atomic<int> count = 0;
+
+    /** @arg 外部提交的任务全部执行且返回值正确 */
+    std::vector<StealThreadPool::task_handle<int>> results;
+    for (int i = 0; i < 1000; i++) {
+        results.push_back(tg.submit([i, &count]() {
+            count++;
+            return i;
+        }));
+    }
+    int sum = 0;
+    for (auto& result : results) {
+        sum += result.get();
+    }
+    CHECK_EQ(sum, 999 * 1000 / 2);
+
+    /** @arg 任务中递归提交的任务进入本地队列，可被其他工作线程偷取 */
+    std::function<void(int)> spawn = [&](int depth) {
+        count++;
+        if (depth > 0) {
+            tg.submit([&spawn, depth]() { spawn(depth - 1); });
+            tg.submit([&spawn, depth]() { spawn(depth - 1); });
+        }
+    };
+    tg.submit([&spawn]() { spawn(10); });
+    while (count < 1000 + 2047) {
+        std::this_thread::yield();
+    }
+    tg.join();
+    CHECK_EQ(count, 1000 + 2047);
+    CHECK_EQ(tg.executed_count(), 1000 + 2047);
+    HKU_INFO("steal: {}, park: {}", tg.steal_count(), tg.park_count());
+}
+
+/** @par 检测点 */
+TEST_CASE("test_StealThreadPool_join_overflow") {
+    /** @arg 外部提交的任务超出主队列无锁部分容量时，join 后全部任务均已执行 */
+    StealThreadPool tg(2);
+    std::atomic<int> count = 0;
+    std::vector<StealThreadPool::task_handle<void>> results;
+    for (int i = 0; i < 10000; i++) {
+        results.push_back(tg.submit([&count]() { count++; }));
+    }
+    tg.join();
+    CHECK_EQ(count, 10000);
+    for (auto& result : results) {
+        CHECK_UNARY(result.wait_for(std::chrono::seconds(0)) == std::future_status::ready);
+    }
+    CHECK_THROWS_AS(tg.submit([]() {}), std::logic_error);
+}
+
+/** @par 检测点 */
+TEST_CASE("test_MPMCQueue") {
+    MPMCQueue<int> queue(4);
+    int value = 0;
+
+    /** @arg 空队列 */
+    CHECK_UNARY(queue.empty());
+    CHECK_UNARY(!queue.try_pop(value));
+
+    /** @arg 超出无锁部分容量后转入溢出队列，数据不丢失且保持先进先出 */
+    for (int i = 0; i < 10; i++) {
+        queue.push(i);
+    }
+    CHECK_EQ(queue.size(), 10);
+    int expect = 0;
+    while (expect < 6 && queue.try_pop(value)) {
+        CHECK_EQ(value, expect++);
+    }
+    for (int i = 10; i < 15; i++) {
+        queue.push(i);
+    }
+    while (queue.try_pop(value)) {
+        CHECK_EQ(value, expect++);
+    }
+    CHECK_EQ(expect, 15);
+    CHECK_UNARY(queue.empty());
+
+    /** @arg 多线程并发入队、出队 */
+    std::atomic<int> total = 0, popped = 0;
+    std::vector<std::thread> threads;
+    for (int i = 0; i < 4; i++) {
+        threads.emplace_back([&]() {
+            for (int j = 1; j <= 1000; j++) {
+                queue.push(j);
+            }
+        });
+        threads.emplace_back([&]() {
+            int v = 0;
+            while (popped < 4000) {
+                if (queue.try_pop(v)) {
+                    total += v;
+                    popped++;
+                }
+            }
+        });
+    }
+    for (auto& t : threads) {
+        t.join();
+    }
+    CHECK_EQ(total, 4 * 1000 * 1001 / 2);
+    CHECK_UNARY(queue.empty());
+}
+
 /** @par 检测点 */
 TEST_CASE("test_MQStealThreadPool") {
     {
@@ -68,4 +68,31 @@ TEST_CASE("test_TimerManager") {
     std::this_thread::sleep_for(std::chrono::seconds(60));*/
 }
 
+/** @par 检测点 */
+TEST_CASE("test_TimerManager_run") {
+    TimerManager tm(2);
+    tm.start();
+
+    /** @arg 周期任务按次数执行完毕后自动移除 */
+    std::atomic<int> count = 0;
+    for (int i = 0; i < 100; i++) {
+        tm.addDurationFunc(3, Milliseconds(10), [&count]() { count++; });
+    }
+
+    /** @arg 移除的任务不再执行 */
+    int id = tm.addDelayFunc(Milliseconds(20), [&count]() { count += 1000; });
+    tm.removeTimer(id);
+    CHECK_EQ(tm.size(), 100);
+
+    for (int i = 0; i < 200 && count < 300; i++) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    CHECK_EQ(count, 300);
+    CHECK_EQ(tm.size(), 0);
+    CHECK_EQ(tm.getJitter().count(), 300);
+    HKU_INFO("jitter: {}", tm.getJitter().str());
+    tm.stop();
+}
+
 /** @} */
\ No newline at end of file
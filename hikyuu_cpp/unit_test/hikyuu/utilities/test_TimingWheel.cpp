@@ -0,0 +1,92 @@
+/*
+ * test_TimingWheel.cpp
+ *
+ *  Created on: 2026-10-18
+ *      Author: fasiondog
+ */
+
+#include "doctest/doctest.h"
+#include <vector>
+#include <hikyuu/utilities/TimingWheel.h>
+
+using namespace hku;
+
+/**
+ * @defgroup test_hikyuu_TimingWheel test_hikyuu_TimingWheel
+ * @ingroup test_hikyuu_utilities
+ * @{
+ */
+
+/** @par 检测点 */
+TEST_CASE("test_TimingWheel") {
+    const int64_t start = 1000000;
+    TimingWheel wheel(start);
+    CHECK_UNARY(wheel.empty());
+    CHECK_EQ(wheel.nextExpire(), INT64_MAX);
+
+    /** @arg 不同层级的定时项均按时到期，且只到期一次 */
+    const int64_t spans[] = {0,          500,         1000,          255000,   256000,
+                             300000,     16384000,    20000000,      86400000000LL,
+                             1048576000, 67108864000, 5000000000000LL};
+    const size_t total = sizeof(spans) / sizeof(spans[0]);
+    std::vector<TimingWheel::Node> nodes(total);
+    for (size_t i = 0; i < total; i++) {
+        nodes[i].expire = start + spans[i];
+        nodes[i].id = int(i);
+        wheel.add(&nodes[i]);
+        CHECK_UNARY(TimingWheel::linked(&nodes[i]));
+    }
+    CHECK_EQ(wheel.size(), total);
+
+    /** @arg 移除定时项 */
+    wheel.remove(&nodes[2]);
+    CHECK_UNARY(!TimingWheel::linked(&nodes[2]));
+    CHECK_EQ(wheel.size(), total - 1);
+
+    std::vector<int> fired(total, 0);
+    std::vector<int64_t> fired_time(total, 0);
+    int64_t now = start;
+    while (!wheel.empty()) {
+        int64_t next = wheel.nextExpire();
+        CHECK_UNARY(next != INT64_MAX);
+        now = next > now ? next : now;
+        wheel.advance(now, [&](TimingWheel::Node* node) {
+            fired[node->id]++;
+            fired_time[node->id] = now;
+        });
+    }
+    for (size_t i = 0; i < total; i++) {
+        if (i == 2) {
+            CHECK_EQ(fired[i], 0);
+        } else {
+            CHECK_EQ(fired[i], 1);
+            CHECK_EQ(fired_time[i], nodes[i].expire);
+        }
+    }
+
+    /** @arg 在到期回调中重新加入，实现周期定时 */
+    TimingWheel::Node node;
+    node.expire = now + 5000;
+    wheel.add(&node);
+    int count = 0;
+    for (int64_t t = now; t < now + 100000; t += 500) {
+        wheel.advance(t, [&](TimingWheel::Node* n) {
+            count++;
+            n->expire += 10000;
+            wheel.add(n);
+        });
+    }
+    CHECK_EQ(count, 10);
+
+    /** @arg 已过期的定时项在下次推进时立即到期 */
+    wheel.reset(now);
+    CHECK_UNARY(wheel.empty());
+    node.expire = now - 1000;
+    wheel.add(&node);
+    CHECK_UNARY(wheel.nextExpire() <= now);
+    count = 0;
+    wheel.advance(now, [&](TimingWheel::Node*) { count++; });
+    CHECK_EQ(count, 1);
+}
+
+/** @} */
@@ -30,6 +30,10 @@ void export_Block() {
       .def(self_ns::str(self))
       .def(self_ns::repr(self))
 
+      .def(self | self)
+      .def(self & self)
+      .def(self - self)
+
       .add_property("category", getCategory, setCategory, "板块所属分类")
       .add_property("name", getName, setName, "板块名称")
 
@@ -71,6 +75,10 @@ void export_Block() {
 
       .def("clear", &Block::clear, "移除包含的所有证券")
 
+      .def("clone", &Block::clone, R"(clone(self)
+
+    深度复制，复制后的板块与原板块互不影响)")
+
       .def("__len__", &Block::size, "包含的证券数量")
 
       .def("__getitem__", &Block::get, R"(__getitem__(self, market_code)
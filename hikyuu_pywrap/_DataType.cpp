@@ -19,6 +19,11 @@ using namespace hku;
 
 PriceList toPriceList(object o) {
     PriceList result;
+    // 支持缓冲协议的一维 double 数组（如 numpy.ndarray）整体复制
+    if (python_buffer_to_vector(o.ptr(), result)) {
+        return result;
+    }
+
     size_t total = extract<size_t>(o.attr("__len__")());
     for (size_t i = 0; i < total; ++i) {
         result.push_back(extract<price_t>(o.attr("__getitem__")(i)));
@@ -26,6 +31,20 @@ PriceList toPriceList(object o) {
     return result;
 }
 
+object PriceList_buffer_view(object self) {
+    const PriceList& data = extract<const PriceList&>(self);
+    return make_price_buffer_view(make_python_owner(self, &data), data.data(), data.size());
+}
+
+void PriceList_append(PriceList& data, price_t val) {
+    check_buffer_not_exported(&data);
+    data.push_back(val);
+}
+
+object DatetimeList_to_us_bytes(const DatetimeList& data) {
+    return datetime_to_us_bytes(data.data(), data.size());
+}
+
 #if !defined(_MSVC_VER)
 bool (*isnan_func)(price_t) = std::isnan;
 bool (*isinf_func)(price_t) = std::isinf;
@@ -42,6 +61,8 @@ void export_DataType() {
       .def("__len__", &DatetimeList::size)
       .def("append", datetimelist_append, "向列表末端加入元素")
       .def("get", datetimeList_at, return_value_policy<copy_const_reference>())
+      .def("_to_us_bytes", DatetimeList_to_us_bytes,
+           "以 bytes 返回距 1970-01-01 的微秒数（int64），供 to_np 使用")
 #if HKU_PYTHON_SUPPORT_PICKLE
       .def_pickle(normal_pickle_suite<DatetimeList>())
 #endif
@@ -49,13 +70,14 @@ void export_DataType() {
 
     PriceList::const_reference (PriceList::*PriceList_at)(PriceList::size_type) const =
       &PriceList::at;
-    void (PriceList::*PriceList_append)(const PriceList::value_type& val) = &PriceList::push_back;
     class_<PriceList>("PriceList")
       .def("__iter__", iterator<PriceList>())
       .def("size", &PriceList::size)
       .def("__len__", &PriceList::size)
-      .def("append", PriceList_append)
+      .def("append", PriceList_append, "向列表末端加入元素，已导出 numpy 数组时抛出 BufferError")
       .def("get", PriceList_at, return_value_policy<copy_const_reference>())
+      .def("_buffer_view", PriceList_buffer_view,
+           "返回只读的缓冲区视图，供 to_np 零拷贝使用，视图存续期间 append 将抛出 BufferError")
 #if HKU_PYTHON_SUPPORT_PICKLE
       .def_pickle(normal_pickle_suite<PriceList>())
 #endif
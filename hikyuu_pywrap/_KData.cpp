@@ -9,6 +9,7 @@
 #include <hikyuu/serialization/KData_serialization.h>
 #include <hikyuu/indicator/crt/KDATA.h>
 #include "pickle_support.h"
+#include "pybind_utils.h"
 
 using namespace boost::python;
 using namespace hku;
@@ -16,6 +17,36 @@ using namespace hku;
 KRecord (KData::*KData_getKRecord1)(size_t pos) const = &KData::getKRecord;
 KRecord (KData::*KData_getKRecord2)(Datetime datetime) const = &KData::getKRecord;
 
+object KData_buffer_view(const KData& kdata, const string& field) {
+    // KData 不可修改，视图持有其副本（共享同一份数据）即可保证数据存续
+    auto owner = std::make_shared<const KData>(kdata);
+    const KRecord* data = owner->data();
+    HKU_IF_RETURN(!data || owner->empty(), make_price_buffer_view(owner, nullptr, 0));
+
+    const price_t* column = nullptr;
+    if (field == "open") {
+        column = &data->openPrice;
+    } else if (field == "high") {
+        column = &data->highPrice;
+    } else if (field == "low") {
+        column = &data->lowPrice;
+    } else if (field == "close") {
+        column = &data->closePrice;
+    } else if (field == "amount") {
+        column = &data->transAmount;
+    } else if (field == "volume") {
+        column = &data->transCount;
+    } else {
+        HKU_THROW_EXCEPTION(std::invalid_argument, "Invalid field: {}", field);
+    }
+    return make_price_buffer_view(owner, column, owner->size(), sizeof(KRecord));
+}
+
+object KData_datetime_us_bytes(const KData& kdata) {
+    const KRecord* data = kdata.data();
+    return datetime_to_us_bytes(data ? &data->datetime : nullptr, kdata.size(), sizeof(KRecord));
+}
+
 void export_KData() {
     class_<KData>(
       "KData", "通过 Stock.getKData 获取的K线数据，由 KRecord 组成的数组，可象 list 一样进行遍历",
@@ -59,6 +90,15 @@ void export_KData() {
     :param Datetime datetime: 指定的日期
     :rtype: KRecord)")
 
+      .def("_buffer_view", KData_buffer_view, R"(_buffer_view(self, field)
+
+    返回指定字段的只读缓冲区视图（带步长），可通过 numpy.asarray 零拷贝访问
+
+    :param str field: open|high|low|close|amount|volume)")
+
+      .def("_datetime_us_bytes", KData_datetime_us_bytes,
+           "以 bytes 返回各K线日期距 1970-01-01 的微秒数（int64），供 to_np 使用")
+
       .def("_getPos", &KData::getPos)  // python中需要将Null的情况改写为None
 
       .def("empty", &KData::empty, R"(empty(self)
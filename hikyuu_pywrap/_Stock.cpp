@@ -28,6 +28,8 @@ void export_Stock() {
       .def("__repr__", &Stock::toString)
 
       .add_property("id", &Stock::id, "内部id")
+      .add_property("dense_id", &Stock::denseId,
+                    "在 StockManager 中的连续编号，未加入 StockManager 时为 4294967295")
       .add_property("market",
                     make_function(&Stock::market, return_value_policy<copy_const_reference>()),
                     "所属市场简称，市场简称是市场的唯一标识")
@@ -159,6 +161,22 @@ void export_Stock() {
     :param KRecord krecord: 新增的实时K线记录
     :param KQuery.KType ktype: K 线类型)")
 
+      .def("realtime_update_from_spot", &Stock::realtimeUpdateFromSpot,
+           (arg("spot"), arg("ktype")),
+           R"(realtime_update_from_spot(self, spot, ktype)
+
+    根据实时行情更新指定类型的K线缓存，各K线类型维护增量聚合状态，无需查询历史数据
+
+    :param KRecord spot: 实时行情，时间为行情时间，开高低收为当日价格，成交金额、成交量为当日累计值
+    :param KQuery.KType ktype: K 线类型)")
+
+      .def("realtime_update_tick_from_spot", &Stock::realtimeUpdateTickFromSpot, (arg("spot")),
+           R"(realtime_update_tick_from_spot(self, spot)
+
+    根据实时行情更新分笔、分时缓存，未缓存时忽略
+
+    :param KRecord spot: 实时行情，时间为行情时间，收盘价为最新价，成交量为当日累计值)")
+
       .def("get_weight", &Stock::getWeight,
            (arg("start") = Datetime::min(), arg("end") = Datetime()),
            R"(get_weight(self, [start, end])
@@ -181,6 +199,29 @@ void export_Stock() {
 
     :param Query.KType ktype: K线类型)")
 
+      .def("load_trans_to_buffer", &Stock::loadTransToBuffer,
+           R"(load_trans_to_buffer(self)
+
+    将最近的分笔数据加载至内存缓存，最大记录数由预加载参数 ticks_max 指定)")
+
+      .def("release_trans_buffer", &Stock::releaseTransBuffer, R"(release_trans_buffer(self)
+
+    释放分笔数据缓存)")
+
+      .def("is_trans_buffer", &Stock::isTransBuffer, R"(分笔数据是否被缓存)")
+
+      .def("load_timeline_to_buffer", &Stock::loadTimeLineToBuffer,
+           R"(load_timeline_to_buffer(self)
+
+    将最近的分时数据加载至内存缓存，最大记录数由预加载参数 timeline_max 指定)")
+
+      .def("release_timeline_buffer", &Stock::releaseTimeLineBuffer,
+           R"(release_timeline_buffer(self)
+
+    释放分时数据缓存)")
+
+      .def("is_timeline_buffer", &Stock::isTimeLineBuffer, R"(分时数据是否被缓存)")
+
       .def(self == self)
       .def(self != self)
 
@@ -13,10 +13,74 @@ using namespace hku;
 
 BOOST_PYTHON_MEMBER_FUNCTION_OVERLOADS(getTradingCalendar_overloads, getTradingCalendar, 1, 2)
 
+PriceList getHistoryFinanceInfo(const StockManager& sm, const Datetime& date, object seq) {
+    StockList stk_list;
+    size_t total = len(seq);
+    stk_list.reserve(total);
+    for (size_t i = 0; i < total; i++) {
+        // 无效项对应的行为 Null 值，保持行与输入一一对应
+        extract<Stock> x(seq[i]);
+        stk_list.push_back(x.check() ? x() : Stock());
+    }
+    return sm.getHistoryFinanceInfo(date, stk_list);
+}
+
+// 等待期间释放 GIL，以免阻塞其他 Python 线程
+bool PreloadScheduler_wait(const PreloadScheduler& scheduler, int64_t timeout) {
+    bool ret = true;
+    PyThreadState* state = PyEval_SaveThread();
+    if (timeout < 0) {
+        scheduler.wait();
+    } else {
+        ret = scheduler.waitFor(timeout);
+    }
+    PyEval_RestoreThread(state);
+    return ret;
+}
+
+bool (PreloadScheduler::*isReady_stk)(const Stock&) const = &PreloadScheduler::isReady;
+bool (PreloadScheduler::*isReady_ktype)(const KQuery::KType&) const = &PreloadScheduler::isReady;
+
 BlockList (StockManager::*getBlockList_1)(const string&) = &StockManager::getBlockList;
 BlockList (StockManager::*getBlockList_2)() = &StockManager::getBlockList;
 
 void export_StockManager() {
+    class_<PreloadProgress>("PreloadProgress", "预加载进度", no_init)
+      .def_readonly("total", &PreloadProgress::total, "任务总数")
+      .def_readonly("finished", &PreloadProgress::finished, "已结束的任务数，包含跳过及失败的任务")
+      .def_readonly("skipped", &PreloadProgress::skipped, "因超出内存预算而跳过的任务数")
+      .def_readonly("failed", &PreloadProgress::failed, "加载失败的任务数")
+      .def_readonly("records", &PreloadProgress::records,
+                    "已加载的记录数，分笔、分时按最大记录数计")
+      .def_readonly("bytes", &PreloadProgress::bytes,
+                    "已加载数据占用的内存字节数（按记录数估算），含加载中任务预占的预算")
+      .def_readonly("elapsed", &PreloadProgress::elapsed, "已耗时（秒）")
+      .add_property("records_per_second", &PreloadProgress::recordsPerSecond, "每秒加载的记录数")
+      .add_property("bytes_per_second", &PreloadProgress::bytesPerSecond, "每秒加载的字节数");
+
+    class_<PreloadScheduler, PreloadSchedulerPtr, boost::noncopyable>(
+      "PreloadScheduler", "预加载调度器，按K线类型优先级加载数据至缓存", no_init)
+      .add_property("memory_limit", &PreloadScheduler::memoryLimit,
+                    "内存预算（字节），0 表示不限制")
+      .def("done", &PreloadScheduler::done, "是否已全部结束")
+      .def("wait", PreloadScheduler_wait, (arg("timeout") = -1), R"(wait(self[, timeout=-1])
+
+    阻塞等待全部任务结束
+
+    :param int timeout: 最长等待时间（毫秒），小于 0 时一直等待
+    :return: 全部任务已结束时返回 True，超时返回 False)")
+      .def("cancel", &PreloadScheduler::cancel, "取消尚未开始的任务，已开始的任务仍将执行完毕")
+      .def("is_ready", isReady_stk)
+      .def("is_ready", isReady_ktype, R"(is_ready(self, stk_or_ktype)
+
+    指定证券或K线类型的全部任务是否已结束，无任务时返回 True
+
+    :param stk_or_ktype: 证券（Stock）或K线类型（含 "TICKS"、"TIMELINE"）
+    :rtype: bool)")
+      .def("progress", &PreloadScheduler::progress, "获取当前进度")
+      .def_readonly("TICKS", &PreloadScheduler::TICKS)
+      .def_readonly("TIMELINE", &PreloadScheduler::TIMELINE);
+
     class_<StockManager>("StockManager", "证券信息管理类", no_init)
       .def("instance", &StockManager::instance, return_value_policy<reference_existing_object>(),
            "获取StockManager单例实例")
@@ -53,6 +117,8 @@ void export_StockManager() {
            return_value_policy<copy_const_reference>(), "获取当前预加载参数")
       .def("get_hikyuu_parameter", &StockManager::getHikyuuParameter,
            return_value_policy<copy_const_reference>(), "获取当前其他参数")
+      .def("get_preload_scheduler", &StockManager::getPreloadScheduler,
+           "获取当前的预加载调度器，数据驱动支持并行加载时 init 不等待预加载完成即返回")
 
       .def("get_market_list", &StockManager::getAllMarket, R"(get_market_list(self)
 
@@ -85,6 +151,18 @@ void export_StockManager() {
     :return: 对应的证券实例，如果实例不存在，则Null<Stock>()，不抛出异常
     :rtype: Stock)")
 
+      .def("get_stock_by_dense_id", &StockManager::getStockByDenseId,
+           R"(get_stock_by_dense_id(self, id)
+
+    根据证券的连续编号获取对应的证券实例
+
+    :param int id: 连续编号，参见 Stock.dense_id
+    :return: 对应的证券实例，如果实例不存在或已被移除，则返回Null<Stock>()
+    :rtype: Stock)")
+
+      .def("dense_id_count", &StockManager::denseIdCount,
+           "已分配的连续编号数量，所有证券的连续编号均小于该值")
+
       .def("get_block", &StockManager::getBlock, R"(get_block(self, category, name)
 
     获取预定义的板块
@@ -114,6 +192,18 @@ void export_StockManager() {
     :return: 日期列表
     :rtype: DatetimeList)")
 
+      .def("get_history_finance_info", getHistoryFinanceInfo, (arg("date"), arg("stock_list")),
+           R"(get_history_finance_info(self, date, stock_list)
+
+    批量获取指定报告期多只证券的历史财务信息，字段含义参见：https://hikyuu.org/finance_fields.html
+
+    返回按行展开的 证券数 × 字段数 矩阵，可通过 numpy.array(x).reshape(len(stock_list), -1)
+    转为二维数组，不存在的证券整行为 constant.null_price
+
+    :param Datetime date: 报告期，必须是0331、0630、0930、1231，如 Datetime(201109300000)
+    :param stock_list: 证券列表
+    :rtype: PriceList)")
+
       .def(
         "add_temp_csv_stock", &StockManager::addTempCsvStock,
         (arg("code"), arg("day_filename"), arg("min_filename"), arg("tick") = 0.01,
@@ -12,6 +12,23 @@ using namespace boost::python;
 using namespace hku;
 
 void export_SpotAgent() {
+    class_<SpotRecord>("SpotRecord", "实时行情记录", no_init)
+      .def_readonly("market", &SpotRecord::market, "市场标识")
+      .def_readonly("code", &SpotRecord::code, "证券代码")
+      .def_readonly("name", &SpotRecord::name, "证券名称")
+      .def_readonly("datetime", &SpotRecord::datetime, "数据时间")
+      .def_readonly("yesterday_close", &SpotRecord::yesterday_close, "昨日收盘价")
+      .def_readonly("open", &SpotRecord::open, "开盘价")
+      .def_readonly("high", &SpotRecord::high, "最高价")
+      .def_readonly("low", &SpotRecord::low, "最低价")
+      .def_readonly("close", &SpotRecord::close, "收盘价")
+      .def_readonly("amount", &SpotRecord::amount, "成交金额（千元）")
+      .def_readonly("volumn", &SpotRecord::volumn, "成交量（手）")
+      .def_readonly("bid1", &SpotRecord::bid1, "买一价")
+      .def_readonly("bid1_amount", &SpotRecord::bid1_amount, "买一数量（手）")
+      .def_readonly("ask1", &SpotRecord::ask1, "卖一价")
+      .def_readonly("ask1_amount", &SpotRecord::ask1_amount, "卖一数量（手）");
+
     def("start_spot_agent", startSpotAgent, (arg("print") = false));
     def("stop_spot_agent", stopSpotAgent);
 }
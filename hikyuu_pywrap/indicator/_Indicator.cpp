@@ -9,6 +9,7 @@
 #include <hikyuu/indicator/Indicator.h>
 #include "../_Parameter.h"
 #include "../pickle_support.h"
+#include "../pybind_utils.h"
 
 using namespace boost::python;
 using namespace hku;
@@ -16,13 +17,29 @@ using namespace hku;
 string (Indicator::*ind_read_name)() const = &Indicator::name;
 void (Indicator::*ind_write_name)(const string&) = &Indicator::name;
 
-void (Indicator::*setContext_1)(const Stock&, const KQuery&) = &Indicator::setContext;
-void (Indicator::*setContext_2)(const KData&) = &Indicator::setContext;
+// 重设上下文将重新分配结果缓存，已导出 numpy 数组时不允许
+void setContext_1(Indicator& ind, const Stock& stk, const KQuery& query) {
+    check_buffer_not_exported(ind.getImp().get());
+    ind.setContext(stk, query);
+}
+
+void setContext_2(Indicator& ind, const KData& kdata) {
+    check_buffer_not_exported(ind.getImp().get());
+    ind.setContext(kdata);
+}
 
 Indicator (Indicator::*ind_call_1)(const Indicator&) = &Indicator::operator();
 Indicator (Indicator::*ind_call_2)(const KData&) = &Indicator::operator();
 Indicator (Indicator::*ind_call_3)() = &Indicator::operator();
 
+object Indicator_buffer_view(object self, size_t result_index) {
+    const Indicator& ind = extract<const Indicator&>(self);
+    HKU_CHECK_THROW(result_index < ind.getResultNumber(), std::out_of_range,
+                    "result_index out of range: {}", result_index);
+    // 视图持有 IndicatorImp，与 Indicator 的 Python 对象是否存续无关
+    return make_price_buffer_view(ind.getImp(), ind.data(result_index), ind.size());
+}
+
 void export_Indicator() {
     class_<Indicator>("Indicator", "技术指标", init<>())
       .def(init<IndicatorImpPtr>())
@@ -118,6 +135,14 @@ void export_Indicator() {
     :param int result_index: 指定的结果集
     :rtype: PriceList)")
 
+      .def("_buffer_view", Indicator_buffer_view, (arg("result_index") = 0),
+           R"(_buffer_view(self[, result_index=0])
+
+    返回指定结果集的只读缓冲区视图，可通过 numpy.asarray 零拷贝访问。视图持有指标的计算结果，
+    视图（及由其生成的 numpy 数组）存续期间调用 set_context 将抛出 BufferError
+
+    :param int result_index: 指定的结果集)")
+
       .def("get_datetime_list", &Indicator::getDatetimeList, R"(get_datetime_list(self)
 
     返回对应的日期列表
@@ -136,7 +161,9 @@ set_context(self, stock, query)
     设置上下文
 
     :param Stock stock: 指定的 Stock
-    :param Query query: 指定的查询条件)")
+    :param Query query: 指定的查询条件
+
+    通过 to_np 导出的 numpy 数组尚未释放时，将抛出 BufferError)")
 
       .def("get_context", &Indicator::getContext, R"(get_context(self)
 
@@ -15,6 +15,12 @@ Indicator (*PRICELIST2)(const PriceList&, int) = PRICELIST;
 Indicator (*PRICELIST3)(const Indicator&, int) = PRICELIST;
 Indicator (*PRICELIST4)(int) = PRICELIST;
 
+PriceList toPriceList(object o);
+
+Indicator PRICELIST_from_object(object data, int discard) {
+    return PRICELIST(toPriceList(data), discard);
+}
+
 Indicator (*KDATA1)(const KData&) = KDATA;
 Indicator (*KDATA3)() = KDATA;
 
@@ -362,6 +368,8 @@ void export_Indicator_build_in() {
     :param string kpart: KDATA|OPEN|HIGH|LOW|CLOSE|AMO|VOL
     :rtype: Indicator)");
 
+    // 最先注册，最后尝试匹配，用于 numpy.ndarray、list 等其他数据
+    def("PRICELIST", PRICELIST_from_object, (arg("data"), arg("discard") = 0));
     def("PRICELIST", PRICELIST2, (arg("data"), arg("discard") = 0));
     def("PRICELIST", PRICELIST3, (arg("data"), arg("result_index") = 0));
     def("PRICELIST", PRICELIST4, (arg("result_index") = 0));
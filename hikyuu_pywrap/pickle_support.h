@@ -47,6 +47,24 @@
 
 namespace bp = boost::python;
 
+/*
+ * 二进制存档以 bytes 返回，避免按 utf-8 解码；setstate 兼容此前以 str 保存的状态
+ */
+inline bp::object archive_to_state(const std::string& archive) {
+#if HKU_SUPPORT_BINARY_ARCHIVE
+    return bp::object(bp::handle<>(PyBytes_FromStringAndSize(archive.data(), archive.size())));
+#else
+    return bp::str(archive);
+#endif
+}
+
+inline std::string state_to_archive(const bp::object& state) {
+    if (PyBytes_Check(state.ptr())) {
+        return std::string(PyBytes_AS_STRING(state.ptr()), PyBytes_GET_SIZE(state.ptr()));
+    }
+    return bp::extract<std::string>(state)();
+}
+
 /*
  * normal_pickle_suite 用于初始化函数__init__没有参数的情况
  */
@@ -54,16 +72,16 @@ template<class T>
 struct normal_pickle_suite : bp::pickle_suite {
     static bp::object getstate(const T& param) {
         std::ostringstream os;
-        OUTPUT_ARCHIVE oa(os);
-        oa << param;
-        return bp::str (os.str());
+        {
+            OUTPUT_ARCHIVE oa(os);
+            oa << param;
+        }
+        return archive_to_state(os.str());
     }
 
     static void
       setstate(T& params, bp::object entries) {
-        bp::str s = bp::extract<bp::str>(entries)();
-        std::string st = bp::extract<std::string>(s)();
-        std::istringstream is(st);
+        std::istringstream is(state_to_archive(entries));
 
         INPUT_ARCHIVE ia(is);
         ia >> params;
@@ -84,16 +102,16 @@ struct name_init_pickle_suite : bp::pickle_suite {
 
     static bp::object getstate(const T& param) {
         std::ostringstream os;
-        OUTPUT_ARCHIVE oa(os);
-        oa << param;
-        return bp::str (os.str());
+        {
+            OUTPUT_ARCHIVE oa(os);
+            oa << param;
+        }
+        return archive_to_state(os.str());
     }
 
     static void
       setstate(T& params, bp::object entries) {
-        bp::str s = bp::extract<bp::str>(entries)();
-        std::string st = bp::extract<std::string>(s)();
-        std::istringstream is(st);
+        std::istringstream is(state_to_archive(entries));
 
         INPUT_ARCHIVE ia(is);
         ia >> params;
@@ -0,0 +1,189 @@
+/*
+ *  Copyright (c) hikyuu.org
+ *
+ *  Created on: 2026-10-18
+ *      Author: fasiondog
+ */
+
+#include <cstring>
+#include <limits>
+#include <unordered_map>
+#include <boost/endian/conversion.hpp>
+#include "pybind_utils.h"
+
+using namespace hku;
+
+namespace {
+
+/* 只读缓冲区视图，持有数据存储的共享对象 */
+struct PriceBufferView {
+    PyObject_HEAD
+    std::shared_ptr<const void>* owner;
+    const double* data;
+    Py_ssize_t shape[1];
+    Py_ssize_t strides[1];
+};
+
+/* 数据存储地址 -> 存续的视图数，仅在持有 GIL 时访问 */
+std::unordered_map<const void*, size_t>& exported_buffers() {
+    static std::unordered_map<const void*, size_t> s_exported;
+    return s_exported;
+}
+
+void PriceBufferView_dealloc(PyObject* self) {
+    PriceBufferView* view = (PriceBufferView*)self;
+    if (view->owner) {
+        auto& exported = exported_buffers();
+        auto iter = exported.find(view->owner->get());
+        if (iter != exported.end() && --iter->second == 0) {
+            exported.erase(iter);
+        }
+        delete view->owner;
+    }
+    Py_TYPE(self)->tp_free(self);
+}
+
+Py_ssize_t PriceBufferView_len(PyObject* self) {
+    return ((PriceBufferView*)self)->shape[0];
+}
+
+int PriceBufferView_getbuffer(PyObject* self, Py_buffer* view, int flags) {
+    if (flags & PyBUF_WRITABLE) {
+        PyErr_SetString(PyExc_BufferError, "PriceBufferView is read-only");
+        return -1;
+    }
+
+    PriceBufferView* p = (PriceBufferView*)self;
+    bool contiguous = p->strides[0] == sizeof(double) || p->shape[0] <= 1;
+    if (!contiguous && (flags & PyBUF_STRIDES) != PyBUF_STRIDES) {
+        PyErr_SetString(PyExc_BufferError, "PriceBufferView is not contiguous");
+        return -1;
+    }
+
+    // 空视图时 data 可能为 nullptr，numpy 要求 buf 非空
+    static double empty_buf = 0.0;
+    view->buf = p->data ? (void*)p->data : (void*)&empty_buf;
+    view->obj = self;
+    Py_INCREF(self);
+    view->len = p->shape[0] * sizeof(double);
+    view->readonly = 1;
+    view->itemsize = sizeof(double);
+    view->format = (flags & PyBUF_FORMAT) ? (char*)"d" : nullptr;
+    view->ndim = 1;
+    view->shape = (flags & PyBUF_ND) ? p->shape : nullptr;
+    view->strides = (flags & PyBUF_STRIDES) == PyBUF_STRIDES ? p->strides : nullptr;
+    view->suboffsets = nullptr;
+    view->internal = nullptr;
+    return 0;
+}
+
+PySequenceMethods PriceBufferView_as_sequence = {PriceBufferView_len};
+
+PyBufferProcs PriceBufferView_as_buffer = {PriceBufferView_getbuffer, nullptr};
+
+PyTypeObject* get_price_buffer_view_type() {
+    static PyTypeObject* type = nullptr;
+    if (type) {
+        return type;
+    }
+
+    static PyTypeObject view_type = {PyVarObject_HEAD_INIT(nullptr, 0)};
+    view_type.tp_name = "hikyuu.cpp.core.PriceBufferView";
+    view_type.tp_basicsize = sizeof(PriceBufferView);
+    view_type.tp_dealloc = PriceBufferView_dealloc;
+    view_type.tp_as_sequence = &PriceBufferView_as_sequence;
+    view_type.tp_as_buffer = &PriceBufferView_as_buffer;
+    view_type.tp_flags = Py_TPFLAGS_DEFAULT;
+    view_type.tp_doc = "只读的价格数据视图，可通过 numpy.asarray 零拷贝访问";
+    if (PyType_Ready(&view_type) < 0) {
+        py::throw_error_already_set();
+    }
+    type = &view_type;
+    return type;
+}
+
+}  // namespace
+
+py::object make_price_buffer_view(std::shared_ptr<const void> owner, const double* data,
+                                  size_t len, size_t stride) {
+    PriceBufferView* view = PyObject_New(PriceBufferView, get_price_buffer_view_type());
+    if (!view) {
+        py::throw_error_already_set();
+    }
+    if (owner) {
+        exported_buffers()[owner.get()]++;
+        view->owner = new std::shared_ptr<const void>(std::move(owner));
+    } else {
+        view->owner = nullptr;
+    }
+    view->data = data;
+    view->shape[0] = data ? Py_ssize_t(len) : 0;
+    view->strides[0] = Py_ssize_t(stride);
+    return py::object(py::handle<>((PyObject*)view));
+}
+
+std::shared_ptr<const void> make_python_owner(py::object obj, const void* storage) {
+    PyObject* ptr = py::incref(obj.ptr());
+    // 由视图释放时调用，此时持有 GIL
+    return std::shared_ptr<const void>(storage, [ptr](const void*) { Py_DECREF(ptr); });
+}
+
+void check_buffer_not_exported(const void* storage) {
+    const auto& exported = exported_buffers();
+    if (storage && exported.find(storage) != exported.end()) {
+        PyErr_SetString(PyExc_BufferError,
+                        "Existing exports of data (e.g. numpy arrays from to_np): object cannot "
+                        "be re-sized or re-calculated");
+        py::throw_error_already_set();
+    }
+}
+
+py::object datetime_to_us_bytes(const Datetime* data, size_t len, size_t stride) {
+    if (!data) {
+        len = 0;
+    }
+
+    PyObject* bytes = PyBytes_FromStringAndSize(nullptr, Py_ssize_t(len * sizeof(int64_t)));
+    if (!bytes) {
+        py::throw_error_already_set();
+    }
+
+    // numpy.datetime64 中的 NaT 为 int64 最小值
+    const int64_t nat = std::numeric_limits<int64_t>::min();
+    const bt::ptime epoch(bd::date(1970, 1, 1));
+    int64_t* out = (int64_t*)PyBytes_AS_STRING(bytes);
+    const char* pos = (const char*)data;
+    for (size_t i = 0; i < len; i++, pos += stride) {
+        const Datetime& d = *(const Datetime*)pos;
+        out[i] = d.isNull() ? nat : (d.ptime() - epoch).total_microseconds();
+    }
+    return py::object(py::handle<>(bytes));
+}
+
+bool python_buffer_to_vector(PyObject* obj, std::vector<double>& out) {
+    if (!PyObject_CheckBuffer(obj)) {
+        return false;
+    }
+
+    Py_buffer view;
+    if (PyObject_GetBuffer(obj, &view, PyBUF_C_CONTIGUOUS | PyBUF_FORMAT) != 0) {
+        PyErr_Clear();
+        return false;
+    }
+
+    // 仅接受本机字节序的 double
+    const char* format = view.format ? view.format : "B";
+    if (*format == '@' || *format == '=' ||
+        (*format == '<' && boost::endian::order::native == boost::endian::order::little)) {
+        format++;
+    }
+
+    bool success =
+      view.ndim == 1 && view.itemsize == sizeof(double) && std::strcmp(format, "d") == 0;
+    if (success) {
+        const double* data = (const double*)view.buf;
+        out.assign(data, data + view.len / sizeof(double));
+    }
+    PyBuffer_Release(&view);
+    return success;
+}
@@ -9,8 +9,10 @@
 #ifndef HIKYUU_PYBIND_UTILS_H
 #define HIKYUU_PYBIND_UTILS_H
 
+#include <memory>
 #include <vector>
 #include <boost/python.hpp>
+#include <hikyuu/datetime/Datetime.h>
 
 namespace py = boost::python;
 
@@ -38,4 +40,46 @@ T python_list_to_vector(py::list pylist) {
     return result;
 }
 
+/**
+ * 创建只读的一维缓冲区视图（支持 Python 缓冲协议），可由 numpy.asarray 零拷贝转换为 numpy 数组
+ * @param owner 持有数据存储的共享对象，视图及由其生成的 numpy 数组存续期间保持其存活，
+ *              并以 owner.get() 登记为已导出 @see check_buffer_not_exported
+ * @param data 首个元素地址
+ * @param len 元素个数
+ * @param stride 相邻元素间的字节数
+ * @note 仅支持 double 类型元素
+ */
+py::object make_price_buffer_view(std::shared_ptr<const void> owner, const double* data,
+                                  size_t len, size_t stride = sizeof(double));
+
+/**
+ * 创建持有 Python 对象引用的共享对象，用于数据存储由 Python 对象持有的情况（如 PriceList）
+ * @param obj 持有数据存储的 Python 对象
+ * @param storage 数据存储的地址，即导出登记的标识
+ */
+std::shared_ptr<const void> make_python_owner(py::object obj, const void* storage);
+
+/**
+ * 会重新分配数据存储的修改操作前调用，数据已通过缓冲区视图导出（视图或由其生成的 numpy 数组
+ * 尚未释放）时抛出 BufferError
+ * @param storage 数据存储的地址，与 make_price_buffer_view 中的 owner.get() 对应
+ */
+void check_buffer_not_exported(const void* storage);
+
+/**
+ * 以 bytes 返回日期序列对应的 int64 数组（距 1970-01-01 的微秒数），Null 日期对应 numpy.datetime64
+ * 中的 NaT，可由 numpy.frombuffer(x, dtype='datetime64[us]') 转换
+ * @param data 首个日期地址
+ * @param len 日期个数
+ * @param stride 相邻日期间的字节数，用于读取结构体数组中的日期字段
+ */
+py::object datetime_to_us_bytes(const hku::Datetime* data, size_t len,
+                                size_t stride = sizeof(hku::Datetime));
+
+/**
+ * 尝试以缓冲协议读取一维 C 连续的 double 数组（如 numpy.ndarray），并一次性复制至 out
+ * @return obj 不支持缓冲协议或不是一维 C 连续的 double 数组时返回 false
+ */
+bool python_buffer_to_vector(PyObject* obj, std::vector<double>& out);
+
 #endif  // HIKYUU_PYBIND_UTILS_H
\ No newline at end of file
@@ -120,6 +120,19 @@ void setKTypeList(StrategyBase* self, object seq) {
     self->setKTypeList(stk_list);
 }
 
+boost::python::list getChangedStocks(const StrategyBase* self) {
+    boost::python::list result;
+    for (const auto& stk : self->getChangedStocks()) {
+        result.append(stk);
+    }
+    return result;
+}
+
+object getSpot(const StrategyBase* self, const Stock& stk) {
+    SpotRecord spot;
+    return self->getSpot(stk, spot) ? object(spot) : object();
+}
+
 void export_Strategy() {
     class_<StrategyBaseWrap, boost::noncopyable>("StrategyBase", init<>())
       .add_property("name",
@@ -138,6 +151,19 @@ void export_Strategy() {
         setKTypeList, "需要的K线类型")
 
       .def("run", &StrategyBase::run)
+      .def("get_changed_stocks", getChangedStocks,
+           R"(get_changed_stocks(self)
+
+    自上次 on_tick 以来行情有更新的证券列表，仅在 on_tick 中有效
+
+    :rtype: list)")
+      .def("get_spot", getSpot, (arg("stock")),
+           R"(get_spot(self, stock)
+
+    获取指定证券的最新行情，证券不在策略的证券列表中或尚未收到行情时返回 None
+
+    :param Stock stock: 指定证券
+    :rtype: SpotRecord)")
       .def("init", &StrategyBase::init, &StrategyBaseWrap::default_init)
       .def("on_tick", &StrategyBase::onTick, &StrategyBaseWrap::default_onTick)
       .def("on_bar", &StrategyBase::onBar, &StrategyBaseWrap::default_onBar)
@@ -30,4 +30,15 @@ void export_FundsRecord() {
       .def_pickle(normal_pickle_suite<FundsRecord>())
 #endif
       ;
+
+    FundsRecordList::const_reference (FundsRecordList::*FundsRecordList_at)(
+      FundsRecordList::size_type) const = &FundsRecordList::at;
+    void (FundsRecordList::*FundsRecordList_append)(const FundsRecord&) =
+      &FundsRecordList::push_back;
+    class_<FundsRecordList>("FundsRecordList", "资产记录列表，C++ std::vector<FundsRecord>包装")
+      .def("__iter__", iterator<FundsRecordList>())
+      .def("size", &FundsRecordList::size)
+      .def("__len__", &FundsRecordList::size)
+      .def("get", FundsRecordList_at, return_value_policy<copy_const_reference>())
+      .def("append", FundsRecordList_append);
 }
@@ -11,6 +11,12 @@
 using namespace boost::python;
 using namespace hku;
 
+void (Performance::*statistics_1)(const TradeManagerPtr&,
+                                  const Datetime&) = &Performance::statistics;
+void (Performance::*statistics_2)(const TradeRecordList&, const PositionRecordList&,
+                                  const DatetimeList&, const FundsRecordList&, const Datetime&,
+                                  int) = &Performance::statistics;
+
 void export_Performance() {
     class_<Performance>("Performance", "简单绩效统计", init<>())
       .def("reset", &Performance::reset, R"(reset(self)
@@ -26,7 +32,7 @@ void export_Performance() {
         :param Datetime datetime: 统计截止时刻
         :rtype: str)")
 
-      .def("statistics", &Performance::statistics, (arg("tm"), arg("datetime") = Datetime::now()),
+      .def("statistics", statistics_1, (arg("tm"), arg("datetime") = Datetime::now()),
            R"(statistics(self, tm[, datetime=Datetime.now()])
 
         根据交易记录，统计截至某一时刻的系统绩效, datetime必须大于等于lastDatetime
@@ -34,6 +40,20 @@ void export_Performance() {
         :param TradeManager tm: 指定的交易管理实例
         :param Datetime datetime: 统计截止时刻)")
 
+      .def("statistics", statistics_2,
+           (arg("trade_list"), arg("his_position"), arg("dates"), arg("funds_list"),
+            arg("datetime"), arg("precision") = 2),
+           R"(statistics(self, trade_list, his_position, dates, funds_list, datetime[, precision=2])
+
+        根据已获取的交易记录、已平仓记录及每日资产，顺序计算一次系统绩效，不再访问交易管理实例
+
+        :param TradeRecordList trade_list: 按时间顺序的交易记录
+        :param PositionRecordList his_position: 已平仓记录
+        :param DatetimeList dates: 日期列表
+        :param FundsRecordList funds_list: 与日期列表一一对应的资产详情
+        :param Datetime datetime: 统计截止时刻
+        :param int precision: 价格精度)")
+
       .def("__getitem__", &Performance::get,
            R"(按指标名称获取指标值，必须在运行 statistics 或 report 之后生效
         
@@ -209,6 +209,16 @@ void export_TradeManager() {
 
       //.def("getFunds", getFunds_1, (arg("ktype") = KQuery::DAY))
       //.def("getFunds", getFunds_2, (arg("datetime"), arg("ktype") = KQuery::DAY))
+      .def("get_funds_list", &TradeManagerBase::getFundsList,
+           (arg("dates"), arg("ktype") = KQuery::DAY),
+           R"(get_funds_list(self, dates[, ktype = Query.DAY])
+
+    获取指定日期列表对应的资产详情
+
+    :param DatetimeList dates: 日期列表，可为任意顺序
+    :param Query.KType ktype: K线类型，必须与日期列表匹配
+    :rtype: FundsRecordList)")
+
       .def("get_funds_curve", getTMFundsCurve_1, (arg("dates"), arg("ktype") = KQuery::DAY),
            R"(get_funds_curve(self, dates[, ktype = Query.DAY])
 
@@ -30,6 +30,16 @@ PriceList (Portfolio::*getPFProfitCurve_1)(const DatetimeList&,
                                            KQuery::KType ktype) = &Portfolio::getProfitCurve;
 PriceList (Portfolio::*getPFProfitCurve_2)() = &Portfolio::getProfitCurve;
 
+static boost::python::tuple getPFCurves(Portfolio& pf, const DatetimeList& dates,
+                                        KQuery::KType ktype) {
+    PortfolioCurves curves = pf.getCurves(dates, ktype);
+    boost::python::list sys_funds;
+    for (size_t i = 0, total = curves.sys_list.size(); i < total; i++) {
+        sys_funds.append(boost::python::make_tuple(curves.sys_list[i], curves.sys_funds[i]));
+    }
+    return boost::python::make_tuple(curves.funds, curves.profit, sys_funds);
+}
+
 void export_Portfolio() {
     class_<Portfolio>("Portfolio", R"(实现多标的、多策略的投资组合)", init<>())
       .def(init<const string&>())
@@ -82,7 +92,7 @@ void export_Portfolio() {
       .def("get_funds_curve", getPFFundsCurve_2,
            R"(get_funds_curve(self)
 
-    获取从账户建立日期到系统当前日期的资产净值曲线（按自然日）
+    获取从账户建立日期到系统当前日期的资产净值曲线（按交易日）
 
     :return: 资产净值列表
     :rtype: PriceList)")
@@ -105,6 +115,16 @@ void export_Portfolio() {
     :return: 收益曲线
     :rtype: PriceList)")
 
+      .def("get_curves", getPFCurves, (arg("dates"), arg("ktype") = KQuery::DAY),
+           R"(get_curves(self, dates[, ktype = Query.DAY])
+
+    一次计算资产净值曲线、收益曲线及各子系统的资产净值曲线
+
+    :param DatetimeList dates: 日期列表，应为递增顺序
+    :param Query.KType ktype: K线类型，必须与日期列表匹配
+    :return: (资产净值曲线, 收益曲线, [(子系统, 子系统资产净值曲线), ...])
+    :rtype: tuple)")
+
 #if HKU_PYTHON_SUPPORT_PICKLE
       .def_pickle(name_init_pickle_suite<Portfolio>())
 #endif
@@ -128,7 +128,8 @@ void export_System() {
   - tp_delay_n=3 (int) : 止盈延迟开始的天数，即止盈策略判断从实际交易几天后开始生效
   - ignore_sell_sg=False (bool) : 忽略卖出信号，只使用止损/止赢等其他方式卖出
   - ev_open_position=False (bool): 是否使用市场环境判定进行初始建仓
-  - cn_open_position=False (bool): 是否使用系统有效性条件进行初始建仓)",
+  - cn_open_position=False (bool): 是否使用系统有效性条件进行初始建仓
+  - fast_run=False (bool): 是否使用快速回测模式，仅在可能发生状态变化的Bar上执行完整判断，交易结果与逐Bar执行一致)",
         init<const string&>())
         .def(init<const TradeManagerPtr&, const MoneyManagerPtr&, const EnvironmentPtr&,
                   const ConditionPtr&, const SignalPtr&, const StoplossPtr&, const StoplossPtr&,
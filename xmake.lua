@@ -125,6 +125,7 @@ add_subdirs("./hikyuu_cpp/hikyuu")
 add_subdirs("./hikyuu_pywrap")
 add_subdirs("./hikyuu_cpp/unit_test")
 add_subdirs("./hikyuu_cpp/demo")
+add_subdirs("./hikyuu_cpp/benchmark")
 add_subdirs("./hikyuu_cpp/hikyuu_server")
 
 before_install("scripts.before_install")